@@ -0,0 +1,651 @@
+/* This file is part of the KDE project
+ * SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+// clazy:excludeall=qstring-arg
+#include "BatchScheduler.h"
+
+#include "kptmaindocument.h"
+#include "kptpart.h"
+#include "kptbuiltinschedulerplugin.h"
+#include "kptschedulerpluginloader.h"
+#include "kptproject.h"
+#include "kptschedule.h"
+#include "kptresource.h"
+#include "kptxmlloaderobject.h"
+#include "SchedulingContext.h"
+#include "ProjectStreamLoader.h"
+#include "XmlStreamSaver.h"
+#include "XmlSaveContext.h"
+#include "AppointmentStream.h"
+#include "BookingDigest.h"
+#include "kptglobal.h"
+#include "kptdebug.h"
+
+#include <MimeTypes.h>
+#include <ExtraProperties.h>
+
+#include <KoStore.h>
+#include <KoStoreDevice.h>
+#include <KoXmlReader.h>
+#include <KoXmlWriter.h>
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QEvent>
+#include <QBuffer>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <QScopedPointer>
+#include <QStringList>
+#include <QUrl>
+#include <QXmlStreamReader>
+
+#include <algorithm>
+
+using namespace KPlato;
+
+namespace {
+
+// Plugin loading is not thread safe
+QMutex s_pluginMutex;
+
+// Return the value in kB of @p key in /proc/self/status
+qint64 processStatus(const QByteArray &key)
+{
+#ifdef Q_OS_LINUX
+    QFile file(QStringLiteral("/proc/self/status"));
+    if (file.open(QIODevice::ReadOnly)) {
+        const QList<QByteArray> lines = file.readAll().split('\n');
+        for (const QByteArray &line : lines) {
+            if (line.startsWith(key)) {
+                return line.mid(key.length()).trimmed().split(' ').value(0).toLongLong();
+            }
+        }
+    }
+#else
+    Q_UNUSED(key)
+#endif
+    return -1;
+}
+
+bool writeEntry(KoStore *store, const QString &name, const QByteArray &data)
+{
+    if (!store->open(name)) {
+        return false;
+    }
+    KoStoreDevice dev(store);
+    const bool ok = dev.write(data.data(), data.size()) == data.size();
+    return store->close() && ok;
+}
+
+// Replace @p fileName atomically, the file may be the one that was loaded
+bool writeFile(const QString &fileName, const QByteArray &data, QString *error)
+{
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        *error = QStringLiteral("Could not write: %1: %2").arg(fileName, file.errorString());
+        return false;
+    }
+    if (file.write(data) != data.size()) {
+        *error = QStringLiteral("Could not write: %1: %2").arg(fileName, file.errorString());
+        file.cancelWriting();
+        return false;
+    }
+    if (!file.commit()) {
+        *error = QStringLiteral("Could not write: %1: %2").arg(fileName, file.errorString());
+        return false;
+    }
+    return true;
+}
+
+// Each run has its own plugins, the granularity is kept in the plugin
+QMap<QString, SchedulerPlugin*> loadPlugins(QObject *owner)
+{
+    QMap<QString, SchedulerPlugin*> plugins;
+    plugins.insert(QStringLiteral("Built-in"), new BuiltinSchedulerPlugin(owner));
+    QMutexLocker locker(&s_pluginMutex);
+    SchedulerPluginLoader *pluginLoader = new SchedulerPluginLoader(owner);
+    QObject::connect(pluginLoader, &SchedulerPluginLoader::pluginLoaded, pluginLoader, [&plugins](const QString &key, SchedulerPlugin *plugin) {
+        plugins.insert(key, plugin);
+    });
+    pluginLoader->loadAllPlugins();
+    return plugins;
+}
+
+} // namespace
+
+BatchScheduler::BatchScheduler(const Options &options)
+    : m_options(options)
+{
+}
+
+qint64 BatchScheduler::residentMemory()
+{
+    return processStatus("VmRSS:");
+}
+
+qint64 BatchScheduler::peakMemory()
+{
+    return processStatus("VmHWM:");
+}
+
+bool BatchScheduler::isPortfolio(const QString &fileName)
+{
+    // Same check as KoApplication
+    return fileName.endsWith(QStringLiteral(".planp"));
+}
+
+Project *BatchScheduler::load(KoStore *store, XMLLoaderObject &loader, QString *error) const
+{
+    if (!store->open(QStringLiteral("root"))) {
+        *error = QStringLiteral("Could not open root");
+        return nullptr;
+    }
+    // Peek at the plan element to decide which loader to use, same as MainDocument::loadMainDocument()
+    QXmlStreamAttributes attributes;
+    {
+        QXmlStreamReader reader(store->device());
+        reader.setNamespaceProcessing(false);
+        if (reader.readNextStartElement()) {
+            attributes = reader.attributes();
+        }
+    }
+    store->close();
+    const QString mimetype = attributes.value(QStringLiteral("mime")).toString();
+    const QString version = attributes.hasAttribute(QStringLiteral("version")) ? attributes.value(QStringLiteral("version")).toString() : PLAN_FILE_SYNTAX_VERSION;
+    if (mimetype != PLAN_MIME_TYPE) {
+        *error = QStringLiteral("Invalid document. Expected mimetype %1, got %2").arg(PLAN_MIME_TYPE, mimetype);
+        return nullptr;
+    }
+    if (version > PLAN_FILE_SYNTAX_VERSION) {
+        warnPlan<<"Document created with a newer version of Plan, syntax version:"<<version;
+    }
+    AppointmentStream appointments;
+    const QString appointmentsFile = attributes.value(QStringLiteral("appointments")).toString();
+    if (!appointmentsFile.isEmpty()) {
+        if (store->open(appointmentsFile)) {
+            if (!appointments.setData(store->read(store->size()))) {
+                warnPlanXml<<"Invalid appointment stream:"<<appointmentsFile;
+            }
+            store->close();
+        } else {
+            warnPlanXml<<"Could not open appointment stream:"<<appointmentsFile;
+        }
+    }
+    loader.setAppointmentStream(appointments);
+
+    Project *project = new Project();
+    bool ok = store->open(QStringLiteral("root"));
+    if (ok && ProjectStreamLoader::canLoad(mimetype, version)) {
+        QXmlStreamReader reader(store->device());
+        reader.setNamespaceProcessing(false);
+        ok = loader.loadProject(project, reader);
+        if (reader.hasError()) {
+            *error = QStringLiteral("Parsing error at line %1, column %2: %3").arg(reader.lineNumber()).arg(reader.columnNumber()).arg(reader.errorString());
+        }
+        store->close();
+    } else if (ok) {
+        KoXmlDocument document(true);
+        QString msg;
+        int line = 0;
+        int column = 0;
+        ok = document.setContent(store->device(), &msg, &line, &column);
+        store->close();
+        if (ok) {
+            ok = loader.loadProject(project, document);
+        } else {
+            *error = QStringLiteral("Parsing error at line %1, column %2: %3").arg(line).arg(column).arg(msg);
+        }
+    }
+    loader.setAppointmentStream(AppointmentStream());
+    if (!ok) {
+        if (error->isEmpty()) {
+            *error = QStringLiteral("Failed to load project");
+        }
+        delete project;
+        return nullptr;
+    }
+    return project;
+}
+
+
+MainDocument *BatchScheduler::loadDocument(const QUrl &url, QObject *parent, QString *error) const
+{
+    // Same as MainDocument::insertResourcesFile()
+    Part *part = new Part(parent);
+    MainDocument *doc = new MainDocument(part, false /*no plugins*/);
+    doc->setSkipSharedResourcesAndProjects(true); // the bookings are taken from the portfolio
+    part->setDocument(doc);
+    doc->setAutoSave(0); //disable
+    doc->setCheckAutoSaveFile(false);
+    doc->setProperty(NOUI, true);
+    doc->setProperty(BLOCKSHAREDPROJECTSLOADING, true);
+    doc->setAutoErrorHandlingEnabled(false); // doc returns error message on nonexisting file
+    if (!doc->openUrl(url)) {
+        *error = doc->errorMessage().isEmpty() ? QStringLiteral("Failed to load project") : doc->errorMessage();
+        delete part; // also deletes document
+        return nullptr;
+    }
+    return doc;
+}
+
+void BatchScheduler::insertSharedBookings(Project *project, const QString &fileName) const
+{
+    // Same as MainDocument::insertSharedProjects() and slotInsertSharedProject()
+    QStringList files;
+    const QFileInfo info(m_options.sharedProjects);
+    if (info.isDir()) {
+        const QDir dir(info.absoluteFilePath());
+        const QStringList entries = dir.entryList(QStringList() << QStringLiteral("*.plan"), QDir::Files);
+        for (const QString &f : entries) {
+            files << dir.absoluteFilePath(f);
+        }
+    } else if (info.isFile()) {
+        files << info.absoluteFilePath();
+    } else {
+        warnPlan<<"Shared projects not found:"<<m_options.sharedProjects;
+        return;
+    }
+    const QList<Resource*> resources = project->resourceList();
+    for (Resource *r : resources) {
+        r->clearExternalAppointments();
+    }
+    const QFileInfo self(fileName);
+    // The resource file is not a project
+    const QString resourceFile = project->sharedResourcesFile().isEmpty() ? QString() : QFileInfo(self.absoluteDir(), project->sharedResourcesFile()).canonicalFilePath();
+    for (const QString &file : qAsConst(files)) {
+        const QString path = QFileInfo(file).canonicalFilePath();
+        if (path == self.canonicalFilePath() || path == resourceFile) {
+            continue;
+        }
+        QScopedPointer<KoStore> store(KoStore::createStore(file, KoStore::Read));
+        if (store->bad()) {
+            warnPlan<<"Could not open shared project:"<<file;
+            continue;
+        }
+        BookingDigest digest;
+        bool ok = false;
+        if (store->hasFile(BookingDigest::fileName()) && store->open(BookingDigest::fileName())) {
+            ok = digest.setData(store->device()->readAll());
+            store->close();
+        }
+        if (!ok) {
+            // no digest, load the complete project
+            XMLLoaderObject loader;
+            QString error;
+            QScopedPointer<Project> shared(load(store.data(), loader, &error));
+            if (!shared) {
+                warnPlan<<"Could not load shared project:"<<file<<error;
+                continue;
+            }
+            digest.create(shared.data());
+        }
+        digest.insertExternalAppointments(project);
+    }
+}
+
+ScheduleManager *BatchScheduler::scheduleManager(Project *project, const QString &name, QString *error) const
+{
+    ScheduleManager *sm = name.isEmpty() ? project->scheduleManagers().value(0) : project->findScheduleManagerByName(name);
+    if (!sm) {
+        sm = name.isEmpty() ? project->createScheduleManager() : project->createScheduleManager(name);
+        project->addScheduleManager(sm);
+    }
+    if (sm->isBaselined()) {
+        *error = QStringLiteral("Schedule manager is baselined: %1").arg(sm->name());
+        return nullptr;
+    }
+    return sm;
+}
+
+bool BatchScheduler::findGranularity(const SchedulerPlugin *plugin, int *index, QString *error) const
+{
+    *index = -1;
+    if (m_options.granularity <= 0) {
+        return true;
+    }
+    const QList<ulong> granularities = plugin->granularities();
+    *index = granularities.indexOf(static_cast<ulong>(m_options.granularity) * 60 * 1000);
+    if (*index < 0) {
+        QStringList values;
+        for (ulong g : granularities) {
+            values << QString::number(g / (60 * 1000));
+        }
+        *error = QStringLiteral("Granularity %1 is not supported by %2, supported: %3").arg(m_options.granularity).arg(plugin->name(), values.join(QStringLiteral(", ")));
+        return false;
+    }
+    return true;
+}
+
+QString BatchScheduler::outputFileName(const QString &fileName) const
+{
+    const QFileInfo info(fileName);
+    return m_options.outputDir.isEmpty() ? info.absoluteFilePath() : QDir(m_options.outputDir).absoluteFilePath(info.fileName());
+}
+
+bool BatchScheduler::save(Project *project, const QString &fileName, const QString &outputFileName, QString *error) const
+{
+    QByteArray data;
+    {
+        // The entries that are not changed by scheduling are copied from the loaded file
+        QScopedPointer<KoStore> source(KoStore::createStore(fileName, KoStore::Read));
+        if (source->bad()) {
+            *error = QStringLiteral("Could not open file: %1").arg(fileName);
+            return false;
+        }
+        if (!save(project, source.data(), &data, error)) {
+            return false;
+        }
+    }
+    return writeFile(outputFileName, data, error);
+}
+
+bool BatchScheduler::save(Project *project, KoStore *source, QByteArray *data, QString *error) const
+{
+    // Same content as MainDocument saves, see KoDocument::saveNativeFormatCalligra()
+    QBuffer buffer(data);
+    QScopedPointer<KoStore> store(KoStore::createStore(&buffer, KoStore::Write, QByteArray(PLAN_MIME_TYPE.latin1()), KoStore::Zip));
+    if (store->bad()) {
+        *error = QStringLiteral("Could not create store");
+        return false;
+    }
+    if (!store->open(QStringLiteral("root"))) {
+        *error = QStringLiteral("Could not write root");
+        return false;
+    }
+    AppointmentStream appointments;
+    {
+        KoStoreDevice dev(store.data());
+        dev.open(QIODevice::WriteOnly);
+        KoXmlWriter writer(&dev);
+        XmlStreamSaver saver(writer);
+        saver.setAppointmentStream(&appointments);
+        saver.save(project);
+    }
+    if (!store->close()) {
+        *error = QStringLiteral("Could not write root");
+        return false;
+    }
+    if (!appointments.isEmpty() && !writeEntry(store.data(), AppointmentStream::fileName(), appointments.data())) {
+        *error = QStringLiteral("Failed to save appointments");
+        return false;
+    }
+    XmlSaveContext context(project);
+    if (context.saveWorkIntervalsCache()) {
+        writeEntry(store.data(), QStringLiteral("workintervalscache.xml"), context.document.toByteArray());
+    }
+    BookingDigest digest;
+    digest.create(project);
+    writeEntry(store.data(), BookingDigest::fileName(), digest.data());
+    // These are not changed by scheduling, so just copy them
+    const QStringList entries = QStringList() << QStringLiteral("documentinfo.xml") << QStringLiteral("preview.png") << QStringLiteral("context.xml");
+    for (const QString &name : entries) {
+        if (source->hasFile(name) && source->open(name)) {
+            const QByteArray entry = source->read(source->size());
+            source->close();
+            writeEntry(store.data(), name, entry);
+        }
+    }
+    if (!store->finalize()) {
+        *error = QStringLiteral("Failed to save");
+        return false;
+    }
+    return true;
+}
+
+BatchScheduler::Result BatchScheduler::run(const QString &fileName) const
+{
+    Result result;
+    result.fileName = fileName;
+    if (isPortfolio(fileName)) {
+        result.error = QStringLiteral("Portfolios are scheduled with runPortfolio()");
+        return result;
+    }
+    if (!m_options.dryRun && m_options.outputDir.isEmpty() && !m_options.overwrite) {
+        result.error = QStringLiteral("No output directory and overwrite is not set");
+        return result;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    QScopedPointer<Project> project;
+    {
+        QScopedPointer<KoStore> store(KoStore::createStore(fileName, KoStore::Read));
+        if (store->bad()) {
+            result.error = QStringLiteral("Could not open file");
+            return result;
+        }
+        XMLLoaderObject loader;
+        project.reset(load(store.data(), loader, &result.error));
+    }
+    if (project && !m_options.sharedProjects.isEmpty()) {
+        insertSharedBookings(project.data(), fileName);
+    }
+    result.load = timer.elapsed();
+    result.loadMemory = residentMemory();
+    if (!project) {
+        return result;
+    }
+
+    QObject owner;
+    const QMap<QString, SchedulerPlugin*> plugins = loadPlugins(&owner);
+    project->setSchedulerPlugins(plugins);
+
+    ScheduleManager *sm = scheduleManager(project.data(), m_options.manager, &result.error);
+    if (!sm) {
+        return result;
+    }
+    if (!m_options.scheduler.isEmpty()) {
+        if (!plugins.contains(m_options.scheduler)) {
+            result.error = QStringLiteral("Unknown scheduler: %1, available: %2").arg(m_options.scheduler, QStringList(plugins.keys()).join(QStringLiteral(", ")));
+            return result;
+        }
+        sm->setSchedulerPluginId(m_options.scheduler);
+    }
+    SchedulerPlugin *plugin = sm->schedulerPlugin();
+    if (!plugin) {
+        result.error = QStringLiteral("No scheduler");
+        return result;
+    }
+    int index = -1;
+    if (!findGranularity(plugin, &index, &result.error)) {
+        return result;
+    }
+    if (index >= 0) {
+        sm->setGranularityIndex(index);
+    }
+
+    timer.restart();
+    plugin->calculate(*project, sm, true);
+    // The scheduler job is deleted with deleteLater(), there is no event loop in this thread
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    result.calculationResult = sm->calculationResult();
+    result.schedule = timer.elapsed();
+    result.scheduleMemory = residentMemory();
+    if (result.calculationResult != ScheduleManager::CalculationDone) {
+        result.error = QStringLiteral("Scheduling failed: %1").arg(sm->name());
+        return result;
+    }
+    if (m_options.dryRun) {
+        result.ok = true;
+        return result;
+    }
+
+    timer.restart();
+    result.outputFileName = outputFileName(fileName);
+    result.ok = save(project.data(), fileName, result.outputFileName, &result.error);
+    result.save = timer.elapsed();
+    result.saveMemory = residentMemory();
+    return result;
+}
+
+QList<BatchScheduler::Result> BatchScheduler::runPortfolio(const QString &fileName) const
+{
+    Result portfolioResult;
+    portfolioResult.fileName = fileName;
+    if (!m_options.dryRun && m_options.outputDir.isEmpty() && !m_options.overwrite) {
+        portfolioResult.error = QStringLiteral("No output directory and overwrite is not set");
+        return QList<Result>() << portfolioResult;
+    }
+    KoXmlDocument document;
+    {
+        QScopedPointer<KoStore> store(KoStore::createStore(fileName, KoStore::Read));
+        if (store->bad() || !store->open(QStringLiteral("root"))) {
+            portfolioResult.error = QStringLiteral("Could not open file");
+            return QList<Result>() << portfolioResult;
+        }
+        QString msg;
+        int line = 0;
+        int column = 0;
+        const bool ok = document.setContent(store->device(), &msg, &line, &column);
+        store->close();
+        if (!ok) {
+            portfolioResult.error = QStringLiteral("Parsing error at line %1, column %2: %3").arg(line).arg(column).arg(msg);
+            return QList<Result>() << portfolioResult;
+        }
+    }
+    // Same as Portfolio::MainDocument::loadXML()
+    const KoXmlElement portfolio = document.documentElement();
+    const QString mimetype = portfolio.attribute(QStringLiteral("mime"));
+    if (mimetype != PLANPORTFOLIO_MIME_TYPE) {
+        portfolioResult.error = QStringLiteral("Invalid document. Expected mimetype %1, got %2").arg(PLANPORTFOLIO_MIME_TYPE, mimetype);
+        return QList<Result>() << portfolioResult;
+    }
+
+    QObject owner;
+    const QMap<QString, SchedulerPlugin*> plugins = loadPlugins(&owner);
+    const QString schedulerKey = m_options.scheduler.isEmpty() ? QStringLiteral("Built-in") : m_options.scheduler;
+    SchedulerPlugin *scheduler = plugins.value(schedulerKey);
+    if (!scheduler) {
+        portfolioResult.error = QStringLiteral("Unknown scheduler: %1, available: %2").arg(schedulerKey, QStringList(plugins.keys()).join(QStringLiteral(", ")));
+        return QList<Result>() << portfolioResult;
+    }
+    int index = -1;
+    if (!findGranularity(scheduler, &index, &portfolioResult.error)) {
+        return QList<Result>() << portfolioResult;
+    }
+    if (index >= 0) {
+        scheduler->setGranularityIndex(index);
+    }
+
+    // Owns the parts, which own the documents
+    QObject parts;
+    // Populate scheduling context, same as Portfolio::SchedulingView::calculateSchedule()
+    SchedulingContext context;
+    context.scheduler = scheduler;
+    context.project = new Project();
+    context.project->setName(QStringLiteral("Project Collection"));
+    context.calculateFrom = QDateTime::currentDateTime();
+
+    QList<Result> results;
+    // Index into results of the scheduled documents
+    QMap<int, KoDocument*> scheduled;
+    DateTime targetEnd;
+    QElapsedTimer timer;
+    const QDir dir = QFileInfo(fileName).absoluteDir();
+    const KoXmlElement projects = portfolio.namedItem(QStringLiteral("projects")).toElement();
+    KoXmlElement p;
+    forEachElement(p, projects) {
+        const QString control = p.attribute(QStringLiteral(SCHEDULINGCONTROL));
+        if (control != QStringLiteral("Schedule") && control != QStringLiteral("Include")) {
+            continue;
+        }
+        Result result;
+        result.fileName = p.attribute(QStringLiteral("url"));
+        if (p.attribute(QStringLiteral(SAVEEMBEDDED)).toInt()) {
+            result.error = QStringLiteral("Embedded projects are not supported: %1").arg(p.attribute(QStringLiteral("name")));
+            return QList<Result>() << result;
+        }
+        const QUrl url = QUrl::fromUserInput(p.attribute(QStringLiteral("url")), dir.absolutePath());
+        if (!url.isLocalFile()) {
+            result.error = QStringLiteral("Only local files are supported");
+            return QList<Result>() << result;
+        }
+        result.fileName = url.toLocalFile();
+        timer.start();
+        MainDocument *doc = loadDocument(url, &parts, &result.error);
+        result.load = timer.elapsed();
+        result.loadMemory = residentMemory();
+        if (!doc) {
+            return QList<Result>() << result;
+        }
+        Project *project = doc->project();
+        project->setSchedulerPlugins(plugins);
+        if (control == QStringLiteral("Include")) {
+            // The bookings of this schedule manager are inserted into the scheduled projects
+            doc->setProperty(SCHEDULEMANAGERNAME, p.attribute(QStringLiteral(SCHEDULEMANAGERNAME)));
+            context.addResourceBookings(doc);
+            continue;
+        }
+        ScheduleManager *sm = scheduleManager(project, m_options.manager.isEmpty() ? p.attribute(QStringLiteral(SCHEDULEMANAGERNAME)) : m_options.manager, &result.error);
+        if (!sm) {
+            return QList<Result>() << result;
+        }
+        sm->setSchedulerPluginId(schedulerKey);
+        if (index >= 0) {
+            sm->setGranularityIndex(index);
+        }
+        project->setProperty(SCHEDULEMANAGERNAME, sm->name());
+        doc->setProperty(SCHEDULEMANAGERNAME, sm->name());
+        if (project->constraintEndTime() < context.calculateFrom) {
+            result.error = QStringLiteral("Scheduling not possible. Project target end time must be later than calculation time.");
+            return QList<Result>() << result;
+        }
+        targetEnd = std::max(targetEnd, project->constraintEndTime());
+        context.addProject(doc, p.hasAttribute(QStringLiteral(SCHEDULINGPRIORITY)) ? p.attribute(QStringLiteral(SCHEDULINGPRIORITY)).toInt() : -1);
+        scheduled.insert(results.count(), doc);
+        results << result;
+    }
+    if (context.projects.isEmpty()) {
+        portfolioResult.error = QStringLiteral("Nothing to schedule");
+        return QList<Result>() << portfolioResult;
+    }
+    context.project->setConstraintEndTime(targetEnd);
+
+    // The projects are calculated in place, highest priority first,
+    // each with the bookings of the included projects and the projects calculated before it
+    timer.start();
+    scheduler->schedule(context);
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    const qint64 elapsed = timer.elapsed();
+    const qint64 memory = residentMemory();
+    bool ok = true;
+    for (auto it = scheduled.constBegin(); it != scheduled.constEnd(); ++it) {
+        Result &result = results[it.key()];
+        const ScheduleManager *sm = it.value()->project()->currentScheduleManager();
+        result.calculationResult = sm ? sm->calculationResult() : 0;
+        result.schedule = elapsed;
+        result.scheduleMemory = memory;
+        if (result.calculationResult != ScheduleManager::CalculationDone) {
+            result.error = QStringLiteral("Scheduling failed: %1").arg(it.value()->property(SCHEDULEMANAGERNAME).toString());
+            ok = false;
+        }
+    }
+    // The projects depend on each other, so either all or none are saved
+    for (auto it = scheduled.constBegin(); it != scheduled.constEnd(); ++it) {
+        Result &result = results[it.key()];
+        if (!ok) {
+            if (result.error.isEmpty()) {
+                result.error = QStringLiteral("Not saved, scheduling of another project in the portfolio failed");
+            }
+            continue;
+        }
+        if (m_options.dryRun) {
+            result.ok = true;
+            continue;
+        }
+        timer.start();
+        result.outputFileName = outputFileName(result.fileName);
+        result.ok = save(it.value()->project(), result.fileName, result.outputFileName, &result.error);
+        result.save = timer.elapsed();
+        result.saveMemory = residentMemory();
+    }
+    return results;
+}
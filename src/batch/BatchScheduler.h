@@ -0,0 +1,112 @@
+/* This file is part of the KDE project
+ * SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#ifndef KPlato_BatchScheduler_h
+#define KPlato_BatchScheduler_h
+
+#include <QList>
+#include <QString>
+
+class KoStore;
+class QObject;
+class QUrl;
+
+namespace KPlato
+{
+class MainDocument;
+class Project;
+class ScheduleManager;
+class SchedulerPlugin;
+class XMLLoaderObject;
+
+/**
+ * Schedules plan files without a user interface.
+ *
+ * A file is loaded directly from the store (see ProjectStreamLoader), one schedule
+ * manager is calculated with the scheduler in the calling thread and the project is saved
+ * with XmlStreamSaver. Nothing is shared between calls to run(), each call loads its own
+ * scheduler plugins, so files can be scheduled in parallel from different threads.
+ *
+ * The projects of a portfolio are scheduled together by runPortfolio(), in priority order
+ * and with the bookings of the other projects, the same way as Plan Portfolio does.
+ * The projects are loaded as plan documents, so this must be called from the main thread.
+ *
+ * The files are written with QSaveFile, so a file is either replaced completely or not at all.
+ */
+class BatchScheduler
+{
+public:
+    struct Options {
+        /// Scheduler plugin key, empty means the scheduler set in the schedule manager
+        QString scheduler;
+        /// Name of the schedule manager, created if it does not exist.
+        /// Empty means the first top level schedule manager.
+        QString manager;
+        /// Scheduling granularity in minutes, 0 means the scheduler default
+        int granularity = 0;
+        /// The scheduled files are saved here
+        QString outputDir;
+        /// Overwrite the scheduled files when there is no output directory
+        bool overwrite = false;
+        /// Only load and schedule, do not save the result
+        bool dryRun = false;
+        /// Plan file, or directory of plan files, with the bookings of the projects
+        /// that share resources with the scheduled project. Not used for portfolios.
+        QString sharedProjects;
+    };
+
+    struct Result {
+        QString fileName;
+        QString outputFileName;
+        bool ok = false;
+        QString error;
+        /// ScheduleManager::CalculationResult
+        int calculationResult = 0;
+        /// Wall time per phase in milliseconds
+        qint64 load = 0;
+        qint64 schedule = 0;
+        qint64 save = 0;
+        /// Resident set size of the process in kB after each phase, -1 if not known
+        qint64 loadMemory = -1;
+        qint64 scheduleMemory = -1;
+        qint64 saveMemory = -1;
+    };
+
+    explicit BatchScheduler(const Options &options);
+
+    /// Load, schedule and save @p fileName
+    Result run(const QString &fileName) const;
+
+    /// Load, schedule and save the projects of the portfolio @p fileName.
+    /// Returns one result per scheduled project, or one result for the portfolio if it failed.
+    /// Must be called from the main thread.
+    QList<Result> runPortfolio(const QString &fileName) const;
+
+    /// Return true if @p fileName is a portfolio file
+    static bool isPortfolio(const QString &fileName);
+
+    /// Return the resident set size of the process in kB, or -1 if not known
+    static qint64 residentMemory();
+    /// Return the peak resident set size of the process in kB, or -1 if not known
+    static qint64 peakMemory();
+
+private:
+    Project *load(KoStore *store, XMLLoaderObject &loader, QString *error) const;
+    MainDocument *loadDocument(const QUrl &url, QObject *parent, QString *error) const;
+    void insertSharedBookings(Project *project, const QString &fileName) const;
+    ScheduleManager *scheduleManager(Project *project, const QString &name, QString *error) const;
+    bool findGranularity(const SchedulerPlugin *plugin, int *index, QString *error) const;
+    QString outputFileName(const QString &fileName) const;
+    bool save(Project *project, const QString &fileName, const QString &outputFileName, QString *error) const;
+    bool save(Project *project, KoStore *source, QByteArray *data, QString *error) const;
+
+private:
+    Options m_options;
+};
+
+} // namespace KPlato
+
+#endif
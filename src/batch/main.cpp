@@ -0,0 +1,161 @@
+/* This file is part of the KDE project
+ * SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+// clazy:excludeall=qstring-arg
+
+/*
+ * Schedules plan files without a user interface, e.g. from a nightly job:
+ *   calligraplanbatch --scheduler TaskJuggler --manager Plan --granularity 15 --output-dir out *.plan
+ *
+ * The scheduled files are saved in --output-dir, the input files are only overwritten with --overwrite.
+ * Files are scheduled in parallel, --jobs sets the number of files scheduled at a time.
+ * --shared-projects gives the plan files with the bookings of resources shared with other projects.
+ * Portfolio files (.planp) are scheduled one at a time after the plan files,
+ * one result is printed for each scheduled project in the portfolio.
+ *
+ * One JSON object is printed per file with the wall time (ms) and the resident memory (kB)
+ * of the process after each phase (load, schedule, save), followed by a summary.
+ * The memory is for the whole process, so with more than one job it includes the other files.
+ */
+
+#include "BatchScheduler.h"
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QFuture>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTextStream>
+#include <QThread>
+#include <QThreadPool>
+#include <QtConcurrent>
+
+using namespace KPlato;
+
+namespace {
+
+QJsonObject toJson(const BatchScheduler::Result &result)
+{
+    QJsonObject object;
+    object.insert(QStringLiteral("file"), result.fileName);
+    object.insert(QStringLiteral("output"), result.outputFileName);
+    object.insert(QStringLiteral("ok"), result.ok);
+    if (!result.error.isEmpty()) {
+        object.insert(QStringLiteral("error"), result.error);
+    }
+    object.insert(QStringLiteral("result"), result.calculationResult);
+    QJsonObject phases;
+    phases.insert(QStringLiteral("load"), result.load);
+    phases.insert(QStringLiteral("schedule"), result.schedule);
+    phases.insert(QStringLiteral("save"), result.save);
+    object.insert(QStringLiteral("phases"), phases);
+    QJsonObject memory;
+    memory.insert(QStringLiteral("load"), result.loadMemory);
+    memory.insert(QStringLiteral("schedule"), result.scheduleMemory);
+    memory.insert(QStringLiteral("save"), result.saveMemory);
+    object.insert(QStringLiteral("memoryKb"), memory);
+    return object;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    // Portfolios are loaded as plan documents, which need a gui application
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication app(argc, argv);
+    QCoreApplication::setApplicationName(QStringLiteral("calligraplanbatch"));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Schedule Plan projects without a user interface."));
+    parser.addHelpOption();
+    const QCommandLineOption schedulerOption(QStringLiteral("scheduler"), QStringLiteral("Scheduler plugin, default is the scheduler set in the schedule manager"), QStringLiteral("key"));
+    const QCommandLineOption managerOption(QStringLiteral("manager"), QStringLiteral("Schedule manager, created if it does not exist. Default is the first schedule manager"), QStringLiteral("name"));
+    const QCommandLineOption granularityOption(QStringLiteral("granularity"), QStringLiteral("Scheduling granularity in minutes, must be supported by the scheduler"), QStringLiteral("minutes"), QStringLiteral("0"));
+    const QCommandLineOption outputOption(QStringLiteral("output-dir"), QStringLiteral("Save the scheduled projects here"), QStringLiteral("dir"));
+    const QCommandLineOption overwriteOption(QStringLiteral("overwrite"), QStringLiteral("Overwrite the files when no output directory is given"));
+    const QCommandLineOption jobsOption(QStringLiteral("jobs"), QStringLiteral("Number of files scheduled in parallel"), QStringLiteral("n"), QString::number(QThread::idealThreadCount()));
+    const QCommandLineOption dryRunOption(QStringLiteral("dry-run"), QStringLiteral("Load and schedule, but do not save"));
+    const QCommandLineOption sharedProjectsOption(QStringLiteral("shared-projects"), QStringLiteral("Plan file, or directory of plan files, with bookings of shared resources"), QStringLiteral("path"));
+    parser.addOptions({ schedulerOption, managerOption, granularityOption, outputOption, overwriteOption, jobsOption, dryRunOption, sharedProjectsOption });
+    parser.addPositionalArgument(QStringLiteral("files"), QStringLiteral("Plan (.plan) and portfolio (.planp) files"), QStringLiteral("files..."));
+    parser.process(app);
+
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+
+    BatchScheduler::Options options;
+    options.scheduler = parser.value(schedulerOption);
+    options.manager = parser.value(managerOption);
+    options.granularity = parser.value(granularityOption).toInt();
+    options.outputDir = parser.value(outputOption);
+    options.overwrite = parser.isSet(overwriteOption);
+    options.dryRun = parser.isSet(dryRunOption);
+    options.sharedProjects = parser.value(sharedProjectsOption);
+    if (!options.dryRun && options.outputDir.isEmpty() && !options.overwrite) {
+        err << "Either --output-dir, --overwrite or --dry-run must be given" << '\n';
+        return 1;
+    }
+
+    QStringList files;
+    QStringList portfolios;
+    const QStringList arguments = parser.positionalArguments();
+    for (const QString &file : arguments) {
+        if (BatchScheduler::isPortfolio(file)) {
+            portfolios << file;
+        } else {
+            files << file;
+        }
+    }
+    files.removeDuplicates();
+    portfolios.removeDuplicates();
+    if (files.isEmpty() && portfolios.isEmpty()) {
+        parser.showHelp(1);
+    }
+
+    const int jobs = qMax(1, parser.value(jobsOption).toInt());
+    QThreadPool::globalInstance()->setMaxThreadCount(jobs);
+
+    QElapsedTimer timer;
+    timer.start();
+    const BatchScheduler scheduler(options);
+    QList<QFuture<BatchScheduler::Result>> futures;
+    for (const QString &file : qAsConst(files)) {
+        futures << QtConcurrent::run(&scheduler, &BatchScheduler::run, file);
+    }
+    int count = 0;
+    int failed = 0;
+    const auto print = [&](const BatchScheduler::Result &result) {
+        ++count;
+        if (!result.ok) {
+            ++failed;
+        }
+        out << QJsonDocument(toJson(result)).toJson(QJsonDocument::Compact) << '\n';
+        out.flush();
+    };
+    for (QFuture<BatchScheduler::Result> &future : futures) {
+        print(future.result());
+    }
+    // The projects of a portfolio are plan documents, they live in the main thread
+    for (const QString &file : qAsConst(portfolios)) {
+        const QList<BatchScheduler::Result> results = scheduler.runPortfolio(file);
+        for (const BatchScheduler::Result &result : results) {
+            print(result);
+        }
+    }
+    QJsonObject summary;
+    summary.insert(QStringLiteral("files"), count);
+    summary.insert(QStringLiteral("failed"), failed);
+    summary.insert(QStringLiteral("jobs"), jobs);
+    summary.insert(QStringLiteral("total"), timer.elapsed());
+    summary.insert(QStringLiteral("peakMemoryKb"), BatchScheduler::peakMemory());
+    out << QJsonDocument(summary).toJson(QJsonDocument::Compact) << '\n';
+
+    return failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,157 @@
+/* This file is part of the KDE project
+ * SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+// clazy:excludeall=qstring-arg
+#include "AppointmentStore.h"
+
+#include "kptappointment.h"
+#include "kptschedule.h"
+#include "Resource.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace KPlato
+{
+
+AppointmentStore::AppointmentStore()
+    : m_revision(0)
+    , m_built(false)
+{
+}
+
+void AppointmentStore::clear()
+{
+    m_built = false;
+    m_nodeSchedule.clear();
+    m_resourceSchedule.clear();
+    m_resource.clear();
+    m_firstRow.clear();
+    m_day.clear();
+    m_effort.clear();
+    m_nodeIndex.clear();
+    m_resourceIndex.clear();
+}
+
+void AppointmentStore::build(const QList<Schedule*> &schedules, int revision)
+{
+    clear();
+    m_revision = revision;
+    m_firstRow.append(0);
+    for (const Schedule *s : schedules) {
+        if (!s) {
+            continue;
+        }
+        const QList<Appointment*> appointments = s->appointments();
+        for (const Appointment *a : appointments) {
+            const int index = m_nodeSchedule.count();
+            m_nodeSchedule.append(s);
+            m_resourceSchedule.append(a->resource());
+            m_resource.append(a->resource() ? a->resource()->resource() : nullptr);
+            m_nodeIndex[s].append(index);
+            if (a->resource()) {
+                m_resourceIndex[a->resource()].append(index);
+            }
+            // Intervals are sorted by date, add one row per date
+            const QMultiMap<QDate, AppointmentInterval> &map = a->intervals().map();
+            QMultiMap<QDate, AppointmentInterval>::const_iterator it = map.constBegin();
+            for (; it != map.constEnd(); ++it) {
+                const qint64 day = it.key().toJulianDay();
+                const qint64 effort = it.value().effort().milliseconds();
+                if (m_day.count() > m_firstRow.last() && m_day.last() == day) {
+                    m_effort.last() += effort;
+                } else {
+                    m_day.append(day);
+                    m_effort.append(effort);
+                }
+            }
+            m_firstRow.append(m_day.count());
+        }
+    }
+    m_built = true;
+}
+
+int AppointmentStore::appointmentCount(const Schedule *schedule) const
+{
+    QHash<const Schedule*, QVector<int>>::const_iterator it = m_nodeIndex.constFind(schedule);
+    if (it != m_nodeIndex.constEnd()) {
+        return it.value().count();
+    }
+    it = m_resourceIndex.constFind(schedule);
+    if (it != m_resourceIndex.constEnd()) {
+        return it.value().count();
+    }
+    return -1;
+}
+
+void AppointmentStore::addPrDay(EffortCostMap &ec, int appointment, qint64 start, qint64 end, EffortCostCalculationType type) const
+{
+    const Schedule *rs = m_resourceSchedule.at(appointment);
+    const Resource *resource = m_resource.at(appointment);
+    const double rate = rs && resource ? rs->normalRatePrHour() : 0.0;
+    const bool work = resource ? resource->type() == Resource::Type_Work : true;
+    if (type == ECCT_Work && !work) {
+        return;
+    }
+    const qint64 *first = m_day.constData() + m_firstRow.at(appointment);
+    const qint64 *last = m_day.constData() + m_firstRow.at(appointment + 1);
+    const qint64 *effort = m_effort.constData();
+    for (const qint64 *day = std::lower_bound(first, last, start); day != last && *day <= end; ++day) {
+        const Duration eff(effort[day - m_day.constData()]);
+        const double cost = eff.toDouble(Duration::Unit_h) * rate;
+        if (type == ECCT_EffortWork && !work) {
+            ec.add(QDate::fromJulianDay(*day), Duration::zeroDuration, cost);
+        } else {
+            ec.add(QDate::fromJulianDay(*day), eff, cost);
+        }
+    }
+}
+
+static void dayRange(QDate start, QDate end, qint64 &first, qint64 &last)
+{
+    first = start.isValid() ? start.toJulianDay() : std::numeric_limits<qint64>::min();
+    last = end.isValid() ? end.toJulianDay() : std::numeric_limits<qint64>::max();
+}
+
+EffortCostMap AppointmentStore::plannedPrDay(const Schedule *schedule, QDate start, QDate end, EffortCostCalculationType type) const
+{
+    EffortCostMap ec;
+    qint64 first, last;
+    dayRange(start, end, first, last);
+    QHash<const Schedule*, QVector<int>>::const_iterator it = m_nodeIndex.constFind(schedule);
+    if (it == m_nodeIndex.constEnd()) {
+        it = m_resourceIndex.constFind(schedule);
+        if (it == m_resourceIndex.constEnd()) {
+            return ec;
+        }
+    }
+    for (int appointment : it.value()) {
+        addPrDay(ec, appointment, first, last, type);
+    }
+    return ec;
+}
+
+EffortCostMap AppointmentStore::plannedPrDay(const Schedule *schedule, const Resource *resource, QDate start, QDate end, EffortCostCalculationType type) const
+{
+    EffortCostMap ec;
+    qint64 first, last;
+    dayRange(start, end, first, last);
+    QHash<const Schedule*, QVector<int>>::const_iterator it = m_nodeIndex.constFind(schedule);
+    if (it == m_nodeIndex.constEnd()) {
+        it = m_resourceIndex.constFind(schedule);
+        if (it == m_resourceIndex.constEnd()) {
+            return ec;
+        }
+    }
+    for (int appointment : it.value()) {
+        if (m_resource.at(appointment) == resource) {
+            addPrDay(ec, appointment, first, last, type);
+        }
+    }
+    return ec;
+}
+
+} // namespace KPlato
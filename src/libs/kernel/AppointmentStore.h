@@ -0,0 +1,88 @@
+/* This file is part of the KDE project
+ * SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#ifndef APPOINTMENTSTORE_H
+#define APPOINTMENTSTORE_H
+
+#include "plankernel_export.h"
+#include "kptglobal.h"
+#include "kpteffortcostmap.h"
+
+#include <QHash>
+#include <QVector>
+
+namespace KPlato
+{
+
+class Schedule;
+class Resource;
+
+/**
+ * Columnar store of the planned effort per day of all appointments in a schedule.
+ *
+ * There is one row per appointment and day with effort.
+ * The rows of an appointment are contiguous and sorted by day,
+ * so a query for a date range is a binary search followed by a linear scan.
+ * Appointments are indexed by node schedule and resource schedule.
+ *
+ * Cost is not stored, it is calculated from the resource rate when queried
+ * so that rate changes do not invalidate the store.
+ *
+ * Any change to an appointment increments the appointment revision of its main schedule,
+ * see MainSchedule::appointmentRevision(). The main schedule rebuilds the store
+ * when this differs from revision().
+ *
+ * The store is implicitly shared, a copy is cheap and can be read in another thread.
+ */
+class PLANKERNEL_EXPORT AppointmentStore
+{
+public:
+    AppointmentStore();
+
+    /// Return true if the store has been built
+    bool isValid() const { return m_built; }
+    /// Return the appointment revision the store was built from
+    int revision() const { return m_revision; }
+    void clear();
+    /// Build the store from the scheduling appointments of the node @p schedules at appointment @p revision
+    void build(const QList<Schedule*> &schedules, int revision = 0);
+
+    int rowCount() const { return m_day.count(); }
+    int appointmentCount() const { return m_nodeSchedule.count(); }
+    /// Return the number of appointments stored for the node or resource @p schedule, -1 if none
+    int appointmentCount(const Schedule *schedule) const;
+
+    /// Planned effort and cost per day for the node or resource @p schedule
+    EffortCostMap plannedPrDay(const Schedule *schedule, QDate start, QDate end, EffortCostCalculationType type = ECCT_All) const;
+    /// Planned effort and cost per day for @p resource in the node @p schedule
+    EffortCostMap plannedPrDay(const Schedule *schedule, const Resource *resource, QDate start, QDate end, EffortCostCalculationType type = ECCT_All) const;
+
+private:
+    friend class TimePhasedCache;
+    void addPrDay(EffortCostMap &ec, int appointment, qint64 start, qint64 end, EffortCostCalculationType type) const;
+
+private:
+    int m_revision;
+    bool m_built;
+
+    // Per appointment
+    QVector<const Schedule*> m_nodeSchedule;
+    QVector<const Schedule*> m_resourceSchedule;
+    QVector<const Resource*> m_resource;
+    QVector<int> m_firstRow; // m_firstRow[i+1] is one past the last row of appointment i
+
+    // Per row
+    QVector<qint64> m_day; // julian day
+    QVector<qint64> m_effort; // milliseconds
+
+    // Appointment indexes
+    QHash<const Schedule*, QVector<int>> m_nodeIndex;
+    QHash<const Schedule*, QVector<int>> m_resourceIndex;
+};
+
+} // namespace KPlato
+
+#endif
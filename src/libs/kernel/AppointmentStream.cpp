@@ -0,0 +1,214 @@
+/* This file is part of the KDE project
+ * SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+// clazy:excludeall=qstring-arg
+#include "AppointmentStream.h"
+
+#include "kptappointment.h"
+#include "kptdatetime.h"
+#include "kptdebug.h"
+
+#include <QtEndian>
+#include <QTimeZone>
+
+#include <cstring>
+
+namespace KPlato
+{
+
+static const char s_magic[] = { 'P', 'L', 'A', 'I' };
+static const quint8 s_version = 1;
+static const int s_headerSize = sizeof(s_magic) + 1 + 4; // magic, version, count
+
+static void writeVarint(QByteArray &data, quint64 value)
+{
+    while (value >= 0x80) {
+        data.append(char((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    data.append(char(value));
+}
+
+// Small negative numbers are encoded as small positive numbers
+static quint64 zigzag(qint64 value)
+{
+    return (quint64(value) << 1) ^ quint64(value >> 63);
+}
+
+static qint64 unzigzag(quint64 value)
+{
+    return qint64(value >> 1) ^ -qint64(value & 1);
+}
+
+static void writeUInt32(QByteArray &data, quint32 value)
+{
+    char buf[4];
+    qToLittleEndian(value, buf);
+    data.append(buf, 4);
+}
+
+static void writeDouble(QByteArray &data, double value)
+{
+    quint64 bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    char buf[8];
+    qToLittleEndian(bits, buf);
+    data.append(buf, 8);
+}
+
+namespace {
+// Bounds checked reading of the encoded data
+class Reader
+{
+public:
+    Reader(const char *data, int size) : m_pos(data), m_end(data + size) {}
+
+    bool varint(quint64 &value) {
+        value = 0;
+        for (int shift = 0; shift < 64 && m_pos < m_end; shift += 7) {
+            const quint8 b = quint8(*m_pos++);
+            value |= quint64(b & 0x7f) << shift;
+            if (!(b & 0x80)) {
+                return true;
+            }
+        }
+        return false;
+    }
+    bool decodeDouble(double &value) {
+        if (m_end - m_pos < 8) {
+            return false;
+        }
+        const quint64 bits = qFromLittleEndian<quint64>(m_pos);
+        std::memcpy(&value, &bits, sizeof(value));
+        m_pos += 8;
+        return true;
+    }
+
+private:
+    const char *m_pos;
+    const char *m_end;
+};
+}
+
+AppointmentStream::AppointmentStream()
+{
+}
+
+QString AppointmentStream::fileName()
+{
+    return QStringLiteral("appointments.bin");
+}
+
+void AppointmentStream::clear()
+{
+    m_data.clear();
+    m_offsets.clear();
+}
+
+int AppointmentStream::add(const AppointmentIntervalList &intervals)
+{
+    m_offsets.append(m_data.size());
+    const QMultiMap<QDate, AppointmentInterval> &map = intervals.map();
+    writeVarint(m_data, map.count());
+    qint64 previousEnd = 0;
+    double previousLoad = 100.0;
+    for (QMultiMap<QDate, AppointmentInterval>::const_iterator it = map.constBegin(); it != map.constEnd(); ++it) {
+        const AppointmentInterval &interval = it.value();
+        const qint64 start = interval.startTime().toSecsSinceEpoch();
+        const qint64 end = interval.endTime().toSecsSinceEpoch();
+        const bool loadChanged = interval.load() != previousLoad;
+        // The lowest bit tells if the load follows
+        writeVarint(m_data, zigzag(start - previousEnd) << 1 | (loadChanged ? 1 : 0));
+        writeVarint(m_data, quint64(end - start));
+        if (loadChanged) {
+            writeDouble(m_data, interval.load());
+            previousLoad = interval.load();
+        }
+        previousEnd = end;
+    }
+    return m_offsets.count() - 1;
+}
+
+QByteArray AppointmentStream::data() const
+{
+    QByteArray data;
+    data.reserve(s_headerSize + m_offsets.count() * 4 + m_data.size());
+    data.append(s_magic, sizeof(s_magic));
+    data.append(char(s_version));
+    writeUInt32(data, m_offsets.count());
+    for (quint32 offset : m_offsets) {
+        writeUInt32(data, offset);
+    }
+    data.append(m_data);
+    return data;
+}
+
+bool AppointmentStream::setData(const QByteArray &data)
+{
+    clear();
+    if (data.size() < s_headerSize || std::memcmp(data.constData(), s_magic, sizeof(s_magic)) != 0) {
+        warnPlanXml<<"Not an appointment stream";
+        return false;
+    }
+    if (quint8(data.at(sizeof(s_magic))) > s_version) {
+        warnPlanXml<<"Unsupported appointment stream version:"<<quint8(data.at(sizeof(s_magic)));
+        return false;
+    }
+    const quint32 count = qFromLittleEndian<quint32>(data.constData() + sizeof(s_magic) + 1);
+    const qint64 payload = s_headerSize + qint64(count) * 4;
+    if (payload > data.size()) {
+        warnPlanXml<<"Invalid appointment stream";
+        return false;
+    }
+    m_data = data.mid(payload);
+    m_offsets.resize(count);
+    for (quint32 i = 0; i < count; ++i) {
+        const quint32 offset = qFromLittleEndian<quint32>(data.constData() + s_headerSize + i * 4);
+        if (offset >= quint32(m_data.size())) {
+            warnPlanXml<<"Invalid appointment stream offset:"<<i<<offset;
+            clear();
+            return false;
+        }
+        m_offsets[i] = offset;
+    }
+    return true;
+}
+
+bool AppointmentStream::intervals(int index, const QTimeZone &timeZone, AppointmentIntervalList &intervals) const
+{
+    if (index < 0 || index >= m_offsets.count()) {
+        return false;
+    }
+    const quint32 offset = m_offsets.at(index);
+    Reader reader(m_data.constData() + offset, m_data.size() - offset);
+    quint64 count;
+    if (!reader.varint(count)) {
+        return false;
+    }
+    qint64 previousEnd = 0;
+    double load = 100.0;
+    for (quint64 i = 0; i < count; ++i) {
+        quint64 header;
+        quint64 duration;
+        if (!reader.varint(header) || !reader.varint(duration)) {
+            return false;
+        }
+        const qint64 start = previousEnd + unzigzag(header >> 1);
+        if ((header & 1) && !reader.decodeDouble(load)) {
+            return false;
+        }
+        const qint64 end = start + qint64(duration);
+        const AppointmentInterval interval(DateTime(QDateTime::fromSecsSinceEpoch(start, timeZone)), DateTime(QDateTime::fromSecsSinceEpoch(end, timeZone)), load);
+        if (!interval.isValid()) {
+            return false;
+        }
+        intervals.add(interval);
+        previousEnd = end;
+    }
+    return true;
+}
+
+} // namespace KPlato
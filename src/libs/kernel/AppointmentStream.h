@@ -0,0 +1,66 @@
+/* This file is part of the KDE project
+ * SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#ifndef APPOINTMENTSTREAM_H
+#define APPOINTMENTSTREAM_H
+
+#include "plankernel_export.h"
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+
+class QTimeZone;
+
+namespace KPlato
+{
+
+class AppointmentIntervalList;
+
+/**
+ * Compact binary encoding of appointment intervals.
+ *
+ * When a project is saved to a store the intervals of the appointments are saved
+ * in a separate entry, fileName(), instead of as appointment-interval elements.
+ * The appointment elements in maindoc.xml refer to their list of intervals
+ * by index, see XmlStreamSaver.
+ *
+ * Each list of intervals is a count followed by one record per interval:
+ * the distance in seconds from the end of the previous interval (zigzag varint),
+ * the duration in seconds (varint) and the load if it differs from the previous interval.
+ * Times are seconds since epoch, the same resolution as the xml format.
+ */
+class PLANKERNEL_EXPORT AppointmentStream
+{
+public:
+    AppointmentStream();
+
+    /// The name of the entry in the store
+    static QString fileName();
+
+    bool isEmpty() const { return m_offsets.isEmpty(); }
+    /// Return the number of interval lists
+    int count() const { return m_offsets.count(); }
+    void clear();
+
+    /// Add @p intervals to the stream and return its index
+    int add(const AppointmentIntervalList &intervals);
+    /// Return the encoded stream
+    QByteArray data() const;
+
+    /// Set the encoded stream, return false if @p data is not valid
+    bool setData(const QByteArray &data);
+    /// Add the intervals with @p index to @p intervals, in time zone @p timeZone
+    bool intervals(int index, const QTimeZone &timeZone, AppointmentIntervalList &intervals) const;
+
+private:
+    QByteArray m_data; // the encoded interval lists
+    QVector<quint32> m_offsets; // start of each interval list in m_data
+};
+
+} // namespace KPlato
+
+#endif
@@ -0,0 +1,176 @@
+/* This file is part of the KDE project
+ * SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+// clazy:excludeall=qstring-arg
+#include "BookingDigest.h"
+
+#include "kptproject.h"
+#include "kptresource.h"
+#include "kptschedule.h"
+#include "kptxmlloaderobject.h"
+#include "kptdebug.h"
+
+#include <KoXmlReader.h>
+
+#include <QDomDocument>
+
+namespace KPlato
+{
+
+// Increment if the format changes, a digest with another version is not used
+static const int s_version = 1;
+
+BookingDigest::BookingDigest()
+{
+}
+
+QString BookingDigest::fileName()
+{
+    return QStringLiteral("bookings.xml");
+}
+
+ScheduleManager *BookingDigest::scheduleManager(const Project *project)
+{
+    if (!project->isScheduled(ANYSCHEDULED)) {
+        return nullptr;
+    }
+    ScheduleManager *sm = project->findScheduleManagerByName(project->property("schedulemanager-name").toString());
+    if (!sm) {
+        // find a suitable schedule
+        const QList<ScheduleManager*> managers = project->allScheduleManagers();
+        for (ScheduleManager *m : managers) {
+            if (m->isBaselined()) {
+                sm = m;
+                break;
+            }
+            if (m->isScheduled()) {
+                sm = m; // take the last one, more likely to be subschedule
+            }
+        }
+    }
+    return sm;
+}
+
+void BookingDigest::create(const Project *project)
+{
+    m_projectId = project->id();
+    m_projectName = project->name();
+    m_timeZone = project->timeZone();
+    m_scheduleManagerName.clear();
+    m_bookings.clear();
+
+    const ScheduleManager *sm = scheduleManager(project);
+    if (!sm) {
+        return;
+    }
+    m_scheduleManagerName = sm->name();
+    const QList<Resource*> resources = project->resourceList();
+    for (const Resource *r : resources) {
+        Appointment app;
+        const QList<Appointment*> appointments = r->appointments(sm->scheduleId());
+        for (const Appointment *a : appointments) {
+            app += *a;
+        }
+        if (!app.isEmpty()) {
+            m_bookings << Booking{ r->id(), r->name(), app.intervals() };
+        }
+    }
+}
+
+QByteArray BookingDigest::data() const
+{
+    QDomDocument document(QStringLiteral("bookings"));
+    document.appendChild(document.createProcessingInstruction(QStringLiteral("xml"), QStringLiteral("version=\"1.0\" encoding=\"UTF-8\"")));
+    QDomElement doc = document.createElement(QStringLiteral("bookings"));
+    doc.setAttribute(QStringLiteral("version"), s_version);
+    doc.setAttribute(QStringLiteral("project-id"), m_projectId);
+    doc.setAttribute(QStringLiteral("project-name"), m_projectName);
+    doc.setAttribute(QStringLiteral("timezone"), QString::fromLatin1(m_timeZone.id()));
+    doc.setAttribute(QStringLiteral("schedule-manager"), m_scheduleManagerName);
+    document.appendChild(doc);
+    for (const Booking &b : m_bookings) {
+        QDomElement me = document.createElement(QStringLiteral("resource"));
+        doc.appendChild(me);
+        me.setAttribute(QStringLiteral("id"), b.resourceId);
+        me.setAttribute(QStringLiteral("name"), b.resourceName);
+        b.intervals.saveXML(me);
+    }
+    return document.toByteArray();
+}
+
+bool BookingDigest::setData(const QByteArray &data)
+{
+    m_projectId.clear();
+    m_projectName.clear();
+    m_timeZone = QTimeZone();
+    m_scheduleManagerName.clear();
+    m_bookings.clear();
+
+    KoXmlDocument document;
+    QString msg;
+    int line = 0;
+    int column = 0;
+    if (!document.setContent(data, false, &msg, &line, &column)) {
+        warnPlanXml<<"Parsing error in booking digest at line"<<line<<"column"<<column<<msg;
+        return false;
+    }
+    const KoXmlElement doc = document.documentElement();
+    if (doc.tagName() != QStringLiteral("bookings") || doc.attribute(QStringLiteral("version")).toInt() != s_version) {
+        warnPlanXml<<"Not a booking digest, or unknown version:"<<doc.tagName()<<doc.attribute(QStringLiteral("version"));
+        return false;
+    }
+    m_projectId = doc.attribute(QStringLiteral("project-id"));
+    if (m_projectId.isEmpty()) {
+        return false;
+    }
+    m_projectName = doc.attribute(QStringLiteral("project-name"));
+    m_scheduleManagerName = doc.attribute(QStringLiteral("schedule-manager"));
+    m_timeZone = QTimeZone(doc.attribute(QStringLiteral("timezone")).toLatin1());
+    if (!m_timeZone.isValid()) {
+        warnPlanXml<<"Invalid time zone in booking digest:"<<doc.attribute(QStringLiteral("timezone"));
+        return false;
+    }
+    // the intervals are in the time zone of the project
+    XMLLoaderObject status;
+    status.setProjectTimeZone(m_timeZone);
+    KoXmlElement e;
+    forEachElement(e, doc) {
+        if (e.tagName() != QStringLiteral("resource")) {
+            continue;
+        }
+        Booking b;
+        b.resourceId = e.attribute(QStringLiteral("id"));
+        b.resourceName = e.attribute(QStringLiteral("name"));
+        b.intervals.loadXML(e, status);
+        if (!b.resourceId.isEmpty() && !b.intervals.isEmpty()) {
+            m_bookings << b;
+        }
+    }
+    return true;
+}
+
+int BookingDigest::insertExternalAppointments(Project *project) const
+{
+    if (m_projectId.isEmpty() || m_projectId == project->id()) {
+        return 0;
+    }
+    int count = 0;
+    for (const Booking &b : m_bookings) {
+        Resource *res = project->resource(b.resourceId);
+        if (!res || !res->isShared()) {
+            continue;
+        }
+        Appointment *app = new Appointment();
+        app->setAuxcilliaryInfo(m_projectName);
+        app->setIntervals(b.intervals);
+        res->addExternalAppointment(m_projectId, app);
+        debugPlanShared<<res->name()<<"added:"<<app->auxcilliaryInfo()<<app;
+        ++count;
+    }
+    return count;
+}
+
+} // namespace KPlato
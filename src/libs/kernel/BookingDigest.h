@@ -0,0 +1,84 @@
+/* This file is part of the KDE project
+ * SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#ifndef BOOKINGDIGEST_H
+#define BOOKINGDIGEST_H
+
+#include "plankernel_export.h"
+
+#include "kptappointment.h"
+
+#include <QByteArray>
+#include <QList>
+#include <QString>
+#include <QTimeZone>
+
+namespace KPlato
+{
+
+class Project;
+class ScheduleManager;
+
+/**
+ * The bookings of the resources of a project, as seen by other projects
+ * that share the resources.
+ *
+ * A project that uses shared projects adds the bookings of its shared resources
+ * in the other projects as external appointments.
+ * The digest is saved in the store, see fileName(), so that these bookings can be read
+ * without loading the complete project.
+ *
+ * The digest holds the merged appointment intervals of each resource
+ * in the schedule returned by scheduleManager().
+ */
+class PLANKERNEL_EXPORT BookingDigest
+{
+public:
+    BookingDigest();
+
+    /// The name of the entry in the store
+    static QString fileName();
+    /// Return the schedule manager with the bookings other projects shall use
+    static ScheduleManager *scheduleManager(const Project *project);
+
+    /// Create the digest of @p project
+    void create(const Project *project);
+
+    QString projectId() const { return m_projectId; }
+    QString projectName() const { return m_projectName; }
+    /// Return the name of the schedule manager, empty if the project is not scheduled
+    QString scheduleManagerName() const { return m_scheduleManagerName; }
+    /// Return the number of resources with bookings
+    int count() const { return m_bookings.count(); }
+
+    /// Return the digest as xml
+    QByteArray data() const;
+    /// Set the digest from xml, return false if @p data is not a valid digest
+    bool setData(const QByteArray &data);
+
+    /**
+     * Add the bookings as external appointments to the shared resources of @p project.
+     * Nothing is added if @p project is the project of this digest.
+     * Return the number of appointments added.
+     */
+    int insertExternalAppointments(Project *project) const;
+
+private:
+    struct Booking {
+        QString resourceId;
+        QString resourceName;
+        AppointmentIntervalList intervals;
+    };
+    QString m_projectId;
+    QString m_projectName;
+    QTimeZone m_timeZone;
+    QString m_scheduleManagerName;
+    QList<Booking> m_bookings;
+};
+
+} // namespace KPlato
+
+#endif
@@ -0,0 +1,307 @@
+/* This file is part of the KDE project
+ * SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+// clazy:excludeall=qstring-arg
+#include "CriticalPathEngine.h"
+
+#include "kptnode.h"
+#include "kpttask.h"
+#include "kptrelation.h"
+#include "kptschedule.h"
+
+#include <QSet>
+#include <QVector>
+
+#include <algorithm>
+
+namespace KPlato
+{
+
+static bool isTask(const Node *node)
+{
+    switch (node->type()) {
+        case Node::Type_Task:
+        case Node::Type_Milestone:
+        case Node::Type_Summarytask:
+            return true;
+        default:
+            break;
+    }
+    return false;
+}
+
+// A critical path ends in a critical start (end) node
+static bool isTerminal(const Node *node, long id, bool fromEnd)
+{
+    if (!(fromEnd ? node->isEndNode() : node->isStartNode())) {
+        return false;
+    }
+    if (isTask(node)) {
+        const Task *task = static_cast<const Task*>(node);
+        return task->startFloat(id) == 0 && task->finishFloat(id) == 0;
+    }
+    return true;
+}
+
+// The nodes a critical path is followed to
+static QList<Node*> nextNodes(const Node *node, bool fromEnd)
+{
+    QList<Node*> nodes;
+    if (fromEnd) {
+        if (isTask(node)) {
+            for (const Relation *r : node->childProxyRelations()) {
+                nodes << r->child();
+            }
+        }
+        const QList<Relation*> relations = node->dependChildNodes();
+        for (const Relation *r : relations) {
+            nodes << r->child();
+        }
+    } else {
+        if (isTask(node)) {
+            for (const Relation *r : node->parentProxyRelations()) {
+                nodes << r->parent();
+            }
+        }
+        const QList<Relation*> relations = node->dependParentNodes();
+        for (const Relation *r : relations) {
+            nodes << r->parent();
+        }
+    }
+    return nodes;
+}
+
+CriticalPathEngine::CriticalPathEngine()
+    : m_valid(false)
+    , m_id(-1)
+{
+}
+
+bool CriticalPathEngine::markCriticalPath(const QList<Node*> &nodes, const QList<Node*> &seeds, long id, bool fromEnd)
+{
+    // Index the nodes and their dependencies in the direction the path is followed
+    QHash<const Node*, int> index;
+    index.reserve(nodes.count());
+    for (int i = 0; i < nodes.count(); ++i) {
+        index.insert(nodes.at(i), i);
+    }
+    const int count = nodes.count();
+    QVector<QVector<int>> next(count);
+    QVector<QVector<int>> previous(count);
+    for (int i = 0; i < count; ++i) {
+        const QList<Node*> lst = nextNodes(nodes.at(i), fromEnd);
+        for (const Node *n : lst) {
+            const int j = index.value(n, -1);
+            if (j < 0) {
+                return false;
+            }
+            next[i] << j;
+            previous[j] << i;
+        }
+    }
+    // Topological order, a node comes after the nodes it leads to
+    QVector<int> order;
+    order.reserve(count);
+    QVector<int> pending(count);
+    for (int i = 0; i < count; ++i) {
+        pending[i] = next.at(i).count();
+        if (pending.at(i) == 0) {
+            order << i;
+        }
+    }
+    for (int i = 0; i < order.count(); ++i) {
+        for (int j : previous.at(order.at(i))) {
+            if (--pending[j] == 0) {
+                order << j;
+            }
+        }
+    }
+    if (order.count() < count) {
+        return false;
+    }
+    QVector<bool> critical(count);
+    QVector<bool> terminal(count);
+    QVector<bool> marked(count);
+    for (int i = 0; i < count; ++i) {
+        Node *n = nodes.at(i);
+        marked[i] = n->inCriticalPath(id);
+        critical[i] = n->isCritical(id);
+        terminal[i] = critical.at(i) && isTerminal(n, id, fromEnd);
+    }
+    // A node leads to a critical start (end) node
+    QVector<bool> leads(count);
+    for (int i : qAsConst(order)) {
+        bool on = marked.at(i) || terminal.at(i);
+        if (!on && critical.at(i)) {
+            for (int j : next.at(i)) {
+                if (leads.at(j)) {
+                    on = true;
+                    break;
+                }
+            }
+        }
+        leads[i] = on;
+    }
+    // A node is reached from the seeds through critical nodes
+    QVector<bool> reached(count);
+    for (const Node *n : seeds) {
+        const int i = index.value(n, -1);
+        if (i >= 0) {
+            reached[i] = true;
+        }
+    }
+    for (int k = order.count() - 1; k >= 0; --k) {
+        const int i = order.at(k);
+        if (!reached.at(i) || marked.at(i) || !critical.at(i) || terminal.at(i)) {
+            continue;
+        }
+        for (int j : next.at(i)) {
+            reached[j] = true;
+        }
+    }
+    for (int i = 0; i < count; ++i) {
+        if (reached.at(i) && leads.at(i) && !marked.at(i)) {
+            Schedule *s = nodes.at(i)->findSchedule(id);
+            if (s) {
+                s->setInCriticalPath(true);
+            }
+        }
+    }
+    return true;
+}
+
+void CriticalPathEngine::clear()
+{
+    m_valid = false;
+    m_id = -1;
+    m_order.clear();
+    m_roots.clear();
+    m_rootPaths.clear();
+}
+
+bool CriticalPathEngine::isRoot(const Node *node) const
+{
+    return node->numDependParentNodes() == 0 && node->inCriticalPath(m_id);
+}
+
+void CriticalPathEngine::insertRoot(Node *node)
+{
+    const int order = m_order.value(node);
+    QList<Node*>::iterator it = std::lower_bound(m_roots.begin(), m_roots.end(), order, [this](const Node *n, int o) {
+        return m_order.value(n) < o;
+    });
+    m_roots.insert(it, node);
+}
+
+QList<QList<Node*>> CriticalPathEngine::calculate(const QList<Node*> &nodes, long id)
+{
+    clear();
+    m_id = id;
+    m_order.reserve(nodes.count());
+    for (int i = 0; i < nodes.count(); ++i) {
+        Node *n = nodes.at(i);
+        m_order.insert(n, i);
+        if (isRoot(n)) {
+            m_roots << n;
+            m_rootPaths.insert(n, calculatePaths(n));
+        }
+    }
+    m_valid = true;
+    return paths();
+}
+
+QList<QList<Node*>> CriticalPathEngine::calculatePaths(Node *root) const
+{
+    struct Frame {
+        QList<Relation*> children;
+        int next;
+        bool extended;
+    };
+    QList<QList<Node*>> paths;
+    QList<Node*> path;
+    QVector<Frame> stack;
+    path << root;
+    stack.append({ root->dependChildNodes(), 0, false });
+    while (!stack.isEmpty()) {
+        Frame &frame = stack.last();
+        Node *child = nullptr;
+        while (frame.next < frame.children.count()) {
+            Node *n = frame.children.at(frame.next++)->child();
+            if (n->inCriticalPath(m_id)) {
+                child = n;
+                break;
+            }
+        }
+        if (child) {
+            frame.extended = true;
+            path << child;
+            stack.append({ child->dependChildNodes(), 0, false });
+            continue;
+        }
+        if (!frame.extended) {
+            paths << path;
+        }
+        stack.removeLast();
+        path.removeLast();
+    }
+    return paths;
+}
+
+QList<QList<Node*>> CriticalPathEngine::relationChanged(const Relation *relation)
+{
+    if (!m_valid) {
+        return QList<QList<Node*>>();
+    }
+    Node *parent = relation->parent();
+    Node *child = relation->child();
+    if (!m_order.contains(parent) || !m_order.contains(child)) {
+        // Nodes added after the paths were calculated
+        clear();
+        return QList<QList<Node*>>();
+    }
+    // The child may have become, or stopped being, a start node
+    const bool wasRoot = m_rootPaths.contains(child);
+    if (isRoot(child) && !wasRoot) {
+        insertRoot(child);
+        m_rootPaths.insert(child, calculatePaths(child));
+    } else if (!isRoot(child) && wasRoot) {
+        m_roots.removeOne(child);
+        m_rootPaths.remove(child);
+    }
+    // The paths through the relation changed for the start nodes that reach the parent
+    if (parent->inCriticalPath(m_id) && child->inCriticalPath(m_id)) {
+        QSet<const Node*> visited;
+        QList<Node*> stack;
+        stack << parent;
+        visited.insert(parent);
+        while (!stack.isEmpty()) {
+            Node *n = stack.takeLast();
+            if (m_rootPaths.contains(n)) {
+                m_rootPaths.insert(n, calculatePaths(n));
+            }
+            const QList<Relation*> relations = n->dependParentNodes();
+            for (const Relation *r : relations) {
+                Node *p = r->parent();
+                if (p->inCriticalPath(m_id) && !visited.contains(p)) {
+                    visited.insert(p);
+                    stack << p;
+                }
+            }
+        }
+    }
+    return paths();
+}
+
+QList<QList<Node*>> CriticalPathEngine::paths() const
+{
+    QList<QList<Node*>> lst;
+    for (const Node *n : m_roots) {
+        lst << m_rootPaths.value(n);
+    }
+    return lst;
+}
+
+} // namespace KPlato
@@ -0,0 +1,71 @@
+/* This file is part of the KDE project
+ * SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#ifndef CRITICALPATHENGINE_H
+#define CRITICALPATHENGINE_H
+
+#include "plankernel_export.h"
+
+#include <QHash>
+#include <QList>
+
+namespace KPlato
+{
+
+class Node;
+class Relation;
+
+/**
+ * Finds the critical paths of a schedule.
+ *
+ * The nodes are visited in topological order so that marking the nodes
+ * in a critical path is linear in the number of nodes and relations.
+ *
+ * The critical paths are enumerated iteratively and cached per start node,
+ * so when a relation is added or removed only the paths of the start nodes
+ * that can reach the relation are recalculated, see relationChanged().
+ *
+ * Floats are calculated by the schedulers, the engine uses them as is.
+ */
+class PLANKERNEL_EXPORT CriticalPathEngine
+{
+public:
+    CriticalPathEngine();
+
+    /**
+     * Mark the nodes in a critical path in schedule @p id.
+     * Starts from @p seeds and follows the critical nodes backwards,
+     * or forwards if @p fromEnd is true, to a critical start (end) node.
+     * @p nodes must contain all nodes that can be reached from @p seeds.
+     * Returns false, and marks nothing, if the dependencies contain a cycle.
+     */
+    static bool markCriticalPath(const QList<Node*> &nodes, const QList<Node*> &seeds, long id, bool fromEnd);
+
+    bool isValid() const { return m_valid; }
+    void clear();
+    /// Find all critical paths in schedule @p id, start nodes are taken from @p nodes in that order
+    QList<QList<Node*>> calculate(const QList<Node*> &nodes, long id);
+    /// Update the critical paths after @p relation has been added to or removed from the project
+    QList<QList<Node*>> relationChanged(const Relation *relation);
+    /// Return all critical paths
+    QList<QList<Node*>> paths() const;
+
+private:
+    bool isRoot(const Node *node) const;
+    void insertRoot(Node *node);
+    QList<QList<Node*>> calculatePaths(Node *root) const;
+
+private:
+    bool m_valid;
+    long m_id;
+    QHash<const Node*, int> m_order;
+    QList<Node*> m_roots; // sorted by m_order
+    QHash<const Node*, QList<QList<Node*>>> m_rootPaths;
+};
+
+} // namespace KPlato
+
+#endif
@@ -155,40 +155,7 @@ bool ProjectLoader_v0::load(Project *project, const KoXmlElement &projectElement
                 delete child;
             }
         }
-        // calendars references calendars in arbitrary saved order
-        bool added = false;
-        do {
-            added = false;
-            QList<Calendar*> lst;
-            while (!cals.isEmpty()) {
-                Calendar *c = cals.takeFirst();
-                BlockCalendarVersion b(c);
-                if (c->parentId().isEmpty()) {
-                    if (status.version() < QStringLiteral("0.6")) {
-                        // base calendar was stored in standard-worktime and is set as status.baseCalendar()
-                        // In later versions status.baseCalendar() == nullptr
-                        warnPlanXml<<"Pre 0.6 version: calendar added to project:"<<c->name()<<"parent:"<<status.baseCalendar();
-                    }
-                    project->addCalendar(c, status.baseCalendar());
-                    added = true;
-                } else {
-                    Calendar *par = project->calendar(c->parentId());
-                    if (par) {
-                        BlockCalendarVersion b(par);
-                        project->addCalendar(c, par);
-                        added = true;
-                        //debugPlanXml<<"added:"<<c->name()<<" to parent:"<<par->name();
-                    } else {
-                        lst.append(c); // treat later
-                        //debugPlanXml<<"treat later:"<<c->name();
-                    }
-                }
-            }
-            cals = lst;
-        } while (added);
-        if (!cals.isEmpty()) {
-            errorPlanXml<<"All calendars not saved!";
-        }
+        addCalendars(project, cals, status);
         //debugPlanXml<<"Calendars<---";
         // now we can load freedays calendar
         e = projectElement.namedItem(QStringLiteral("project-settings")).toElement();
@@ -550,6 +517,44 @@ bool ProjectLoader_v0::load(Project *project, const KoXmlElement &projectElement
     return true;
 }
 
+void ProjectLoader_v0::addCalendars(Project *project, QList<Calendar*> &cals, XMLLoaderObject &status)
+{
+    // calendars references calendars in arbitrary saved order
+    bool added = false;
+    do {
+        added = false;
+        QList<Calendar*> lst;
+        while (!cals.isEmpty()) {
+            Calendar *c = cals.takeFirst();
+            BlockCalendarVersion b(c);
+            if (c->parentId().isEmpty()) {
+                if (status.version() < QStringLiteral("0.6")) {
+                    // base calendar was stored in standard-worktime and is set as status.baseCalendar()
+                    // In later versions status.baseCalendar() == nullptr
+                    warnPlanXml<<"Pre 0.6 version: calendar added to project:"<<c->name()<<"parent:"<<status.baseCalendar();
+                }
+                project->addCalendar(c, status.baseCalendar());
+                added = true;
+            } else {
+                Calendar *par = project->calendar(c->parentId());
+                if (par) {
+                    BlockCalendarVersion b(par);
+                    project->addCalendar(c, par);
+                    added = true;
+                    //debugPlanXml<<"added:"<<c->name()<<" to parent:"<<par->name();
+                } else {
+                    lst.append(c); // treat later
+                    //debugPlanXml<<"treat later:"<<c->name();
+                }
+            }
+        }
+        cals = lst;
+    } while (added);
+    if (!cals.isEmpty()) {
+        errorPlanXml<<"All calendars not saved!";
+    }
+}
+
 bool KPlato::ProjectLoader_v0::loadSettings(const KoXmlElement& element, KPlato::XMLLoaderObject& status)
 {
     Q_UNUSED(status)
@@ -668,121 +673,126 @@ bool ProjectLoader_v0::load(Task *task, const KoXmlElement &element, XMLLoaderOb
         if (! n.isElement()) {
             continue;
         }
-        KoXmlElement e = n.toElement();
-        if (e.tagName() == QStringLiteral("project")) {
-            // Load the subproject
+        loadTaskChild(task, n.toElement(), status);
+    }
+    //debugPlanXml<<m_name<<" loaded";
+    return true;
+}
+
+bool ProjectLoader_v0::loadTaskChild(Task *task, const KoXmlElement &e, XMLLoaderObject &status)
+{
+    if (e.tagName() == QStringLiteral("project")) {
+        // Load the subproject
 /*              Project *child = new Project(this, status);
-            if (child->load(e)) {
-                if (!project.addSubTask(child, this)) {
+        if (child->load(e)) {
+            if (!project.addSubTask(child, this)) {
+                delete child;  // TODO: Complain about this
+            }
+        } else {
+            // TODO: Complain about this
+            delete child;
+        }*/
+    } else if (e.tagName() == QStringLiteral("task")) {
+        if (status.loadTaskChildren()) {
+            // Load the task
+            Task *child = new Task(task);
+            if (load(child, e, status)) {
+                if (!status.project().addSubTask(child, task)) {
+                    errorPlanXml<<"Failed to add task";
                     delete child;  // TODO: Complain about this
                 }
             } else {
                 // TODO: Complain about this
+                errorPlanXml<<"Failed to load task";
                 delete child;
-            }*/
-        } else if (e.tagName() == QStringLiteral("task")) {
-            if (status.loadTaskChildren()) {
-                // Load the task
-                Task *child = new Task(task);
-                if (load(child, e, status)) {
-                    if (!status.project().addSubTask(child, task)) {
-                        errorPlanXml<<"Failed to add task";
-                        delete child;  // TODO: Complain about this
-                    }
+            }
+        }
+    } else if (e.tagName() == QStringLiteral("resource")) {
+        // TODO: Load the resource (projects don't have resources yet)
+    } else if (e.tagName() == QStringLiteral("estimate") ||
+               (/*status.version() < QStringLiteral("0.6") &&*/ e.tagName() == QStringLiteral("effort"))) {
+        //  Load the estimate
+        load(task->estimate(), e, status);
+    } else if (e.tagName() == QStringLiteral("workpackage")) {
+        load(task->workPackage(), e, status);
+    } else if (e.tagName() == QStringLiteral("progress")) {
+        load(task->completion(), e, status);
+    } else if (e.tagName() == QStringLiteral("task-schedules") || (status.version() < QStringLiteral("0.7.0") && e.tagName() == QStringLiteral("schedules"))) {
+        KoXmlNode n = e.firstChild();
+        for (; ! n.isNull(); n = n.nextSibling()) {
+            if (! n.isElement()) {
+                continue;
+            }
+            KoXmlElement el = n.toElement();
+            if (el.tagName() == QStringLiteral("task-schedule") || el.tagName() ==  QStringLiteral("schedule")) {
+                NodeSchedule *sch = new NodeSchedule();
+                if (loadNodeSchedule(sch, el, status)) {
+                    sch->setNode(task);
+                    task->addSchedule(sch);
                 } else {
-                    // TODO: Complain about this
-                    errorPlanXml<<"Failed to load task";
-                    delete child;
+                    errorPlanXml<<"Failed to load schedule";
+                    delete sch;
                 }
             }
-        } else if (e.tagName() == QStringLiteral("resource")) {
-            // TODO: Load the resource (projects don't have resources yet)
-        } else if (e.tagName() == QStringLiteral("estimate") ||
-                   (/*status.version() < QStringLiteral("0.6") &&*/ e.tagName() == QStringLiteral("effort"))) {
-            //  Load the estimate
-            load(task->estimate(), e, status);
-        } else if (e.tagName() == QStringLiteral("workpackage")) {
-            load(task->workPackage(), e, status);
-        } else if (e.tagName() == QStringLiteral("progress")) {
-            load(task->completion(), e, status);
-        } else if (e.tagName() == QStringLiteral("task-schedules") || (status.version() < QStringLiteral("0.7.0") && e.tagName() == QStringLiteral("schedules"))) {
-            KoXmlNode n = e.firstChild();
-            for (; ! n.isNull(); n = n.nextSibling()) {
-                if (! n.isElement()) {
-                    continue;
-                }
-                KoXmlElement el = n.toElement();
-                if (el.tagName() == QStringLiteral("task-schedule") || el.tagName() ==  QStringLiteral("schedule")) {
-                    NodeSchedule *sch = new NodeSchedule();
-                    if (loadNodeSchedule(sch, el, status)) {
-                        sch->setNode(task);
-                        task->addSchedule(sch);
-                    } else {
-                        errorPlanXml<<"Failed to load schedule";
-                        delete sch;
-                    }
+        }
+    } else if (e.tagName() == QStringLiteral("resourcegroup-request")) {
+        Q_ASSERT(status.version() < QStringLiteral("0.7.0"));
+        KoXmlElement re;
+        forEachElement(re, e) {
+            if (re.tagName() == QStringLiteral("resource-request")) {
+                ResourceRequest *r = new ResourceRequest();
+                if (load(r, re, status)) {
+                    task->requests().addResourceRequest(r);
+                } else {
+                    errorPlanXml<<"Failed to load resource request";
+                    delete r;
                 }
             }
-        } else if (e.tagName() == QStringLiteral("resourcegroup-request")) {
-            Q_ASSERT(status.version() < QStringLiteral("0.7.0"));
-            KoXmlElement re;
-            forEachElement(re, e) {
-                if (re.tagName() == QStringLiteral("resource-request")) {
-                    ResourceRequest *r = new ResourceRequest();
-                    if (load(r, re, status)) {
-                        task->requests().addResourceRequest(r);
-                    } else {
-                        errorPlanXml<<"Failed to load resource request";
-                        delete r;
+        }
+        ResourceGroup *group = status.project().group(e.attribute(QStringLiteral("group-id")));
+        if (!group) {
+            errorPlanXml<<"Could not find resourcegroup"<<e.attribute(QStringLiteral("group-id"));
+        } else {
+            QList<ResourceRequest*> groupRequests;
+            int numRequests = e.attribute(QStringLiteral("units")).toInt();
+            for (int i = 0; i < numRequests; ++i) {
+                const auto resources = group->resources();
+                for (Resource *r : resources) {
+                    if (!task->requests().find(r)) {
+                        groupRequests << new ResourceRequest(r, 100);
+                        task->requests().addResourceRequest(groupRequests.last());
                     }
                 }
             }
-            ResourceGroup *group = status.project().group(e.attribute(QStringLiteral("group-id")));
-            if (!group) {
-                errorPlanXml<<"Could not find resourcegroup"<<e.attribute(QStringLiteral("group-id"));
-            } else {
-                QList<ResourceRequest*> groupRequests;
-                int numRequests = e.attribute(QStringLiteral("units")).toInt();
-                for (int i = 0; i < numRequests; ++i) {
-                    const auto resources = group->resources();
-                    for (Resource *r : resources) {
-                        if (!task->requests().find(r)) {
-                            groupRequests << new ResourceRequest(r, 100);
-                            task->requests().addResourceRequest(groupRequests.last());
-                        }
-                    }
-                }
-                for (ResourceRequest *rr : qAsConst(groupRequests)) {
-                    const auto resources = group->resources();
-                    for (Resource *r : resources) {
-                        if (!task->requests().find(r)) {
-                            rr->addAlternativeRequest(new ResourceRequest(r));
-                        }
+            for (ResourceRequest *rr : qAsConst(groupRequests)) {
+                const auto resources = group->resources();
+                for (Resource *r : resources) {
+                    if (!task->requests().find(r)) {
+                        rr->addAlternativeRequest(new ResourceRequest(r));
                     }
                 }
             }
-        } else if (e.tagName() == QStringLiteral("documents")) {
-            load(task->documents(), e, status);
-        } else if (e.tagName() == QStringLiteral("workpackage-log")) {
-            KoXmlNode n = e.firstChild();
-            for (; ! n.isNull(); n = n.nextSibling()) {
-                if (! n.isElement()) {
-                    continue;
-                }
-                KoXmlElement el = n.toElement();
-                if (el.tagName() == QStringLiteral("workpackage")) {
-                    WorkPackage *wp = new WorkPackage(task);
-                    if (loadWpLog(wp, el, status)) {
-                        task->addWorkPackage(wp);
-                    } else {
-                        errorPlanXml<<"Failed to load logged workpackage";
-                        delete wp;
-                    }
+        }
+    } else if (e.tagName() == QStringLiteral("documents")) {
+        load(task->documents(), e, status);
+    } else if (e.tagName() == QStringLiteral("workpackage-log")) {
+        KoXmlNode n = e.firstChild();
+        for (; ! n.isNull(); n = n.nextSibling()) {
+            if (! n.isElement()) {
+                continue;
+            }
+            KoXmlElement el = n.toElement();
+            if (el.tagName() == QStringLiteral("workpackage")) {
+                WorkPackage *wp = new WorkPackage(task);
+                if (loadWpLog(wp, el, status)) {
+                    task->addWorkPackage(wp);
+                } else {
+                    errorPlanXml<<"Failed to load logged workpackage";
+                    delete wp;
                 }
             }
         }
     }
-    //debugPlanXml<<m_name<<" loaded";
     return true;
 }
 
@@ -1752,7 +1762,16 @@ bool ProjectLoader_v0::load(Appointment *appointment, const KoXmlElement& elemen
     }
     //debugPlanXml<<"res="<<m_resource<<" node="<<m_node;
     AppointmentIntervalList lst = appointment->intervals();
-    load(lst, element, status);
+    if (element.hasAttribute(QStringLiteral("intervals"))) {
+        // The intervals are saved in the appointment stream
+        bool ok;
+        const int index = element.attribute(QStringLiteral("intervals")).toInt(&ok);
+        if (!ok || !status.appointmentStream().intervals(index, status.projectTimeZone(), lst)) {
+            errorPlanXml<<"Failed to load appointment intervals from stream:"<<element.attribute(QStringLiteral("intervals"));
+        }
+    } else {
+        load(lst, element, status);
+    }
     if (lst.isEmpty()) {
         errorPlanXml<<"Appointment interval list is empty (added anyway): "<<node->name()<<res->name();
         return false;
@@ -85,6 +85,13 @@ public:
     bool load(AppointmentInterval &interval, const KoXmlElement& element, XMLLoaderObject &status) override;
 
     bool loadResourceGroup(ResourceGroup *group, const KoXmlElement &element, XMLLoaderObject &status);
+    /// Load a child element of a task, except the attributes
+    bool loadTaskChild(Task *task, const KoXmlElement &element, XMLLoaderObject &status);
+    /**
+     * Add the loaded calendars @p cals to @p project, parents before children.
+     * On return @p cals contains the calendars that could not be added.
+     */
+    void addCalendars(Project *project, QList<Calendar*> &cals, XMLLoaderObject &status);
 
     void printProjectStatistics(const XMLLoaderObject& status);
 };
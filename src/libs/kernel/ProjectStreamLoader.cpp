@@ -0,0 +1,630 @@
+/* This file is part of the KDE project
+ * SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+// clazy:excludeall=qstring-arg
+#include "ProjectStreamLoader.h"
+
+#include "kptxmlloaderobject.h"
+#include "kptproject.h"
+#include "kpttask.h"
+#include "kptcalendar.h"
+#include "kptschedule.h"
+#include "kptrelation.h"
+#include "kptresourcerequest.h"
+#include "Resource.h"
+#include "ResourceGroup.h"
+#include "kptdebug.h"
+
+#include <MimeTypes.h>
+
+#include <QXmlStreamReader>
+
+namespace KPlato
+{
+
+static QString attributeValue(const QXmlStreamAttributes &attributes, const QString &name, const QString &defaultValue = QString())
+{
+    return attributes.hasAttribute(name) ? attributes.value(name).toString() : defaultValue;
+}
+
+ProjectStreamLoader::ProjectStreamLoader(XMLLoaderObject &status)
+    : m_status(status)
+    , m_project(nullptr)
+    , m_accounts(true)
+    , m_accountsLoaded(false)
+    , m_calendarsLoaded(false)
+    , m_hasFreedays(false)
+{
+}
+
+bool ProjectStreamLoader::canLoad(const QString &mimetype, const QString &version)
+{
+    return mimetype == PLAN_MIME_TYPE && version >= QStringLiteral("0.7.0") && version.split(QLatin1Char('.')).value(0).toInt() == 0;
+}
+
+QString ProjectStreamLoader::errorString() const
+{
+    return m_errorString;
+}
+
+bool ProjectStreamLoader::load(Project *project, QXmlStreamReader &reader)
+{
+    debugPlanXml<<"--->";
+    m_project = project;
+    if (!reader.isStartElement() || reader.name() != QLatin1String("plan")) {
+        if (!reader.readNextStartElement() || reader.name() != QLatin1String("plan")) {
+            m_errorString = reader.hasError() ? reader.errorString() : QStringLiteral("Could not find a plan element");
+            errorPlanXml<<m_errorString;
+            return false;
+        }
+    }
+    const QXmlStreamAttributes attributes = reader.attributes();
+    m_status.setMimetype(attributeValue(attributes, QStringLiteral("mime")));
+    m_status.setVersion(attributeValue(attributes, QStringLiteral("version"), PLAN_FILE_SYNTAX_VERSION));
+    if (!canLoad(m_status.mimetype(), m_status.version())) {
+        m_errorString = QStringLiteral("Cannot load mime type %1 version %2").arg(m_status.mimetype(), m_status.version());
+        errorPlanXml<<m_errorString;
+        return false;
+    }
+    bool found = false;
+    while (reader.readNextStartElement()) {
+        if (!found && reader.name() == QLatin1String("project")) {
+            found = readProject(reader);
+        } else {
+            skipElement(reader);
+        }
+    }
+    if (reader.hasError()) {
+        m_errorString = QStringLiteral("Parsing error at line %1, column %2: %3").arg(reader.lineNumber()).arg(reader.columnNumber()).arg(reader.errorString());
+        errorPlanXml<<m_errorString;
+        return false;
+    }
+    if (!found) {
+        m_errorString = QStringLiteral("Could not find a project element");
+        errorPlanXml<<m_errorString;
+        return false;
+    }
+    // Now all objects exist, resolve the references
+    loadAccounts();
+    resolveFreedays();
+    resolveRelations();
+    resolveRequests();
+
+    m_status.setProgress(90);
+    debugPlanXml<<"<---";
+    return true;
+}
+
+bool ProjectStreamLoader::readElement(QXmlStreamReader &reader, KoXmlDocument &document)
+{
+    QString errorMsg;
+    int errorLine = 0;
+    int errorColumn = 0;
+    if (!document.setContentFromCurrentElement(&reader, &errorMsg, &errorLine, &errorColumn)) {
+        errorPlanXml<<"Failed to read element:"<<errorMsg<<"line:"<<errorLine<<"column:"<<errorColumn;
+        return false;
+    }
+    return true;
+}
+
+void ProjectStreamLoader::skipElement(QXmlStreamReader &reader)
+{
+    debugPlanXml<<"Skip:"<<reader.name();
+    reader.skipCurrentElement();
+}
+
+bool ProjectStreamLoader::readProject(QXmlStreamReader &reader)
+{
+    readProjectAttributes(reader);
+    m_status.setProgress(10);
+
+    // The elements are handled in the order they are saved
+    while (reader.readNextStartElement()) {
+        const QStringRef tag = reader.name();
+        debugPlanXml<<m_status.version()<<tag;
+        if (tag == QLatin1String("project-settings")) {
+            readSettings(reader);
+        } else if (tag == QLatin1String("documents")) {
+            KoXmlDocument document(true);
+            if (readElement(reader, document)) {
+                m_loader.load(m_project->documents(), document.documentElement(), m_status);
+            }
+        } else if (tag == QLatin1String("accounts")) {
+            // accounts refer to tasks, so they are loaded after the tasks
+            readElement(reader, m_accounts);
+        } else if (tag == QLatin1String("calendars")) {
+            readCalendars(reader);
+            m_status.setProgress(15);
+        } else if (tag == QLatin1String("resource-groups")) {
+            readResourceGroups(reader);
+        } else if (tag == QLatin1String("resources")) {
+            readResources(reader);
+        } else if (tag == QLatin1String("resource-group-relations")) {
+            readResourceGroupRelations(reader);
+        } else if (tag == QLatin1String("required-resources")) {
+            readRequiredResources(reader);
+        } else if (tag == QLatin1String("resource-teams")) {
+            readResourceTeams(reader);
+        } else if (tag == QLatin1String("tasks")) {
+            m_status.setProgress(20);
+            readTasks(reader);
+            loadAccounts();
+            m_status.setProgress(70);
+        } else if (tag == QLatin1String("relations")) {
+            readRelations(reader);
+        } else if (tag == QLatin1String("project-schedules")) {
+            loadAccounts();
+            readScheduleManagers(reader);
+        } else if (tag == QLatin1String("resource-requests")) {
+            readRequests(reader, QStringLiteral("resource-request"), m_requests);
+        } else if (tag == QLatin1String("required-resource-requests")) {
+            readRequests(reader, QStringLiteral("required-resource-request"), m_requiredRequests);
+        } else if (tag == QLatin1String("alternative-requests")) {
+            readRequests(reader, QStringLiteral("alternative-request"), m_alternativeRequests);
+        } else {
+            // NOTE: external-appointments are not loaded by ProjectLoader_v0 either,
+            // they are read from the shared resources file
+            skipElement(reader);
+        }
+    }
+    return !reader.hasError();
+}
+
+// Same as the project attributes in ProjectLoader_v0::load(Project*)
+void ProjectStreamLoader::readProjectAttributes(QXmlStreamReader &reader)
+{
+    const QXmlStreamAttributes attributes = reader.attributes();
+    Project *project = m_project;
+    if (attributes.hasAttribute(QStringLiteral("name"))) {
+        project->setName(attributeValue(attributes, QStringLiteral("name")));
+    }
+    if (attributes.hasAttribute(QStringLiteral("id"))) {
+        project->removeId(project->id());
+        project->setId(attributeValue(attributes, QStringLiteral("id")));
+        project->registerNodeId(project);
+    }
+    if (attributes.hasAttribute(QStringLiteral("priority"))) {
+        project->setPriority(attributeValue(attributes, QStringLiteral("priority")).toInt());
+    }
+    if (attributes.hasAttribute(QStringLiteral("leader"))) {
+        project->setLeader(attributeValue(attributes, QStringLiteral("leader")));
+    }
+    if (attributes.hasAttribute(QStringLiteral("description"))) {
+        project->setDescription(attributeValue(attributes, QStringLiteral("description")));
+    }
+    if (attributes.hasAttribute(QStringLiteral("timezone"))) {
+        QTimeZone tz(attributeValue(attributes, QStringLiteral("timezone")).toLatin1());
+        if (tz.isValid()) {
+            project->setTimeZone(tz);
+        } else warnPlanXml<<"No timezone specified, using default (local)";
+        m_status.setProjectTimeZone(project->timeZone());
+    }
+    if (attributes.hasAttribute(QStringLiteral("scheduling"))) {
+        // Allow for both numeric and text
+        const QString s = attributeValue(attributes, QStringLiteral("scheduling"), QString::number(0));
+        bool ok = false;
+        int constraint = s.toInt(&ok);
+        if (ok) {
+            project->setConstraint(static_cast<Node::ConstraintType>(constraint));
+        } else {
+            project->setConstraint(s);
+        }
+        constraint = project->constraint();
+        if (constraint != Node::MustStartOn && constraint != Node::MustFinishOn) {
+            errorPlanXml << "Illegal constraint: " << project->constraintToString();
+            project->setConstraint(Node::MustStartOn);
+        }
+    }
+    QString s = attributeValue(attributes, QStringLiteral("start-time"));
+    if (!s.isEmpty()) {
+        project->setConstraintStartTime(DateTime::fromString(s, project->timeZone()));
+    }
+    s = attributeValue(attributes, QStringLiteral("end-time"));
+    if (!s.isEmpty()) {
+        project->setConstraintEndTime(DateTime::fromString(s, project->timeZone()));
+    }
+}
+
+void ProjectStreamLoader::readSettings(QXmlStreamReader &reader)
+{
+    KoXmlDocument document(true);
+    if (!readElement(reader, document)) {
+        return;
+    }
+    const KoXmlElement element = document.documentElement();
+    m_loader.loadSettings(element, m_status);
+    const KoXmlElement freedays = element.namedItem(QStringLiteral("freedays")).toElement();
+    m_hasFreedays = !freedays.isNull();
+    m_freedaysId = freedays.attribute(QStringLiteral("calendar-id"));
+}
+
+void ProjectStreamLoader::readCalendars(QXmlStreamReader &reader)
+{
+    m_calendarsLoaded = true;
+    QList<Calendar*> cals;
+    while (reader.readNextStartElement()) {
+        if (reader.name() != QLatin1String("calendar")) {
+            skipElement(reader);
+            continue;
+        }
+        KoXmlDocument document(true);
+        if (!readElement(reader, document)) {
+            continue;
+        }
+        // Referenced by resources
+        Calendar *child = new Calendar();
+        child->setProject(m_project);
+        if (m_loader.load(child, document.documentElement(), m_status)) {
+            cals.append(child); // temporary, reorder later
+        } else {
+            errorPlanXml << "Failed to load calendar";
+            delete child;
+        }
+    }
+    m_loader.addCalendars(m_project, cals, m_status);
+}
+
+void ProjectStreamLoader::readResourceGroups(QXmlStreamReader &reader)
+{
+    while (reader.readNextStartElement()) {
+        if (reader.name() != QLatin1String("resource-group")) {
+            skipElement(reader);
+            continue;
+        }
+        KoXmlDocument document(true);
+        if (!readElement(reader, document)) {
+            continue;
+        }
+        ResourceGroup *child = new ResourceGroup();
+        if (m_loader.load(child, document.documentElement(), m_status)) {
+            m_project->addResourceGroup(child);
+        } else {
+            errorPlanXml<<"Failed to load resource group";
+            delete child;
+        }
+    }
+}
+
+void ProjectStreamLoader::readResources(QXmlStreamReader &reader)
+{
+    while (reader.readNextStartElement()) {
+        if (reader.name() != QLatin1String("resource")) {
+            skipElement(reader);
+            continue;
+        }
+        KoXmlDocument document(true);
+        if (!readElement(reader, document)) {
+            continue;
+        }
+        Resource *r = new Resource();
+        if (m_loader.load(r, document.documentElement(), m_status)) {
+            m_project->addResource(r);
+        } else {
+            errorPlanXml<<"Failed to load resource xml";
+            delete r;
+        }
+    }
+}
+
+void ProjectStreamLoader::readResourceGroupRelations(QXmlStreamReader &reader)
+{
+    while (reader.readNextStartElement()) {
+        if (reader.name() == QLatin1String("resource-group-relation")) {
+            const QXmlStreamAttributes attributes = reader.attributes();
+            ResourceGroup *g = m_project->group(attributeValue(attributes, QStringLiteral("group-id")));
+            Resource *r = m_project->resource(attributeValue(attributes, QStringLiteral("resource-id")));
+            if (r && g) {
+                r->addParentGroup(g);
+            } else {
+                errorPlanXml<<"Failed to load resource-group-relation";
+            }
+        }
+        reader.skipCurrentElement();
+    }
+}
+
+void ProjectStreamLoader::readResourceTeams(QXmlStreamReader &reader)
+{
+    while (reader.readNextStartElement()) {
+        if (reader.name() == QLatin1String("team")) {
+            const QXmlStreamAttributes attributes = reader.attributes();
+            Resource *r = m_project->findResource(attributeValue(attributes, QStringLiteral("team-id")));
+            Resource *tm = m_project->findResource(attributeValue(attributes, QStringLiteral("member-id")));
+            if (r == nullptr || tm == nullptr) {
+                errorPlanXml<<"resource-teams: cannot find resources";
+            } else if (r == tm) {
+                errorPlanXml<<"resource-teams: a team cannot be a member of itself";
+            } else {
+                r->addTeamMemberId(tm->id());
+            }
+        } else {
+            errorPlanXml<<"resource-teams: unhandled tag"<<reader.name();
+        }
+        reader.skipCurrentElement();
+    }
+}
+
+void ProjectStreamLoader::readRequiredResources(QXmlStreamReader &reader)
+{
+    while (reader.readNextStartElement()) {
+        if (reader.name() == QLatin1String("required-resource")) {
+            const QXmlStreamAttributes attributes = reader.attributes();
+            Resource *required = m_project->resource(attributeValue(attributes, QStringLiteral("required-id")));
+            Resource *resource = m_project->resource(attributeValue(attributes, QStringLiteral("resource-id")));
+            if (required && resource) {
+                resource->addRequiredId(required->id());
+            } else {
+                errorPlanXml<<"Failed to load required-resource";
+            }
+        }
+        reader.skipCurrentElement();
+    }
+}
+
+void ProjectStreamLoader::readTasks(QXmlStreamReader &reader)
+{
+    while (reader.readNextStartElement()) {
+        if (reader.name() != QLatin1String("task")) {
+            skipElement(reader);
+            continue;
+        }
+        // Depends on resources already loaded
+        Task *child = readTask(reader, m_project);
+        if (!m_project->addTask(child, m_project)) {
+            errorPlanXml<<"Failed to load task";
+            delete child;
+        } else {
+            debugPlanXml<<m_status.version()<<"Added task:"<<child;
+        }
+    }
+    if (m_project->numChildren() == 0) {
+        debugPlanXml<<"No tasks added";
+    }
+}
+
+// The attributes are the same as in ProjectLoader_v0::load(Task*),
+// child tasks are read from the stream and other child elements are loaded
+// by ProjectLoader_v0::loadTaskChild()
+Task *ProjectStreamLoader::readTask(QXmlStreamReader &reader, Node *parent)
+{
+    const QXmlStreamAttributes attributes = reader.attributes();
+    Task *task = new Task(parent);
+    bool ok = false;
+    task->setId(attributeValue(attributes, QStringLiteral("id")));
+    task->setPriority(attributeValue(attributes, QStringLiteral("priority"), QString::number(0)).toInt());
+
+    task->setName(attributeValue(attributes, QStringLiteral("name")));
+    task->setLeader(attributeValue(attributes, QStringLiteral("leader")));
+    task->setDescription(attributeValue(attributes, QStringLiteral("description")));
+
+    // Allow for both numeric and text
+    const QString constraint = attributeValue(attributes, QStringLiteral("scheduling"), QString::number(0));
+    auto c = (Node::ConstraintType)constraint.toInt(&ok);
+    if (!ok) {
+        task->setConstraint(constraint);
+    } else {
+        task->setConstraint(c);
+    }
+    QString s = attributeValue(attributes, QStringLiteral("constraint-starttime"));
+    if (!s.isEmpty()) {
+        task->setConstraintStartTime(DateTime::fromString(s, m_status.projectTimeZone()));
+    }
+    s = attributeValue(attributes, QStringLiteral("constraint-endtime"));
+    if (!s.isEmpty()) {
+        task->setConstraintEndTime(DateTime::fromString(s, m_status.projectTimeZone()));
+    }
+    task->setStartupCost(attributeValue(attributes, QStringLiteral("startup-cost"), QString::number(0.0)).toDouble());
+    task->setShutdownCost(attributeValue(attributes, QStringLiteral("shutdown-cost"), QString::number(0.0)).toDouble());
+
+    while (reader.readNextStartElement()) {
+        if (reader.name() == QLatin1String("task")) {
+            if (!m_status.loadTaskChildren()) {
+                skipElement(reader);
+                continue;
+            }
+            Task *child = readTask(reader, task);
+            if (!m_project->addSubTask(child, task)) {
+                errorPlanXml<<"Failed to add task";
+                delete child;
+            }
+            continue;
+        }
+        KoXmlDocument document(true);
+        if (readElement(reader, document)) {
+            m_loader.loadTaskChild(task, document.documentElement(), m_status);
+        }
+    }
+    return task;
+}
+
+void ProjectStreamLoader::readRelations(QXmlStreamReader &reader)
+{
+    while (reader.readNextStartElement()) {
+        if (reader.name() == QLatin1String("relation")) {
+            const QXmlStreamAttributes attributes = reader.attributes();
+            PendingRelation relation;
+            relation.parentId = attributeValue(attributes, QStringLiteral("parent-id"));
+            relation.childId = attributeValue(attributes, QStringLiteral("child-id"));
+            relation.type = attributeValue(attributes, QStringLiteral("type"));
+            relation.lag = attributeValue(attributes, QStringLiteral("lag"));
+            m_relations << relation;
+        }
+        reader.skipCurrentElement();
+    }
+}
+
+void ProjectStreamLoader::readScheduleManagers(QXmlStreamReader &reader)
+{
+    while (reader.readNextStartElement()) {
+        if (reader.name() != QLatin1String("schedule-management")) {
+            skipElement(reader);
+            continue;
+        }
+        KoXmlDocument document(true);
+        if (!readElement(reader, document)) {
+            continue;
+        }
+        // References tasks and resources
+        ScheduleManager *sm = new ScheduleManager(*m_project);
+        if (m_loader.load(sm, document.documentElement(), m_status)) {
+            m_project->addScheduleManager(sm);
+        } else {
+            errorPlanXml << "Failed to load schedule manager";
+            delete sm;
+        }
+    }
+}
+
+void ProjectStreamLoader::readRequests(QXmlStreamReader &reader, const QString &tag, QVector<PendingRequest> &requests)
+{
+    while (reader.readNextStartElement()) {
+        if (reader.name() != tag) {
+            skipElement(reader);
+            continue;
+        }
+        const QXmlStreamAttributes attributes = reader.attributes();
+        PendingRequest request;
+        request.taskId = attributeValue(attributes, QStringLiteral("task-id"));
+        request.resourceId = attributeValue(attributes, QStringLiteral("resource-id"));
+        request.requiredId = attributeValue(attributes, QStringLiteral("required-id"));
+        request.requestId = attributeValue(attributes, QStringLiteral("request-id")).toInt();
+        request.units = attributeValue(attributes, QStringLiteral("units"), QString::number(100)).toInt();
+        requests << request;
+        reader.skipCurrentElement();
+    }
+}
+
+void ProjectStreamLoader::loadAccounts()
+{
+    if (m_accountsLoaded) {
+        return;
+    }
+    m_accountsLoaded = true;
+    if (m_accounts.documentElement().isNull()) {
+        return;
+    }
+    if (!m_loader.load(m_project->accounts(), m_accounts.documentElement(), m_status)) {
+        warnPlanXml << "Failed to load accounts";
+    }
+    m_accounts.clear();
+}
+
+void ProjectStreamLoader::resolveFreedays()
+{
+    if (!m_calendarsLoaded) {
+        return;
+    }
+    if (m_hasFreedays) {
+        m_project->setFreedaysCalendar(m_project->findCalendar(m_freedaysId));
+    } else {
+        // set a calendar if loading an old project
+        m_project->setFreedaysCalendar(m_project->calendars().value(0));
+    }
+}
+
+// Same as ProjectLoader_v0::load(Relation*)
+void ProjectStreamLoader::resolveRelations()
+{
+    debugPlanXml<<"relations:"<<m_relations.count();
+    for (const PendingRelation &r : qAsConst(m_relations)) {
+        Node *parent = m_project->findNode(r.parentId);
+        if (parent == nullptr) {
+            warnPlanXml<<"Parent node == 0, cannot find id:"<<r.parentId;
+            continue;
+        }
+        Node *child = m_project->findNode(r.childId);
+        if (child == nullptr) {
+            warnPlanXml<<"Child node == 0, cannot find id:"<<r.childId;
+            continue;
+        }
+        if (child == parent) {
+            warnPlanXml<<"Parent node == child node";
+            continue;
+        }
+        if (!parent->legalToLink(child)) {
+            warnPlanXml<<"Realation is not legal:"<<parent->name()<<"->"<<child->name();
+            continue;
+        }
+        Relation *relation = new Relation();
+        relation->setParent(parent);
+        relation->setChild(child);
+        relation->setType(r.type);
+        relation->setLag(Duration::fromString(r.lag));
+        if (!parent->addDependChildNode(relation)) {
+            errorPlanXml<<"Failed to add relation: Child="<<child->name()<<" parent="<<parent->name();
+            delete relation;
+            continue;
+        }
+        if (!child->addDependParentNode(relation)) {
+            parent->takeDependChildNode(relation);
+            errorPlanXml<<"Failed to add relation: Child="<<child->name()<<" parent="<<parent->name();
+            delete relation;
+        }
+    }
+    m_relations.clear();
+}
+
+// Same as the requests in ProjectLoader_v0::load(Project*)
+void ProjectStreamLoader::resolveRequests()
+{
+    for (const PendingRequest &r : qAsConst(m_requests)) {
+        Node *task = m_project->findNode(r.taskId);
+        if (!task) {
+            warnPlanXml<<"resource-request: Failed to find task";
+            continue;
+        }
+        Resource *resource = m_project->findResource(r.resourceId);
+        if (!resource) {
+            warnPlanXml<<"resource-request: Failed to find resource";
+            continue;
+        }
+        ResourceRequest *request = new ResourceRequest(resource, r.units);
+        Q_ASSERT(r.requestId > 0);
+        request->setId(r.requestId);
+        task->requests().addResourceRequest(request);
+    }
+    for (const PendingRequest &r : qAsConst(m_requiredRequests)) {
+        Node *task = m_project->findNode(r.taskId);
+        if (!task) {
+            warnPlanXml<<"required-resource-request: Failed to find task";
+            continue;
+        }
+        ResourceRequest *request = task->requests().resourceRequest(r.requestId);
+        Resource *required = m_project->findResource(r.requiredId);
+        if (request && required && request->resource() != required) {
+            if (request->requiredResources().contains(required)) {
+                errorPlanXml<<"Required resource request exists"<<required;
+                continue;
+            }
+            request->addRequiredResource(required);
+        } else {
+            errorPlanXml<<"Loading required resource requests failed";
+        }
+    }
+    for (const PendingRequest &r : qAsConst(m_alternativeRequests)) {
+        Node *task = m_project->findNode(r.taskId);
+        if (!task) {
+            warnPlanXml<<"alternative-request: Failed to find task";
+            continue;
+        }
+        ResourceRequest *rr = task->requests().resourceRequest(r.requestId);
+        if (!rr) {
+            errorPlanXml<<"Failed to find request to add alternatives to";
+            continue;
+        }
+        Resource *resource = m_project->findResource(r.resourceId);
+        if (!resource) {
+            errorPlanXml<<"Alternative request: Failed to find resource:"<<r.resourceId;
+            continue;
+        }
+        rr->addAlternativeRequest(new ResourceRequest(resource, r.units));
+    }
+    m_requests.clear();
+    m_requiredRequests.clear();
+    m_alternativeRequests.clear();
+}
+
+} // namespace KPlato
@@ -0,0 +1,117 @@
+/* This file is part of the KDE project
+ * SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#ifndef PROJECTSTREAMLOADER_H
+#define PROJECTSTREAMLOADER_H
+
+#include "plankernel_export.h"
+
+#include "ProjectLoader_v0.h"
+
+#include <KoXmlReader.h>
+
+#include <QString>
+#include <QVector>
+
+class QXmlStreamReader;
+
+namespace KPlato
+{
+
+class XMLLoaderObject;
+class Project;
+class Task;
+class Node;
+
+/**
+ * Loads a project directly from a QXmlStreamReader.
+ *
+ * The document is read in one pass without building a document of the complete file.
+ * Tasks and the project level relations and requests are created directly from the reader.
+ * Other objects are read one element at a time into a small KoXmlDocument and loaded
+ * with the ProjectLoader_v0 methods, so the result is the same as ProjectLoader_v0::load().
+ *
+ * Relations and requests refer to tasks by id, they are collected while reading
+ * and resolved when the complete document has been read.
+ *
+ * Only syntax version 0.7.0 and later is supported.
+ */
+class PLANKERNEL_EXPORT ProjectStreamLoader
+{
+public:
+    explicit ProjectStreamLoader(XMLLoaderObject &status);
+
+    /// Return true if a document with mime type @p mimetype and syntax @p version can be loaded
+    static bool canLoad(const QString &mimetype, const QString &version);
+
+    /**
+     * Load @p project from @p reader.
+     * The reader must be at the start of the document, or at the start of the plan element.
+     * Create the reader with namespace processing off, like the document loader.
+     */
+    bool load(Project *project, QXmlStreamReader &reader);
+
+    QString errorString() const;
+
+private:
+    struct PendingRelation {
+        QString parentId;
+        QString childId;
+        QString type;
+        QString lag;
+    };
+    struct PendingRequest {
+        QString taskId;
+        QString resourceId;
+        QString requiredId;
+        int requestId;
+        int units;
+    };
+
+    bool readElement(QXmlStreamReader &reader, KoXmlDocument &document);
+    void skipElement(QXmlStreamReader &reader);
+
+    bool readProject(QXmlStreamReader &reader);
+    void readProjectAttributes(QXmlStreamReader &reader);
+    void readSettings(QXmlStreamReader &reader);
+    void readCalendars(QXmlStreamReader &reader);
+    void readResourceGroups(QXmlStreamReader &reader);
+    void readResources(QXmlStreamReader &reader);
+    void readResourceGroupRelations(QXmlStreamReader &reader);
+    void readResourceTeams(QXmlStreamReader &reader);
+    void readRequiredResources(QXmlStreamReader &reader);
+    void readTasks(QXmlStreamReader &reader);
+    Task *readTask(QXmlStreamReader &reader, Node *parent);
+    void readRelations(QXmlStreamReader &reader);
+    void readScheduleManagers(QXmlStreamReader &reader);
+    void readRequests(QXmlStreamReader &reader, const QString &tag, QVector<PendingRequest> &requests);
+
+    void loadAccounts();
+    void resolveFreedays();
+    void resolveRelations();
+    void resolveRequests();
+
+private:
+    XMLLoaderObject &m_status;
+    ProjectLoader_v0 m_loader;
+    Project *m_project;
+    QString m_errorString;
+
+    KoXmlDocument m_accounts; // loaded after the tasks, like ProjectLoader_v0
+    bool m_accountsLoaded;
+    bool m_calendarsLoaded;
+    bool m_hasFreedays;
+    QString m_freedaysId;
+
+    QVector<PendingRelation> m_relations;
+    QVector<PendingRequest> m_requests;
+    QVector<PendingRequest> m_requiredRequests;
+    QVector<PendingRequest> m_alternativeRequests;
+};
+
+} // namespace KPlato
+
+#endif
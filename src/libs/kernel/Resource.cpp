@@ -430,13 +430,18 @@ bool Resource::addAppointment(Appointment *appointment, Schedule &main) {
 void Resource::addAppointment(Schedule *node, const DateTime &start, const DateTime &end, double load)
 {
     Q_ASSERT(start < end);
+    addAppointment(node, AppointmentInterval(start, end, load));
+}
+
+void Resource::addAppointment(Schedule *node, const AppointmentInterval &interval)
+{
     Schedule *s = findSchedule(node->id());
     if (s == nullptr) {
         s = createSchedule(node->parent());
     }
     s->setCalculationMode(node->calculationMode());
-    //debugPlan<<"id="<<node->id()<<" Mode="<<node->calculationMode()<<""<<start<<end;
-    s->addAppointment(node, start, end, load);
+    //debugPlan<<"id="<<node->id()<<" Mode="<<node->calculationMode()<<""<<interval;
+    s->addAppointment(node, interval);
 }
 
 void Resource::initiateCalculation(Schedule &sch) {
@@ -545,29 +550,21 @@ DateTimeInterval Resource::requiredAvailable(Schedule *node, const DateTime &sta
 {
     Q_ASSERT(m_currentSchedule);
     DateTimeInterval interval(start, end);
-#ifndef PLAN_NLOGDEBUG
-    if (m_currentSchedule) m_currentSchedule->logDebug(QStringLiteral("Required available in interval: %1").arg(interval.toString()));
-#endif
+    scheduleLogDebug(m_currentSchedule, ScheduleLog::Event_RequiredAvailable, ScheduleLog::time(interval.first), ScheduleLog::time(interval.second));
     DateTime availableFrom = m_availableFrom.isValid() ? m_availableFrom : (m_project ? m_project->constraintStartTime() : DateTime());
     DateTime availableUntil = m_availableUntil.isValid() ? m_availableUntil : (m_project ? m_project->constraintEndTime() : DateTime());
     DateTimeInterval x = interval.limitedTo(availableFrom, availableUntil);
     if (calendar() == nullptr) {
-#ifndef PLAN_NLOGDEBUG
-        if (m_currentSchedule) m_currentSchedule->logDebug(QStringLiteral("Required available: no calendar, %1").arg(x.toString()));
-#endif
+        scheduleLogDebug(m_currentSchedule, ScheduleLog::Event_RequiredAvailableNoCalendar, ScheduleLog::time(x.first), ScheduleLog::time(x.second));
         return x;
     }
     DateTimeInterval i = m_currentSchedule->firstBookedInterval(x, node);
     if (i.isValid()) {
-#ifndef PLAN_NLOGDEBUG
-        if (m_currentSchedule) m_currentSchedule->logDebug(QStringLiteral("Required available: booked, %1").arg(i.toString()));
-#endif
+        scheduleLogDebug(m_currentSchedule, ScheduleLog::Event_RequiredAvailableBooked, ScheduleLog::time(i.first), ScheduleLog::time(i.second));
         return i; 
     }
     i = calendar()->firstInterval(x.first, x.second, m_currentSchedule);
-#ifndef PLAN_NLOGDEBUG
-    if (m_currentSchedule) m_currentSchedule->logDebug(QStringLiteral("Required first available in %1:  %2").arg(x.toString()).arg(i.toString()));
-#endif
+    scheduleLogDebug(m_currentSchedule, ScheduleLog::Event_RequiredFirstAvailable, ScheduleLog::time(x.first), ScheduleLog::time(x.second), ScheduleLog::time(i.first), ScheduleLog::time(i.second));
     return i;
 }
 
@@ -592,9 +589,12 @@ void Resource::makeAppointment(Schedule *node, const DateTime &from, const DateT
     AppointmentIntervalList lst = workIntervals(from, end, m_currentSchedule).toTimeZone(tz);
     const auto intervals = lst.map().values();
     for (const AppointmentInterval &i : intervals) {
-        m_currentSchedule->addAppointment(node, i.startTime(), i.endTime(), load);
+        AppointmentInterval a = i;
+        a.setLoad(load);
+        m_currentSchedule->addAppointment(node, a);
         for (Resource *r : required) {
-            r->addAppointment(node, i.startTime(), i.endTime(), r->units()); //FIXME: units may not be correct
+            a.setLoad(r->units()); //FIXME: units may not be correct
+            r->addAppointment(node, a);
         }
     }
 }
@@ -786,8 +786,7 @@ DateTime Resource::WorkInfoCache::firstAvailableAfter(const DateTime &time, cons
                 return ti.first;
             }
         } else {
-            DateTime t = qMax(it.value().startTime(), time);
-            return t;
+            return it.value().start() > TimePoint::fromDateTime(time) ? it.value().startTime() : time;
         }
     }
     if (it == intervals.map().constEnd()) {
@@ -825,8 +824,7 @@ DateTime Resource::WorkInfoCache::firstAvailableBefore(const DateTime &time, con
                 return ti.second;
             }
         } else {
-            DateTime t = qMin(it.value().endTime(), time);
-            return t;
+            return it.value().end() < TimePoint::fromDateTime(time) ? it.value().endTime() : time;
         }
     }
     if (it == intervals.map().constBegin()) {
@@ -903,9 +901,7 @@ Duration Resource::effort(Schedule *sch, const DateTime &start, const Duration &
         until = availableBefore(startTime + duration, startTime, sch);
     }
     if (! (from.isValid() && until.isValid())) {
-#ifndef PLAN_NLOGDEBUG
-        if (sch) sch->logDebug(QStringLiteral("Resource not available in interval:") + startTime.toString() + QLatin1Char(',') + (startTime+duration).toString());
-#endif
+        scheduleLogDebug(sch, ScheduleLog::Event_ResourceNotAvailable, ScheduleLog::time(startTime), ScheduleLog::time(startTime + duration));
     } else {
         for (Resource *r : required) {
             from = r->availableAfter(from, until);
@@ -919,9 +915,9 @@ Duration Resource::effort(Schedule *sch, const DateTime &start, const Duration &
         }
     }
     if (from.isValid() && until.isValid()) {
-#ifndef PLAN_NLOGDEBUG
-        if (sch && until < from) sch->logDebug(QStringLiteral(" until < from: until=") + until.toString() + QStringLiteral(" from=") + from.toString());
-#endif
+        if (until < from) {
+            scheduleLogDebug(sch, ScheduleLog::Event_UntilBeforeFrom, ScheduleLog::time(until), ScheduleLog::time(from));
+        }
         e = workIntervals(from, until).effort(from, until) * units / 100;
         if (sch && (! sch->allowOverbooking() || sch->allowOverbookingState() == Schedule::OBS_Deny)) {
             auto s = m_project ? from.toTimeZone(m_project->timeZone()) : from;
@@ -934,9 +930,7 @@ Duration Resource::effort(Schedule *sch, const DateTime &start, const Duration &
 //        e = (cal->effort(from, until, sch)) * m_units / 100;
     }
     //debugPlan<<m_name<<startTime<<" e="<<e.toString(Duration::Format_Day)<<" ("<<m_units<<")";
-#ifndef PLAN_NLOGDEBUG
-    if (sch) sch->logDebug(QStringLiteral("effort: %1 for %2 effort = %3").arg(startTime.toString()).arg(duration.toString()).arg(e.toString()));
-#endif
+    scheduleLogDebug(sch, ScheduleLog::Event_Effort, ScheduleLog::time(startTime), duration.milliseconds(), e.milliseconds());
     return e;
 }
 
@@ -1001,23 +995,21 @@ DateTime Resource::availableBefore(const DateTime &time, const DateTime &limit,
     }
     DateTime availableUntil = m_availableUntil.isValid() ? m_availableUntil : (m_project ? m_project->constraintEndTime() : DateTime());
     if (! availableUntil.isValid()) {
-#ifndef PLAN_NLOGDEBUG
-        if (sch) sch->logDebug(QStringLiteral("availableUntil is invalid"));
-#endif
+        scheduleLogDebug(sch, ScheduleLog::Event_AvailableUntilInvalid);
         t = time;
     } else {
         t = availableUntil < time ? availableUntil : time;
     }
-#ifndef PLAN_NLOGDEBUG
-    if (sch && t < lmt) sch->logDebug(QStringLiteral("t < lmt: ") + t.toString() + QStringLiteral(" < ") + lmt.toString());
-#endif
+    if (t < lmt) {
+        scheduleLogDebug(sch, ScheduleLog::Event_AvailableBeforeLimit, ScheduleLog::time(t), ScheduleLog::time(lmt));
+    }
     t = m_workinfocache.firstAvailableBefore(t, lmt, cal, sch);
     if (m_project) {
         t = t.toTimeZone(m_project->timeZone());
     }
-#ifndef PLAN_NLOGDEBUG
-    if (sch && t.isValid() && t < lmt) sch->logDebug(QStringLiteral(" t < lmt: t=") + t.toString() + QStringLiteral(" lmt=") + lmt.toString());
-#endif
+    if (t.isValid() && t < lmt) {
+        scheduleLogDebug(sch, ScheduleLog::Event_AvailableBeforeLimit, ScheduleLog::time(t), ScheduleLog::time(lmt));
+    }
     return t;
 }
 
@@ -128,6 +128,8 @@ public:
     virtual bool addAppointment(Appointment *appointment, Schedule &main);
     /// Adds appointment to both this resource and node
     virtual void addAppointment(Schedule *node, const DateTime &start, const DateTime &end, double load = 100);
+    /// Adds the appointment @p interval to both this resource and node
+    void addAppointment(Schedule *node, const AppointmentInterval &interval);
 
     void initiateCalculation(Schedule &sch);
     bool isAvailable(Task *task);
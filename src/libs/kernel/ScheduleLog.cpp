@@ -0,0 +1,122 @@
+/* This file is part of the KDE project
+ * SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+// clazy:excludeall=qstring-arg
+#include "ScheduleLog.h"
+
+#include "kptdatetime.h"
+#include "kptduration.h"
+
+#include <QDateTime>
+
+#include <limits>
+
+namespace KPlato
+{
+
+static int initialScheduleLogLevel()
+{
+    bool ok = false;
+    const int level = qEnvironmentVariableIntValue("PLAN_SCHEDULELOG_LEVEL", &ok);
+    return ok ? level : ScheduleLog::Severity_Debug;
+}
+
+QAtomicInt ScheduleLog::s_level(initialScheduleLogLevel());
+
+void ScheduleLog::setLevel(int severity)
+{
+    s_level.storeRelaxed(severity);
+}
+
+int ScheduleLog::level()
+{
+    return s_level.loadRelaxed();
+}
+
+qint64 ScheduleLog::time(const QDateTime &dt)
+{
+    return dt.isValid() ? dt.toMSecsSinceEpoch() : std::numeric_limits<qint64>::min();
+}
+
+static QString timeToString(qint64 msecs, const QTimeZone &timeZone)
+{
+    if (msecs == std::numeric_limits<qint64>::min()) {
+        return QStringLiteral("''");
+    }
+    const QDateTime dt = timeZone.isValid() ? QDateTime::fromMSecsSinceEpoch(msecs, timeZone) : QDateTime::fromMSecsSinceEpoch(msecs);
+    return dt.toString();
+}
+
+static QString intervalToString(qint64 start, qint64 end, const QTimeZone &timeZone)
+{
+    return QStringLiteral("%1 - %2").arg(timeToString(start, timeZone), timeToString(end, timeZone));
+}
+
+static QString durationToString(qint64 msecs)
+{
+    return Duration(msecs).toString();
+}
+
+static QString unitToString(qint64 unit)
+{
+    switch (unit) {
+        case ScheduleLog::Unit_Days: return QStringLiteral("Days");
+        case ScheduleLog::Unit_Hours: return QStringLiteral("Hours");
+        case ScheduleLog::Unit_Minutes: return QStringLiteral("Minutes");
+        case ScheduleLog::Unit_Seconds: return QStringLiteral("Seconds");
+        case ScheduleLog::Unit_Milliseconds: return QStringLiteral("Milliseconds");
+        default: break;
+    }
+    return QString::number(unit);
+}
+
+QString ScheduleLog::message(int event, const Arguments &arguments, const QTimeZone &timeZone)
+{
+    const qint64 *v = arguments.value;
+    switch (event) {
+        case Event_None:
+            return QString();
+        case Event_RequiredAvailable:
+            return QStringLiteral("Required available in interval: %1").arg(intervalToString(v[0], v[1], timeZone));
+        case Event_RequiredAvailableNoCalendar:
+            return QStringLiteral("Required available: no calendar, %1").arg(intervalToString(v[0], v[1], timeZone));
+        case Event_RequiredAvailableBooked:
+            return QStringLiteral("Required available: booked, %1").arg(intervalToString(v[0], v[1], timeZone));
+        case Event_RequiredFirstAvailable:
+            return QStringLiteral("Required first available in %1:  %2").arg(intervalToString(v[0], v[1], timeZone), intervalToString(v[2], v[3], timeZone));
+        case Event_ResourceNotAvailable:
+            return QStringLiteral("Resource not available in interval: %1").arg(intervalToString(v[0], v[1], timeZone));
+        case Event_UntilBeforeFrom:
+            return QStringLiteral(" until < from: until=%1 from=%2").arg(timeToString(v[0], timeZone), timeToString(v[1], timeZone));
+        case Event_Effort:
+            return QStringLiteral("effort: %1 for %2 effort = %3").arg(timeToString(v[0], timeZone), durationToString(v[1]), durationToString(v[2]));
+        case Event_AvailableUntilInvalid:
+            return QStringLiteral("availableUntil is invalid");
+        case Event_AvailableBeforeLimit:
+            return QStringLiteral("t < lmt: t=%1 lmt=%2").arg(timeToString(v[0], timeZone), timeToString(v[1], timeZone));
+        case Event_EffortDeviation:
+            return QStringLiteral("Deviation: %1").arg(durationToString(v[0]));
+        case Event_DurationMatch:
+            return QStringLiteral("%1 done: %2").arg(unitToString(v[0]).toLower(), v[1] ? QStringLiteral("match") : QStringLiteral("nomatch"));
+        case Event_DurationStep:
+            return QStringLiteral("%1: duration %2 e=%3 (%4)").arg(unitToString(v[0]), intervalToString(v[1], v[2], timeZone), durationToString(v[3]), durationToString(v[4]));
+        case Event_LengthFrom:
+            return QStringLiteral("Calculate length from: %1").arg(timeToString(v[0], timeZone));
+        case Event_LengthStep:
+            return QStringLiteral("%1: duration %2 = %3 (%4)").arg(unitToString(v[0]), intervalToString(v[1], v[2], timeZone), durationToString(v[3]), durationToString(v[4]));
+        case Event_LengthMovedEnd:
+            return QStringLiteral("Moved end to work: %1 -> %2").arg(timeToString(v[0], timeZone), timeToString(v[1], timeZone));
+        case Event_LengthCalculated:
+            return QStringLiteral("Calculated length: %1 = %2").arg(intervalToString(v[0], v[1], timeZone), durationToString(v[2]));
+        case Event_ScheduleAsap:
+            return QStringLiteral("ASAP: %1 earliest: %2").arg(timeToString(v[0], timeZone), timeToString(v[1], timeZone));
+        default:
+            break;
+    }
+    return QStringLiteral("Unknown log event: %1").arg(event);
+}
+
+} // namespace KPlato
@@ -0,0 +1,141 @@
+/* This file is part of the KDE project
+ * SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#ifndef SCHEDULELOG_H
+#define SCHEDULELOG_H
+
+#include "plankernel_export.h"
+
+#include <QAtomicInt>
+#include <QString>
+#include <QTimeZone>
+
+#include <type_traits>
+
+class QDateTime;
+
+/**
+ * Lowest log severity compiled into the scheduler hot paths.
+ * Severities match Schedule::Log::Type (Debug = 0, Info, Warning, Error).
+ * Defining PLAN_NLOGDEBUG removes debug records at compile time.
+ */
+#ifndef PLAN_SCHEDULELOG_MIN_SEVERITY
+#ifdef PLAN_NLOGDEBUG
+#define PLAN_SCHEDULELOG_MIN_SEVERITY 1
+#else
+#define PLAN_SCHEDULELOG_MIN_SEVERITY 0
+#endif
+#endif
+
+/**
+ * Add a structured debug record to @p schedule.
+ * Arguments are only evaluated if debug records are enabled,
+ * so the macro can be left in scheduler hot paths.
+ * Usage: scheduleLogDebug(sch, ScheduleLog::Event_Effort, ScheduleLog::time(start), d.milliseconds());
+ */
+#define scheduleLogDebug(schedule, ...) \
+    do { \
+        if (KPlato::ScheduleLog::isEnabled(KPlato::ScheduleLog::Severity_Debug) && (schedule)) { \
+            (schedule)->addLogRecord(KPlato::ScheduleLog::record(KPlato::ScheduleLog::Severity_Debug, __VA_ARGS__)); \
+        } \
+    } while (false)
+
+namespace KPlato
+{
+
+class Node;
+class Resource;
+
+/**
+ * Structured scheduling log.
+ *
+ * The scheduler adds fixed size binary records, the message text is
+ * only generated when the log is displayed.
+ * Records are kept pending in the main schedule and moved into the log
+ * in batches while scheduling, see MainSchedule::flushLogRecords().
+ */
+class PLANKERNEL_EXPORT ScheduleLog
+{
+public:
+    enum Severity { Severity_Debug = 0, Severity_Info, Severity_Warning, Severity_Error };
+
+    /// Identifies the message format of a record
+    enum Event {
+        Event_None = 0,
+        Event_RequiredAvailable,            // interval
+        Event_RequiredAvailableNoCalendar,  // interval
+        Event_RequiredAvailableBooked,      // interval
+        Event_RequiredFirstAvailable,       // interval, interval
+        Event_ResourceNotAvailable,         // time, time
+        Event_UntilBeforeFrom,              // until, from
+        Event_Effort,                       // time, duration, effort
+        Event_AvailableUntilInvalid,
+        Event_AvailableBeforeLimit,         // time, limit
+        Event_EffortDeviation,              // deviation
+        Event_DurationMatch,                // unit, match
+        Event_DurationStep,                 // unit, time, time, effort, remaining
+        Event_LengthFrom,                   // time
+        Event_LengthStep,                   // unit, time, time, length, remaining
+        Event_LengthMovedEnd,               // time, time
+        Event_LengthCalculated,             // time, time, length
+        Event_ScheduleAsap                  // start, early start
+    };
+    /// Used by Event_DurationMatch, Event_DurationStep and Event_LengthStep
+    enum Unit { Unit_Days = 0, Unit_Hours, Unit_Minutes, Unit_Seconds, Unit_Milliseconds };
+
+    enum { ArgumentCount = 5 };
+    struct Arguments {
+        qint64 value[ArgumentCount];
+    };
+
+    /// A log record. Trivially copyable so pending records are cheap to store.
+    struct Record {
+        qint32 event;
+        qint16 severity;
+        qint16 phase;
+        const Node *node;
+        const Resource *resource;
+        Arguments arguments;
+    };
+
+    /// Return true if records of @p severity shall be logged
+    static bool isEnabled(int severity) {
+        return severity >= PLAN_SCHEDULELOG_MIN_SEVERITY && severity >= s_level.loadRelaxed();
+    }
+    /// Set the lowest severity logged at runtime
+    static void setLevel(int severity);
+    static int level();
+
+    static Record record(int severity, Event event, qint64 a0 = 0, qint64 a1 = 0, qint64 a2 = 0, qint64 a3 = 0, qint64 a4 = 0) {
+        Record r;
+        r.event = event;
+        r.severity = severity;
+        r.phase = -1;
+        r.node = nullptr;
+        r.resource = nullptr;
+        r.arguments.value[0] = a0;
+        r.arguments.value[1] = a1;
+        r.arguments.value[2] = a2;
+        r.arguments.value[3] = a3;
+        r.arguments.value[4] = a4;
+        return r;
+    }
+    /// Encode @p dt as a record argument
+    static qint64 time(const QDateTime &dt);
+
+    /// Generate the message text of @p event, times are shown in @p timeZone
+    static QString message(int event, const Arguments &arguments, const QTimeZone &timeZone = QTimeZone());
+
+private:
+    static QAtomicInt s_level;
+};
+
+} // namespace KPlato
+
+Q_DECLARE_TYPEINFO(KPlato::ScheduleLog::Record, Q_PRIMITIVE_TYPE);
+static_assert(std::is_trivially_copyable<KPlato::ScheduleLog::Record>::value, "ScheduleLog::Record must be trivially copyable");
+
+#endif
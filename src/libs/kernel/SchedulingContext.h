@@ -16,6 +16,8 @@
 #include <QList>
 #include <QMultiMap>
 
+#include <atomic>
+
 class KoDocument;
 
 namespace KPlato 
@@ -39,8 +41,10 @@ public:
     QList<const KoDocument*> resourceBookings;
     QDateTime calculateFrom;
     bool scheduleInParallel;
-    bool cancelScheduling;
+    /// Set from the ui thread while the scheduler runs in a worker thread
+    std::atomic<bool> cancelScheduling;
 
+    /// Documents owned by the context, deleted in clear()
     QList<KoDocument*> calculatedDocuments;
 
     QVector<KPlato::Schedule::Log> log;
@@ -0,0 +1,154 @@
+/* This file is part of the KDE project
+ * SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+// clazy:excludeall=qstring-arg
+#include "TimePhasedCache.h"
+
+#include "AppointmentStore.h"
+
+#include <QPair>
+
+#include <algorithm>
+
+namespace KPlato
+{
+
+TimePhasedCache::TimePhasedCache()
+    : m_revision(0)
+    , m_built(false)
+{
+}
+
+TimePhasedCache TimePhasedCache::create(const AppointmentStore &store)
+{
+    TimePhasedCache cache;
+    cache.build(store);
+    return cache;
+}
+
+QDate TimePhasedCache::periodStart(const QDate &date, Resolution resolution)
+{
+    switch (resolution) {
+        case Week:
+            return date.addDays(1 - date.dayOfWeek());
+        case Month:
+            return QDate(date.year(), date.month(), 1);
+        case Quarter:
+            return QDate(date.year(), ((date.month() - 1) / 3) * 3 + 1, 1);
+        default:
+            break;
+    }
+    return date;
+}
+
+QDate TimePhasedCache::nextPeriodStart(const QDate &date, Resolution resolution)
+{
+    const QDate start = periodStart(date, resolution);
+    switch (resolution) {
+        case Week:
+            return start.addDays(7);
+        case Month:
+            return start.addMonths(1);
+        case Quarter:
+            return start.addMonths(3);
+        default:
+            break;
+    }
+    return start.addDays(1);
+}
+
+void TimePhasedCache::clear()
+{
+    m_built = false;
+    m_items.clear();
+}
+
+void TimePhasedCache::build(const AppointmentStore &store)
+{
+    clear();
+    // the cache is as current as the store it is built from
+    m_revision = store.m_revision;
+
+    QVector<QPair<qint64, qint64>> days;
+    const QList<const QHash<const Schedule*, QVector<int>>*> indexes = { &store.m_nodeIndex, &store.m_resourceIndex };
+    for (const QHash<const Schedule*, QVector<int>> *index : indexes) {
+        for (auto it = index->constBegin(); it != index->constEnd(); ++it) {
+            days.clear();
+            for (int a : it.value()) {
+                for (int row = store.m_firstRow.at(a); row < store.m_firstRow.at(a + 1); ++row) {
+                    days << qMakePair(store.m_day.at(row), store.m_effort.at(row));
+                }
+            }
+            addItem(it.key(), days);
+        }
+    }
+    m_built = store.m_built;
+}
+
+void TimePhasedCache::addItem(const Schedule *schedule, QVector<QPair<qint64, qint64>> &days)
+{
+    // appointments of different resources or tasks overlap in time
+    std::sort(days.begin(), days.end());
+
+    Item &item = m_items[schedule];
+    for (int r = Day; r <= Quarter; ++r) {
+        Series &series = item.series[r];
+        qint64 end = 0;
+        for (const QPair<qint64, qint64> &day : qAsConst(days)) {
+            if (series.period.isEmpty() || day.first >= end) {
+                const QDate date = QDate::fromJulianDay(day.first);
+                series.period << periodStart(date, static_cast<Resolution>(r)).toJulianDay();
+                series.effort << 0;
+                end = nextPeriodStart(date, static_cast<Resolution>(r)).toJulianDay();
+            }
+            series.effort.last() += day.second;
+        }
+    }
+    for (const QPair<qint64, qint64> &day : qAsConst(days)) {
+        item.total += day.second;
+    }
+}
+
+Duration TimePhasedCache::effort(const Schedule *schedule, const QDate &date, Resolution resolution) const
+{
+    const auto it = m_items.constFind(schedule);
+    if (it == m_items.constEnd() || !date.isValid()) {
+        return Duration::zeroDuration;
+    }
+    const Series &series = it.value().series[resolution];
+    const qint64 period = periodStart(date, resolution).toJulianDay();
+    const auto pos = std::lower_bound(series.period.constBegin(), series.period.constEnd(), period);
+    if (pos == series.period.constEnd() || *pos != period) {
+        return Duration::zeroDuration;
+    }
+    return Duration(series.effort.at(pos - series.period.constBegin()));
+}
+
+Duration TimePhasedCache::totalEffort(const Schedule *schedule) const
+{
+    const auto it = m_items.constFind(schedule);
+    return it == m_items.constEnd() ? Duration::zeroDuration : Duration(it.value().total);
+}
+
+QDate TimePhasedCache::startDate(const Schedule *schedule) const
+{
+    const auto it = m_items.constFind(schedule);
+    if (it == m_items.constEnd() || it.value().series[Day].period.isEmpty()) {
+        return QDate();
+    }
+    return QDate::fromJulianDay(it.value().series[Day].period.first());
+}
+
+QDate TimePhasedCache::endDate(const Schedule *schedule) const
+{
+    const auto it = m_items.constFind(schedule);
+    if (it == m_items.constEnd() || it.value().series[Day].period.isEmpty()) {
+        return QDate();
+    }
+    return QDate::fromJulianDay(it.value().series[Day].period.last());
+}
+
+} // namespace KPlato
@@ -0,0 +1,113 @@
+/* This file is part of the KDE project
+ * SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#ifndef TIMEPHASEDCACHE_H
+#define TIMEPHASEDCACHE_H
+
+#include "plankernel_export.h"
+#include "kptduration.h"
+
+#include <QDate>
+#include <QHash>
+#include <QMetaType>
+#include <QPair>
+#include <QVector>
+
+namespace KPlato
+{
+
+class AppointmentStore;
+class Schedule;
+
+/**
+ * Planned effort of tasks and resources aggregated per day, week, month and quarter.
+ *
+ * The cache is built from the day rows of an AppointmentStore and is keyed on
+ * node schedules (tasks) and resource schedules (resources).
+ * A lookup is a binary search in the periods of one schedule and resolution,
+ * so a view that shows a few columns costs the same whether a column is a day or a quarter.
+ *
+ * Weeks start on monday.
+ *
+ * The cache only holds copies of the store data and is safe to build in a worker thread,
+ * see MainSchedule::buildTimePhasedCache(). The data is implicitly shared, so a cache is cheap to copy.
+ */
+class PLANKERNEL_EXPORT TimePhasedCache
+{
+public:
+    enum Resolution { Day = 0, Week, Month, Quarter };
+
+    TimePhasedCache();
+
+    /// Return a cache built from @p store
+    static TimePhasedCache create(const AppointmentStore &store);
+
+    /// Return the first day of the period of @p resolution that contains @p date
+    static QDate periodStart(const QDate &date, Resolution resolution);
+    /// Return the first day of the period after the one that contains @p date
+    static QDate nextPeriodStart(const QDate &date, Resolution resolution);
+
+    /// Return true if the cache has been built
+    bool isValid() const { return m_built; }
+    /// Return the appointment revision of the store the cache was built from
+    int revision() const { return m_revision; }
+    void clear();
+    /// Build the cache from the day rows of @p store
+    void build(const AppointmentStore &store);
+
+    /// Return the effort of the node or resource @p schedule in the period of @p resolution that contains @p date
+    Duration effort(const Schedule *schedule, const QDate &date, Resolution resolution = Day) const;
+    /// Return the total effort of the node or resource @p schedule
+    Duration totalEffort(const Schedule *schedule) const;
+    /// Return the first day with effort for @p schedule, invalid if none
+    QDate startDate(const Schedule *schedule) const;
+    /// Return the last day with effort for @p schedule, invalid if none
+    QDate endDate(const Schedule *schedule) const;
+
+private:
+    // Periods sorted by start, one per period with effort
+    struct Series {
+        QVector<qint64> period; // julian day of the period start
+        QVector<qint64> effort; // milliseconds
+    };
+    struct Item {
+        Series series[Quarter + 1];
+        qint64 total = 0;
+    };
+    void addItem(const Schedule *schedule, QVector<QPair<qint64, qint64>> &days);
+
+private:
+    int m_revision;
+    bool m_built;
+    QHash<const Schedule*, Item> m_items;
+};
+
+/**
+ * The effort of one node or resource schedule in a TimePhasedCache.
+ * Used to pass the effort of a resource to the resource gantt delegate.
+ */
+class PLANKERNEL_EXPORT TimePhasedEffort
+{
+public:
+    TimePhasedEffort() : m_schedule(nullptr) {}
+    TimePhasedEffort(const TimePhasedCache &cache, const Schedule *schedule) : m_cache(cache), m_schedule(schedule) {}
+
+    bool isValid() const { return m_schedule && m_cache.isValid(); }
+    /// Return the effort in the period of @p resolution that contains @p date
+    Duration effort(const QDate &date, TimePhasedCache::Resolution resolution) const { return m_cache.effort(m_schedule, date, resolution); }
+    QDate startDate() const { return m_cache.startDate(m_schedule); }
+    QDate endDate() const { return m_cache.endDate(m_schedule); }
+
+private:
+    TimePhasedCache m_cache;
+    const Schedule *m_schedule;
+};
+
+} // namespace KPlato
+
+Q_DECLARE_METATYPE(KPlato::TimePhasedEffort)
+
+#endif
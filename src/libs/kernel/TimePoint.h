@@ -0,0 +1,55 @@
+/* This file is part of the KDE project
+ * SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#ifndef TIMEPOINT_H
+#define TIMEPOINT_H
+
+#include <QDateTime>
+
+#include <limits>
+
+namespace KPlato
+{
+
+/**
+ * A point in time as milliseconds since epoch, UTC.
+ *
+ * Unlike DateTime it has no time zone and no shared data, so it is
+ * cheap to copy, compare and do arithmetic on.
+ * Use it for intermediate results in calculations and convert to
+ * DateTime only when the result is returned, see TimeZoneOffsets::toDateTime().
+ */
+class TimePoint
+{
+public:
+    /// Create an invalid time point
+    constexpr TimePoint() : m_msecs(std::numeric_limits<qint64>::min()) {}
+    constexpr explicit TimePoint(qint64 msecsSinceEpoch) : m_msecs(msecsSinceEpoch) {}
+
+    static TimePoint fromDateTime(const QDateTime &dt) { return dt.isValid() ? TimePoint(dt.toMSecsSinceEpoch()) : TimePoint(); }
+
+    constexpr bool isValid() const { return m_msecs != std::numeric_limits<qint64>::min(); }
+    constexpr qint64 toMSecsSinceEpoch() const { return m_msecs; }
+
+    constexpr TimePoint addMSecs(qint64 msecs) const { return TimePoint(m_msecs + msecs); }
+    constexpr qint64 msecsTo(TimePoint other) const { return other.m_msecs - m_msecs; }
+
+    constexpr bool operator==(TimePoint other) const { return m_msecs == other.m_msecs; }
+    constexpr bool operator!=(TimePoint other) const { return m_msecs != other.m_msecs; }
+    constexpr bool operator<(TimePoint other) const { return m_msecs < other.m_msecs; }
+    constexpr bool operator<=(TimePoint other) const { return m_msecs <= other.m_msecs; }
+    constexpr bool operator>(TimePoint other) const { return m_msecs > other.m_msecs; }
+    constexpr bool operator>=(TimePoint other) const { return m_msecs >= other.m_msecs; }
+
+private:
+    qint64 m_msecs;
+};
+
+} // namespace KPlato
+
+Q_DECLARE_TYPEINFO(KPlato::TimePoint, Q_PRIMITIVE_TYPE);
+
+#endif
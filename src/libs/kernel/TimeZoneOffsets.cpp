@@ -0,0 +1,151 @@
+/* This file is part of the KDE project
+ * SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+// clazy:excludeall=qstring-arg
+#include "TimeZoneOffsets.h"
+
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+
+#include <algorithm>
+
+namespace KPlato
+{
+
+static const qint64 s_msecsPerDay = 86400000;
+
+// Milliseconds from epoch to the local date/time, as if it was UTC
+static qint64 localMSecs(QDate date, QTime time)
+{
+    return (date.toJulianDay() - QDate(1970, 1, 1).toJulianDay()) * s_msecsPerDay + time.msecsSinceStartOfDay();
+}
+
+TimeZoneOffsets::TimeZoneOffsets()
+{
+}
+
+TimeZoneOffsets::TimeZoneOffsets(const QTimeZone &timeZone)
+{
+    Data *data = new Data();
+    data->timeZone = timeZone;
+    const QDateTime first(QDate(1970, 1, 1), QTime(0, 0), Qt::UTC);
+    const QDateTime last(QDate(2100, 1, 1), QTime(0, 0), Qt::UTC);
+    data->first = first.toMSecsSinceEpoch();
+    data->last = last.toMSecsSinceEpoch();
+    data->offsets << timeZone.offsetFromUtc(first);
+    const QTimeZone::OffsetDataList transitions = timeZone.transitions(first, last);
+    for (const QTimeZone::OffsetData &transition : transitions) {
+        if (transition.offsetFromUtc == data->offsets.last()) {
+            continue;
+        }
+        data->transitions << transition.atUtc.toMSecsSinceEpoch();
+        data->offsets << transition.offsetFromUtc;
+    }
+    m_data.reset(data);
+}
+
+TimeZoneOffsets TimeZoneOffsets::forTimeZone(const QTimeZone &timeZone)
+{
+    static QMutex mutex;
+    static QHash<QByteArray, TimeZoneOffsets> tables;
+
+    if (!timeZone.isValid()) {
+        return TimeZoneOffsets();
+    }
+    QMutexLocker locker(&mutex);
+    QHash<QByteArray, TimeZoneOffsets>::const_iterator it = tables.constFind(timeZone.id());
+    if (it != tables.constEnd()) {
+        return it.value();
+    }
+    const TimeZoneOffsets offsets(timeZone);
+    tables.insert(timeZone.id(), offsets);
+    return offsets;
+}
+
+QTimeZone TimeZoneOffsets::timeZone() const
+{
+    return m_data ? m_data->timeZone : QTimeZone();
+}
+
+int TimeZoneOffsets::offsetFromUtc(TimePoint time) const
+{
+    Q_ASSERT(isValid());
+    const qint64 msecs = time.toMSecsSinceEpoch();
+    if (msecs < m_data->first || msecs >= m_data->last) {
+        return m_data->timeZone.offsetFromUtc(QDateTime::fromMSecsSinceEpoch(msecs, Qt::UTC));
+    }
+    const QVector<qint64> &transitions = m_data->transitions;
+    const int i = std::upper_bound(transitions.constBegin(), transitions.constEnd(), msecs) - transitions.constBegin();
+    return m_data->offsets.at(i);
+}
+
+TimePoint TimeZoneOffsets::fromLocal(QDate date, QTime time) const
+{
+    Q_ASSERT(isValid());
+    if (!date.isValid() || !time.isValid()) {
+        return TimePoint();
+    }
+    const qint64 local = localMSecs(date, time);
+    // Offsets can only change once in a day, so the offset a day before (after)
+    // is the offset before (after) any transition near the local time
+    const int before = offsetFromUtc(TimePoint(local - s_msecsPerDay));
+    const TimePoint early(local - before * 1000LL);
+    if (offsetFromUtc(early) == before) {
+        return early;
+    }
+    const int after = offsetFromUtc(TimePoint(local + s_msecsPerDay));
+    const TimePoint late(local - after * 1000LL);
+    if (offsetFromUtc(late) == after) {
+        return late;
+    }
+    // Skipped by the transition, early is moved forward by the gap
+    return early;
+}
+
+// Milliseconds from epoch to the local date/time of time, as if it was UTC
+qint64 TimeZoneOffsets::toLocalMSecs(TimePoint time) const
+{
+    return time.toMSecsSinceEpoch() + offsetFromUtc(time) * 1000LL;
+}
+
+QDate TimeZoneOffsets::localDate(TimePoint time) const
+{
+    Q_ASSERT(isValid());
+    if (!time.isValid()) {
+        return QDate();
+    }
+    const qint64 local = toLocalMSecs(time);
+    qint64 days = local / s_msecsPerDay;
+    if (local % s_msecsPerDay < 0) {
+        --days;
+    }
+    return QDate::fromJulianDay(QDate(1970, 1, 1).toJulianDay() + days);
+}
+
+QTime TimeZoneOffsets::localTime(TimePoint time) const
+{
+    Q_ASSERT(isValid());
+    if (!time.isValid()) {
+        return QTime();
+    }
+    qint64 msecs = toLocalMSecs(time) % s_msecsPerDay;
+    if (msecs < 0) {
+        msecs += s_msecsPerDay;
+    }
+    return QTime::fromMSecsSinceStartOfDay(static_cast<int>(msecs));
+}
+
+DateTime TimeZoneOffsets::toDateTime(TimePoint time) const
+{
+    Q_ASSERT(isValid());
+    if (!time.isValid()) {
+        return DateTime();
+    }
+    return DateTime(QDateTime::fromMSecsSinceEpoch(time.toMSecsSinceEpoch(), m_data->timeZone));
+}
+
+} // namespace KPlato
@@ -0,0 +1,83 @@
+/* This file is part of the KDE project
+ * SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#ifndef TIMEZONEOFFSETS_H
+#define TIMEZONEOFFSETS_H
+
+#include "plankernel_export.h"
+
+#include "TimePoint.h"
+#include "kptdatetime.h"
+
+#include <QSharedPointer>
+#include <QTimeZone>
+#include <QVector>
+
+namespace KPlato
+{
+
+/**
+ * The offsets from UTC of a time zone as a table of transitions.
+ *
+ * Converting between local date/time and TimePoint is a binary search in the
+ * table instead of a time zone database lookup.
+ * The table covers the years 1970 - 2100, outside this range QTimeZone is used.
+ *
+ * Tables are shared between all users of the same time zone, see forTimeZone().
+ */
+class PLANKERNEL_EXPORT TimeZoneOffsets
+{
+public:
+    /// Create an invalid table
+    TimeZoneOffsets();
+
+    /// Return the (shared) table for @p timeZone
+    static TimeZoneOffsets forTimeZone(const QTimeZone &timeZone);
+
+    bool isValid() const { return !m_data.isNull(); }
+    QTimeZone timeZone() const;
+
+    /// Return the offset from UTC in seconds at @p time
+    int offsetFromUtc(TimePoint time) const;
+    /**
+     * Return the time point of the local @p date and @p time.
+     * A local time that is skipped when daylight time starts is moved forward,
+     * an ambiguous local time gives the first occurrence.
+     */
+    TimePoint fromLocal(QDate date, QTime time) const;
+    /// Return the local date of @p time
+    QDate localDate(TimePoint time) const;
+    /// Return the local time of day of @p time
+    QTime localTime(TimePoint time) const;
+    /**
+     * Return the local date/time of @p time as a DateTime in this time zone.
+     * This needs a time zone database lookup, so only use it for results
+     * that are handed to code outside the calculation.
+     */
+    DateTime toDateTime(TimePoint time) const;
+
+    /// Tables are shared, so this is true if both are tables of the same time zone
+    bool operator==(const TimeZoneOffsets &other) const { return m_data == other.m_data; }
+    bool operator!=(const TimeZoneOffsets &other) const { return m_data != other.m_data; }
+
+private:
+    explicit TimeZoneOffsets(const QTimeZone &timeZone);
+    qint64 toLocalMSecs(TimePoint time) const;
+
+private:
+    struct Data {
+        QTimeZone timeZone;
+        qint64 first; // the range covered by the table
+        qint64 last;
+        QVector<qint64> transitions; // utc msecs when the offset changes
+        QVector<int> offsets; // offsets[i] is valid from transitions[i - 1] until transitions[i]
+    };
+    QSharedPointer<const Data> m_data;
+};
+
+} // namespace KPlato
+
+#endif
@@ -48,7 +48,8 @@ public:
         SaveRelations = 0x4,
         SaveResources = 0x8,
         SaveRequests = 0x10,
-        SaveProject = 0x20
+        SaveProject = 0x20,
+        SaveStreamed = 0x40 ///< Child tasks and schedule managers are left out, see XmlStreamSaver
     };
     bool saveAll(const Project *project) const {
         Q_UNUSED(project);
@@ -66,6 +67,9 @@ public:
     }
     bool saveChildren(const Node *node) const {
         Q_UNUSED(node);
+        if (options & SaveStreamed) {
+            return false;
+        }
         if (options & SaveAll) {
             return true;
         }
@@ -77,6 +81,9 @@ public:
         }
         return (options & SaveSelectedNodes) && nodes.contains(relation->parent()) && nodes.contains(relation->child());
     }
+    bool saveStreamed() const {
+        return options & SaveStreamed;
+    }
     void save() const {
         Q_ASSERT(m_project);
         if (!m_project) {
@@ -0,0 +1,417 @@
+/* This file is part of the KDE project
+ * SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+// clazy:excludeall=qstring-arg
+#include "XmlStreamSaver.h"
+
+#include "XmlSaveContext.h"
+#include "AppointmentStream.h"
+#include "kptappointment.h"
+#include "kptproject.h"
+#include "kptschedule.h"
+#include "kptdebug.h"
+
+#include <KoXmlWriter.h>
+
+#include <QDomDocument>
+#include <QDomElement>
+#include <QDomNamedNodeMap>
+
+namespace KPlato
+{
+
+XmlStreamSaver::XmlStreamSaver(KoXmlWriter &writer)
+    : m_writer(writer)
+    , m_appointmentStream(nullptr)
+{
+}
+
+void XmlStreamSaver::setAppointmentStream(AppointmentStream *stream)
+{
+    m_appointmentStream = stream;
+}
+
+void XmlStreamSaver::save(Project *project)
+{
+    XmlSaveContext context(project);
+    context.options = XmlSaveContext::SaveAll | XmlSaveContext::SaveStreamed;
+    context.save(); // tasks and project-schedules are left empty
+
+    m_writer.startDocument("plan");
+    m_writer.addCompleteElement("<!DOCTYPE plan>\n");
+    QDomElement doc = context.document.documentElement();
+    if (m_appointmentStream) {
+        doc.setAttribute(QStringLiteral("appointments"), AppointmentStream::fileName());
+    }
+    const QByteArray tag = doc.tagName().toUtf8();
+    m_writer.startElement(tag.constData());
+    writeAttributes(m_writer, doc);
+    for (QDomNode n = doc.firstChild(); !n.isNull(); n = n.nextSibling()) {
+        if (n.isElement() && n.toElement().tagName() == QStringLiteral("project")) {
+            writeProject(project, n.toElement(), context);
+        } else {
+            writeNode(m_writer, n);
+        }
+    }
+    m_writer.endElement();
+    m_writer.endDocument();
+}
+
+void XmlStreamSaver::writeProject(const Project *project, const QDomElement &element, const XmlSaveContext &context)
+{
+    m_writer.startElement("project");
+    writeAttributes(m_writer, element);
+    for (QDomNode n = element.firstChild(); !n.isNull(); n = n.nextSibling()) {
+        const QString tag = n.isElement() ? n.toElement().tagName() : QString();
+        if (tag == QStringLiteral("tasks")) {
+            debugPlanXml<<"tasks:"<<project->numChildren();
+            m_writer.startElement("tasks");
+            writeAttributes(m_writer, n.toElement());
+            for (int i = 0; i < project->numChildren(); ++i) {
+                writeTask(project->childNode(i), context);
+            }
+            m_writer.endElement();
+        } else if (tag == QStringLiteral("project-schedules")) {
+            debugPlanXml<<"project-schedules:"<<project->scheduleManagers().count();
+            m_writer.startElement("project-schedules");
+            writeAttributes(m_writer, n.toElement());
+            const QList<ScheduleManager*> managers = project->scheduleManagers();
+            for (const ScheduleManager *sm : managers) {
+                writeScheduleManager(project, sm);
+            }
+            m_writer.endElement();
+        } else {
+            writeNode(m_writer, n);
+        }
+    }
+    m_writer.endElement();
+}
+
+void XmlStreamSaver::writeTask(const Node *node, const XmlSaveContext &context)
+{
+    // context has option SaveStreamed, so the child tasks are not included
+    QDomDocument document;
+    QDomElement parent = document.createElement(QStringLiteral("tasks"));
+    document.appendChild(parent);
+    node->save(parent, context);
+    const QDomElement element = parent.firstChildElement();
+    if (element.isNull()) {
+        return;
+    }
+    const QByteArray tag = element.tagName().toUtf8();
+    m_writer.startElement(tag.constData());
+    writeAttributes(m_writer, element);
+    writeChildren(m_writer, element);
+    for (int i = 0; i < node->numChildren(); ++i) {
+        writeTask(node->childNode(i), context);
+    }
+    m_writer.endElement();
+}
+
+void XmlStreamSaver::writeScheduleManager(const Project *project, const ScheduleManager *sm)
+{
+    QDomDocument document;
+    QDomElement parent = document.createElement(QStringLiteral("project-schedules"));
+    document.appendChild(parent);
+    const QDomElement element = sm->saveManagerXML(parent);
+    m_writer.startElement("schedule-management");
+    writeAttributes(m_writer, element);
+    for (QDomNode n = element.firstChild(); !n.isNull(); n = n.nextSibling()) {
+        if (n.isElement() && n.toElement().tagName() == QStringLiteral("project-schedule")) {
+            m_writer.startElement("project-schedule");
+            writeAttributes(m_writer, n.toElement());
+            writeChildren(m_writer, n.toElement());
+            writeAppointments(project, sm->expected()->id());
+            m_writer.endElement();
+        } else {
+            writeNode(m_writer, n);
+        }
+    }
+    const QList<ScheduleManager*> children = sm->children();
+    for (const ScheduleManager *child : children) {
+        writeScheduleManager(project, child);
+    }
+    m_writer.endElement();
+}
+
+// Same order as Node::saveAppointments()
+void XmlStreamSaver::writeAppointments(const Node *node, long id)
+{
+    if (node->type() != Node::Type_Project) {
+        const Schedule *s = node->findSchedule(id);
+        if (s) {
+            writeAppointments(s);
+        }
+    }
+    for (int i = 0; i < node->numChildren(); ++i) {
+        writeAppointments(node->childNode(i), id);
+    }
+}
+
+void XmlStreamSaver::writeAppointments(const Schedule *schedule)
+{
+    const QList<Appointment*> appointments = schedule->appointments();
+    for (const Appointment *a : appointments) {
+        if (a->resource() == nullptr || a->resource()->resource() == nullptr) {
+            errorPlan<<"Incomplete appointment data: No resource";
+            continue;
+        }
+        if (a->node() == nullptr || a->node()->node() == nullptr) {
+            errorPlan<<"Incomplete appointment data: No node";
+            continue;
+        }
+        writeAppointment(a->resource()->resource()->id(), a->node()->node()->id(), a->intervals());
+    }
+}
+
+// Same as Appointment::saveXML(), but the intervals are added to the appointment stream if there is one
+void XmlStreamSaver::writeAppointment(const QString &resourceId, const QString &taskId, const AppointmentIntervalList &intervals)
+{
+    m_writer.startElement("appointment");
+    m_writer.addAttribute("resource-id", resourceId);
+    m_writer.addAttribute("task-id", taskId);
+    if (m_appointmentStream) {
+        m_writer.addAttribute("intervals", m_appointmentStream->add(intervals));
+    } else {
+        // Same as AppointmentIntervalList::saveXML()
+        for (auto it = intervals.map().constBegin(); it != intervals.map().constEnd(); ++it) {
+            m_writer.startElement("appointment-interval");
+            m_writer.addAttribute("start", it.value().startTime().toString(Qt::ISODate));
+            m_writer.addAttribute("end", it.value().endTime().toString(Qt::ISODate));
+            m_writer.addAttribute("load", QString::number(it.value().load()));
+            m_writer.endElement();
+        }
+    }
+    m_writer.endElement();
+}
+
+void XmlStreamSaver::save(const XmlSnapshot &snapshot)
+{
+    m_writer.startDocument("plan");
+    m_writer.addCompleteElement("<!DOCTYPE plan>\n");
+    const QDomElement doc = snapshot.m_document.documentElement();
+    const QByteArray tag = doc.tagName().toUtf8();
+    m_writer.startElement(tag.constData());
+    writeAttributes(m_writer, doc);
+    if (m_appointmentStream) {
+        m_writer.addAttribute("appointments", AppointmentStream::fileName());
+    }
+    for (QDomNode n = doc.firstChild(); !n.isNull(); n = n.nextSibling()) {
+        if (n.isElement() && n.toElement().tagName() == QStringLiteral("project")) {
+            writeProject(snapshot, n.toElement());
+        } else {
+            writeNode(m_writer, n);
+        }
+    }
+    m_writer.endElement();
+    m_writer.endDocument();
+}
+
+void XmlStreamSaver::writeProject(const XmlSnapshot &snapshot, const QDomElement &element)
+{
+    m_writer.startElement("project");
+    writeAttributes(m_writer, element);
+    for (QDomNode n = element.firstChild(); !n.isNull(); n = n.nextSibling()) {
+        const QString tag = n.isElement() ? n.toElement().tagName() : QString();
+        if (tag == QStringLiteral("tasks")) {
+            m_writer.startElement("tasks");
+            writeAttributes(m_writer, n.toElement());
+            for (int i = 0; i < snapshot.m_tasks.count();) {
+                i = writeTask(snapshot, i);
+            }
+            m_writer.endElement();
+        } else if (tag == QStringLiteral("project-schedules")) {
+            m_writer.startElement("project-schedules");
+            writeAttributes(m_writer, n.toElement());
+            for (int i = 0; i < snapshot.m_managers.count();) {
+                i = writeScheduleManager(snapshot, i);
+            }
+            m_writer.endElement();
+        } else {
+            writeNode(m_writer, n);
+        }
+    }
+    m_writer.endElement();
+}
+
+// Write the task at @p index and its children, return the index of the next task
+int XmlStreamSaver::writeTask(const XmlSnapshot &snapshot, int index)
+{
+    const XmlSnapshot::Element &item = snapshot.m_tasks.at(index);
+    const QDomElement element = item.document.documentElement().firstChildElement();
+    const QByteArray tag = element.tagName().toUtf8();
+    m_writer.startElement(tag.constData());
+    writeAttributes(m_writer, element);
+    writeChildren(m_writer, element);
+    ++index;
+    for (int i = 0; i < item.children; ++i) {
+        index = writeTask(snapshot, index);
+    }
+    m_writer.endElement();
+    return index;
+}
+
+// Write the schedule manager at @p index and its children, return the index of the next manager
+int XmlStreamSaver::writeScheduleManager(const XmlSnapshot &snapshot, int index)
+{
+    const XmlSnapshot::Element &item = snapshot.m_managers.at(index);
+    const QDomElement element = item.document.documentElement().firstChildElement();
+    m_writer.startElement("schedule-management");
+    writeAttributes(m_writer, element);
+    for (QDomNode n = element.firstChild(); !n.isNull(); n = n.nextSibling()) {
+        if (n.isElement() && n.toElement().tagName() == QStringLiteral("project-schedule")) {
+            m_writer.startElement("project-schedule");
+            writeAttributes(m_writer, n.toElement());
+            writeChildren(m_writer, n.toElement());
+            const auto appointments = snapshot.m_appointments.constFind(item.scheduleId);
+            if (appointments != snapshot.m_appointments.constEnd()) {
+                for (const XmlSnapshot::AppointmentData &a : appointments.value()) {
+                    writeAppointment(a.resourceId, a.taskId, a.intervals);
+                }
+            }
+            m_writer.endElement();
+        } else {
+            writeNode(m_writer, n);
+        }
+    }
+    ++index;
+    for (int i = 0; i < item.children; ++i) {
+        index = writeScheduleManager(snapshot, index);
+    }
+    m_writer.endElement();
+    return index;
+}
+
+void XmlStreamSaver::writeAttributes(KoXmlWriter &writer, const QDomElement &element)
+{
+    const QDomNamedNodeMap attributes = element.attributes();
+    for (int i = 0; i < attributes.count(); ++i) {
+        const QDomAttr attr = attributes.item(i).toAttr();
+        writer.addAttribute(attr.name().toUtf8().constData(), attr.value());
+    }
+}
+
+void XmlStreamSaver::writeChildren(KoXmlWriter &writer, const QDomElement &element)
+{
+    for (QDomNode n = element.firstChild(); !n.isNull(); n = n.nextSibling()) {
+        writeNode(writer, n);
+    }
+}
+
+void XmlStreamSaver::writeNode(KoXmlWriter &writer, const QDomNode &node)
+{
+    if (node.isElement()) {
+        const QDomElement element = node.toElement();
+        // KoXmlWriter keeps a pointer to the tag name until endElement()
+        const QByteArray tag = element.tagName().toUtf8();
+        // Elements with text content are written without indentation, like QDomDocument does
+        const bool indent = !element.firstChild().isText();
+        writer.startElement(tag.constData(), indent);
+        writeAttributes(writer, element);
+        writeChildren(writer, element);
+        writer.endElement();
+    } else if (node.isText()) { // includes CDATA sections
+        writer.addTextNode(node.toText().data());
+    } else if (node.isProcessingInstruction()) {
+        const QDomProcessingInstruction pi = node.toProcessingInstruction();
+        writer.addProcessingInstruction(QString(pi.target() + QLatin1Char(' ') + pi.data()).toUtf8().constData());
+    }
+    // comments are not used in plan documents
+}
+
+//--------------------
+XmlSnapshot::XmlSnapshot()
+{
+}
+
+XmlSnapshot::XmlSnapshot(Project *project)
+{
+    XmlSaveContext context(project);
+    context.options = XmlSaveContext::SaveAll | XmlSaveContext::SaveStreamed;
+    context.save(); // tasks and project-schedules are left empty
+    m_document = context.document;
+    for (int i = 0; i < project->numChildren(); ++i) {
+        addTask(project->childNode(i), context);
+    }
+    const QList<ScheduleManager*> managers = project->scheduleManagers();
+    for (const ScheduleManager *sm : managers) {
+        addScheduleManager(project, sm);
+    }
+}
+
+bool XmlSnapshot::isNull() const
+{
+    return m_document.isNull();
+}
+
+// Same as XmlStreamSaver::writeTask()
+void XmlSnapshot::addTask(const Node *node, const XmlSaveContext &context)
+{
+    Element item;
+    QDomElement parent = item.document.createElement(QStringLiteral("tasks"));
+    item.document.appendChild(parent);
+    node->save(parent, context);
+    if (parent.firstChildElement().isNull()) {
+        return;
+    }
+    const int index = m_tasks.count();
+    m_tasks.append(item);
+    for (int i = 0; i < node->numChildren(); ++i) {
+        const int count = m_tasks.count();
+        addTask(node->childNode(i), context);
+        if (m_tasks.count() > count) {
+            ++m_tasks[index].children;
+        }
+    }
+}
+
+// Same as XmlStreamSaver::writeScheduleManager()
+void XmlSnapshot::addScheduleManager(const Project *project, const ScheduleManager *sm)
+{
+    Element item;
+    QDomElement parent = item.document.createElement(QStringLiteral("project-schedules"));
+    item.document.appendChild(parent);
+    sm->saveManagerXML(parent);
+    if (sm->expected()) {
+        item.scheduleId = sm->expected()->id();
+        if (!m_appointments.contains(item.scheduleId)) {
+            addAppointments(project, item.scheduleId, m_appointments[item.scheduleId]);
+        }
+    }
+    const QList<ScheduleManager*> children = sm->children();
+    item.children = children.count();
+    m_managers.append(item);
+    for (const ScheduleManager *child : children) {
+        addScheduleManager(project, child);
+    }
+}
+
+// Same as XmlStreamSaver::writeAppointments(), the intervals are implicitly shared
+void XmlSnapshot::addAppointments(const Node *node, long id, QVector<AppointmentData> &appointments)
+{
+    if (node->type() != Node::Type_Project) {
+        const Schedule *s = node->findSchedule(id);
+        if (s) {
+            const QList<Appointment*> list = s->appointments();
+            for (const Appointment *a : list) {
+                if (a->resource() == nullptr || a->resource()->resource() == nullptr) {
+                    errorPlan<<"Incomplete appointment data: No resource";
+                    continue;
+                }
+                if (a->node() == nullptr || a->node()->node() == nullptr) {
+                    errorPlan<<"Incomplete appointment data: No node";
+                    continue;
+                }
+                appointments.append({ a->resource()->resource()->id(), a->node()->node()->id(), a->intervals() });
+            }
+        }
+    }
+    for (int i = 0; i < node->numChildren(); ++i) {
+        addAppointments(node->childNode(i), id, appointments);
+    }
+}
+
+} // namespace KPlato
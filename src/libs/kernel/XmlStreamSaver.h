@@ -0,0 +1,132 @@
+/* This file is part of the KDE project
+ * SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#ifndef XMLSTREAMSAVER_H
+#define XMLSTREAMSAVER_H
+
+#include "plankernel_export.h"
+
+#include "kptappointment.h"
+
+#include <QDomDocument>
+#include <QHash>
+#include <QVector>
+
+class KoXmlWriter;
+class QDomElement;
+class QDomNode;
+
+namespace KPlato
+{
+
+class Project;
+class Node;
+class AppointmentStream;
+class ScheduleManager;
+class Schedule;
+class XmlSaveContext;
+
+/**
+ * A copy of what XmlStreamSaver writes of a project.
+ *
+ * The copy is taken in the thread that owns the project. Each task and schedule manager
+ * is saved to its own small QDomDocument, and the appointment intervals are
+ * implicitly shared with the project. Nothing refers to the project, so the copy
+ * can be written with XmlStreamSaver::save(const XmlSnapshot&) in another thread
+ * while the project is changed. Used by autosave.
+ */
+class PLANKERNEL_EXPORT XmlSnapshot
+{
+public:
+    XmlSnapshot();
+    explicit XmlSnapshot(Project *project);
+
+    bool isNull() const;
+
+private:
+    friend class XmlStreamSaver;
+
+    struct Element {
+        QDomDocument document;
+        /// Number of child elements that follow in preorder
+        int children = 0;
+        /// Id of the expected schedule of a schedule manager
+        long scheduleId = -1;
+    };
+    struct AppointmentData {
+        QString resourceId;
+        QString taskId;
+        AppointmentIntervalList intervals;
+    };
+
+    void addTask(const Node *node, const XmlSaveContext &context);
+    void addScheduleManager(const Project *project, const ScheduleManager *sm);
+    void addAppointments(const Node *node, long id, QVector<AppointmentData> &appointments);
+
+    /// The project without tasks and schedules
+    QDomDocument m_document;
+    /// Tasks and schedule managers in preorder
+    QVector<Element> m_tasks;
+    QVector<Element> m_managers;
+    /// Appointments per schedule id, in the order Node::saveAppointments() saves them
+    QHash<long, QVector<AppointmentData>> m_appointments;
+};
+
+/**
+ * Saves a project directly to a KoXmlWriter.
+ *
+ * The tasks and the schedules (with appointments) make up most of a project file.
+ * They are saved one task and one appointment list at a time into a small temporary
+ * QDomDocument that is written out and discarded, so the complete document is never held in memory.
+ * The rest of the project is saved with the usual save() methods.
+ *
+ * The content is the same as XmlSaveContext::save() with option XmlSaveContext::SaveAll.
+ * If an AppointmentStream is set, the appointment intervals are saved to the stream
+ * and the appointments refer to them by index, see setAppointmentStream().
+ */
+class PLANKERNEL_EXPORT XmlStreamSaver
+{
+public:
+    explicit XmlStreamSaver(KoXmlWriter &writer);
+
+    /**
+     * Save the appointment intervals to @p stream instead of as xml.
+     * The caller saves the stream to the store entry AppointmentStream::fileName().
+     */
+    void setAppointmentStream(AppointmentStream *stream);
+
+    /// Write the plan document of @p project
+    void save(Project *project);
+    /// Write the plan document of the project @p snapshot was taken of.
+    /// This can be called in any thread.
+    void save(const XmlSnapshot &snapshot);
+
+    /// Write @p node and its children
+    static void writeNode(KoXmlWriter &writer, const QDomNode &node);
+    /// Write the attributes of @p element, call after KoXmlWriter::startElement()
+    static void writeAttributes(KoXmlWriter &writer, const QDomElement &element);
+    /// Write the child nodes of @p element
+    static void writeChildren(KoXmlWriter &writer, const QDomElement &element);
+
+private:
+    void writeProject(const Project *project, const QDomElement &element, const XmlSaveContext &context);
+    void writeTask(const Node *node, const XmlSaveContext &context);
+    void writeScheduleManager(const Project *project, const ScheduleManager *sm);
+    void writeAppointments(const Node *node, long id);
+    void writeAppointments(const Schedule *schedule);
+    void writeAppointment(const QString &resourceId, const QString &taskId, const AppointmentIntervalList &intervals);
+    void writeProject(const XmlSnapshot &snapshot, const QDomElement &element);
+    int writeTask(const XmlSnapshot &snapshot, int index);
+    int writeScheduleManager(const XmlSnapshot &snapshot, int index);
+
+private:
+    KoXmlWriter &m_writer;
+    AppointmentStream *m_appointmentStream;
+};
+
+} // namespace KPlato
+
+#endif
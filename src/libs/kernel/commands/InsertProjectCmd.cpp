@@ -39,6 +39,7 @@ InsertProjectCmd::InsertProjectCmd(Project &fromProject, Node *parent, Node *aft
     , m_parent(parent)
     , m_after(after)
 {
+    setBatchProject(m_project);
 }
 
 void InsertProjectCmd::execute()
@@ -6,6 +6,7 @@
 
 // clazy:excludeall=qstring-arg
 #include "MacroCommand.h"
+#include "kptproject.h"
 #include "kptdebug.h"
 
 #include <QApplication>
@@ -25,14 +26,43 @@ void MacroCommand::addCommand(KUndo2Command *cmd)
     cmds.append(cmd);
 }
 
+qint64 MacroCommand::memoryCost() const
+{
+    qint64 cost = KUndo2Command::memoryCost();
+    for (const KUndo2Command *c : qAsConst(cmds)) {
+        cost += c->memoryCost();
+    }
+    return cost;
+}
+
+int MacroCommand::id() const
+{
+    return cmds.count() == 1 ? cmds.first()->id() : -1;
+}
+
+bool MacroCommand::mergeWith(const KUndo2Command *command)
+{
+    const MacroCommand *other = dynamic_cast<const MacroCommand*>(command);
+    if (!other || cmds.count() != 1 || other->cmds.count() != 1) {
+        return false;
+    }
+    return cmds.first()->mergeWith(other->cmds.first());
+}
+
 void MacroCommand::execute()
 {
     if (m_busyCursorEnabled) {
         QApplication::setOverrideCursor(Qt::BusyCursor);
     }
+    if (m_batchProject) {
+        m_batchProject->beginChanges();
+    }
     for (KUndo2Command *c : qAsConst(cmds)) {
         c->redo();
     }
+    if (m_batchProject) {
+        m_batchProject->endChanges();
+    }
     if (m_busyCursorEnabled) {
         QApplication::restoreOverrideCursor();
     }
@@ -43,9 +73,15 @@ void MacroCommand::unexecute()
     if (m_busyCursorEnabled) {
         QApplication::setOverrideCursor(Qt::BusyCursor);
     }
+    if (m_batchProject) {
+        m_batchProject->beginChanges();
+    }
     for (int i = cmds.count() - 1; i >= 0; --i) {
         cmds.at(i)->undo();
     }
+    if (m_batchProject) {
+        m_batchProject->endChanges();
+    }
     if (m_busyCursorEnabled) {
         QApplication::restoreOverrideCursor();
     }
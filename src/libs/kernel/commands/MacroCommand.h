@@ -13,7 +13,9 @@
 
 namespace KPlato
 {
-    
+
+class Project;
+
 class PLANKERNEL_EXPORT MacroCommand : public KUndo2Command
 {
 public:
@@ -32,10 +34,22 @@ public:
 
     bool isEmpty() const { return cmds.isEmpty(); }
 
+    qint64 memoryCost() const override;
+
+    /// A macro with one command can be merged with another such macro if the commands can be merged.
+    /// The id is the id of the command, so a macro and a bare command may have the same id,
+    /// mergeWith() of both must check the type of the other command.
+    int id() const override;
+    bool mergeWith(const KUndo2Command *command) override;
+
     void setBusyCursorEnabled(bool on) { m_busyCursorEnabled = on; }
 
+    /// Execute and unexecute the commands as one batch of changes to @p project, see Project::beginChanges()
+    void setBatchProject(Project *project) { m_batchProject = project; }
+
 protected:
     bool m_busyCursorEnabled = false;
+    Project *m_batchProject = nullptr;
     QList<KUndo2Command*> cmds;
 };
 
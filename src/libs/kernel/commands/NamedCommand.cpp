@@ -8,9 +8,14 @@
 #include "NamedCommand.h"
 #include "kptschedule.h"
 #include "kptappointment.h"
+#include "kptnode.h"
 #include "kptdebug.h"
 
 #include <QApplication>
+#include <QTime>
+
+// Commands pushed within this time (ms) of the previous one are merged
+static const int s_mergeInterval = 1500;
 
 
 using namespace KPlato;
@@ -45,3 +50,32 @@ void NamedCommand::addSchScheduled(Schedule *sch)
         }
     }
 }
+
+bool NamedCommand::isMergeable(const KUndo2Command *other)
+{
+    if (id() == -1 || other->id() != id()) {
+        return false;
+    }
+    const int elapsed = endTime().msecsTo(QTime::currentTime());
+    return elapsed >= 0 && elapsed < s_mergeInterval;
+}
+
+qint64 NamedCommand::nodeCost(const Node *node)
+{
+    qint64 cost = sizeof(Node) + (node->name().size() + node->description().size()) * sizeof(QChar);
+    const auto schedules = node->schedules();
+    for (const Schedule *s : schedules) {
+        cost += sizeof(Schedule);
+        const auto appointments = s->appointments();
+        for (const Appointment *a : appointments) {
+            cost += appointmentCost(a);
+        }
+    }
+    return cost;
+}
+
+qint64 NamedCommand::appointmentCost(const Appointment *appointment)
+{
+    const qint64 intervalCost = sizeof(QDate) + sizeof(AppointmentInterval) + 2 * sizeof(DateTime) + sizeof(double);
+    return sizeof(Appointment) + appointment->intervals().map().count() * intervalCost;
+}
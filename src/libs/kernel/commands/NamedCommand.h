@@ -19,10 +19,23 @@ namespace KPlato
 {
 
 class Schedule;
+class Node;
+class Appointment;
 
 class PLANKERNEL_EXPORT NamedCommand : public KUndo2Command
 {
 public:
+    /// Ids of commands that merge with a following command of the same kind, see KUndo2Command::id()
+    enum MergeId {
+        NodeModifyNameId = 1000,
+        NodeModifyLeaderId,
+        NodeModifyDescriptionId,
+        NodeModifyPriorityId,
+        ModifyEstimateId,
+        EstimateModifyOptimisticRatioId,
+        EstimateModifyPessimisticRatioId
+    };
+
     explicit NamedCommand(const KUndo2MagicString& name)
         : KUndo2Command(name)
     {}
@@ -33,6 +46,18 @@ public:
     virtual void unexecute() = 0;
 
 protected:
+    /**
+     * Return true if @p other has the same id as this command and is pushed
+     * within the merge interval after this command was executed or last merged.
+     * Typing into an editor or spinning a value then results in one undo step.
+     */
+    bool isMergeable(const KUndo2Command *other);
+
+    /// Return an estimate of the memory used by @p node itself, not including child nodes
+    static qint64 nodeCost(const Node *node);
+    /// Return an estimate of the memory used by @p appointment
+    static qint64 appointmentCost(const Appointment *appointment);
+
     /// Set all scheduled in the m_schedules map to their original scheduled state
     void setSchScheduled();
     /// Set all schedules in the m_schedules map to scheduled state @p state
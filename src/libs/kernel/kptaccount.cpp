@@ -9,6 +9,9 @@
 
 #include "kptduration.h"
 #include "kptproject.h"
+#include "kptappointment.h"
+#include "kptschedule.h"
+#include "AppointmentStore.h"
 #include "kptdebug.h"
 
 #include <KoXmlReader.h>
@@ -16,6 +19,9 @@
 #include <KLocalizedString>
 
 #include <QDate>
+#include <QtConcurrent>
+
+#include <functional>
 
 namespace KPlato
 {
@@ -374,8 +380,50 @@ EffortCostMap Account::plannedCost(const QDate &start, const QDate &end, long id
             ec += a->plannedCost(start, end, id);
         }
     }
+    ec += ownPlannedCost(start, end, id);
+    return ec;
+}
+
+// Planned effort and cost per day of @p schedule, from @p store if it holds all the appointments
+static EffortCostMap plannedPrDay(const AppointmentStore &store, const Schedule *schedule, const QDate &start, const QDate &end)
+{
+    EffortCostMap ec;
+    if (schedule == nullptr) {
+        return ec;
+    }
+    const QList<Appointment*> appointments = schedule->appointments();
+    if (store.isValid() && store.appointmentCount(schedule) == appointments.count()) {
+        return store.plannedPrDay(schedule, start, end);
+    }
+    for (const Appointment *a : appointments) {
+        ec += a->plannedPrDay(start, end);
+    }
+    return ec;
+}
+
+static EffortCostMap plannedPrDay(const AppointmentStore &store, const Node *node, const QDate &start, const QDate &end, long id)
+{
+    if (node->numChildren() > 0) {
+        EffortCostMap ec;
+        const QList<Node*> nodes = node->childNodeIterator();
+        for (const Node *n : nodes) {
+            ec += plannedPrDay(store, n, start, end, id);
+        }
+        return ec;
+    }
+    return plannedPrDay(store, node->schedule(id), start, end);
+}
+
+EffortCostMap Account::ownPlannedCost(const QDate &start, const QDate &end, long id) const
+{
+    return ownPlannedCost(m_list ? m_list->appointmentStore(id) : AppointmentStore(), start, end, id);
+}
+
+EffortCostMap Account::ownPlannedCost(const AppointmentStore &store, const QDate &start, const QDate &end, long id) const
+{
+    EffortCostMap ec;
     for (Account::CostPlace *cp : qAsConst(m_costPlaces)) {
-        ec += plannedCost(*cp, start, end, id);
+        ec += plannedCost(store, *cp, start, end, id);
     }
     if (isDefaultAccount()) {
         const QList<Node*> list = m_list == nullptr ? QList<Node*>() : m_list->allNodes();
@@ -384,7 +432,7 @@ EffortCostMap Account::plannedCost(const QDate &start, const QDate &end, long id
                 continue;
             }
             if (n->runningAccount() == nullptr) {
-                ec += n->plannedEffortCostPrDay(start, end, id);
+                ec += plannedPrDay(store, n, start, end, id);
             }
             if (n->startupAccount() == nullptr) {
                 if ((! start.isValid() || n->startTime(id).date() >= start) &&
@@ -404,13 +452,18 @@ EffortCostMap Account::plannedCost(const QDate &start, const QDate &end, long id
 }
 
 EffortCostMap Account::plannedCost(const Account::CostPlace &cp, const QDate &start, const QDate &end, long id) const
+{
+    return plannedCost(m_list ? m_list->appointmentStore(id) : AppointmentStore(), cp, start, end, id);
+}
+
+EffortCostMap Account::plannedCost(const AppointmentStore &store, const Account::CostPlace &cp, const QDate &start, const QDate &end, long id) const
 {
     EffortCostMap ec;
     if (cp.node()) {
         Node &node = *(cp.node());
         //debugPlan<<"n="<<n->name();
         if (cp.running()) {
-            ec += node.plannedEffortCostPrDay(start, end, id);
+            ec += plannedPrDay(store, &node, start, end, id);
         }
         if (cp.startup()) {
             if ((! start.isValid() || node.startTime(id).date() >= start) &&
@@ -426,7 +479,7 @@ EffortCostMap Account::plannedCost(const Account::CostPlace &cp, const QDate &st
         }
     } else if (cp.resource()) {
         if (cp.running()) {
-            ec += cp.resource()->plannedEffortCostPrDay(start, end, id);
+            ec += plannedPrDay(store, cp.resource()->findSchedule(id), start, end);
         }
     }
     return ec;
@@ -445,6 +498,13 @@ EffortCostMap Account::actualCost(const QDate &start, const QDate &end, long id)
             ec += a->actualCost(start, end, id);
         }
     }
+    ec += ownActualCost(start, end, id);
+    return ec;
+}
+
+EffortCostMap Account::ownActualCost(const QDate &start, const QDate &end, long id) const
+{
+    EffortCostMap ec;
     const auto costs = costPlaces();
     for (Account::CostPlace *cp : costs) {
         ec += actualCost(*cp, start, end, id);
@@ -735,6 +795,52 @@ EffortCostMap Accounts::actualCost(const Account &account, const QDate &start, c
     return account.actualCost(start, end, id);
 }
 
+// Add the cost of the sub-accounts of @p account to its own cost in @p costs
+static EffortCostMap addSubAccountCosts(const Account *account, QHash<const Account*, EffortCostMap> &costs)
+{
+    EffortCostMap ec = costs.value(account);
+    for (const Account *a : account->accountList()) {
+        ec += addSubAccountCosts(a, costs);
+    }
+    costs.insert(account, ec);
+    return ec;
+}
+
+QHash<const Account*, EffortCostMap> Accounts::plannedCosts(const QDate &start, const QDate &end, long id) const
+{
+    const QList<Account*> accounts = allAccounts();
+    // The store is built here, the workers only read the shared copy
+    const AppointmentStore store = appointmentStore(id);
+    const std::function<EffortCostMap(const Account*)> calculate = [&store, start, end, id](const Account *a) {
+        return a->ownPlannedCost(store, start, end, id);
+    };
+    const QList<EffortCostMap> own = QtConcurrent::blockingMapped<QList<EffortCostMap>>(accounts, calculate);
+    QHash<const Account*, EffortCostMap> costs;
+    costs.reserve(accounts.count());
+    for (int i = 0; i < accounts.count(); ++i) {
+        costs.insert(accounts.at(i), own.at(i));
+    }
+    for (const Account *a : m_accountList) {
+        addSubAccountCosts(a, costs);
+    }
+    return costs;
+}
+
+QHash<const Account*, EffortCostMap> Accounts::actualCosts(const QDate &start, const QDate &end, long id) const
+{
+    // Completion is not safe to access concurrently
+    QHash<const Account*, EffortCostMap> costs;
+    const QList<Account*> accounts = allAccounts();
+    costs.reserve(accounts.count());
+    for (const Account *a : accounts) {
+        costs.insert(a, a->ownActualCost(start, end, id));
+    }
+    for (const Account *a : m_accountList) {
+        addSubAccountCosts(a, costs);
+    }
+    return costs;
+}
+
 void Accounts::insert(Account *account, Account *parent, int index) {
     Q_ASSERT(account);
     if (parent == nullptr) {
@@ -937,6 +1043,12 @@ QList<Node*> Accounts::allNodes() const
     return m_project.allNodes();
 }
 
+AppointmentStore Accounts::appointmentStore(long id) const
+{
+    const Schedule *s = m_project.schedule(id);
+    return s ? s->appointmentStore() : AppointmentStore();
+}
+
 #ifndef NDEBUG
 void Accounts::printDebug(const QString& indent) {
     debugPlan<<indent<<"Accounts:"<<this<<m_accountList.count()<<" children";
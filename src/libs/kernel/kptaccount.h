@@ -11,6 +11,7 @@
 #include "plankernel_export.h"
 
 #include <QMap>
+#include <QHash>
 #include <QList>
 
 #include "kptglobal.h"
@@ -28,6 +29,7 @@ namespace KPlato
 
 class Accounts;
 class Account;
+class AppointmentStore;
 
 
 /**
@@ -177,9 +179,20 @@ public:
 
     EffortCostMap actualCost(long id = BASELINESCHEDULE) const;
     EffortCostMap actualCost(const QDate &start, const QDate &end, long id = BASELINESCHEDULE) const;
+
+    /// Return the planned cost from the cost places of this account, sub-accounts are not included
+    EffortCostMap ownPlannedCost(const QDate &start, const QDate &end, long id = BASELINESCHEDULE) const;
+    /**
+     * Return the planned cost from the cost places of this account, sub-accounts are not included.
+     * Appointments are read from @p store, so this can be called for several accounts concurrently.
+     */
+    EffortCostMap ownPlannedCost(const AppointmentStore &store, const QDate &start, const QDate &end, long id) const;
+    /// Return the actual cost from the cost places of this account, sub-accounts are not included
+    EffortCostMap ownActualCost(const QDate &start, const QDate &end, long id = BASELINESCHEDULE) const;
     
 protected:
     EffortCostMap plannedCost(const CostPlace &cp, const QDate &start, const QDate &end, long id) const;
+    EffortCostMap plannedCost(const AppointmentStore &store, const CostPlace &cp, const QDate &start, const QDate &end, long id) const;
     EffortCostMap actualCost(const Account::CostPlace &cp, const QDate &start, const QDate &end, long id) const;
 
 private:
@@ -227,6 +240,18 @@ public:
     /// Return the actual cost from all cost places of this account added to cost from all sub-accounts
     /// for the interval @p start to @p end inclusive
     EffortCostMap actualCost(const Account &account, const QDate &start, const QDate &end, long id = BASELINESCHEDULE) const;
+
+    /**
+     * Return the planned cost of all accounts for the interval @p start to @p end inclusive.
+     * The cost places of the accounts are calculated concurrently,
+     * and each sub-account is only calculated once.
+     */
+    QHash<const Account*, EffortCostMap> plannedCosts(const QDate &start = QDate(), const QDate &end = QDate(), long id = BASELINESCHEDULE) const;
+    /**
+     * Return the actual cost of all accounts for the interval @p start to @p end inclusive.
+     * Each sub-account is only calculated once.
+     */
+    QHash<const Account*, EffortCostMap> actualCosts(const QDate &start = QDate(), const QDate &end = QDate(), long id = BASELINESCHEDULE) const;
     
     void clear() { m_accountList.clear(); m_idDict.clear(); }
     void insert(Account *account, Account *parent=nullptr, int index = -1);
@@ -258,6 +283,8 @@ public:
     void accountChanged(Account *account);
     QList<Account*> allAccounts() const { return m_idDict.values(); }
     QList<Node*> allNodes() const;
+    /// Return the appointment store of the main schedule with @p id
+    AppointmentStore appointmentStore(long id) const;
     
 Q_SIGNALS:
     void accountAdded(const KPlato::Account*);
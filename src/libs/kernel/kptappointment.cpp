@@ -26,6 +26,18 @@ namespace KPlato
 
 class Resource;
 
+// Return @p time as a DateTime in @p timeZone
+static DateTime toDateTime(const TimeZoneOffsets &timeZone, TimePoint time)
+{
+    if (!time.isValid()) {
+        return DateTime();
+    }
+    if (!timeZone.isValid()) {
+        return DateTime(QDateTime::fromMSecsSinceEpoch(time.toMSecsSinceEpoch()));
+    }
+    return timeZone.toDateTime(time);
+}
+
 AppointmentInterval::AppointmentInterval()
     : d(new AppointmentIntervalData())
 {
@@ -68,33 +80,69 @@ AppointmentInterval::AppointmentInterval(QDate date, const TimeInterval& timeInt
 #endif
 }
 
+AppointmentInterval::AppointmentInterval(const TimeZoneOffsets &timeZone, TimePoint start, TimePoint end, double load)
+    : d(new AppointmentIntervalData())
+{
+    d->timeZone = timeZone;
+    d->start = start;
+    d->end = end;
+    d->load = load;
+}
+
 AppointmentInterval::~AppointmentInterval() {
     //debugPlan<<this;
 }
 
-const DateTime &AppointmentInterval::startTime() const
+DateTime AppointmentInterval::startTime() const
 {
-    return d->start;
+    return toDateTime(d->timeZone, d->start);
 }
+
 void AppointmentInterval::setStartTime(const DateTime &time)
 {
-    if (d->start != time) {
-        d->start = time;
+    if (time.isValid() && !d->timeZone.isValid()) {
+        d->timeZone = TimeZoneOffsets::forTimeZone(time.timeZone());
     }
+    d->start = TimePoint::fromDateTime(time);
 }
 
-const DateTime &AppointmentInterval::endTime() const
+DateTime AppointmentInterval::endTime() const
 {
-    return d->end;
+    return toDateTime(d->timeZone, d->end);
 }
 
 void AppointmentInterval::setEndTime(const DateTime &time)
+{
+    if (time.isValid() && !d->timeZone.isValid()) {
+        d->timeZone = TimeZoneOffsets::forTimeZone(time.timeZone());
+    }
+    d->end = TimePoint::fromDateTime(time);
+}
+
+void AppointmentInterval::setStart(TimePoint time)
+{
+    if (d->start != time) {
+        d->start = time;
+    }
+}
+
+void AppointmentInterval::setEnd(TimePoint time)
 {
     if (d->end != time) {
         d->end = time;
     }
 }
 
+QDate AppointmentInterval::startDate() const
+{
+    return d->timeZone.isValid() ? d->timeZone.localDate(d->start) : startTime().date();
+}
+
+QDate AppointmentInterval::endDate() const
+{
+    return d->timeZone.isValid() ? d->timeZone.localDate(d->end) : endTime().date();
+}
+
 double AppointmentInterval::load() const
 {
     return d->load;
@@ -109,52 +157,56 @@ void AppointmentInterval::setLoad(double load)
 
 QTimeZone AppointmentInterval::timeZone() const
 {
-    return d->start.timeZone();
+    return d->timeZone.isValid() ? d->timeZone.timeZone() : QTimeZone::systemTimeZone();
 }
 
 AppointmentInterval &AppointmentInterval::toTimeZone(const QTimeZone &tz)
 {
-    if (d->start.timeZone() != tz) {
-        d->start = d->start.toTimeZone(tz);
+    if (!d->timeZone.isValid() || d->timeZone.timeZone() != tz) {
+        d->timeZone = TimeZoneOffsets::forTimeZone(tz);
     }
-    if (d->end.timeZone() != tz) {
-        d->end = d->end.toTimeZone(tz);
+    return *this;
+}
+
+AppointmentInterval &AppointmentInterval::toTimeZone(const TimeZoneOffsets &timeZone)
+{
+    // the time points are the same in all time zones
+    if (d->timeZone != timeZone) {
+        d->timeZone = timeZone;
     }
     return *this;
 }
 
 Duration AppointmentInterval::effort() const
 {
-    return (d->end - d->start) * d->load / 100;
+    if (!d->start.isValid() || !d->end.isValid()) {
+        return Duration::zeroDuration;
+    }
+    return Duration(qAbs(d->start.msecsTo(d->end))) * d->load / 100;
 }
 
 Duration AppointmentInterval::effort(const DateTime &start, const DateTime &end) const {
-    if (start >= d->end || end <= d->start) {
+    return effort(TimePoint::fromDateTime(start), TimePoint::fromDateTime(end));
+}
+
+Duration AppointmentInterval::effort(TimePoint start, TimePoint end) const {
+    const TimePoint e = end.isValid() && end < d->end ? end : d->end;
+    if (start >= d->end || e <= d->start) {
         return Duration::zeroDuration;
     }
-    DateTime s = (start > d->start ? start : d->start);
-    DateTime e = (end < d->end ? end : d->end);
-    return (e - s) * d->load / 100;
+    const TimePoint s = start > d->start ? start : d->start;
+    return Duration(s.msecsTo(e)) * d->load / 100;
 }
 
 Duration AppointmentInterval::effort(QDate time, bool upto) const {
-    DateTime t(time);
+    const TimePoint t = TimePoint::fromDateTime(DateTime(time));
     //debugPlan<<time<<upto<<t<<d->start<<d->end;
     if (upto) {
-        if (t <= d->start) {
-            return Duration::zeroDuration;
-        }
-        DateTime e = (t < d->end ? t : d->end);
-        Duration eff = (e - d->start) * d->load / 100;
-        //debugPlan<<d->toString();
-        return eff;
+        // from start till time
+        return effort(TimePoint(), t);
     }
     // from time till end
-    if (t >= d->end) {
-        return Duration::zeroDuration;
-    }
-    DateTime s = (t > d->start ? t : d->start);
-    return (d->end - s) * d->load / 100;
+    return effort(t, TimePoint());
 }
 
 bool AppointmentInterval::loadXML(KoXmlElement &element, XMLLoaderObject &status) {
@@ -162,16 +214,14 @@ bool AppointmentInterval::loadXML(KoXmlElement &element, XMLLoaderObject &status
     bool ok;
     QString s = element.attribute(QStringLiteral("start"));
     if (!s.isEmpty())
-        d->start = DateTime::fromString(s, status.projectTimeZone());
+        setStartTime(DateTime::fromString(s, status.projectTimeZone()));
     s = element.attribute(QStringLiteral("end"));
     if (!s.isEmpty())
-        d->end = DateTime::fromString(s, status.projectTimeZone());
+        setEndTime(DateTime::fromString(s, status.projectTimeZone()));
     d->load = element.attribute(QStringLiteral("load"), QStringLiteral("100")).toDouble(&ok);
     if (!ok) d->load = 100;
     if (! isValid()) {
         errorPlan<<"AppointmentInterval::loadXML: Invalid interval:"<<*this<<element.attribute(QStringLiteral("start"))<<element.attribute(QStringLiteral("end"));
-    } else {
-        Q_ASSERT(d->start.timeZone() == d->end.timeZone());
     }
     return isValid();
 }
@@ -182,8 +232,8 @@ void AppointmentInterval::saveXML(QDomElement &element) const
     QDomElement me = element.ownerDocument().createElement(QStringLiteral("appointment-interval"));
     element.appendChild(me);
 
-    me.setAttribute(QStringLiteral("start"), d->start.toString(Qt::ISODate));
-    me.setAttribute(QStringLiteral("end"), d->end.toString(Qt::ISODate));
+    me.setAttribute(QStringLiteral("start"), startTime().toString(Qt::ISODate));
+    me.setAttribute(QStringLiteral("end"), endTime().toString(Qt::ISODate));
     me.setAttribute(QStringLiteral("load"), QString::number(d->load));
 }
 
@@ -192,13 +242,18 @@ bool AppointmentInterval::isValid() const {
 }
 
 AppointmentInterval AppointmentInterval::firstInterval(const AppointmentInterval &interval, const DateTime &from) const {
+    return firstInterval(interval, TimePoint::fromDateTime(from));
+}
+
+AppointmentInterval AppointmentInterval::firstInterval(const AppointmentInterval &interval, TimePoint from) const {
     //debugPlan<<interval.startTime().toString()<<" -"<<interval.endTime().toString()<<" from="<<from.toString();
-    DateTime f = from;
-    DateTime s1 = d->start;
-    DateTime e1 = d->end;
-    DateTime s2 = interval.startTime();
-    DateTime e2 = interval.endTime();
+    const TimePoint f = from;
+    TimePoint s1 = d->start;
+    const TimePoint e1 = d->end;
+    TimePoint s2 = interval.d->start;
+    const TimePoint e2 = interval.d->end;
     AppointmentInterval a;
+    a.d->timeZone = d->timeZone;
     if (f.isValid() && f >= e1 && f >= e2) {
         return a;
     }
@@ -212,27 +267,27 @@ AppointmentInterval AppointmentInterval::firstInterval(const AppointmentInterval
     }
 
     if (s1 < s2) {
-        a.setStartTime(s1);
+        a.setStart(s1);
         if (e1 <= s2) {
-            a.setEndTime(e1);
+            a.setEnd(e1);
         } else {
-            a.setEndTime(s2);
+            a.setEnd(s2);
         }
         a.setLoad(d->load);
     } else if (s1 > s2) {
-        a.setStartTime(s2);
+        a.setStart(s2);
         if (e2 <= s1) {
-            a.setEndTime(e2);
+            a.setEnd(e2);
         } else {
-            a.setEndTime(s1);
+            a.setEnd(s1);
         }
         a.setLoad(interval.load());
     } else {
-        a.setStartTime(s1);
+        a.setStart(s1);
         if (e1 <= e2)
-            a.setEndTime(e1);
+            a.setEnd(e1);
         else
-            a.setEndTime(e2);
+            a.setEnd(e2);
         a.setLoad(d->load + interval.load());
     }
     //debugPlan<<a.startTime().toString()<<" -"<<a.endTime().toString()<<" load="<<a.load();
@@ -276,25 +331,25 @@ bool AppointmentInterval::intersects(const AppointmentInterval &other) const
 
 AppointmentInterval AppointmentInterval::interval(const DateTime &start, const DateTime &end) const
 {
-    // TODO: Find and fix those that call with "wrong" timezone
-    const DateTime s = start.toTimeZone(d->start.timeZone());
-    const DateTime e = end.toTimeZone(d->end.timeZone());
-    if (s <= d->start && e >= d->end) {
+    return interval(TimePoint::fromDateTime(start), TimePoint::fromDateTime(end));
+}
+
+AppointmentInterval AppointmentInterval::interval(TimePoint start, TimePoint end) const
+{
+    if (start <= d->start && end >= d->end) {
         return *this;
     }
-    return AppointmentInterval(qMax(s, d->start), qMin(e, d->end), d->load);
+    return AppointmentInterval(d->timeZone, qMax(start, d->start), qMin(end, d->end), d->load);
 }
 
 bool AppointmentInterval::merge(const AppointmentInterval &interval)
 {
     if (isConticuousTo(interval)) {
-        const DateTime s = interval.d->start.toTimeZone(d->start.timeZone());
-        const DateTime e = interval.d->end.toTimeZone(d->end.timeZone());
-        if (s < d->start) {
-            d->start = s;
+        if (interval.d->start < d->start) {
+            d->start = interval.d->start;
         }
-        if (e > d->end) {
-            d->end = e;
+        if (interval.d->end > d->end) {
+            d->end = interval.d->end;
         }
         return true;
     }
@@ -308,7 +363,7 @@ bool AppointmentInterval::isConticuousTo(const AppointmentInterval &other) const
 
 QString AppointmentInterval::toString() const
 {
-    return QStringLiteral("%1 - %2, %3%").arg(d->start.toString(Qt::ISODate)).arg(d->end.toString(Qt::ISODate)).arg(d->load);
+    return QStringLiteral("%1 - %2, %3%").arg(startTime().toString(Qt::ISODate)).arg(endTime().toString(Qt::ISODate)).arg(d->load);
 }
 
 QDebug operator<<(QDebug dbg, const KPlato::AppointmentInterval &i)
@@ -341,10 +396,18 @@ QTimeZone AppointmentIntervalList::timeZone() const
 
 AppointmentIntervalList &AppointmentIntervalList::toTimeZone(const QTimeZone &tz)
 {
+    if (m_map.isEmpty()) {
+        return *this;
+    }
+    const TimeZoneOffsets timeZone = TimeZoneOffsets::forTimeZone(tz);
+    if (m_map.first().timeZoneOffsets() == timeZone) {
+        // all intervals are in the same time zone, see add()
+        return *this;
+    }
+    // the dates change, so the intervals must be split again
     AppointmentIntervalList m;
     for (const auto &interval : qAsConst(m_map)) {
-        const AppointmentInterval i(interval.startTime().toTimeZone(tz), interval.endTime().toTimeZone(tz), interval.load());
-        m.add(i);
+        m.add(AppointmentInterval(timeZone, interval.start(), interval.end(), interval.load()));
     }
     m_map = m.m_map;
     return *this;
@@ -392,12 +455,16 @@ void AppointmentIntervalList::subtract(const AppointmentInterval &interval)
     if (! interval.isValid()) {
         return;
     }
-    const DateTime st = interval.startTime();
-    const DateTime et = interval.endTime();
+    const TimeZoneOffsets tz = m_map.first().timeZoneOffsets();
+    const TimePoint st = interval.start();
+    const TimePoint et = interval.end();
     Q_ASSERT(st < et);
     const double load = interval.load();
+    // the dates of the intervals in this list
+    const QDate first = tz.isValid() ? tz.localDate(st) : interval.startDate();
+    const QDate last = tz.isValid() ? tz.localDate(et) : interval.endDate();
 //     debugPlan<<"subtract:"<<*this<<'\n'<<"minus"<<interval;
-    for (QDate date = st.date(); date <= et.date(); date = date.addDays(1)) {
+    for (QDate date = first; date <= last; date = date.addDays(1)) {
         if (! m_map.contains(date)) {
             continue;
         }
@@ -413,29 +480,29 @@ void AppointmentIntervalList::subtract(const AppointmentInterval &interval)
             }
             if (vi < interval) {
                 //debugPlan<<"subtract: vi<interval"<<vi<<interval;
-                if (vi.startTime() < st) {
-                    l.insert(0, AppointmentInterval(vi.startTime(), st, vi.load()));
+                if (vi.start() < st) {
+                    l.insert(0, AppointmentInterval(tz, vi.start(), st, vi.load()));
                     //if (! l.at(0).isValid()) { debugPlan<<vi<<interval<<l.at(0); qFatal("Invalid interval"); }
                 }
                 if (vi.load() > load) {
-                    l.insert(0, AppointmentInterval(st, qMin(vi.endTime(), et), vi.load() - load));
+                    l.insert(0, AppointmentInterval(tz, st, qMin(vi.end(), et), vi.load() - load));
                     //if (! l.at(0).isValid()) { debugPlan<<vi<<interval<<l.at(0); qFatal("Invalid interval"); }
                 }
             } else if (interval < vi) {
                 //debugPlan<<"subtract: interval<vi"<<vi<<interval;
                 if (vi.load() > load) {
                     //debugPlan<<"subtract: interval<vi vi.load > load"<<vi.load()<<load;
-                    l.insert(0, AppointmentInterval(vi.startTime(), qMin(vi.endTime(), et), vi.load() - load));
+                    l.insert(0, AppointmentInterval(tz, vi.start(), qMin(vi.end(), et), vi.load() - load));
                     //if (! l.at(0).isValid()) { debugPlan<<vi<<interval<<l.at(0); qFatal("Invalid interval"); }
                 }
-                if (et < vi.endTime()) {
+                if (et < vi.end()) {
                     //debugPlan<<"subtract: interval<vi et < vi.endTime"<<et<<vi.endTime();
-                    l.insert(0, AppointmentInterval(et, vi.endTime(), vi.load()));
+                    l.insert(0, AppointmentInterval(tz, et, vi.end(), vi.load()));
                     //if (! l.at(0).isValid()) { debugPlan<<vi<<interval<<l.at(0); qFatal("Invalid interval"); }
                 }
             } else if (vi.load() > load) {
                 //debugPlan<<"subtract: vi==interval"<<vi<<interval;
-                l.insert(0, AppointmentInterval(st, et, vi.load() - load));
+                l.insert(0, AppointmentInterval(tz, st, et, vi.load() - load));
                 //if (! l.at(0).isValid()) { debugPlan<<vi<<interval<<l.at(0); qFatal("Invalid interval"); }
             }
         }
@@ -460,13 +527,20 @@ AppointmentIntervalList &AppointmentIntervalList::operator+=(const AppointmentIn
 }
 
 AppointmentIntervalList AppointmentIntervalList::extractIntervals(const DateTime &start, const DateTime &end) const
+{
+    return extractIntervals(TimePoint::fromDateTime(start), TimePoint::fromDateTime(end));
+}
+
+AppointmentIntervalList AppointmentIntervalList::extractIntervals(TimePoint start, TimePoint end) const
 {
     if (isEmpty()) {
         return AppointmentIntervalList();
     }
+    const TimeZoneOffsets tz = m_map.first().timeZoneOffsets();
     QList<AppointmentInterval> ilst;
-    QMultiMap<QDate, AppointmentInterval>::const_iterator it = m_map.lowerBound(start.date());
-    for (; it != m_map.constEnd() && it.key() <= end.date(); ++it) {
+    QMultiMap<QDate, AppointmentInterval>::const_iterator it = tz.isValid() ? m_map.lowerBound(tz.localDate(start)) : m_map.constBegin();
+    const QDate last = tz.isValid() ? tz.localDate(end) : m_map.lastKey();
+    for (; it != m_map.constEnd() && it.key() <= last; ++it) {
         AppointmentInterval i = it.value().interval(start, end);
         if (i.isValid()) {
             ilst.append(i);
@@ -475,7 +549,7 @@ AppointmentIntervalList AppointmentIntervalList::extractIntervals(const DateTime
     QMultiMap<QDate, AppointmentInterval> lst;
     while (!ilst.isEmpty()) {
         auto i = ilst.takeLast();
-        lst.insert(i.startTime().date(), i);
+        lst.insert(i.startDate(), i);
     }
     return AppointmentIntervalList(lst);
 }
@@ -494,34 +568,35 @@ void AppointmentIntervalList::add(const AppointmentInterval &ai)
     }
     auto interval = ai;
     if (!isEmpty()) {
-        interval.toTimeZone(m_map.first().timeZone());
+        interval.toTimeZone(m_map.first().timeZoneOffsets());
     }
-    QDate date = interval.startTime().date();
-    QDate ed =  interval.endTime().date();
+    const TimeZoneOffsets tz = interval.timeZoneOffsets();
+    QDate date = interval.startDate();
+    QDate ed =  interval.endDate();
     int load = interval.load();
 
     QList<AppointmentInterval> lst;
-    if (date == ed) {
+    if (date == ed || !tz.isValid()) {
         lst << interval;
     } else {
         // split intervals into separate dates
-        const auto tz = interval.timeZone();
-        QTime t1 = interval.startTime().time();
+        TimePoint t1 = interval.start();
         while (date < ed) {
-            lst << AppointmentInterval(DateTime(date, t1, tz), DateTime(date.addDays(1), QTime(0, 0), tz), load);
+            const TimePoint midnight = tz.fromLocal(date.addDays(1), QTime(0, 0));
+            lst << AppointmentInterval(tz, t1, midnight, load);
             //debugPlan<<"split:"<<date<<lst.last();
             Q_ASSERT_X(lst.last().isValid(), "Split", "Invalid interval");
             date = date.addDays(1);
-            t1 = QTime();
+            t1 = midnight;
         }
-        if (interval.endTime().time() != QTime(0, 0, 0)) {
-            lst << AppointmentInterval(DateTime(ed, QTime(0, 0), tz), interval.endTime(), load);
+        if (t1 < interval.end()) {
+            lst << AppointmentInterval(tz, t1, interval.end(), load);
             Q_ASSERT_X(lst.last().isValid(), "Split", "Invalid interval");
         }
     }
     for (AppointmentInterval li : qAsConst(lst)) {
         Q_ASSERT_X(lst.last().isValid(), "Add", "Invalid interval");
-        date = li.startTime().date();
+        date = li.startDate();
         if (! m_map.contains(date)) {
             m_map.insert(date, li);
             continue;
@@ -561,29 +636,29 @@ void AppointmentIntervalList::add(const AppointmentInterval &ai)
             //debugPlan<<"intersects, merge"<<li<<vi;
             if (li < vi) {
                 //debugPlan<<"li < vi:";
-                if (li.startTime() < vi.startTime()) {
-                    l.insert(0, AppointmentInterval(li.startTime(), vi.startTime(), li.load()));
+                if (li.start() < vi.start()) {
+                    l.insert(0, AppointmentInterval(tz, li.start(), vi.start(), li.load()));
                     Q_ASSERT_X(l.at(0).isValid(), "Intersects, start", "Add Invalid interval");
                 }
-                l.insert(0, AppointmentInterval(vi.startTime(), qMin(vi.endTime(), li.endTime()), vi.load() + li.load()));
+                l.insert(0, AppointmentInterval(tz, vi.start(), qMin(vi.end(), li.end()), vi.load() + li.load()));
                 Q_ASSERT_X(l.at(0).isValid(), "Intersects, middle", "Add Invalid interval");
-                li.setStartTime(l.at(0).endTime()); // if more of li, it may overlap with next vi
-                if (l.at(0).endTime() < vi.endTime()) {
-                    l.insert(0, AppointmentInterval(l.at(0).endTime(), vi.endTime(), vi.load()));
+                li.setStart(l.at(0).end()); // if more of li, it may overlap with next vi
+                if (l.at(0).end() < vi.end()) {
+                    l.insert(0, AppointmentInterval(tz, l.at(0).end(), vi.end(), vi.load()));
                     //debugPlan<<"li < vi: vi rest:"<<l.at(0);
                     Q_ASSERT_X(l.at(0).isValid(), "Intersects, end", "Add Invalid interval");
                 }
             } else if (vi < li) {
                 //debugPlan<<"vi < li:";
-                if (vi.startTime() < li.startTime()) {
-                    l.insert(0, AppointmentInterval(vi.startTime(), li.startTime(), vi.load()));
+                if (vi.start() < li.start()) {
+                    l.insert(0, AppointmentInterval(tz, vi.start(), li.start(), vi.load()));
                     Q_ASSERT_X(l.at(0).isValid(), "Intersects, start", "Add Invalid interval");
                 }
-                l.insert(0, AppointmentInterval(li.startTime(), qMin(vi.endTime(), li.endTime()), vi.load() + li.load()));
+                l.insert(0, AppointmentInterval(tz, li.start(), qMin(vi.end(), li.end()), vi.load() + li.load()));
                 Q_ASSERT_X(l.at(0).isValid(), "Intersects, middle", "Add Invalid interval");
-                li.setStartTime(l.at(0).endTime()); // if more of li, it may overlap with next vi
-                if (l.at(0).endTime() < vi.endTime()) {
-                    l.insert(0, AppointmentInterval(l.at(0).endTime(), vi.endTime(), vi.load()));
+                li.setStart(l.at(0).end()); // if more of li, it may overlap with next vi
+                if (l.at(0).end() < vi.end()) {
+                    l.insert(0, AppointmentInterval(tz, l.at(0).end(), vi.end(), vi.load()));
                     //debugPlan<<"vi < li: vi rest:"<<l.at(0);
                     Q_ASSERT_X(l.at(0).isValid(), "Intersects, end", "Add Invalid interval");
                 }
@@ -602,7 +677,7 @@ void AppointmentIntervalList::add(const AppointmentInterval &ai)
         }
         for(const AppointmentInterval &i : qAsConst(l)) {
             Q_ASSERT(i.isValid());
-            m_map.insert(i.startTime().date(), i);
+            m_map.insert(i.startDate(), i);
         }
     }
 }
@@ -620,10 +695,20 @@ Duration AppointmentIntervalList::effort() const
 
 // Returns the effort from start to end
 Duration AppointmentIntervalList::effort(const DateTime &start, const DateTime &end) const
+{
+    return effort(TimePoint::fromDateTime(start), TimePoint::fromDateTime(end));
+}
+
+Duration AppointmentIntervalList::effort(TimePoint start, TimePoint end) const
 {
     Duration d;
-    QMultiMap<QDate, AppointmentInterval>::const_iterator it = m_map.lowerBound(start.date());
-    for (; it != m_map.constEnd() && it.key() <= end.date(); ++it) {
+    if (m_map.isEmpty()) {
+        return d;
+    }
+    const TimeZoneOffsets tz = m_map.first().timeZoneOffsets();
+    QMultiMap<QDate, AppointmentInterval>::const_iterator it = tz.isValid() ? m_map.lowerBound(tz.localDate(start)) : m_map.constBegin();
+    const QDate last = tz.isValid() ? tz.localDate(end) : m_map.lastKey();
+    for (; it != m_map.constEnd() && it.key() <= last; ++it) {
         d += it.value().effort(start, end);
     }
     return d;
@@ -706,6 +791,18 @@ Appointment::Appointment(Schedule *resource, Schedule *node, const DateTime &sta
 
 }
 
+Appointment::Appointment(Schedule *resource, Schedule *node, const AppointmentInterval &interval)
+    : m_extraRepeats(),
+      m_skipRepeats() {
+    m_node = node;
+    m_resource = resource;
+    m_calculationMode = Schedule::Scheduling;
+    m_repeatInterval = Duration();
+    m_repeatCount = 0;
+
+    addInterval(interval);
+}
+
 Appointment::Appointment(const Appointment &app)
 {
     copy(app);
@@ -717,14 +814,26 @@ Appointment::~Appointment() {
     detach();
 }
 
+void Appointment::intervalsChanged()
+{
+    if (m_node) {
+        m_node->appointmentsChanged();
+    }
+    if (m_resource) {
+        m_resource->appointmentsChanged();
+    }
+}
+
 Appointment &Appointment::toTimeZone(const QTimeZone &tz)
 {
+    intervalsChanged();
     m_intervals.toTimeZone(tz);
     return *this;
 }
 
 void Appointment::clear()
 {
+    intervalsChanged();
     m_intervals.clear();
 }
 
@@ -732,9 +841,11 @@ AppointmentIntervalList Appointment::intervals(const DateTime &start, const Date
 {
     //debugPlan<<start<<end;
     AppointmentIntervalList lst;
+    const TimePoint s = TimePoint::fromDateTime(start);
+    const TimePoint e = TimePoint::fromDateTime(end);
     QMultiMap<QDate, AppointmentInterval>::const_iterator it = m_intervals.map().lowerBound(start.date());
     for (; it != m_intervals.map().constEnd() && it.key() <= end.date(); ++it) {
-        AppointmentInterval ai = it.value().interval(start, end);
+        AppointmentInterval ai = it.value().interval(s, e);
         if (ai.isValid()) {
             lst.add(ai);
             //debugPlan<<ai.startTime().toString()<<ai.endTime().toString();
@@ -744,6 +855,7 @@ AppointmentIntervalList Appointment::intervals(const DateTime &start, const Date
 }
 
 void Appointment::setIntervals(const AppointmentIntervalList &lst) {
+    intervalsChanged();
     m_intervals.clear();
     const auto intervals = lst.map().values();
     for (const AppointmentInterval &i : intervals) {
@@ -753,7 +865,7 @@ void Appointment::setIntervals(const AppointmentIntervalList &lst) {
 
 void Appointment::addInterval(const AppointmentInterval &a) {
     Q_ASSERT(a.isValid());
-    Q_ASSERT(a.startTime().timeZone() == a.endTime().timeZone());
+    intervalsChanged();
     m_intervals.add(a);
 //     if (m_resource && m_resource->resource() && m_node && m_node->node()) debugPlan<<"Mode="<<m_calculationMode<<":"<<m_resource->resource()->name()<<" to"<<m_node->node()->name()<<""<<a.startTime()<<a.endTime();
 }
@@ -782,7 +894,7 @@ DateTime Appointment::startTime() const {
         //debugPlan<<"empty list";
         return DateTime();
     }
-    return m_intervals.map().values().first().startTime();
+    return m_intervals.map().first().startTime();
 }
 
 DateTime Appointment::endTime() const {
@@ -790,7 +902,7 @@ DateTime Appointment::endTime() const {
         //debugPlan<<"empty list";
         return DateTime();
     }
-    return m_intervals.map().values().last().endTime();
+    return m_intervals.map().last().endTime();
 }
 
 bool Appointment::isBusy(const DateTime &/*start*/, const DateTime &/*end*/) {
@@ -862,11 +974,11 @@ Duration Appointment::plannedEffort(const Resource *resource, QDate date, Effort
 // Returns the planned effort upto and including the date
 Duration Appointment::plannedEffortTo(QDate date, EffortCostCalculationType type) const {
     Duration d;
-    QDate e(date.addDays(1));
+    const TimePoint e = TimePoint::fromDateTime(DateTime(date.addDays(1)));
     if (type == ECCT_All || m_resource == nullptr || m_resource->resource()->type() == Resource::Type_Work) {
         const auto intervals = m_intervals.map().values();
         for (const AppointmentInterval &i : intervals) {
-            d += i.effort(e, true); // upto e, not including
+            d += i.effort(TimePoint(), e); // upto e, not including
         }
     }
     //debugPlan<<date<<d.toString();
@@ -885,9 +997,10 @@ Duration Appointment::plannedEffortTo(const Resource *resource, QDate date, Effo
 Duration Appointment::plannedEffortTo(const QDateTime &time, EffortCostCalculationType type) const {
     Duration d;
     if (type == ECCT_All || m_resource == nullptr || m_resource->resource()->type() == Resource::Type_Work) {
+        const TimePoint t = TimePoint::fromDateTime(time);
         const auto intervals = this->intervals(startTime(), time).map().values();
         for (const AppointmentInterval &i : intervals) {
-            d += i.effort(i.startTime(), time); // upto e, not including
+            d += i.effort(i.start(), t); // upto e, not including
         }
     }
     //debugPlan<<date<<d.toString();
@@ -1011,9 +1124,11 @@ Duration Appointment::effort(const DateTime &start, const DateTime &end, EffortC
 Duration Appointment::effort(const DateTime &start, KPlato::Duration duration, EffortCostCalculationType type) const {
     Duration d;
     if (type == ECCT_All || m_resource == nullptr || m_resource->resource()->type() == Resource::Type_Work) {
+        const TimePoint s = TimePoint::fromDateTime(start);
+        const TimePoint e = TimePoint::fromDateTime(start + duration);
         const auto intervals = m_intervals.map().values();
         for (const AppointmentInterval &i : intervals) {
-            d += i.effort(start, start+duration);
+            d += i.effort(s, e);
         }
     }
     return d;
@@ -1036,6 +1151,7 @@ Appointment Appointment::operator+(const Appointment &app) {
 }
 
 Appointment &Appointment::operator-=(const Appointment &app) {
+    intervalsChanged();
     m_intervals -= app.m_intervals;
     return *this;
 }
@@ -1072,25 +1188,25 @@ void Appointment::merge(const Appointment &app) {
     //debugPlan<<"add"<<lst1.count()<<" intervals to"<<lst2.count()<<" intervals";
     AppointmentInterval i2;
     int index1 = 0, index2 = 0;
-    DateTime from;
+    TimePoint from;
     while (index1 < lst1.size() || index2 < lst2.size()) {
         if (index1 >= lst1.size()) {
             i2 = lst2[index2];
-            if (!from.isValid() || from < i2.startTime())
-                from = i2.startTime();
-            result.append(AppointmentInterval(from, i2.endTime(), i2.load()));
+            if (!from.isValid() || from < i2.start())
+                from = i2.start();
+            result.append(AppointmentInterval(i2.timeZoneOffsets(), from, i2.end(), i2.load()));
             //debugPlan<<"Interval+ (i2):"<<from<<" -"<<i2.endTime();
-            from = i2.endTime();
+            from = i2.end();
             ++index2;
             continue;
         }
         if (index2 >= lst2.size()) {
             i1 = lst1[index1];
-            if (!from.isValid() || from < i1.startTime())
-                from = i1.startTime();
-            result.append(AppointmentInterval(from, i1.endTime(), i1.load()));
+            if (!from.isValid() || from < i1.start())
+                from = i1.start();
+            result.append(AppointmentInterval(i1.timeZoneOffsets(), from, i1.end(), i1.load()));
             //debugPlan<<"Interval+ (i1):"<<from<<" -"<<i1.endTime();
-            from = i1.endTime();
+            from = i1.end();
             ++index1;
             continue;
         }
@@ -1101,15 +1217,16 @@ void Appointment::merge(const Appointment &app) {
             break;
         }
         result.append(AppointmentInterval(i)); 
-        from = i.endTime();
+        from = i.end();
         //debugPlan<<"Interval+ (i):"<<i.startTime()<<" -"<<i.endTime()<<" load="<<i.load();
-        if (i.endTime() >= i1.endTime()) {
+        if (i.end() >= i1.end()) {
             ++index1;
         }
-        if (i.endTime() >= i2.endTime()) {
+        if (i.end() >= i2.end()) {
             ++index2;
         }
     }
+    intervalsChanged();
     m_intervals.clear();
     for (const AppointmentInterval &i : qAsConst(result)) {
         m_intervals.add(i);
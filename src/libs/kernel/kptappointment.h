@@ -13,6 +13,7 @@
 
 #include "kptduration.h"
 #include "kptdatetime.h"
+#include "TimeZoneOffsets.h"
 
 #include <KoXmlReaderForward.h>
 
@@ -42,14 +43,21 @@ class AppointmentIntervalData : public QSharedData
 public:
     AppointmentIntervalData() : load(0) {}
     AppointmentIntervalData(const AppointmentIntervalData &other)
-        : QSharedData(other), start(other.start), end(other.end), load(other.load) {}
+        : QSharedData(other), timeZone(other.timeZone), start(other.start), end(other.end), load(other.load) {}
     ~AppointmentIntervalData() {}
 
-    DateTime start;
-    DateTime end;
+    TimeZoneOffsets timeZone; // start and end are returned as DateTime in this time zone
+    TimePoint start;
+    TimePoint end;
     double load; //percent
 };
 
+/**
+ * A time interval with a load.
+ * The start and end are kept as time points, so comparing, merging and
+ * calculating effort does not need time zone lookups.
+ * startTime() and endTime() return them as DateTime in the time zone of the interval.
+ */
 class PLANKERNEL_EXPORT AppointmentInterval
 {
 public:
@@ -57,27 +65,44 @@ public:
     AppointmentInterval(const AppointmentInterval &other);
     AppointmentInterval(const DateTime &start, const DateTime &end, double load=100);
     AppointmentInterval(QDate date, const TimeInterval &timeInterval, double load=100);
+    /// Create an interval from @p start to @p end in @p timeZone
+    AppointmentInterval(const TimeZoneOffsets &timeZone, TimePoint start, TimePoint end, double load=100);
     ~AppointmentInterval();
     
     Duration effort() const;
     Duration effort(const DateTime &start, const DateTime &end) const;
+    /// Return the effort from @p start to @p end, an invalid time point is unlimited
+    Duration effort(TimePoint start, TimePoint end) const;
     Duration effort(QDate time, bool upto) const;
     
     bool loadXML(KoXmlElement &element, XMLLoaderObject &status);
     void saveXML(QDomElement &element) const;
     
-    const DateTime &startTime() const;
+    /// Return the start time as a DateTime in the time zone of the interval
+    DateTime startTime() const;
     void setStartTime(const DateTime &time);
-    const DateTime &endTime() const;
+    /// Return the end time as a DateTime in the time zone of the interval
+    DateTime endTime() const;
     void setEndTime(const DateTime &time);
+    TimePoint start() const { return d->start; }
+    void setStart(TimePoint time);
+    TimePoint end() const { return d->end; }
+    void setEnd(TimePoint time);
+    /// Return the local date of the start time
+    QDate startDate() const;
+    /// Return the local date of the end time
+    QDate endDate() const;
     double load() const;
     void setLoad(double load);
     QTimeZone timeZone() const;
+    const TimeZoneOffsets &timeZoneOffsets() const { return d->timeZone; }
     AppointmentInterval &toTimeZone(const QTimeZone &tz);
+    AppointmentInterval &toTimeZone(const TimeZoneOffsets &timeZone);
 
     bool isValid() const;
 
     AppointmentInterval firstInterval(const AppointmentInterval &interval, const DateTime &from) const;
+    AppointmentInterval firstInterval(const AppointmentInterval &interval, TimePoint from) const;
 
     /// Merge this interval with @p interval if it is conticuous to this.
     /// @return true if merged
@@ -90,6 +115,7 @@ public:
     bool isConticuousTo(const AppointmentInterval &other) const;
     bool intersects(const AppointmentInterval &other) const;
     AppointmentInterval interval(const DateTime &start, const DateTime &end) const;
+    AppointmentInterval interval(TimePoint start, TimePoint end) const;
 
     QString toString() const;
 
@@ -131,11 +157,13 @@ public:
 
     /// Returns the intervals in the range @p start, @p end
     AppointmentIntervalList extractIntervals(const DateTime &start, const DateTime &end) const;
+    AppointmentIntervalList extractIntervals(TimePoint start, TimePoint end) const;
 
     /// Return the total effort
     Duration effort() const;
     /// Return the effort limited to the interval @p start, @p end
     Duration effort(const DateTime &start, const DateTime &end) const;
+    Duration effort(TimePoint start, TimePoint end) const;
 
     QMultiMap<QDate, AppointmentInterval> map();
     const QMultiMap<QDate, AppointmentInterval> &map() const;
@@ -167,6 +195,7 @@ public:
     explicit Appointment();
     Appointment(Schedule *resource, Schedule *node, const DateTime &start, const DateTime &end, double load);
     Appointment(Schedule *resource, Schedule *node, const DateTime &start, Duration duration, double load);
+    Appointment(Schedule *resource, Schedule *node, const AppointmentInterval &interval);
     Appointment(const Appointment &app);
     ~Appointment();
 
@@ -266,6 +295,10 @@ public:
 protected:
     void copy(const Appointment &app);
     
+private:
+    /// Tell the schedules that the intervals have changed
+    void intervalsChanged();
+
 private:
     Schedule *m_node;
     Schedule *m_resource;
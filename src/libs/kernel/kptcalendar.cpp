@@ -697,6 +697,7 @@ void Calendar::copy(const Calendar *calendar)
 const Calendar &Calendar::copy(const Calendar &calendar) {
     m_name = calendar.name();
     m_timeZone = calendar.timeZone();
+    m_timeZoneOffsets = calendar.m_timeZoneOffsets;
     // m_parent = calendar.parentCal(); 
     // m_id = calendar.id();
 #ifdef HAVE_KHOLIDAYS
@@ -719,6 +720,7 @@ void Calendar::init() {
 #endif
     m_weekdays = new CalendarWeekdays();
     m_timeZone = QTimeZone::systemTimeZone();
+    m_timeZoneOffsets = TimeZoneOffsets::forTimeZone(m_timeZone);
     m_cacheversion = 0;
     m_blockversion = false;
 }
@@ -795,6 +797,7 @@ void Calendar::setTimeZone(const QTimeZone &tz)
     }
     //debugPlan<<tz->name();
     m_timeZone = tz;
+    m_timeZoneOffsets = TimeZoneOffsets::forTimeZone(m_timeZone);
 #ifdef HAVE_KHOLIDAYS
     if (m_regionCode == QStringLiteral("Default")) {
         setHolidayRegion(QStringLiteral("Default"));
@@ -1077,10 +1080,28 @@ bool Calendar::hasParent(Calendar *cal) {
     return m_parent->hasParent(cal);
 }
 
+TimePoint Calendar::fromLocal(QDate date, QTime time) const
+{
+    if (!m_timeZoneOffsets.isValid()) {
+        return TimePoint::fromDateTime(DateTime(date, time, m_timeZone));
+    }
+    return m_timeZoneOffsets.fromLocal(date, time);
+}
+
+DateTime Calendar::toDateTime(TimePoint time) const
+{
+    if (!m_timeZoneOffsets.isValid()) {
+        return time.isValid() ? DateTime(QDateTime::fromMSecsSinceEpoch(time.toMSecsSinceEpoch(), QTimeZone::systemTimeZone())) : DateTime();
+    }
+    return m_timeZoneOffsets.toDateTime(time);
+}
+
 AppointmentIntervalList Calendar::workIntervals(const QDateTime &start, const QDateTime &end, double load) const
 {
     const auto tz = start.timeZone();
     const auto limit = end.toTimeZone(start.timeZone());
+    // The intervals are kept as time points in the callers time zone
+    const TimeZoneOffsets offsets = m_timeZoneOffsets.isValid() && tz == m_timeZone ? m_timeZoneOffsets : TimeZoneOffsets::forTimeZone(tz);
     debugPlan<<tz<<start<<end<<load;
     AppointmentIntervalList lst;
     TimeInterval res;
@@ -1096,9 +1117,8 @@ AppointmentIntervalList Calendar::workIntervals(const QDateTime &start, const QD
         //debugPlan<<"Check single day:"<<s.date()<<s.time()<<length;
         res = firstInterval(start.date(), startTime, length, nullptr);
         while (res.isValid()) {
-            const DateTime dt1 = DateTime(start.date(), res.startTime(), m_timeZone).toTimeZone(tz);
-            const DateTime dt2 = dt1.addMSecs(res.second).toTimeZone(tz);
-            lst.add(AppointmentInterval(dt1, dt2, load));
+            const TimePoint t1 = fromLocal(start.date(), res.startTime());
+            lst.add(AppointmentInterval(offsets, t1, t1.addMSecs(res.second), load));
             length -= res.second;
             if (length <= 0 || res.endsMidnight()) {
                 break;
@@ -1125,14 +1145,11 @@ AppointmentIntervalList Calendar::workIntervals(const QDateTime &start, const QD
         res = firstInterval(date, startTime, length);
         while (res.isValid()) {
             //debugPlan<<"interval:"<<date<<startTime<<'='<<res.first<<res.second;
-            DateTime dt1(date, res.startTime(), m_timeZone);
-            DateTime dt2(date, res.endTime(), m_timeZone);
-            if (res.endsMidnight()) {
-                dt2 = dt2.addDays(1);
-            }
-            AppointmentInterval i(dt1.toTimeZone(tz), dt2.toTimeZone(tz), load);
+            const TimePoint t1 = fromLocal(date, res.startTime());
+            const TimePoint t2 = fromLocal(res.endsMidnight() ? date.addDays(1) : date, res.endTime());
+            AppointmentInterval i(offsets, t1, t2, load);
             lst.add(i);
-            debugPlan<<res<<dt1<<dt2<<lst;
+            debugPlan<<res<<i<<lst;
             length -= startTime.msecsTo(res.endTime());
             if (length <= 0 || res.endsMidnight()) {
                 break;
@@ -1302,8 +1319,8 @@ DateTimeInterval Calendar::firstInterval(const QDateTime &start, const QDateTime
         if (! res.isValid()) {
             return DateTimeInterval();
         }
-        DateTime dt1(start.date(), res.first, m_timeZone);
-        DateTimeInterval dti(dt1, DateTime(dt1.addMSecs(res.second)).toTimeZone(m_timeZone));
+        const TimePoint t1 = fromLocal(start.date(), res.first);
+        DateTimeInterval dti(toDateTime(t1), toDateTime(t1.addMSecs(res.second)));
 //         debugPlan<<"Result firstInterval:"<<dti;
         return dti;
     }
@@ -1327,8 +1344,8 @@ DateTimeInterval Calendar::firstInterval(const QDateTime &start, const QDateTime
             //debugPlan<<"inp:"<<start<<"-"<<end;
             //debugPlan<<"Found an interval ("<<date<<","<<res.first<<","<<res.second<<")";
             // return result in callers timezone
-            DateTime dt1(date, res.first, m_timeZone);
-            DateTimeInterval dti(DateTime(dt1), dt1.addMSecs(res.second).toTimeZone(m_timeZone));
+            const TimePoint t1 = fromLocal(date, res.first);
+            DateTimeInterval dti(toDateTime(t1), toDateTime(t1.addMSecs(res.second)));
 //             debugPlan<<"Result firstInterval:"<<dti;
             return dti;
         }
@@ -11,6 +11,7 @@
 #include "kptdatetime.h"
 #include "kptduration.h"
 #include "kptdebug.h"
+#include "TimeZoneOffsets.h"
 #include "plankernel_export.h"
 
 #include <utility>
@@ -581,6 +582,11 @@ protected:
      */
     AppointmentIntervalList workIntervals(const QDateTime &start, const QDateTime &end, double load) const;
 
+    /// Return the time point of local @p date and @p time in this calendars time zone
+    TimePoint fromLocal(QDate date, QTime time) const;
+    /// Return @p time as a DateTime in this calendars time zone
+    DateTime toDateTime(TimePoint time) const;
+
     /**
      * Find the first available time backwards from @p time. Search until @p limit.
      * Return invalid datetime if not available.
@@ -602,6 +608,7 @@ private:
     QList<Calendar*> m_calendars;
 
     QTimeZone m_timeZone;
+    TimeZoneOffsets m_timeZoneOffsets; // cached utc offsets of m_timeZone
     bool m_default; // this is the default calendar, only used for save/load
     bool m_shared;
 
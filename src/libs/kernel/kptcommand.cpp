@@ -614,6 +614,23 @@ void NodeDeleteCmd::unexecute()
         setSchScheduled();
     }
 }
+qint64 NodeDeleteCmd::memoryCost() const
+{
+    qint64 cost = NamedCommand::memoryCost();
+    if (m_mine) {
+        cost += nodeCost(m_node);
+    }
+    for (const Appointment *a : m_appointments) {
+        cost += appointmentCost(a);
+    }
+    if (m_cmd) {
+        cost += m_cmd->memoryCost();
+    }
+    if (m_relCmd) {
+        cost += m_relCmd->memoryCost();
+    }
+    return cost;
+}
 
 TaskAddCmd::TaskAddCmd(Project *project, Node *node, Node *after, const KUndo2MagicString& name)
         : NamedCommand(name),
@@ -757,6 +774,20 @@ void NodeModifyNameCmd::unexecute()
 
 
 }
+int NodeModifyNameCmd::id() const
+{
+    return NodeModifyNameId;
+}
+bool NodeModifyNameCmd::mergeWith(const KUndo2Command *command)
+{
+    const NodeModifyNameCmd *other = dynamic_cast<const NodeModifyNameCmd*>(command);
+    if (!other || !isMergeable(command) || &other->m_node != &m_node) {
+        return false;
+    }
+    newName = other->newName;
+    setEndTime();
+    return true;
+}
 
 NodeModifyPriorityCmd::NodeModifyPriorityCmd(Node &node, int oldValue, int newValue, const KUndo2MagicString& name)
     : NamedCommand(name)
@@ -773,6 +804,20 @@ void NodeModifyPriorityCmd::unexecute()
 {
     m_node.setPriority(m_oldValue);
 }
+int NodeModifyPriorityCmd::id() const
+{
+    return NodeModifyPriorityId;
+}
+bool NodeModifyPriorityCmd::mergeWith(const KUndo2Command *command)
+{
+    const NodeModifyPriorityCmd *other = dynamic_cast<const NodeModifyPriorityCmd*>(command);
+    if (!other || !isMergeable(command) || &other->m_node != &m_node) {
+        return false;
+    }
+    m_newValue = other->m_newValue;
+    setEndTime();
+    return true;
+}
 
 NodeModifyLeaderCmd::NodeModifyLeaderCmd(Node &node, const QString& leader, const KUndo2MagicString& name)
         : NamedCommand(name),
@@ -793,6 +838,20 @@ void NodeModifyLeaderCmd::unexecute()
 
 
 }
+int NodeModifyLeaderCmd::id() const
+{
+    return NodeModifyLeaderId;
+}
+bool NodeModifyLeaderCmd::mergeWith(const KUndo2Command *command)
+{
+    const NodeModifyLeaderCmd *other = dynamic_cast<const NodeModifyLeaderCmd*>(command);
+    if (!other || !isMergeable(command) || &other->m_node != &m_node) {
+        return false;
+    }
+    newLeader = other->newLeader;
+    setEndTime();
+    return true;
+}
 
 NodeModifyDescriptionCmd::NodeModifyDescriptionCmd(Node &node, const QString& description, const KUndo2MagicString& name)
         : NamedCommand(name),
@@ -813,6 +872,20 @@ void NodeModifyDescriptionCmd::unexecute()
 
 
 }
+int NodeModifyDescriptionCmd::id() const
+{
+    return NodeModifyDescriptionId;
+}
+bool NodeModifyDescriptionCmd::mergeWith(const KUndo2Command *command)
+{
+    const NodeModifyDescriptionCmd *other = dynamic_cast<const NodeModifyDescriptionCmd*>(command);
+    if (!other || !isMergeable(command) || &other->m_node != &m_node) {
+        return false;
+    }
+    newDescription = other->newDescription;
+    setEndTime();
+    return true;
+}
 
 NodeModifyConstraintCmd::NodeModifyConstraintCmd(Node &node, Node::ConstraintType c, const KUndo2MagicString& name)
         : NamedCommand(name),
@@ -1328,6 +1401,21 @@ void ModifyEstimateCmd::unexecute()
     m_estimate->setPessimisticRatio(m_pessimistic);
     m_estimate->setOptimisticRatio(m_optimistic);
 }
+int ModifyEstimateCmd::id() const
+{
+    return ModifyEstimateId;
+}
+bool ModifyEstimateCmd::mergeWith(const KUndo2Command *command)
+{
+    const ModifyEstimateCmd *other = dynamic_cast<const ModifyEstimateCmd*>(command);
+    // Do not merge if resource requests are removed, it is a separate step for the user
+    if (!other || !isMergeable(command) || other->m_estimate != m_estimate || m_cmd || other->m_cmd) {
+        return false;
+    }
+    m_newvalue = other->m_newvalue;
+    setEndTime();
+    return true;
+}
 
 EstimateModifyOptimisticRatioCmd::EstimateModifyOptimisticRatioCmd(Node &node, int oldvalue, int newvalue, const KUndo2MagicString& name)
         : NamedCommand(name),
@@ -1344,6 +1432,20 @@ void EstimateModifyOptimisticRatioCmd::unexecute()
 {
     m_estimate->setOptimisticRatio(m_oldvalue);
 }
+int EstimateModifyOptimisticRatioCmd::id() const
+{
+    return EstimateModifyOptimisticRatioId;
+}
+bool EstimateModifyOptimisticRatioCmd::mergeWith(const KUndo2Command *command)
+{
+    const EstimateModifyOptimisticRatioCmd *other = dynamic_cast<const EstimateModifyOptimisticRatioCmd*>(command);
+    if (!other || !isMergeable(command) || other->m_estimate != m_estimate) {
+        return false;
+    }
+    m_newvalue = other->m_newvalue;
+    setEndTime();
+    return true;
+}
 
 EstimateModifyPessimisticRatioCmd::EstimateModifyPessimisticRatioCmd(Node &node, int oldvalue, int newvalue, const KUndo2MagicString& name)
         : NamedCommand(name),
@@ -1360,6 +1462,20 @@ void EstimateModifyPessimisticRatioCmd::unexecute()
 {
     m_estimate->setPessimisticRatio(m_oldvalue);
 }
+int EstimateModifyPessimisticRatioCmd::id() const
+{
+    return EstimateModifyPessimisticRatioId;
+}
+bool EstimateModifyPessimisticRatioCmd::mergeWith(const KUndo2Command *command)
+{
+    const EstimateModifyPessimisticRatioCmd *other = dynamic_cast<const EstimateModifyPessimisticRatioCmd*>(command);
+    if (!other || !isMergeable(command) || other->m_estimate != m_estimate) {
+        return false;
+    }
+    m_newvalue = other->m_newvalue;
+    setEndTime();
+    return true;
+}
 
 ModifyEstimateTypeCmd::ModifyEstimateTypeCmd(Node &node, int oldvalue, int newvalue, const KUndo2MagicString& name)
         : NamedCommand(name),
@@ -2620,6 +2736,25 @@ void AddScheduleManagerCmd::unexecute()
     m_mine = true;
     m_cmd.undo();
 }
+qint64 AddScheduleManagerCmd::memoryCost() const
+{
+    qint64 cost = NamedCommand::memoryCost() + m_cmd.memoryCost();
+    if (m_mine && m_exp) {
+        // the schedules of a manager that is not in the project are kept by the command
+        cost += sizeof(ScheduleManager);
+        const auto nodes = m_node.allNodes();
+        for (const Node *n : nodes) {
+            const Schedule *s = n->schedules().value(m_exp->id());
+            if (s) {
+                const auto appointments = s->appointments();
+                for (const Appointment *a : appointments) {
+                    cost += appointmentCost(a);
+                }
+            }
+        }
+    }
+    return cost;
+}
 
 DeleteScheduleManagerCmd::DeleteScheduleManagerCmd(Project &node, ScheduleManager *sm, const KUndo2MagicString& name)
     : AddScheduleManagerCmd(node, sm, -1, name)
@@ -2643,6 +2778,10 @@ void DeleteScheduleManagerCmd::unexecute()
     AddScheduleManagerCmd::execute();
     cmd.unexecute();
 }
+qint64 DeleteScheduleManagerCmd::memoryCost() const
+{
+    return AddScheduleManagerCmd::memoryCost() + cmd.memoryCost();
+}
 
 MoveScheduleManagerCmd::MoveScheduleManagerCmd(ScheduleManager *sm, ScheduleManager *newparent, int newindex, const KUndo2MagicString& name)
     : NamedCommand(name),
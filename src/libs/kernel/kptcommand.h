@@ -323,6 +323,7 @@ public:
     ~NodeDeleteCmd() override;
     void execute() override;
     void unexecute() override;
+    qint64 memoryCost() const override;
 
 private:
     Node *m_node;
@@ -374,6 +375,8 @@ public:
     NodeModifyNameCmd(Node &node, const QString& nodename, const KUndo2MagicString& name = KUndo2MagicString());
     void execute() override;
     void unexecute() override;
+    int id() const override;
+    bool mergeWith(const KUndo2Command *command) override;
 
 private:
     Node &m_node;
@@ -387,6 +390,8 @@ public:
     NodeModifyPriorityCmd(Node &node, int oldValue, int newValue, const KUndo2MagicString& name = KUndo2MagicString());
     void execute() override;
     void unexecute() override;
+    int id() const override;
+    bool mergeWith(const KUndo2Command *command) override;
 
 private:
     Node &m_node;
@@ -400,6 +405,8 @@ public:
     NodeModifyLeaderCmd(Node &node, const QString& leader, const KUndo2MagicString& name = KUndo2MagicString());
     void execute() override;
     void unexecute() override;
+    int id() const override;
+    bool mergeWith(const KUndo2Command *command) override;
 
 private:
     Node &m_node;
@@ -413,6 +420,8 @@ public:
     NodeModifyDescriptionCmd(Node &node, const QString& description, const KUndo2MagicString& name = KUndo2MagicString());
     void execute() override;
     void unexecute() override;
+    int id() const override;
+    bool mergeWith(const KUndo2Command *command) override;
 
 private:
     Node &m_node;
@@ -694,6 +703,8 @@ public:
     ~ModifyEstimateCmd() override;
     void execute() override;
     void unexecute() override;
+    int id() const override;
+    bool mergeWith(const KUndo2Command *command) override;
 
 private:
     Estimate *m_estimate;
@@ -709,6 +720,8 @@ public:
     EstimateModifyOptimisticRatioCmd(Node &node, int oldvalue, int newvalue, const KUndo2MagicString& name = KUndo2MagicString());
     void execute() override;
     void unexecute() override;
+    int id() const override;
+    bool mergeWith(const KUndo2Command *command) override;
 
 private:
     Estimate *m_estimate;
@@ -722,6 +735,8 @@ public:
     EstimateModifyPessimisticRatioCmd(Node &node, int oldvalue, int newvalue, const KUndo2MagicString& name = KUndo2MagicString());
     void execute() override;
     void unexecute() override;
+    int id() const override;
+    bool mergeWith(const KUndo2Command *command) override;
 
 private:
     Estimate *m_estimate;
@@ -1476,6 +1491,7 @@ public:
     ~AddScheduleManagerCmd() override;
     void execute() override;
     void unexecute() override;
+    qint64 memoryCost() const override;
 
 protected:
     Project &m_node;
@@ -1493,6 +1509,7 @@ public:
     DeleteScheduleManagerCmd(Project &project, ScheduleManager *sm, const KUndo2MagicString& name = KUndo2MagicString());
     void execute() override;
     void unexecute() override;
+    qint64 memoryCost() const override;
 
 private:
     MacroCommand cmd;
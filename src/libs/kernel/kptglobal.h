@@ -66,7 +66,8 @@ namespace Role
         Planned,
         Actual,
         Foreground,
-        Object
+        Object,
+        TimePhased
     };
 } //namespace Role
 
@@ -93,6 +93,8 @@ Node::~Node() {
 }
 
 void Node::init() {
+    m_position = -1;
+    m_validPositions = 0;
     m_priority = 0;
     m_documents.node = this;
     m_currentSchedule = nullptr;
@@ -194,9 +196,10 @@ const Node *Node::projectNode() const {
 void Node::takeChildNode(Node *node) {
     //debugPlan<<"find="<<m_nodes.indexOf(node);
     int t = type();
-    int i = m_nodes.indexOf(node);
+    int i = indexOf(node);
     if (i != -1) {
         m_nodes.removeAt(i);
+        invalidatePositions(i);
     }
     node->setParentNode(nullptr);
     if (t != type()) {
@@ -208,6 +211,7 @@ void Node::takeChildNode(int number) {
     int t = type();
     if (number >= 0 && number < m_nodes.size()) {
         Node *n = m_nodes.takeAt(number);
+        invalidatePositions(number);
         //debugPlan<<(n?n->id():"null")<<" :"<<(n?n->name():"");
         if (n) {
             n->setParentNode(nullptr);
@@ -220,10 +224,13 @@ void Node::takeChildNode(int number) {
 
 void Node::insertChildNode(int index, Node *node) {
     int t = type();
-    if (index == -1)
+    if (index == -1) {
         m_nodes.append(node);
-    else
+        invalidatePositions(m_nodes.count() - 1);
+    } else {
         m_nodes.insert(index,node);
+        invalidatePositions(index);
+    }
     node->setParentNode(this);
     if (t != type()) {
         changed(TypeProperty);
@@ -232,9 +239,10 @@ void Node::insertChildNode(int index, Node *node) {
 
 void Node::addChildNode(Node *node, Node *after) {
     int t = type();
-    int index = m_nodes.indexOf(after);
+    int index = indexOf(after);
     if (index == -1) {
         m_nodes.append(node);
+        invalidatePositions(m_nodes.count() - 1);
         node->setParentNode(this);
         if (t != type()) {
             changed(TypeProperty);
@@ -242,6 +250,7 @@ void Node::addChildNode(Node *node, Node *after) {
         return;
     }
     m_nodes.insert(index+1, node);
+    invalidatePositions(index + 1);
     node->setParentNode(this);
     if (t != type()) {
         changed(TypeProperty);
@@ -250,7 +259,7 @@ void Node::addChildNode(Node *node, Node *after) {
 
 int Node::findChildNode(const Node* node) const
 {
-    return m_nodes.indexOf(const_cast<Node*>(node));
+    return indexOf(node);
 }
 
 bool Node::isChildOf(const Node* node) const
@@ -281,6 +290,20 @@ const Node* Node::childNode(int number) const
 
 int Node::indexOf(const Node *node) const
 {
+    if (node == nullptr) {
+        return -1;
+    }
+    if (m_validPositions < m_nodes.count()) {
+        for (int i = m_validPositions; i < m_nodes.count(); ++i) {
+            m_nodes.at(i)->m_position = i;
+        }
+        m_validPositions = m_nodes.count();
+    }
+    const int pos = node->m_position;
+    if (pos >= 0 && pos < m_nodes.count() && m_nodes.at(pos) == node) {
+        return pos;
+    }
+    // Not a child, or a node that is temporarily in two child lists (see InsertProjectCmd)
     return m_nodes.indexOf(const_cast<Node*>(node));
 }
 
@@ -364,7 +387,7 @@ void Node::takeDependParentNode(Relation *rel) {
 
 bool Node::isParentOf(const Node *node) const
 {
-    if (m_nodes.indexOf(const_cast<Node*>(node)) != -1)
+    if (indexOf(node) != -1)
         return true;
 
     QListIterator<Node*> nit(childNodeIterator());
@@ -918,7 +941,7 @@ Node *Node::siblingBefore() {
 
 Node *Node::childBefore(Node *node) {
     //debugPlan;
-    int index = m_nodes.indexOf(node);
+    int index = indexOf(node);
     if (index > 0){
         return m_nodes.at(index-1);
     }
@@ -935,8 +958,8 @@ Node *Node::siblingAfter() {
 Node *Node::childAfter(Node *node)
 {
     //debugPlan;
-    Q_ASSERT(m_nodes.contains(node));
-    int index = m_nodes.indexOf(node);
+    int index = indexOf(node);
+    Q_ASSERT(index != -1);
     if (index < m_nodes.count()-1) {
         return m_nodes.at(index+1);
     }
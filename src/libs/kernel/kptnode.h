@@ -168,6 +168,8 @@ public:
     const Node* childNode(int number) const;
     int findChildNode(const Node* node) const;
     bool isChildOf(const Node *node) const;
+    /// Return the position of @p node in the list of child nodes, -1 if not a child.
+    /// Normally constant time, see m_position.
     int indexOf(const Node *node) const;
 
     // Time-dependent child-node-management.
@@ -659,6 +661,13 @@ protected:
     QList<Relation*> m_dependParentNodes;
     QList<Node*>m_parentNodes;
     Node *m_parent;
+
+    /// Position of this node in the child list of its parent.
+    /// Valid when it is less than the parents m_validPositions.
+    mutable int m_position;
+    /// The positions of the child nodes from this index must be renumbered
+    mutable int m_validPositions;
+    void invalidatePositions(int index) const { m_validPositions = qMin(m_validPositions, index); }
     
 
     QString m_id; // unique id
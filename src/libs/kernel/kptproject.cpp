@@ -310,7 +310,7 @@ void Project::calculate(const DateTime &dt)
             calcFreeFloat();
         }
         Q_EMIT scheduleChanged(cs);
-        Q_EMIT projectChanged();
+        emitProjectChanged();
     } else if (type() == Type_Subproject) {
         warnPlan << "Subprojects not implemented";
     } else {
@@ -348,10 +348,11 @@ void Project::calculate(ScheduleManager &sm)
         Q_EMIT scheduleChanged(sm.expected());
         setCurrentSchedule(sm.expected()->id());
     }
+    sm.expected()->flushLogRecords();
     Q_EMIT sigProgress(maxprogress);
     Q_EMIT sigCalculationFinished(this, &sm);
     Q_EMIT scheduleManagerChanged(&sm);
-    Q_EMIT projectChanged();
+    emitProjectChanged();
     sm.setScheduling(false);
 }
 
@@ -383,10 +384,10 @@ void Project::calculate()
     Estimate::Use estType = (Estimate::Use) cs->type();
     if (type() == Type_Project) {
         QElapsedTimer timer; timer.start();
+        cs->setPhaseName(0, i18n("Init"));
         initiateCalculation(*cs);
         initiateCalculationLists(*cs); // must be after initiateCalculation() !!
         if (! backwards) {
-            cs->setPhaseName(0, i18n("Init"));
             cs->logInfo(i18n("Schedule project forward from: %1", locale.toString(m_constraintStartTime, QLocale::ShortFormat)), 0);
             cs->startTime = m_constraintStartTime;
             cs->earlyStart = m_constraintStartTime;
@@ -418,7 +419,6 @@ void Project::calculate()
                 calcCriticalPath(false);
             }
         } else {
-            cs->setPhaseName(0, i18n("Init"));
             cs->logInfo(i18n("Schedule project backward from: %1", locale.toString(m_constraintEndTime, QLocale::ShortFormat)), 0);
             // Calculate from end time
             propagateLatestFinish(m_constraintEndTime);
@@ -498,7 +498,7 @@ void Project::finishCalculation(ScheduleManager &sm)
     cs->notScheduled = false;
     calcFreeFloat();
     Q_EMIT scheduleChanged(cs);
-    Q_EMIT projectChanged();
+    emitProjectChanged();
 }
 
 void Project::setProgress(int progress, ScheduleManager *sm)
@@ -536,15 +536,12 @@ bool Project::calcCriticalPath(bool fromEnd)
     if (cs == nullptr) {
         return false;
     }
-    if (fromEnd) {
-        QListIterator<Node*> startnodes = cs->startNodes();
-        while (startnodes.hasNext()) {
-            startnodes.next() ->calcCriticalPath(fromEnd);
-        }
-    } else {
-        QListIterator<Node*> endnodes = cs->endNodes();
-        while (endnodes.hasNext()) {
-            endnodes.next() ->calcCriticalPath(fromEnd);
+    const QList<Node*> seeds = fromEnd ? cs->startNodes() : cs->endNodes();
+    if (!CriticalPathEngine::markCriticalPath(allNodes(), seeds, cs->id(), fromEnd)) {
+        // Should not happen, dependencies are checked for cycles
+        warnPlan<<"Failed to mark critical path, using recursive search";
+        for (Node *n : seeds) {
+            n->calcCriticalPath(fromEnd);
         }
     }
     calcCriticalPathList(cs);
@@ -555,34 +552,28 @@ void Project::calcCriticalPathList(MainSchedule *cs)
 {
     //debugPlan<<m_name<<", "<<cs->name();
     cs->clearCriticalPathList();
-    const auto nodes = allNodes();
-    for (Node *n : nodes) {
-        if (n->numDependParentNodes() == 0 && n->inCriticalPath(cs->id())) {
-            cs->addCriticalPath();
-            cs->addCriticalPathNode(n);
-            calcCriticalPathList(cs, n);
-        }
-    }
+    cs->m_pathlists = cs->criticalPathEngine().calculate(allNodes(), cs->id());
     cs->criticalPathListCached = true;
     //debugPlan<<*(criticalPathList(cs->id()));
 }
 
-void Project::calcCriticalPathList(MainSchedule *cs, Node *node)
+void Project::updateCriticalPathLists(const Relation *relation)
 {
-    //debugPlan<<node->name()<<", "<<cs->id();
-    bool newPath = false;
-    QList<Node*> lst = *(cs->currentCriticalPath());
-    const auto relations = node->dependChildNodes();
-    for (Relation *r : relations) {
-        if (r->child()->inCriticalPath(cs->id())) {
-            if (newPath) {
-                cs->addCriticalPath(&lst);
-                //debugPlan<<node->name()<<" new path";
+    const QList<ScheduleManager*> managers = allScheduleManagers();
+    for (ScheduleManager *sm : managers) {
+        MainSchedule *ms = sm->expected();
+        if (ms == nullptr || !ms->criticalPathListCached) {
+            continue;
+        }
+        CriticalPathEngine &engine = ms->criticalPathEngine();
+        if (relation && engine.isValid()) {
+            ms->m_pathlists = engine.relationChanged(relation);
+            if (engine.isValid()) {
+                continue;
             }
-            cs->addCriticalPathNode(r->child());
-            calcCriticalPathList(cs, r->child());
-            newPath = true;
         }
+        // recalculated when asked for
+        ms->clearCriticalPathList();
     }
 }
 
@@ -1331,7 +1322,7 @@ void Project::save(QDomElement &element, const XmlSaveContext &context) const
         if (numChildren() > 0) {
             QDomElement e = me.ownerDocument().createElement(QStringLiteral("tasks"));
             me.appendChild(e);
-            for (int i = 0; i < numChildren(); i++) {
+            for (int i = 0; i < numChildren() && !context.saveStreamed(); i++) {
                 childNode(i)->save(e, context);
             }
         }
@@ -1351,8 +1342,8 @@ void Project::save(QDomElement &element, const XmlSaveContext &context) const
         if (!m_managers.isEmpty()) {
             QDomElement el = me.ownerDocument().createElement(QStringLiteral("project-schedules"));
             me.appendChild(el);
-            for (ScheduleManager *sm : qAsConst(m_managers)) {
-                sm->saveXML(el);
+            for (int i = 0; i < m_managers.count() && !context.saveStreamed(); ++i) {
+                m_managers.at(i)->saveXML(el);
             }
         }
         // save resource requests
@@ -1440,6 +1431,11 @@ void Project::saveWorkPackageXML(QDomElement &element, const Node *node, long id
     if (node == nullptr) {
         return;
     }
+    saveWorkPackageNodeXML(me, node, id);
+}
+
+void Project::saveWorkPackageNodeXML(QDomElement &me, const Node *node, long id) const
+{
     const auto assignedResources = node->assignedResources(id);
     debugPlanWp<<"save resources"<<assignedResources;
     if (!assignedResources.isEmpty()) {
@@ -1451,7 +1447,7 @@ void Project::saveWorkPackageXML(QDomElement &element, const Node *node, long id
             }
         }
     }
-    auto tasksElement = element.ownerDocument().createElement(QStringLiteral("tasks"));
+    auto tasksElement = me.ownerDocument().createElement(QStringLiteral("tasks"));
     me.appendChild(tasksElement);
 
     node->saveWorkPackageXML(tasksElement, id);
@@ -1494,7 +1490,7 @@ void Project::addResourceGroup(ResourceGroup *group, ResourceGroup *parent, int
         }
         Q_EMIT resourceGroupAdded(group);
     }
-    Q_EMIT projectChanged();
+    emitProjectChanged();
 }
 
 void Project::takeResourceGroup(ResourceGroup *group)
@@ -1523,7 +1519,7 @@ void Project::takeResourceGroup(ResourceGroup *group)
         }
         Q_EMIT resourceGroupRemoved();
     }
-    Q_EMIT projectChanged();
+    emitProjectChanged();
 }
 
 const QList<ResourceGroup*> &Project::resourceGroups() const
@@ -1584,7 +1580,7 @@ void Project::addResource(Resource *resource, int index)
     m_resources.insert(i, resource);
     resource->setProject(this);
     Q_EMIT resourceAdded(resource);
-    Q_EMIT projectChanged();
+    emitProjectChanged();
 }
 
 bool Project::takeResource(Resource *resource)
@@ -1604,7 +1600,7 @@ bool Project::takeResource(Resource *resource)
     bool rem = m_resources.removeOne(resource);
     Q_ASSERT(!m_resources.contains(resource));
     Q_EMIT resourceRemoved();
-    Q_EMIT projectChanged();
+    emitProjectChanged();
     return rem;
 }
 
@@ -1698,7 +1694,7 @@ bool Project::addSubTask(Node* task, int index, Node* parent, bool emitSignal)
     connect(this, &Project::standardWorktimeChanged, task, &Node::slotStandardWorktimeChanged);
     if (emitSignal) {
         Q_EMIT nodeAdded(task);
-        Q_EMIT projectChanged();
+        emitProjectChanged();
         if (p != this && p->numChildren() == 1) {
             Q_EMIT nodeChanged(p, TypeProperty);
         }
@@ -1718,9 +1714,10 @@ void Project::takeTask(Node *node, bool emitSignal)
     if (emitSignal) Q_EMIT nodeToBeRemoved(node);
     disconnect(this, &Project::standardWorktimeChanged, node, &Node::slotStandardWorktimeChanged);
     parent->takeChildNode(node);
+    updateCriticalPathLists(nullptr);
     if (emitSignal) {
         Q_EMIT nodeRemoved(node);
-        Q_EMIT projectChanged();
+        emitProjectChanged();
         if (parent != this && parent->type() != Node::Type_Summarytask) {
             Q_EMIT nodeChanged(parent, TypeProperty);
         }
@@ -2467,7 +2464,7 @@ void Project::addCalendar(Calendar *calendar, Calendar *parent, int index)
     }
     setCalendarId(calendar);
     Q_EMIT calendarAdded(calendar);
-    Q_EMIT projectChanged();
+    emitProjectChanged();
 }
 
 void Project::takeCalendar(Calendar *calendar)
@@ -2487,7 +2484,7 @@ void Project::takeCalendar(Calendar *calendar)
     }
     Q_EMIT calendarRemoved(calendar);
     calendar->setProject(nullptr);
-    Q_EMIT projectChanged();
+    emitProjectChanged();
 }
 
 int Project::indexOf(const Calendar *calendar) const
@@ -2572,7 +2569,7 @@ void Project::setDefaultCalendar(Calendar *cal)
         cal->setDefault(true);
     }
     Q_EMIT defaultCalendarChanged(cal);
-    Q_EMIT projectChanged();
+    emitProjectChanged();
 }
 
 void Project::setStandardWorktime(StandardWorktime * worktime)
@@ -2689,7 +2686,7 @@ void Project::setWbsDefinition(const WBSDefinition &def)
     //debugPlan;
     m_wbsDefinition = def;
     Q_EMIT wbsDefinitionChanged();
-    Q_EMIT projectChanged();
+    emitProjectChanged();
 }
 
 QString Project::generateWBSCode(QList<int> &indexes, bool sortable) const
@@ -2731,7 +2728,7 @@ void Project::setCurrentSchedule(long id)
         r->setCurrentSchedule(id);
     }
     Q_EMIT currentScheduleChanged();
-    Q_EMIT projectChanged();
+    emitProjectChanged();
 }
 
 void Project::setCurrentScheduleManager(ScheduleManager *sm)
@@ -2818,7 +2815,7 @@ void Project::addScheduleManager(ScheduleManager *sm, ScheduleManager *parent, i
     m_managerIdMap.insert(sm->managerId(), sm);
 
     Q_EMIT scheduleManagerAdded(sm);
-    Q_EMIT projectChanged();
+    emitProjectChanged();
     //debugPlan<<"Added:"<<sm->name()<<", now"<<m_managers.count();
 }
 
@@ -2839,7 +2836,7 @@ int Project::takeScheduleManager(ScheduleManager *sm)
             sm->setParentManager(nullptr);
             m_managerIdMap.remove(sm->managerId());
             Q_EMIT scheduleManagerRemoved(sm);
-            Q_EMIT projectChanged();
+            emitProjectChanged();
         }
     } else {
         index = indexOf(sm);
@@ -2848,7 +2845,7 @@ int Project::takeScheduleManager(ScheduleManager *sm)
             m_managers.removeAt(indexOf(sm));
             m_managerIdMap.remove(sm->managerId());
             Q_EMIT scheduleManagerRemoved(sm);
-            Q_EMIT projectChanged();
+            emitProjectChanged();
         }
     }
     return index;
@@ -2961,6 +2958,41 @@ void Project::insertCalendarId(const QString &id, Calendar *calendar)
     calendarIdDict.insert(id, calendar);
 }
 
+void Project::beginChanges()
+{
+    if (m_changesLevel++ == 0) {
+        m_projectChangedPending = false;
+        Q_EMIT changesStarted();
+    }
+}
+
+void Project::endChanges()
+{
+    Q_ASSERT(m_changesLevel > 0);
+    if (m_changesLevel == 0 || --m_changesLevel > 0) {
+        return;
+    }
+    Q_EMIT changesFinished();
+    if (m_projectChangedPending) {
+        m_projectChangedPending = false;
+        Q_EMIT projectChanged();
+    }
+}
+
+bool Project::isChanging() const
+{
+    return m_changesLevel > 0;
+}
+
+void Project::emitProjectChanged()
+{
+    if (m_changesLevel > 0) {
+        m_projectChangedPending = true;
+    } else {
+        Q_EMIT projectChanged();
+    }
+}
+
 void Project::changed(Node *node, int property)
 {
     if (m_parent == nullptr) {
@@ -2968,7 +3000,7 @@ void Project::changed(Node *node, int property)
         if (property != Node::TypeProperty) {
             // add/remove node is handled elsewhere
             Q_EMIT nodeChanged(node, property);
-            Q_EMIT projectChanged();
+            emitProjectChanged();
         }
         return;
     }
@@ -2979,20 +3011,20 @@ void Project::changed(ResourceGroup *group)
 {
     Q_UNUSED(group)
     //debugPlan;
-    Q_EMIT projectChanged();
+    emitProjectChanged();
 }
 
 void Project::changed(ScheduleManager *sm, int property)
 {
     Q_EMIT scheduleManagerChanged(sm, property);
-    Q_EMIT projectChanged();
+    emitProjectChanged();
 }
 
 void Project::changed(MainSchedule *sch)
 {
     //debugPlan<<sch->id();
     Q_EMIT scheduleChanged(sch);
-    Q_EMIT projectChanged();
+    emitProjectChanged();
 }
 
 void Project::sendScheduleToBeAdded(const ScheduleManager *sm, int row)
@@ -3004,7 +3036,7 @@ void Project::sendScheduleAdded(const MainSchedule *sch)
 {
     //debugPlan<<sch->id();
     Q_EMIT scheduleAdded(sch);
-    Q_EMIT projectChanged();
+    emitProjectChanged();
 }
 
 void Project::sendScheduleToBeRemoved(const MainSchedule *sch)
@@ -3017,25 +3049,25 @@ void Project::sendScheduleRemoved(const MainSchedule *sch)
 {
     //debugPlan<<sch->id();
     Q_EMIT scheduleRemoved(sch);
-    Q_EMIT projectChanged();
+    emitProjectChanged();
 }
 
 void Project::changed(Resource *resource)
 {
     Q_UNUSED(resource)
-    Q_EMIT projectChanged();
+    emitProjectChanged();
 }
 
 void Project::changed(Calendar *cal)
 {
     Q_EMIT calendarChanged(cal);
-    Q_EMIT projectChanged();
+    emitProjectChanged();
 }
 
 void Project::changed(StandardWorktime *w)
 {
     Q_EMIT standardWorktimeChanged(w);
-    Q_EMIT projectChanged();
+    emitProjectChanged();
 }
 
 bool Project::addRelation(Relation *rel, bool check)
@@ -3049,8 +3081,9 @@ bool Project::addRelation(Relation *rel, bool check)
     Q_EMIT relationToBeAdded(rel, rel->parent()->numDependChildNodes(), rel->child()->numDependParentNodes());
     rel->parent()->addDependChildNode(rel);
     rel->child()->addDependParentNode(rel);
+    updateCriticalPathLists(rel);
     Q_EMIT relationAdded(rel);
-    Q_EMIT projectChanged();
+    emitProjectChanged();
     return true;
 }
 
@@ -3059,8 +3092,9 @@ void Project::takeRelation(Relation *rel)
     Q_EMIT relationToBeRemoved(rel);
     rel->parent() ->takeDependChildNode(rel);
     rel->child() ->takeDependParentNode(rel);
+    updateCriticalPathLists(rel);
     Q_EMIT relationRemoved(rel);
-    Q_EMIT projectChanged();
+    emitProjectChanged();
 }
 
 void Project::setRelationType(Relation *rel, Relation::Type type)
@@ -3068,7 +3102,7 @@ void Project::setRelationType(Relation *rel, Relation::Type type)
     Q_EMIT relationToBeModified(rel);
     rel->setType(type);
     Q_EMIT relationModified(rel);
-    Q_EMIT projectChanged();
+    emitProjectChanged();
 }
 
 void Project::setRelationLag(Relation *rel, const Duration &lag)
@@ -3076,7 +3110,7 @@ void Project::setRelationLag(Relation *rel, const Duration &lag)
     Q_EMIT relationToBeModified(rel);
     rel->setLag(lag);
     Q_EMIT relationModified(rel);
-    Q_EMIT projectChanged();
+    emitProjectChanged();
 }
 
 QList<Node*> Project::flatNodeList(Node *parent)
@@ -3202,6 +3236,10 @@ void Project::nodeDestroyed(QObject *obj)
 void Project::emitProjectCalculated(KPlato::Project *project, KPlato::ScheduleManager *sm)
 {
     Q_UNUSED(project)
+    if (sm && sm->expected()) {
+        // aggregate the new appointments while the views are updated
+        sm->expected()->buildTimePhasedCache();
+    }
     Q_EMIT projectCalculated(sm);
 }
 
@@ -114,7 +114,10 @@ public:
 
     using Node::saveWorkPackageXML;
     /// Save a workpackage document containing @p node with schedule identity @p id
+    /// If @p node is nullptr, only the project element is saved, see saveWorkPackageNodeXML()
     void saveWorkPackageXML(QDomElement &element, const Node *node, long id) const;
+    /// Save the workpackage data of @p node with schedule identity @p id to the @p project element
+    void saveWorkPackageNodeXML(QDomElement &project, const Node *node, long id) const;
 
     /**
      * Add the node @p task to the project, after node @p position
@@ -471,7 +474,6 @@ public:
     void setRelationLag(Relation *relation, const Duration &lag);
 
     void calcCriticalPathList(MainSchedule *cs);
-    void calcCriticalPathList(MainSchedule *cs, Node *node);
     /**
      * Returns the list of critical paths for schedule @p id
      */
@@ -538,6 +540,19 @@ public:
     void setFreedaysCalendar(Calendar *calendar);
     Calendar *freedaysCalendar() const;
 
+    /**
+     * Start a batch of changes, e.g. when a project is inserted or many commands are executed.
+     * Until the matching endChanges() projectChanged() is emitted at most once,
+     * and models may postpone updating until changesFinished() is emitted.
+     * The signals for each node, resource or relation are still emitted.
+     * Calls can be nested, only the outermost pair has effect.
+     */
+    void beginChanges();
+    /// End a batch of changes started with beginChanges()
+    void endChanges();
+    /// Return true if a batch of changes is in progress
+    bool isChanging() const;
+
 public Q_SLOTS:
     /// Sets m_progress to @p progress and emits signal sigProgress()
     /// If @p sm is not 0, progress is also set for the schedule manager
@@ -555,10 +570,16 @@ Q_SIGNALS:
     void aboutToBeDeleted();
     /// Emitted when anything in the project is changed (use with care)
     void projectChanged();
+    /// Emitted when a batch of changes is started, see beginChanges()
+    void changesStarted();
+    /// Emitted when a batch of changes is finished, before projectChanged(), see endChanges()
+    void changesFinished();
     /// Emitted when the WBS code definition has changed. This may change all nodes.
     void wbsDefinitionChanged();
     /// Emitted when a schedule has been calculated
     void projectCalculated(KPlato::ScheduleManager *sm);
+    /// Emitted when a new time-phased cache of the expected schedule of @p sm has been built, see MainSchedule::timePhasedCache()
+    void timePhasedCacheChanged(KPlato::ScheduleManager *sm);
     /// Emitted when the pointer to the current schedule has been changed
     void currentScheduleChanged();
     /// Use to show progress during calculation
@@ -715,6 +736,10 @@ private Q_SLOTS:
 
 private:
     void init();
+    /// Update the cached critical paths after @p relation changed, clear them if @p relation is null
+    void updateCriticalPathLists(const Relation *relation);
+    /// Emit projectChanged(), or postpone it to endChanges()
+    void emitProjectChanged();
 
     QHash<QString, ResourceGroup*> resourceGroupIdDict;
     QHash<QString, Resource*> resourceIdDict;
@@ -746,6 +771,8 @@ private:
     bool m_sharedResourcesLoaded;
     QString m_sharedResourcesFile;
     Calendar *m_freedaysCalendar= nullptr;
+    int m_changesLevel = 0;
+    bool m_projectChangedPending = false;
 
 public:
     class WorkPackageInfo {
@@ -27,7 +27,6 @@
 #include <KoXmlReader.h>
 
 #include <KLocalizedString>
-#include <KFormat>
 
 #include <QLocale>
 #include <QDomElement>
@@ -806,9 +805,7 @@ ulong ResourceRequestCollection::granularity() const
 bool ResourceRequestCollection::accepted(const Duration &estimate, const Duration &result, Schedule *ns) const
 {
     const auto deviation = estimate.milliseconds() - result.milliseconds();
-    if (ns) {
-        ns->logDebug(QStringLiteral("Deviation: %1").arg(KFormat().formatDuration(deviation, KFormat::FoldHours)));
-    }
+    scheduleLogDebug(ns, ScheduleLog::Event_EffortDeviation, deviation);
     if (deviation == 0) {
         return true;
     }
@@ -866,11 +863,9 @@ Duration ResourceRequestCollection::duration(const QList<ResourceRequest*> &lst,
         }
     }
     match = accepted(_effort, e, ns);
-    if (ns) ns->logDebug(QStringLiteral("days done: %1").arg(match?QStringLiteral("match"):QStringLiteral("nomatch")));
+    scheduleLogDebug(ns, ScheduleLog::Event_DurationMatch, ScheduleLog::Unit_Days, match);
     if (! match && day <= nDays) {
-#ifndef PLAN_NLOGDEBUG
-        if (ns) ns->logDebug(QStringLiteral("Days: duration ") + logtime.toString() + QStringLiteral(" - ") + end.toString() + QStringLiteral(" e=") + e.toString() + QStringLiteral(" (") + (_effort - e).toString() + QLatin1Char(')'));
-#endif
+        scheduleLogDebug(ns, ScheduleLog::Event_DurationStep, ScheduleLog::Unit_Days, ScheduleLog::time(logtime), ScheduleLog::time(end), e.milliseconds(), (_effort - e).milliseconds());
         logtime = start;
         for (int i=0; !match && i < 24; ++i) {
             // hours
@@ -895,12 +890,10 @@ Duration ResourceRequestCollection::duration(const QList<ResourceRequest*> &lst,
         }
         //debugPlan<<"duration"<<(backward?"backward":"forward:")<<start.toString()<<" e="<<e.toString()<<" ("<<e.milliseconds()<<")  match="<<match<<" sts="<<sts;
         match = accepted(_effort, e, ns);
-        if (ns) ns->logDebug(QStringLiteral("hours done: %1").arg(match?QStringLiteral("match"):QStringLiteral("nomatch")));
+        scheduleLogDebug(ns, ScheduleLog::Event_DurationMatch, ScheduleLog::Unit_Hours, match);
     }
     if (! match && day <= nDays) {
-#ifndef PLAN_NLOGDEBUG
-        if (ns) ns->logDebug(QStringLiteral("Hours: duration ") + logtime.toString() + QStringLiteral(" - ") + end.toString() + QStringLiteral(" e=") + e.toString() + QStringLiteral(" (") + (_effort - e).toString() + QLatin1Char(')'));
-#endif
+        scheduleLogDebug(ns, ScheduleLog::Event_DurationStep, ScheduleLog::Unit_Hours, ScheduleLog::time(logtime), ScheduleLog::time(end), e.milliseconds(), (_effort - e).milliseconds());
         logtime = start;
         for (int i=0; !match && i < 60; ++i) {
             //minutes
@@ -920,12 +913,10 @@ Duration ResourceRequestCollection::duration(const QList<ResourceRequest*> &lst,
         }
         //debugPlan<<"duration"<<(backward?"backward":"forward:")<<"  start="<<start.toString()<<" e="<<e.toString()<<" match="<<match<<" sts="<<sts;
         match = accepted(_effort, e, ns);
-        if (ns) ns->logDebug(QStringLiteral("minutes done: %1").arg(match?QStringLiteral("match"):QStringLiteral("nomatch")));
+        scheduleLogDebug(ns, ScheduleLog::Event_DurationMatch, ScheduleLog::Unit_Minutes, match);
     }
     if (! match && day <= nDays) {
-#ifndef PLAN_NLOGDEBUG
-        if (ns) ns->logDebug(QStringLiteral("Minutes: duration ") + logtime.toString() + QStringLiteral(" - ") + end.toString() + QStringLiteral(" e=") + e.toString() + QStringLiteral(" (") + (_effort - e).toString() + QLatin1Char(')'));
-#endif
+        scheduleLogDebug(ns, ScheduleLog::Event_DurationStep, ScheduleLog::Unit_Minutes, ScheduleLog::time(logtime), ScheduleLog::time(end), e.milliseconds(), (_effort - e).milliseconds());
         logtime = start;
         for (int i=0; !match && i < 60; ++i) {
             //seconds
@@ -944,12 +935,10 @@ Duration ResourceRequestCollection::duration(const QList<ResourceRequest*> &lst,
             //debugPlan<<"duration(s)["<<i<<"]"<<(backward?"backward":"forward:")<<" time="<<start.time().toString()<<" e="<<e.toString()<<" ("<<e.milliseconds()<<")";
         }
         match = accepted(_effort, e, ns);
-        if (ns) ns->logDebug(QStringLiteral("seconds done: %1").arg(match?QStringLiteral("match"):QStringLiteral("nomatch")));
+        scheduleLogDebug(ns, ScheduleLog::Event_DurationMatch, ScheduleLog::Unit_Seconds, match);
     }
     if (! match && day <= nDays) {
-#ifndef PLAN_NLOGDEBUG
-        if (ns) ns->logDebug(QStringLiteral("Seconds: duration ") + logtime.toString() + QStringLiteral(" - ") + end.toString() + QStringLiteral(" e=") + e.toString() + QStringLiteral(" (") + (_effort - e).toString() +QLatin1Char(')'));
-#endif
+        scheduleLogDebug(ns, ScheduleLog::Event_DurationStep, ScheduleLog::Unit_Seconds, ScheduleLog::time(logtime), ScheduleLog::time(end), e.milliseconds(), (_effort - e).milliseconds());
         for (int i=0; !match && i < 1000; ++i) {
             //milliseconds
             end.setTime(end.time().addMSecs(inc));
@@ -965,7 +954,7 @@ Duration ResourceRequestCollection::duration(const QList<ResourceRequest*> &lst,
             }
             //debugPlan<<"duration(ms)["<<i<<"]"<<(backward?"backward":"forward:")<<" time="<<start.time().toString()<<" e="<<e.toString()<<" ("<<e.milliseconds()<<")";
         }
-        if (ns) ns->logDebug(QStringLiteral("milliseconds done: %1").arg(match?QStringLiteral("match"):QStringLiteral("nomatch")));
+        scheduleLogDebug(ns, ScheduleLog::Event_DurationMatch, ScheduleLog::Unit_Milliseconds, match);
         match = accepted(_effort, e, ns);
     }
     if (!match && ns) {
@@ -24,7 +24,9 @@
 
 #include <KLocalizedString>
 
+#include <QElapsedTimer>
 #include <QStringList>
+#include <QtConcurrent>
 
 
 namespace KPlato
@@ -33,19 +35,24 @@ namespace KPlato
 class ScheduleManager;
 
 Schedule::Log::Log(const Node *n, int sev, const QString &msg, int ph)
-    : node(n), resource(nullptr), message(msg), severity(sev), phase(ph)
+    : node(n), resource(nullptr), message(msg), severity(sev), phase(ph), event(ScheduleLog::Event_None)
 {
     Q_ASSERT(n);
 //     debugPlan<<*this<<nodeId;
 }
 
 Schedule::Log::Log(const Node *n, const Resource *r, int sev, const QString &msg, int ph)
-    : node(n), resource(r), message(msg), severity(sev), phase(ph)
+    : node(n), resource(r), message(msg), severity(sev), phase(ph), event(ScheduleLog::Event_None)
 {
     Q_ASSERT(r);
 //     debugPlan<<*this<<resourceId;
 }
 
+Schedule::Log::Log(const ScheduleLog::Record &record)
+    : node(record.node), resource(record.resource), severity(record.severity), phase(record.phase), event(record.event), arguments(record.arguments)
+{
+}
+
 Schedule::Log::Log(const Log &other)
 {
     node = other.node;
@@ -53,6 +60,8 @@ Schedule::Log::Log(const Log &other)
     message = other.message;
     severity = other.severity;
     phase = other.phase;
+    event = other.event;
+    arguments = other.arguments;
 }
 
 Schedule::Log &Schedule::Log::operator=(const Schedule::Log &other)
@@ -62,6 +71,8 @@ Schedule::Log &Schedule::Log::operator=(const Schedule::Log &other)
     message = other.message;
     severity = other.severity;
     phase = other.phase;
+    event = other.event;
+    arguments = other.arguments;
     return *this;
 }
 
@@ -358,6 +369,7 @@ void Schedule::insertBackwardNode(Node *node)
 // used (directly) when appointment wants to attach itself again
 bool Schedule::attach(Appointment *appointment)
 {
+    appointmentsChanged();
     int mode = appointment->calculationMode();
     //debugPlan<<appointment<<mode;
     if (mode == Scheduling) {
@@ -395,6 +407,11 @@ bool Schedule::attach(Appointment *appointment)
 }
 
 // used to add new schedules
+void Schedule::addAppointment(Schedule *other, const DateTime &start, const DateTime &end, double load)
+{
+    addAppointment(other, AppointmentInterval(start, end, load));
+}
+
 bool Schedule::add(Appointment *appointment)
 {
     //debugPlan<<this;
@@ -406,6 +423,7 @@ void Schedule::takeAppointment(Appointment *appointment, int mode)
 {
     Q_UNUSED(mode);
     //debugPlan<<"("<<this<<")"<<mode<<":"<<appointment<<","<<appointment->calculationMode();
+    appointmentsChanged();
     int i = m_forward.indexOf(appointment);
     if (i != -1) {
         m_forward.removeAt(i);
@@ -557,6 +575,10 @@ EffortCostMap Schedule::bcwsPrDay(EffortCostCalculationType type)
 EffortCostMap Schedule::plannedEffortCostPrDay(const QDate &start, const QDate &end, EffortCostCalculationType type) const
 {
     //debugPlan<<m_name<<m_appointments;
+    const AppointmentStore store = appointmentStore();
+    if (store.isValid() && store.appointmentCount(this) == m_appointments.count()) {
+        return store.plannedPrDay(this, start, end, type);
+    }
     EffortCostMap ec;
     QListIterator<Appointment*> it(m_appointments);
     while (it.hasNext()) {
@@ -569,11 +591,14 @@ EffortCostMap Schedule::plannedEffortCostPrDay(const QDate &start, const QDate &
 EffortCostMap Schedule::plannedEffortCostPrDay(const Resource *resource, const QDate &start, const QDate &end, EffortCostCalculationType type) const
 {
     //debugPlan<<m_name<<m_appointments;
+    const AppointmentStore store = appointmentStore();
+    if (store.isValid() && store.appointmentCount(this) == m_appointments.count()) {
+        return store.plannedPrDay(this, resource, start, end, type);
+    }
     EffortCostMap ec;
     for (const Appointment *a : qAsConst(m_appointments)) {
         if (a->resource() && a->resource()->resource() == resource) {
             ec += a->plannedPrDay(start, end, type);
-            break;
         }
     }
     return ec;
@@ -696,12 +721,41 @@ void Schedule::addLog(const Schedule::Log &log)
     }
 }
 
+void Schedule::addLogRecord(const ScheduleLog::Record &record)
+{
+    if (m_parent) {
+        m_parent->addLogRecord(record);
+    }
+}
+
+AppointmentStore Schedule::appointmentStore() const
+{
+    return m_parent ? m_parent->appointmentStore() : AppointmentStore();
+}
+
+void Schedule::appointmentsChanged()
+{
+    if (m_parent) {
+        m_parent->appointmentsChanged();
+    }
+}
+
+QString Schedule::Log::text() const
+{
+    if (event == ScheduleLog::Event_None) {
+        return message;
+    }
+    const Node *project = node ? node->projectNode() : nullptr;
+    const QTimeZone tz = project && project->type() == Node::Type_Project ? static_cast<const Project*>(project)->timeZone() : QTimeZone();
+    return ScheduleLog::message(event, arguments, tz);
+}
+
 QString Schedule::Log::formatMsg() const
  {
     QString s;
     s += node ? QStringLiteral("%1 ").arg(node->name(), -8) : QString();
     s += resource ? QStringLiteral("%1 ").arg(resource->name(), -8) : QString();
-    s += message;
+    s += text();
     return s;
 }
 
@@ -832,16 +886,16 @@ void NodeSchedule::saveXML(QDomElement &element) const
     sch.setAttribute(QStringLiteral("free-float"), freeFloat.toString());
 }
 
-void NodeSchedule::addAppointment(Schedule *resource, const DateTime &start, const DateTime &end, double load)
+void NodeSchedule::addAppointment(Schedule *resource, const AppointmentInterval &interval)
 {
     //debugPlan;
     Appointment * a = findAppointment(resource, this, m_calculationMode);
     if (a != nullptr) {
         //debugPlan<<"Add interval to existing"<<a;
-        a->addInterval(start, end, load);
+        a->addInterval(interval);
         return ;
     }
-    a = new Appointment(resource, this, start, end, load);
+    a = new Appointment(resource, this, interval);
     bool result = add(a);
     Q_ASSERT (result);
     result = resource->add(a);
@@ -917,6 +971,15 @@ void NodeSchedule::logDebug(const QString &msg, int phase)
     }
 }
 
+void NodeSchedule::addLogRecord(const ScheduleLog::Record &record)
+{
+    if (m_parent) {
+        ScheduleLog::Record r = record;
+        r.node = m_node;
+        m_parent->addLogRecord(r);
+    }
+}
+
 //-----------------------------------------------
 ResourceSchedule::ResourceSchedule()
         : Schedule(),
@@ -966,17 +1029,17 @@ ResourceSchedule::~ResourceSchedule()
 }
 
 // called from the resource
-void ResourceSchedule::addAppointment(Schedule *node, const DateTime &start, const DateTime &end, double load)
+void ResourceSchedule::addAppointment(Schedule *node, const AppointmentInterval &interval)
 {
-    Q_ASSERT(start < end);
+    Q_ASSERT(interval.isValid());
     //debugPlan<<"("<<this<<")"<<node<<","<<m_calculationMode;
     Appointment * a = findAppointment(this, node, m_calculationMode);
     if (a != nullptr) {
         //debugPlan<<"Add interval to existing"<<a;
-        a->addInterval(start, end, load);
+        a->addInterval(interval);
         return ;
     }
-    a = new Appointment(this, node, start, end, load);
+    a = new Appointment(this, node, interval);
     bool result = add(a);
     Q_ASSERT (result == true);
     result = node->add(a);
@@ -1178,6 +1241,28 @@ void ResourceSchedule::logDebug(const QString &msg, int phase)
     }
 }
 
+void ResourceSchedule::addLogRecord(const ScheduleLog::Record &record)
+{
+    if (m_parent) {
+        ScheduleLog::Record r = record;
+        r.node = m_nodeSchedule ? m_nodeSchedule->node() : nullptr;
+        r.resource = m_resource;
+        m_parent->addLogRecord(r);
+    }
+}
+
+AppointmentStore ResourceSchedule::appointmentStore() const
+{
+    return m_parent ? m_parent->appointmentStore() : AppointmentStore();
+}
+
+void ResourceSchedule::appointmentsChanged()
+{
+    if (m_parent) {
+        m_parent->appointmentsChanged();
+    }
+}
+
 //--------------------------------------
 MainSchedule::MainSchedule()
     : NodeSchedule(),
@@ -1201,6 +1286,10 @@ MainSchedule::MainSchedule(Node *node, const QString& name, Schedule::Type type,
 MainSchedule::~MainSchedule()
 {
     //debugPlan<<"("<<this<<")";
+    if (m_timePhasedWatcher) {
+        m_timePhasedWatcher->waitForFinished();
+        delete m_timePhasedWatcher;
+    }
 }
 
 void MainSchedule::incProgress()
@@ -1402,6 +1491,7 @@ void MainSchedule::clearCriticalPathList()
     m_pathlists.clear();
     m_currentCriticalPath = nullptr;
     criticalPathListCached = false;
+    m_criticalPathEngine.clear();
 }
 
 QList<Node*> *MainSchedule::currentCriticalPath() const
@@ -1430,12 +1520,154 @@ void MainSchedule::addCriticalPathNode(Node *node)
 
 QVector<Schedule::Log> MainSchedule::logs() const
 {
+    const_cast<MainSchedule*>(this)->flushLogRecords();
     return m_log;
 }
 
+void MainSchedule::clearLogs()
+{
+    m_logRecords.clear();
+    m_log.clear();
+    m_logPhase.clear();
+    m_phaseStartTimes.clear();
+}
+
+void MainSchedule::setPhaseName(int phase, const QString &name)
+{
+    m_logPhase[phase] = name;
+    QElapsedTimer timer;
+    timer.start();
+    m_phaseStartTimes[phase] = timer.msecsSinceReference();
+}
+
+AppointmentStore MainSchedule::appointmentStore() const
+{
+    QMutexLocker locker(&m_appointmentStoreMutex);
+    const int revision = appointmentRevision();
+    if (!m_appointmentStore.isValid() || m_appointmentStore.revision() != revision) {
+        const Project *project = node() && node()->type() == Node::Type_Project ? static_cast<const Project*>(node()) : nullptr;
+        if (!project) {
+            return AppointmentStore();
+        }
+        QList<Schedule*> schedules;
+        const QList<Node*> nodes = project->allNodes();
+        for (const Node *n : nodes) {
+            Schedule *s = n->findSchedule(m_id);
+            if (s) {
+                schedules << s;
+            }
+        }
+        m_appointmentStore.build(schedules, revision);
+    }
+    // the copy stays valid even if the store is rebuilt by another caller
+    return m_appointmentStore;
+}
+
+void MainSchedule::appointmentsChanged()
+{
+    m_appointmentRevision.ref();
+}
+
+TimePhasedCache MainSchedule::timePhasedCache() const
+{
+    QMutexLocker locker(&m_timePhasedCacheMutex);
+    if (m_timePhasedWatcher && m_timePhasedWatcher->isFinished()) {
+        takeTimePhasedCache();
+    }
+    const bool current = m_timePhasedCache.isValid() && m_timePhasedCache.revision() == appointmentRevision();
+    locker.unlock();
+    if (!current) {
+        buildTimePhasedCache();
+    }
+    locker.relock();
+    // the last built cache, the caller checks the revision if it must be current
+    return m_timePhasedCache;
+}
+
+void MainSchedule::takeTimePhasedCache() const
+{
+    const TimePhasedCache cache = m_timePhasedWatcher->result();
+    if (!m_timePhasedCache.isValid() || cache.revision() >= m_timePhasedCache.revision()) {
+        m_timePhasedCache = cache;
+    }
+    m_timePhasedWatcher->deleteLater();
+    m_timePhasedWatcher = nullptr;
+}
+
+void MainSchedule::buildTimePhasedCache() const
+{
+    // The store is built here, in the thread that owns the appointments.
+    // The worker only aggregates a copy of it.
+    const AppointmentStore store = appointmentStore();
+    if (!store.isValid()) {
+        return;
+    }
+    QMutexLocker locker(&m_timePhasedCacheMutex);
+    if (m_timePhasedCache.isValid() && m_timePhasedCache.revision() == store.revision()) {
+        return;
+    }
+    if (m_timePhasedWatcher) {
+        if (m_timePhasedRevision == store.revision()) {
+            return;
+        }
+        // a running build is not stopped, its result is just dropped
+        QObject::disconnect(m_timePhasedWatcher, nullptr, nullptr, nullptr);
+        m_timePhasedWatcher->deleteLater();
+    }
+    m_timePhasedRevision = store.revision();
+    m_timePhasedWatcher = new QFutureWatcher<TimePhasedCache>();
+    QObject::connect(m_timePhasedWatcher, &QFutureWatcherBase::finished, m_timePhasedWatcher, [this]() {
+        QMutexLocker locker(&m_timePhasedCacheMutex);
+        if (m_timePhasedWatcher) {
+            takeTimePhasedCache();
+        }
+        locker.unlock();
+        if (m_manager) {
+            Q_EMIT m_manager->project().timePhasedCacheChanged(m_manager);
+        }
+    });
+    m_timePhasedWatcher->setFuture(QtConcurrent::run(&TimePhasedCache::create, store));
+}
+
+void MainSchedule::addLogRecord(const ScheduleLog::Record &record)
+{
+    ScheduleLog::Record r = record;
+    if (!r.node && !r.resource) {
+        r.node = node();
+    }
+    m_logRecords.append(r);
+    if (m_logRecords.count() == 1) {
+        m_logRecordTimer.start();
+    }
+    // let the log view follow a long calculation
+    if (m_logRecords.count() >= LogRecordBatchSize || m_logRecordTimer.hasExpired(LogRecordFlushInterval)) {
+        flushLogRecords();
+    }
+}
+
+void MainSchedule::flushLogRecords()
+{
+    if (m_logRecords.isEmpty()) {
+        return;
+    }
+    const int first = m_log.count();
+    for (ScheduleLog::Record r : qAsConst(m_logRecords)) {
+        if (r.phase == -1 && !m_log.isEmpty()) {
+            r.phase = m_log.last().phase;
+        }
+        m_log.append(Schedule::Log(r));
+    }
+    m_logRecords.clear();
+    if (m_manager) {
+        m_manager->logsAdded(m_log.mid(first));
+    }
+}
+
 void MainSchedule::addLog(const KPlato::Schedule::Log &log)
 {
     Q_ASSERT(log.resource || log.node);
+    // keep the order of messages
+    flushLogRecords();
 #ifndef NDEBUG
     if (log.resource) {
         Q_ASSERT(manager()->project().findResource(log.resource->id()) == log.resource);
@@ -1871,6 +2103,16 @@ void ScheduleManager::logAdded(const Schedule::Log &log)
     Q_EMIT logInserted(expected(), row, row);
 }
 
+void ScheduleManager::logsAdded(const QVector<KPlato::Schedule::Log> &logs)
+{
+    if (logs.isEmpty()) {
+        return;
+    }
+    Q_EMIT sigLogsAdded(logs);
+    int last = expected()->logs().count() - 1;
+    Q_EMIT logInserted(expected(), last - logs.count() + 1, last);
+}
+
 void ScheduleManager::slotAddLog(const QVector<KPlato::Schedule::Log> &log)
 {
     if (expected() && ! log.isEmpty()) {
@@ -1899,6 +2141,18 @@ void ScheduleManager::setPhaseNames(const QMap<int, QString> &phasenames)
 }
 
 void ScheduleManager::saveXML(QDomElement &element) const
+{
+    QDomElement el = saveManagerXML(element);
+    if (m_expected && ! m_expected->isDeleted()) {
+        QDomElement schs = el.firstChildElement(QStringLiteral("project-schedule"));
+        m_project.saveAppointments(schs, m_expected->id());
+    }
+    for (ScheduleManager *sm : qAsConst(m_children)) {
+        sm->saveXML(el);
+    }
+}
+
+QDomElement ScheduleManager::saveManagerXML(QDomElement &element) const
 {
     QDomElement el = element.ownerDocument().createElement(QStringLiteral("schedule-management"));
     element.appendChild(el);
@@ -1919,12 +2173,8 @@ void ScheduleManager::saveXML(QDomElement &element) const
         QDomElement schs = el.ownerDocument().createElement(QStringLiteral("project-schedule"));
         el.appendChild(schs);
         m_expected->saveXML(schs);
-        m_project.saveAppointments(schs, m_expected->id());
     }
-    for (ScheduleManager *sm : qAsConst(m_children)) {
-        sm->saveXML(el);
-    }
-
+    return el;
 }
 
 void ScheduleManager::saveWorkPackageXML(QDomElement &element, const Node &node) const
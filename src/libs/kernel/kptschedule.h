@@ -15,9 +15,17 @@
 #include "kpteffortcostmap.h"
 #include "kptdatetime.h"
 #include "kptduration.h"
-
+#include "ScheduleLog.h"
+#include "AppointmentStore.h"
+#include "TimePhasedCache.h"
+#include "CriticalPathEngine.h"
+
+#include <QAtomicInt>
+#include <QElapsedTimer>
+#include <QFutureWatcher>
 #include <QList>
 #include <QMap>
+#include <QMutex>
 #include <QString>
 
 //#include "KoXmlReaderForward.h"
@@ -30,6 +38,7 @@ namespace KPlato
 {
 
 class Appointment;
+class AppointmentInterval;
 class Node;
 class Project;
 class Task;
@@ -127,7 +136,9 @@ public:
     /// Adds appointment to this schedule only
     virtual bool add(Appointment *appointment);
     /// Adds appointment to both this resource schedule and node schedule
-    virtual void addAppointment(Schedule * /*other*/, const DateTime & /*start*/, const DateTime & /*end*/, double /*load*/ = 100) {}
+    void addAppointment(Schedule *other, const DateTime &start, const DateTime &end, double load = 100);
+    /// Adds the appointment @p interval to both this resource schedule and node schedule
+    virtual void addAppointment(Schedule * /*other*/, const AppointmentInterval & /*interval*/) {}
     /// Removes appointment without deleting it.
     virtual void takeAppointment(Appointment *appointment, int type = Scheduling);
     Appointment *findAppointment(Schedule *resource, Schedule *node, int type = Scheduling);
@@ -155,6 +166,10 @@ public:
     virtual EffortCostMap bcwsPrDay(EffortCostCalculationType type = ECCT_All) const;
     virtual EffortCostMap plannedEffortCostPrDay(const QDate &start, const QDate &end, EffortCostCalculationType type = ECCT_All) const;
     virtual EffortCostMap plannedEffortCostPrDay(const Resource *resource, const QDate &start, const QDate &end, EffortCostCalculationType type = ECCT_All) const;
+    /// Return the appointment store of the main schedule, an empty store if not available
+    virtual AppointmentStore appointmentStore() const;
+    /// Called when an appointment to this schedule has changed
+    virtual void appointmentsChanged();
     
     /// Returns the total planned effort for @p resource this schedule
     virtual Duration plannedEffort(const Resource *resource, EffortCostCalculationType type = ECCT_All) const;
@@ -230,10 +245,12 @@ public:
         public:
             enum Type { Type_Debug = 0, Type_Info, Type_Warning, Type_Error };
             Log() 
-                : node(nullptr), resource(nullptr), severity(0), phase(-1)
+                : node(nullptr), resource(nullptr), severity(0), phase(-1), event(ScheduleLog::Event_None)
             {}
             Log(const Node *n, int sev, const QString &msg, int ph = -1);
             Log(const Node *n, const Resource *r, int sev, const QString &msg, int ph = -1);
+            /// Create a log from a structured @p record, the message text is generated by text()
+            explicit Log(const ScheduleLog::Record &record);
             Log(const Log &other);
 
             Log &operator=(const Log &other);
@@ -243,10 +260,16 @@ public:
             QString message;
             int severity;
             int phase;
+            int event;
+            ScheduleLog::Arguments arguments;
 
+            /// Return the message, generated from event and arguments if needed
+            QString text() const;
             QString formatMsg() const;
     };
     virtual void addLog(const Log &log);
+    /// Add a structured log record, see scheduleLogDebug()
+    virtual void addLogRecord(const ScheduleLog::Record &record);
     virtual void clearLogs() {};
     virtual void logError(const QString &, int = -1) {}
     virtual void logWarning(const QString &, int = -1) {}
@@ -380,7 +403,8 @@ public:
     void saveXML(QDomElement &element) const override;
 
     // tasks------------>
-    void addAppointment(Schedule *resource, const DateTime &start, const DateTime &end, double load = 100) override;
+    using Schedule::addAppointment;
+    void addAppointment(Schedule *resource, const AppointmentInterval &interval) override;
     void takeAppointment(Appointment *appointment, int type = Schedule::Scheduling) override;
 
     Node *node() const override { return m_node; }
@@ -395,6 +419,7 @@ public:
     void logWarning(const QString &msg, int phase = -1) override;
     void logInfo(const QString &msg, int phase = -1) override;
     void logDebug(const QString &, int = -1) override;
+    void addLogRecord(const ScheduleLog::Record &record) override;
 
 protected:
     void init();
@@ -417,7 +442,8 @@ public:
 
     bool isDeleted() const override
     { return m_parent == nullptr ? true : m_parent->isDeleted(); }
-    void addAppointment(Schedule *node, const DateTime &start, const DateTime &end, double load = 100) override;
+    using Schedule::addAppointment;
+    void addAppointment(Schedule *node, const AppointmentInterval &interval) override;
     void takeAppointment(Appointment *appointment, int type = Scheduling) override;
 
     bool isOverbooked() const override;
@@ -434,6 +460,9 @@ public:
     void logWarning(const QString &msg, int phase = -1) override;
     void logInfo(const QString &msg, int phase = -1) override;
     void logDebug(const QString &, int = -1) override;
+    void addLogRecord(const ScheduleLog::Record &record) override;
+    AppointmentStore appointmentStore() const override;
+    void appointmentsChanged() override;
 
     void setNodeSchedule(const Schedule *sch) { m_nodeSchedule = sch; }
     
@@ -507,14 +536,49 @@ public:
         return m_pathlists.count() <= index ? lst : m_pathlists[ index ];
     }
     void addCriticalPathNode(Node *node);
+    /// The engine that calculates and caches the critical paths
+    CriticalPathEngine &criticalPathEngine() { return m_criticalPathEngine; }
     
     QVector<Schedule::Log> logs() const;
     void setLog(const QVector<Schedule::Log> &log) { m_log = log; }
     void addLog(const Schedule::Log &log) override;
-    void clearLogs() override { m_log.clear(); m_logPhase.clear(); }
+    void addLogRecord(const ScheduleLog::Record &record) override;
+    /// Return a shared copy of the appointment store, (re)built if any appointment has changed
+    AppointmentStore appointmentStore() const override;
+    /// Increments the appointment revision
+    void appointmentsChanged() override;
+    /// Return the revision of the appointments of this schedule, incremented on every change
+    int appointmentRevision() const { return m_appointmentRevision.loadAcquire(); }
+    /**
+     * Return the last built cache of the effort aggregated per period.
+     * If any appointment has changed since, a new cache is built in a worker thread
+     * and Project::timePhasedCacheChanged() is emitted when it is ready.
+     * The cache is never built here, so compare its revision with appointmentRevision()
+     * if it must be current.
+     * The returned cache is a shared copy, it is not changed when the appointments change.
+     * It is not valid if it has never been built.
+     */
+    TimePhasedCache timePhasedCache() const;
+    /// Start building the time-phased cache in a worker thread, unless it is current or already being built
+    void buildTimePhasedCache() const;
+    /// Pending log records are flushed when this many records are pending
+    static const int LogRecordBatchSize = 256;
+    /// or when the first pending record has waited this long (ms)
+    static const int LogRecordFlushInterval = 250;
+    /**
+     * Move pending log records into the log.
+     * Records added with addLogRecord() are kept pending while scheduling
+     * and flushed in batches, see LogRecordBatchSize and LogRecordFlushInterval,
+     * when scheduling finishes and when the log is read.
+     */
+    void flushLogRecords();
+    void clearLogs() override;
     
-    void setPhaseName(int phase, const QString &name) { m_logPhase[ phase ] = name; }
+    /// Set the name of @p phase and register the time the phase started
+    void setPhaseName(int phase, const QString &name);
     QString logPhase(int phase) const { return m_logPhase.value(phase); }
+    /// Return the monotonic time (ms, see QElapsedTimer::msecsSinceReference()) @p phase started, or -1 if not started
+    qint64 phaseStartTime(int phase) const { return m_phaseStartTimes.value(phase, -1); }
     static QString logSeverity(int severity);
     QMap<int, QString> phaseNames() const { return m_logPhase; }
     void setPhaseNames(const QMap<int, QString> &pn) { m_logPhase = pn; }
@@ -529,6 +593,10 @@ public:
 protected:
     void changed(Schedule *sch) override;
 
+private:
+    /// Take the result of the finished worker, m_timePhasedCacheMutex must be locked
+    void takeTimePhasedCache() const;
+
 private:
     friend class Project;
     
@@ -542,10 +610,23 @@ private:
     QList<Node*> m_summarytasks;
     
     QList<Node*> *m_currentCriticalPath;
+    CriticalPathEngine m_criticalPathEngine;
     
     
     QVector<Schedule::Log> m_log;
     QMap<int, QString> m_logPhase;
+    QMap<int, qint64> m_phaseStartTimes;
+    QVector<ScheduleLog::Record> m_logRecords;
+    QElapsedTimer m_logRecordTimer; // started when the first record is pending
+
+    QAtomicInt m_appointmentRevision;
+    mutable QMutex m_appointmentStoreMutex;
+    mutable AppointmentStore m_appointmentStore;
+
+    mutable QMutex m_timePhasedCacheMutex;
+    mutable TimePhasedCache m_timePhasedCache;
+    mutable QFutureWatcher<TimePhasedCache> *m_timePhasedWatcher = nullptr;
+    mutable int m_timePhasedRevision = 0;
 };
 
 /**
@@ -640,6 +721,8 @@ public:
 
     // NOTE: Saving is done here, loading is done using the XmlLoaderObject
     void saveXML(QDomElement &element) const;
+    /// Save the schedule management element and the project schedule, without appointments and sub-managers
+    QDomElement saveManagerXML(QDomElement &element) const;
     
     /// Save a workpackage document
     void saveWorkPackageXML(QDomElement &element, const Node &node) const;
@@ -672,6 +755,9 @@ public:
     /// Log added by MainSchedule
     /// Emits sigLogAdded() to enable synchronization between schedules
     void logAdded(const Schedule::Log &log);
+    /// Logs added by MainSchedule when log records are flushed
+    /// Emits sigLogsAdded()
+    void logsAdded(const QVector<KPlato::Schedule::Log> &logs);
 
     /// Create and load a MainSchedule
     //MainSchedule *loadMainSchedule(KoXmlElement &element, XMLLoaderObject &status);
@@ -721,6 +807,9 @@ Q_SIGNALS:
     /// Emitted by logAdded()
     /// Used by scheduling thread
     void sigLogAdded(const KPlato::Schedule::Log &log);
+    /// Emitted by logsAdded()
+    /// Used by scheduling thread
+    void sigLogsAdded(const QVector<KPlato::Schedule::Log> &logs);
 
 protected:
     Project &m_project;
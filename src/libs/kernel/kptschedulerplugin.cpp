@@ -121,6 +121,8 @@ void SchedulerPlugin::haltCalculation(SchedulerThread *job)
 
 void SchedulerPlugin::cancelScheduling(SchedulingContext &context)
 {
+    context.cancelScheduling = true;
+    QMutexLocker locker(&m_jobsMutex);
     for (SchedulerThread *j : qAsConst(m_jobs)) {
        j->cancelScheduling(context);
     }
@@ -324,6 +326,12 @@ void SchedulerThread::slotAddLog(const KPlato::Schedule::Log &log)
     m_logs << log;
 }
 
+void SchedulerThread::slotAddLogs(const QVector<KPlato::Schedule::Log> &logs)
+{
+    QMutexLocker m(&m_logMutex);
+    m_logs << logs;
+}
+
 QVector<Schedule::Log> SchedulerThread::takeLog()
 {
     QMutexLocker m(&m_logMutex);
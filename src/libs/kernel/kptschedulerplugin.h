@@ -106,8 +106,10 @@ public:
     /// Returns false if the plugin does not support this option.
     bool scheduleInParallel() const;
 
-    /// Schedule all projects
-    /// Not threaded, used by portfolio
+    /// Schedule all projects in @p context, used by portfolio.
+    /// This is called in a worker thread. The documents in @p context are private
+    /// copies, the caller merges the result into the real projects.
+    /// Must not touch any ui and must not call KoDocument::setModified().
     virtual void schedule(SchedulingContext &context);
 
 public Q_SLOTS:
@@ -134,6 +136,8 @@ private:
 protected:
     QTimer m_synctimer;
     QList<SchedulerThread*> m_jobs;
+    /// Protects m_jobs when schedule() runs in a worker thread
+    QMutex m_jobsMutex;
 
     int m_granularityIndex;
     QList<long unsigned int> m_granularities;
@@ -205,8 +209,7 @@ public:
     static void updateResource(const KPlato::Resource *tr, Resource *r, XMLLoaderObject &status);
     static void updateAppointments(const Project *tp, const ScheduleManager *tm, Project *mp, ScheduleManager *sm, XMLLoaderObject &status);
 
-    /// Schedule all projects
-    /// Not threaded, used by portfolio
+    /// Schedule all projects in @p context, see SchedulerPlugin::schedule()
     virtual void schedule(SchedulingContext &context);
 
 Q_SIGNALS:
@@ -237,6 +240,7 @@ protected Q_SLOTS:
     void setProgress(int);
 
     void slotAddLog(const KPlato::Schedule::Log &log);
+    void slotAddLogs(const QVector<KPlato::Schedule::Log> &logs);
 
 protected:
     /// Re-implement to do the job
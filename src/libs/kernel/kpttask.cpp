@@ -1650,9 +1650,7 @@ DateTime Task::scheduleFromStartTime(int use) {
             } else {
                 cs->startTime = workTimeAfter(cs->startTime, cs);
             }
-#ifndef PLAN_NLOGDEBUG
-            cs->logDebug(QStringLiteral("ASAP: ") + cs->startTime.toString() + QStringLiteral(" earliest: ") + cs->earlyStart.toString());
-#endif
+            scheduleLogDebug(cs, ScheduleLog::Event_ScheduleAsap, ScheduleLog::time(cs->startTime), ScheduleLog::time(cs->earlyStart));
             cs->duration = duration(cs->startTime, use, false);
             cs->endTime = cs->startTime + cs->duration;
             makeAppointments();
@@ -2437,9 +2435,7 @@ Duration Task::length(const DateTime &time, KPlato::Duration duration, Schedule
 #endif
         return duration;
     }
-#ifndef PLAN_NLOGDEBUG
-    if (sch) sch->logDebug(QStringLiteral("Calculate length from: ") + time.toString());
-#endif
+    scheduleLogDebug(sch, ScheduleLog::Event_LengthFrom, ScheduleLog::time(time));
     DateTime logtime = time;
     bool sts=true;
     bool match = false;
@@ -2465,9 +2461,7 @@ Duration Task::length(const DateTime &time, KPlato::Duration duration, Schedule
         }
     }
     if (! match) {
-#ifndef PLAN_NLOGDEBUG
-        if (sch) sch->logDebug(QStringLiteral("Days: duration ") + logtime.toString() + QStringLiteral(" - ") + end.toString() + QStringLiteral(" = ") + l.toString() + QStringLiteral(" (") + (duration - l).toString() + QLatin1Char(')'));
-#endif
+        scheduleLogDebug(sch, ScheduleLog::Event_LengthStep, ScheduleLog::Unit_Days, ScheduleLog::time(logtime), ScheduleLog::time(end), l.milliseconds(), (duration - l).milliseconds());
         logtime = start;
         for (int i=0; !match && i < 24; ++i) {
             // hours
@@ -2488,9 +2482,7 @@ Duration Task::length(const DateTime &time, KPlato::Duration duration, Schedule
         //debugPlan<<"duration"<<(backward?"backward":"forward:")<<start.toString()<<" l="<<l.toString()<<" ("<<l.milliseconds()<<")  match="<<match<<" sts="<<sts;
     }
     if (! match) {
-#ifndef PLAN_NLOGDEBUG
-        if (sch) sch->logDebug(QStringLiteral("Hours: duration ") + logtime.toString() + QStringLiteral(" - ") + end.toString() + QStringLiteral(" = ") + l.toString() + QStringLiteral(" (") + (duration - l).toString() + QLatin1Char(')'));
-#endif
+        scheduleLogDebug(sch, ScheduleLog::Event_LengthStep, ScheduleLog::Unit_Hours, ScheduleLog::time(logtime), ScheduleLog::time(end), l.milliseconds(), (duration - l).milliseconds());
         logtime = start;
         for (int i=0; !match && i < 60; ++i) {
             //minutes
@@ -2511,9 +2503,7 @@ Duration Task::length(const DateTime &time, KPlato::Duration duration, Schedule
         //debugPlan<<"duration"<<(backward?"backward":"forward:")<<"  start="<<start.toString()<<" l="<<l.toString()<<" match="<<match<<" sts="<<sts;
     }
     if (! match) {
-#ifndef PLAN_NLOGDEBUG
-        if (sch) sch->logDebug(QStringLiteral("Minutes: duration ") + logtime.toString() + QStringLiteral(" - ") + end.toString() + QStringLiteral(" = ") + l.toString() + QStringLiteral(" (") + (duration - l).toString() + QLatin1Char(')'));
-#endif
+        scheduleLogDebug(sch, ScheduleLog::Event_LengthStep, ScheduleLog::Unit_Minutes, ScheduleLog::time(logtime), ScheduleLog::time(end), l.milliseconds(), (duration - l).milliseconds());
         logtime = start;
         for (int i=0; !match && i < 60 && sts; ++i) {
             //seconds
@@ -2533,9 +2523,7 @@ Duration Task::length(const DateTime &time, KPlato::Duration duration, Schedule
         }
     }
     if (! match) {
-#ifndef PLAN_NLOGDEBUG
-        if (sch) sch->logDebug(QStringLiteral("Seconds: duration ") + logtime.toString() + QStringLiteral(" - ") + end.toString() + QStringLiteral(" l ") + l.toString() + QStringLiteral(" (") + (duration - l).toString() + QLatin1Char(')'));
-#endif
+        scheduleLogDebug(sch, ScheduleLog::Event_LengthStep, ScheduleLog::Unit_Seconds, ScheduleLog::time(logtime), ScheduleLog::time(end), l.milliseconds(), (duration - l).milliseconds());
         for (int i=0; !match && i < 1000; ++i) {
             //milliseconds
             end.setTime(end.time().addMSecs(inc));
@@ -2569,17 +2557,13 @@ Duration Task::length(const DateTime &time, KPlato::Duration duration, Schedule
                 t = cal->firstAvailableBefore(end, projectNode()->constraintStartTime());
             }
         }
-#ifndef PLAN_NLOGDEBUG
-        if (sch) sch->logDebug(QStringLiteral("Moved end to work: ") + end.toString() + QStringLiteral(" -> ") + t.toString());
-#endif
+        scheduleLogDebug(sch, ScheduleLog::Event_LengthMovedEnd, ScheduleLog::time(end), ScheduleLog::time(t));
     }
     end = t.isValid() ? t : time;
     //debugPlan<<"<---"<<(backward?"(B)":"(F)")<<m_name<<":"<<end.toString()<<"-"<<time.toString()<<"="<<(end - time).toString()<<" duration:"<<duration.toString(Duration::Format_Day);
     l = end>time ? end-time : time-end;
     if (match) {
-#ifndef PLAN_NLOGDEBUG
-        if (sch) sch->logDebug(QStringLiteral("Calculated length: ") + time.toString() + QStringLiteral(" - ") + end.toString() + QStringLiteral(" = ") + l.toString());
-#endif
+        scheduleLogDebug(sch, ScheduleLog::Event_LengthCalculated, ScheduleLog::time(time), ScheduleLog::time(end), l.milliseconds());
     }
     return l;
 }
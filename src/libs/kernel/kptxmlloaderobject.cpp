@@ -10,12 +10,14 @@
 #include "kptdatetime.h"
 #include "ProjectLoaderBase.h"
 #include "ProjectLoader_v0.h"
+#include "ProjectStreamLoader.h"
 
 #include <MimeTypes.h>
 #include <KoXmlReader.h>
 
 #include <QString>
 #include <QStringList>
+#include <QXmlStreamReader>
 
 using namespace KPlato ;
 
@@ -241,6 +243,16 @@ bool XMLLoaderObject::loadTaskChildren()
     return m_loadTaskChildren;
 }
 
+void XMLLoaderObject::setAppointmentStream(const AppointmentStream &stream)
+{
+    m_appointmentStream = stream;
+}
+
+const AppointmentStream &XMLLoaderObject::appointmentStream() const
+{
+    return m_appointmentStream;
+}
+
 /// Load a project from xml
 bool XMLLoaderObject::loadProject(Project *project, const KoXmlDocument &document)
 {
@@ -270,6 +282,26 @@ bool XMLLoaderObject::loadProject(Project *project, const KoXmlDocument &documen
     return result;
 }
 
+bool XMLLoaderObject::loadProject(Project *project, QXmlStreamReader &reader)
+{
+    debugPlanXml<<project;
+    m_project = project;
+
+    if (m_updater) m_updater->setProgress(5);
+    startLoad();
+
+    ProjectStreamLoader loader(*this);
+    bool result = loader.load(project, reader);
+    if (!result) {
+        addMsg(Errors, QStringLiteral("Loading of project failed: %1").arg(loader.errorString()));
+    }
+    stopLoad();
+    if (m_updater) m_updater->setProgress(100); // the rest is only processing, not loading
+
+    debugPlanXml<<project<<result;
+    return result;
+}
+
 bool XMLLoaderObject::loadWorkIntervalsCache(Project *project, const KoXmlElement &plan)
 {
     if (!project) {
@@ -8,6 +8,7 @@
 #define XMLLOADEROBJECT_H
 
 #include "plankernel_export.h"
+#include "AppointmentStream.h"
 
 #include <QElapsedTimer>
 #include <QDateTime>
@@ -21,6 +22,7 @@ class QStringList;
 
 class KoXmlDocument;
 class KoXmlElement;
+class QXmlStreamReader;
 
 namespace KPlato 
 {
@@ -82,8 +84,14 @@ public:
     void setLoadTaskChildren(bool state);
     bool loadTaskChildren();
 
+    /// The appointment intervals referred to by the appointments in the document
+    void setAppointmentStream(const AppointmentStream &stream);
+    const AppointmentStream &appointmentStream() const;
+
     /// Load a project from xml
     bool loadProject(Project *project, const KoXmlDocument &document);
+    /// Load a project directly from @p reader, see ProjectStreamLoader
+    bool loadProject(Project *project, QXmlStreamReader &reader);
     bool loadWorkIntervalsCache(Project *project, const KoXmlElement &plan);
 
 protected:
@@ -106,6 +114,7 @@ protected:
     QPointer<KoUpdater> m_updater;
 
     bool m_loadTaskChildren;
+    AppointmentStream m_appointmentStream;
 };
 
 } //namespace KPlato
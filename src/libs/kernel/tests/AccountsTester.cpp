@@ -559,6 +559,20 @@ void AccountsTester::subaccounts()
     ec = project->accounts().actualCost(*a1);
     QCOMPARE(ec.totalEffort().toDouble(Duration::Unit_h), 4.0);
     QCOMPARE(ec.totalCost(), 426.0);
+
+    // All accounts in one go
+    QHash<const Account*, EffortCostMap> costs = project->accounts().plannedCosts();
+    QCOMPARE(costs.count(), project->accounts().allAccounts().count());
+    QCOMPARE(costs.value(a2).totalEffort().toDouble(Duration::Unit_h), 0.0);
+    QCOMPARE(costs.value(a2).totalCost(), 1.0);
+    QCOMPARE(costs.value(a1).totalEffort().toDouble(Duration::Unit_h), 8.0);
+    QCOMPARE(costs.value(a1).totalCost(), 826.0);
+
+    costs = project->accounts().actualCosts();
+    QCOMPARE(costs.count(), project->accounts().allAccounts().count());
+    QCOMPARE(costs.value(a2).totalCost(), 1.0);
+    QCOMPARE(costs.value(a1).totalEffort().toDouble(Duration::Unit_h), 4.0);
+    QCOMPARE(costs.value(a1).totalCost(), 426.0);
 }
 
 void AccountsTester::deleteAccount()
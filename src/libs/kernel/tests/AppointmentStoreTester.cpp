@@ -0,0 +1,163 @@
+/* This file is part of the KDE project
+   SPDX-FileCopyrightText: 2026 agent <agent@local>
+   
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+// clazy:excludeall=qstring-arg
+#include "AppointmentStoreTester.h"
+#include "ProjectGenerator.h"
+
+#include "AppointmentStore.h"
+#include "kptappointment.h"
+#include "kptproject.h"
+#include "kpttask.h"
+#include "kptschedule.h"
+#include "Resource.h"
+
+#include <QTest>
+
+
+namespace KPlato
+{
+
+// Calculate the result without using the store
+static EffortCostMap plannedPrDay(const Schedule *s, const Resource *resource, QDate start, QDate end, EffortCostCalculationType type)
+{
+    EffortCostMap ec;
+    const QList<Appointment*> appointments = s->appointments();
+    for (const Appointment *a : appointments) {
+        if (!resource || (a->resource() && a->resource()->resource() == resource)) {
+            ec += a->plannedPrDay(start, end, type);
+        }
+    }
+    return ec;
+}
+
+static void compare(const EffortCostMap &actual, const EffortCostMap &expected)
+{
+    QCOMPARE(actual.days().keys(), expected.days().keys());
+    EffortCostDayMap::const_iterator it = expected.days().constBegin();
+    for (; it != expected.days().constEnd(); ++it) {
+        const EffortCost ec = actual.effortCost(it.key());
+        QCOMPARE(ec.effort(), it.value().effort());
+        QVERIFY(qAbs(ec.cost() - it.value().cost()) < 0.001);
+    }
+}
+
+void AppointmentStoreTester::initTestCase()
+{
+    ProjectGenerator::Parameters p;
+    p.tasks = 30;
+    p.resources = 4;
+    p.maxEffort = 10;
+    m_project = ProjectGenerator(p).generate();
+    m_project->resourceList().at(1)->setType(Resource::Type_Material);
+    m_manager = ProjectGenerator::scheduleManager(m_project);
+    m_manager->createSchedules();
+    m_project->calculate(*m_manager);
+    QVERIFY(m_manager->isScheduled());
+}
+
+void AppointmentStoreTester::cleanupTestCase()
+{
+    delete m_project;
+}
+
+void AppointmentStoreTester::plannedPrDay()
+{
+    const long id = m_manager->scheduleId();
+    const AppointmentStore store = m_manager->expected()->appointmentStore();
+    QVERIFY(store.isValid());
+    QVERIFY(store.rowCount() > 0);
+
+    const QDate start = m_project->startTime(id).date();
+    const QDate end = m_project->endTime(id).date();
+    const QList<QPair<QDate, QDate>> ranges = { { QDate(), QDate() }, { start, end }, { start.addDays(5), start.addDays(20) } };
+    const QList<EffortCostCalculationType> types = { ECCT_All, ECCT_EffortWork, ECCT_Work };
+
+    const QList<Task*> tasks = m_project->allTasks();
+    for (const Task *t : tasks) {
+        const Schedule *s = t->findSchedule(id);
+        QVERIFY(s);
+        for (const auto &range : ranges) {
+            for (EffortCostCalculationType type : types) {
+                compare(s->plannedEffortCostPrDay(range.first, range.second, type), plannedPrDay(s, nullptr, range.first, range.second, type));
+                const QList<Resource*> resources = m_project->resourceList();
+                for (const Resource *r : resources) {
+                    compare(s->plannedEffortCostPrDay(r, range.first, range.second, type), plannedPrDay(s, r, range.first, range.second, type));
+                }
+            }
+        }
+    }
+    const QList<Resource*> resources = m_project->resourceList();
+    for (Resource *r : resources) {
+        const Schedule *s = r->findSchedule(id);
+        QVERIFY(s);
+        for (const auto &range : ranges) {
+            for (EffortCostCalculationType type : types) {
+                compare(r->plannedEffortCostPrDay(range.first, range.second, id, type), plannedPrDay(s, nullptr, range.first, range.second, type));
+                // a resource schedule asked for its own resource, and for another one
+                compare(s->plannedEffortCostPrDay(r, range.first, range.second, type), plannedPrDay(s, r, range.first, range.second, type));
+                QVERIFY(s->plannedEffortCostPrDay(resources.first() == r ? resources.last() : resources.first(), range.first, range.second, type).days().isEmpty());
+            }
+        }
+    }
+}
+
+void AppointmentStoreTester::invalidate()
+{
+    const long id = m_manager->scheduleId();
+    MainSchedule *ms = m_manager->expected();
+    const AppointmentStore store = ms->appointmentStore();
+    QVERIFY(store.isValid());
+    QCOMPARE(store.revision(), ms->appointmentRevision());
+
+    Task *task = m_project->allTasks().last();
+    Schedule *s = task->findSchedule(id);
+    QVERIFY(!s->appointments().isEmpty());
+    Appointment *a = s->appointments().first();
+    const DateTime start = a->endTime().addDays(7);
+    a->addInterval(start, start + Duration(qint64(4), Duration::Unit_h), 100);
+    QVERIFY(store.revision() != ms->appointmentRevision());
+
+    const EffortCostMap ec = s->plannedEffortCostPrDay(start.date(), start.date());
+    QCOMPARE(ms->appointmentStore().revision(), ms->appointmentRevision());
+    // the old copy is not changed by the rebuild
+    QCOMPARE(store.plannedPrDay(s, start.date(), start.date()).effortOnDate(start.date()), Duration::zeroDuration);
+    QCOMPARE(ec.effortOnDate(start.date()), Duration(qint64(4), Duration::Unit_h));
+    compare(ec, plannedPrDay(s, nullptr, start.date(), start.date(), ECCT_All));
+
+    // rate changes do not need a rebuild
+    Resource *r = a->resource()->resource();
+    const int revision = ms->appointmentRevision();
+    r->setNormalRate(r->normalRate() * 2);
+    QCOMPARE(ms->appointmentRevision(), revision);
+    compare(s->plannedEffortCostPrDay(QDate(), QDate()), plannedPrDay(s, nullptr, QDate(), QDate(), ECCT_All));
+}
+
+void AppointmentStoreTester::otherProject()
+{
+    MainSchedule *ms = m_manager->expected();
+    const AppointmentStore store = ms->appointmentStore();
+    const int revision = ms->appointmentRevision();
+
+    // scheduling and deleting another project does not touch this store
+    ProjectGenerator::Parameters p;
+    p.tasks = 5;
+    p.resources = 2;
+    Project *project = ProjectGenerator(p).generate();
+    ScheduleManager *sm = ProjectGenerator::scheduleManager(project);
+    sm->createSchedules();
+    project->calculate(*sm);
+    QVERIFY(sm->isScheduled());
+    QVERIFY(sm->expected()->appointmentRevision() > 0);
+    delete project;
+
+    QCOMPARE(ms->appointmentRevision(), revision);
+    QCOMPARE(ms->appointmentStore().revision(), store.revision());
+}
+
+} //namespace KPlato
+
+QTEST_GUILESS_MAIN(KPlato::AppointmentStoreTester)
@@ -0,0 +1,93 @@
+/* This file is part of the KDE project
+   SPDX-FileCopyrightText: 2026 agent <agent@local>
+   
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+// clazy:excludeall=qstring-arg
+#include "AppointmentStreamTester.h"
+
+#include "AppointmentStream.h"
+#include "kptappointment.h"
+#include "kptdatetime.h"
+
+#include <QTest>
+#include <QTimeZone>
+
+
+namespace KPlato
+{
+
+void AppointmentStreamTester::roundTrip()
+{
+    QTimeZone tz("Europe/Berlin");
+    DateTime dt(QDate(2023, 3, 24), QTime(8, 0), tz);
+
+    AppointmentIntervalList lst1;
+    lst1.add(AppointmentInterval(dt, dt.addSecs(4 * 3600), 100));
+    lst1.add(AppointmentInterval(dt.addSecs(5 * 3600), dt.addSecs(9 * 3600), 50));
+    // over the change to summer time
+    dt = dt.addDays(1);
+    lst1.add(AppointmentInterval(dt, dt.addSecs(8 * 3600), 50));
+    dt = dt.addDays(3);
+    lst1.add(AppointmentInterval(dt, dt.addSecs(8 * 3600), 33.3));
+    QCOMPARE(lst1.map().count(), 4);
+
+    AppointmentIntervalList lst2;
+    lst2.add(AppointmentInterval(dt.addDays(-10), dt.addDays(-10).addSecs(3600), 100));
+
+    AppointmentStream stream;
+    QCOMPARE(stream.add(lst1), 0);
+    QCOMPARE(stream.add(lst2), 1);
+    QCOMPARE(stream.add(AppointmentIntervalList()), 2);
+
+    AppointmentStream loaded;
+    QVERIFY(loaded.setData(stream.data()));
+    QCOMPARE(loaded.count(), 3);
+
+    AppointmentIntervalList result;
+    QVERIFY(loaded.intervals(0, tz, result));
+    QCOMPARE(result.map(), lst1.map());
+    QCOMPARE(result.map().last().load(), 33.3);
+
+    result.clear();
+    QVERIFY(loaded.intervals(1, tz, result));
+    QCOMPARE(result.map(), lst2.map());
+
+    result.clear();
+    QVERIFY(loaded.intervals(2, tz, result));
+    QVERIFY(result.isEmpty());
+
+    QVERIFY(!loaded.intervals(3, tz, result));
+}
+
+void AppointmentStreamTester::invalidData()
+{
+    AppointmentStream stream;
+    QVERIFY(!stream.setData(QByteArray()));
+    QVERIFY(!stream.setData(QByteArray("<appointment-interval/>")));
+    QVERIFY(stream.isEmpty());
+
+    DateTime dt(QDate(2023, 3, 24), QTime(8, 0), QTimeZone::utc());
+    AppointmentIntervalList lst;
+    lst.add(AppointmentInterval(dt, dt.addSecs(3600), 100));
+    lst.add(AppointmentInterval(dt.addSecs(7200), dt.addSecs(9000), 50));
+    stream.add(lst);
+    QByteArray data = stream.data();
+
+    // the offset table is larger than the data
+    QByteArray invalid = data;
+    invalid[5] = 10;
+    QVERIFY(!stream.setData(invalid));
+
+    // the last interval is missing
+    invalid = data;
+    invalid.chop(4);
+    QVERIFY(stream.setData(invalid));
+    AppointmentIntervalList result;
+    QVERIFY(!stream.intervals(0, QTimeZone::utc(), result));
+}
+
+} //namespace KPlato
+
+QTEST_GUILESS_MAIN(KPlato::AppointmentStreamTester)
@@ -0,0 +1,140 @@
+/* This file is part of the KDE project
+   SPDX-FileCopyrightText: 2026 agent <agent@local>
+   
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+// clazy:excludeall=qstring-arg
+#include "BookingDigestTester.h"
+
+#include "BookingDigest.h"
+#include "kptappointment.h"
+#include "kptcalendar.h"
+#include "kptdatetime.h"
+#include "kptproject.h"
+#include "kptresourcerequest.h"
+#include "kptschedule.h"
+#include "kpttask.h"
+
+#include <QTest>
+#include <QTimeZone>
+
+
+namespace KPlato
+{
+
+static Project *createProject(const QString &name, const QString &resourceId = QString())
+{
+    const QTimeZone tz("Europe/Berlin");
+    Project *project = new Project();
+    project->setName(name);
+    project->setId(project->uniqueNodeId());
+    project->registerNodeId(project);
+    project->setTimeZone(tz);
+    const DateTime dt(QDate(2023, 3, 20), QTime(0, 0), tz);
+    project->setConstraintStartTime(dt);
+    project->setConstraintEndTime(dt.addDays(30));
+
+    Calendar *calendar = new Calendar(QStringLiteral("C1"));
+    calendar->setTimeZone(tz);
+    calendar->setDefault(true);
+    const QTime t1(8, 0, 0);
+    const int length = t1.msecsTo(QTime(16, 0, 0));
+    for (int i = 1; i <= 7; ++i) {
+        CalendarDay *d = calendar->weekday(i);
+        d->setState(CalendarDay::Working);
+        d->addInterval(t1, length);
+    }
+    project->addCalendar(calendar);
+
+    Resource *r = new Resource();
+    r->setId(resourceId);
+    r->setName(QStringLiteral("R1"));
+    r->setCalendar(calendar);
+    r->setShared(true);
+    project->addResource(r);
+    return project;
+}
+
+void BookingDigestTester::notScheduled()
+{
+    QScopedPointer<Project> project(createProject(QStringLiteral("P1")));
+    BookingDigest digest;
+    digest.create(project.data());
+    QCOMPARE(digest.projectId(), project->id());
+    QVERIFY(digest.scheduleManagerName().isEmpty());
+    QCOMPARE(digest.count(), 0);
+
+    BookingDigest loaded;
+    QVERIFY(loaded.setData(digest.data()));
+    QCOMPARE(loaded.projectId(), project->id());
+    QCOMPARE(loaded.count(), 0);
+}
+
+void BookingDigestTester::roundTrip()
+{
+    QScopedPointer<Project> project(createProject(QStringLiteral("P1")));
+    Resource *r1 = project->resourceAt(0);
+    Task *t = project->createTask();
+    t->setName(QStringLiteral("T1"));
+    project->addTask(t, project.data());
+    t->estimate()->setUnit(Duration::Unit_h);
+    t->estimate()->setExpectedEstimate(16.0);
+    t->estimate()->setType(Estimate::Type_Effort);
+    t->requests().addResourceRequest(new ResourceRequest(r1, 100));
+
+    ScheduleManager *sm = project->createScheduleManager(QStringLiteral("Plan"));
+    project->addScheduleManager(sm);
+    sm->createSchedules();
+    project->calculate(*sm);
+    QVERIFY(project->isScheduled(ANYSCHEDULED));
+
+    BookingDigest digest;
+    digest.create(project.data());
+    QCOMPARE(digest.scheduleManagerName(), sm->name());
+    QCOMPARE(digest.count(), 1);
+
+    BookingDigest loaded;
+    QVERIFY(loaded.setData(digest.data()));
+    QCOMPARE(loaded.projectId(), project->id());
+    QCOMPARE(loaded.projectName(), project->name());
+    QCOMPARE(loaded.scheduleManagerName(), sm->name());
+    QCOMPARE(loaded.count(), 1);
+
+    // not inserted into the project itself
+    QCOMPARE(loaded.insertExternalAppointments(project.data()), 0);
+
+    QScopedPointer<Project> other(createProject(QStringLiteral("P2"), r1->id()));
+    Resource *r2 = other->resourceAt(0);
+    QCOMPARE(r2->id(), r1->id());
+    QCOMPARE(loaded.insertExternalAppointments(other.data()), 1);
+    QCOMPARE(r2->numExternalAppointments(), 1);
+
+    Appointment expected;
+    const QList<Appointment*> appointments = r1->appointments(sm->scheduleId());
+    for (const Appointment *a : appointments) {
+        expected += *a;
+    }
+    QScopedPointer<Appointment> app(r2->takeExternalAppointment(project->id()));
+    QVERIFY(app);
+    QCOMPARE(app->auxcilliaryInfo(), project->name());
+    QCOMPARE(app->intervals().map(), expected.intervals().map());
+
+    // only shared resources get external appointments
+    r2->setShared(false);
+    QCOMPARE(loaded.insertExternalAppointments(other.data()), 0);
+}
+
+void BookingDigestTester::invalidData()
+{
+    BookingDigest digest;
+    QVERIFY(!digest.setData(QByteArray()));
+    QVERIFY(!digest.setData(QByteArray("<plan/>")));
+    QVERIFY(!digest.setData(QByteArray("<bookings version=\"1\"/>")));
+    QVERIFY(!digest.setData(QByteArray("<bookings version=\"1000\" project-id=\"P\" timezone=\"UTC\"/>")));
+    QVERIFY(digest.setData(QByteArray("<bookings version=\"1\" project-id=\"P\" timezone=\"UTC\"/>")));
+}
+
+} //namespace KPlato
+
+QTEST_GUILESS_MAIN(KPlato::BookingDigestTester)
@@ -0,0 +1,26 @@
+/* This file is part of the KDE project
+   SPDX-FileCopyrightText: 2026 agent <agent@local>
+   
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KPlato_BookingDigestTester_h
+#define KPlato_BookingDigestTester_h
+
+#include <QObject>
+
+namespace KPlato
+{
+
+class BookingDigestTester : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void notScheduled();
+    void roundTrip();
+    void invalidData();
+};
+
+} //namespace KPlato
+
+#endif
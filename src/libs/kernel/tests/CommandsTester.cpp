@@ -12,6 +12,9 @@
 #include <kptcalendar.h>
 #include <kptproject.h>
 #include <kptresource.h>
+#include <kpttask.h>
+
+#include <kundo2stack.h>
 
 #include <QTest>
 
@@ -518,6 +521,120 @@ void CommandsTester::testProjectModifyDefaultCalendarCmd()
     delete calendar2;
     delete cmd1;
 }
+
+void CommandsTester::testMergeCommands()
+{
+    Project project;
+    project.setId(project.uniqueNodeId());
+    project.registerNodeId(&project);
+    Task *t1 = project.createTask();
+    t1->setName(QStringLiteral("T1"));
+    QVERIFY(project.addTask(t1, &project));
+    Task *t2 = project.createTask();
+    t2->setName(QStringLiteral("T2"));
+    QVERIFY(project.addTask(t2, &project));
+
+    KUndo2QStack stack;
+    // typing a name results in one command
+    stack.push(new NodeModifyNameCmd(*t1, QStringLiteral("A")));
+    stack.push(new NodeModifyNameCmd(*t1, QStringLiteral("AB")));
+    stack.push(new NodeModifyNameCmd(*t1, QStringLiteral("ABC")));
+    QCOMPARE(stack.count(), 1);
+    QCOMPARE(t1->name(), QStringLiteral("ABC"));
+    stack.undo();
+    QCOMPARE(t1->name(), QStringLiteral("T1"));
+    stack.redo();
+    QCOMPARE(t1->name(), QStringLiteral("ABC"));
+
+    // another node or another kind of command is not merged
+    stack.push(new NodeModifyNameCmd(*t2, QStringLiteral("X")));
+    QCOMPARE(stack.count(), 2);
+    stack.push(new NodeModifyPriorityCmd(*t2, t2->priority(), 10));
+    stack.push(new NodeModifyPriorityCmd(*t2, 10, 20));
+    QCOMPARE(stack.count(), 3);
+    stack.push(new NodeModifyNameCmd(*t2, QStringLiteral("XY")));
+    QCOMPARE(stack.count(), 4);
+    stack.undo();
+    QCOMPARE(t2->name(), QStringLiteral("X"));
+    stack.undo();
+    QCOMPARE(t2->priority(), 0);
+
+    // not merged with a saved command
+    stack.redo();
+    stack.setClean();
+    stack.push(new NodeModifyPriorityCmd(*t2, 20, 30));
+    QCOMPARE(stack.count(), 4);
+}
+
+void CommandsTester::testMergeMacroCommands()
+{
+    Project project;
+    project.setId(project.uniqueNodeId());
+    project.registerNodeId(&project);
+    Task *t1 = project.createTask();
+    t1->setName(QStringLiteral("T1"));
+    QVERIFY(project.addTask(t1, &project));
+
+    KUndo2QStack stack;
+    // macros with one command merge like the command
+    MacroCommand *m = new MacroCommand();
+    m->addCommand(new NodeModifyNameCmd(*t1, QStringLiteral("A")));
+    stack.push(m);
+    m = new MacroCommand();
+    m->addCommand(new NodeModifyNameCmd(*t1, QStringLiteral("AB")));
+    stack.push(m);
+    QCOMPARE(stack.count(), 1);
+    QCOMPARE(t1->name(), QStringLiteral("AB"));
+
+    // a bare command has the same id as the macro, but is not merged with it
+    stack.push(new NodeModifyNameCmd(*t1, QStringLiteral("ABC")));
+    QCOMPARE(stack.count(), 2);
+    m = new MacroCommand();
+    m->addCommand(new NodeModifyNameCmd(*t1, QStringLiteral("ABCD")));
+    QCOMPARE(m->id(), stack.command(1)->id());
+    stack.push(m);
+    QCOMPARE(stack.count(), 3);
+    QCOMPARE(t1->name(), QStringLiteral("ABCD"));
+
+    stack.undo();
+    QCOMPARE(t1->name(), QStringLiteral("ABC"));
+    stack.undo();
+    QCOMPARE(t1->name(), QStringLiteral("AB"));
+    stack.undo();
+    QCOMPARE(t1->name(), QStringLiteral("T1"));
+}
+
+void CommandsTester::testUndoMemoryLimit()
+{
+    Project project;
+    project.setId(project.uniqueNodeId());
+    project.registerNodeId(&project);
+    QList<Task*> tasks;
+    for (int i = 0; i < 10; ++i) {
+        Task *t = project.createTask();
+        t->setName(QStringLiteral("T%1").arg(i));
+        QVERIFY(project.addTask(t, &project));
+        tasks << t;
+    }
+    KUndo2QStack stack;
+    stack.push(new NodeDeleteCmd(tasks.at(0)));
+    const qint64 cost = stack.memoryCost();
+    QVERIFY(cost > qint64(sizeof(Task)));
+
+    stack.setUndoMemoryLimit(cost * 3 + cost / 2);
+    for (int i = 1; i < tasks.count(); ++i) {
+        stack.push(new NodeDeleteCmd(tasks.at(i)));
+    }
+    QCOMPARE(project.numChildren(), 0);
+    QCOMPARE(stack.count(), 3);
+    QVERIFY(stack.memoryCost() <= stack.undoMemoryLimit());
+
+    while (stack.canUndo()) {
+        stack.undo();
+    }
+    QCOMPARE(project.numChildren(), 3);
+    QCOMPARE(project.childNode(0)->name(), QStringLiteral("T7"));
+}
 } // namespace KPlato
 
 QTEST_GUILESS_MAIN(KPlato::CommandsTester)
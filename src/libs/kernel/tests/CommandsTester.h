@@ -39,6 +39,10 @@ private Q_SLOTS:
     void testCalendarModifyDateCmd();
     void testProjectModifyDefaultCalendarCmd();
 
+    void testMergeCommands();
+    void testMergeMacroCommands();
+    void testUndoMemoryLimit();
+
 private:
     Project *m_project;
 };
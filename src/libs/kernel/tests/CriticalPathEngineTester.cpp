@@ -0,0 +1,148 @@
+/* This file is part of the KDE project
+   SPDX-FileCopyrightText: 2026 agent <agent@local>
+   
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+// clazy:excludeall=qstring-arg
+#include "CriticalPathEngineTester.h"
+#include "ProjectGenerator.h"
+
+#include "CriticalPathEngine.h"
+#include "kptproject.h"
+#include "kpttask.h"
+#include "kptrelation.h"
+#include "kptschedule.h"
+
+#include <QTest>
+
+
+namespace KPlato
+{
+
+// Find the critical paths the recursive way
+static void addPaths(Node *node, long id, QList<Node*> path, QList<QList<Node*>> &paths)
+{
+    path << node;
+    bool extended = false;
+    const QList<Relation*> relations = node->dependChildNodes();
+    for (const Relation *r : relations) {
+        if (r->child()->inCriticalPath(id)) {
+            addPaths(r->child(), id, path, paths);
+            extended = true;
+        }
+    }
+    if (!extended) {
+        paths << path;
+    }
+}
+
+static QList<QList<Node*>> criticalPaths(Project *project, long id)
+{
+    QList<QList<Node*>> paths;
+    const QList<Node*> nodes = project->allNodes();
+    for (Node *n : nodes) {
+        if (n->numDependParentNodes() == 0 && n->inCriticalPath(id)) {
+            addPaths(n, id, QList<Node*>(), paths);
+        }
+    }
+    return paths;
+}
+
+void CriticalPathEngineTester::initTestCase()
+{
+    ProjectGenerator::Parameters p;
+    p.tasks = 60;
+    p.summarySize = 10;
+    p.dependencyDensity = 2.0;
+    p.dependencyWindow = 10;
+    p.resources = p.tasks; // avoid resource conflicts
+    m_project = ProjectGenerator(p).generate();
+    m_manager = ProjectGenerator::scheduleManager(m_project);
+    m_manager->createSchedules();
+    m_project->calculate(*m_manager);
+    QVERIFY(m_manager->isScheduled());
+}
+
+void CriticalPathEngineTester::cleanupTestCase()
+{
+    delete m_project;
+}
+
+void CriticalPathEngineTester::markCriticalPath()
+{
+    const long id = m_manager->scheduleId();
+    const QList<Node*> nodes = m_project->allNodes();
+    QList<Node*> marked;
+    for (Node *n : nodes) {
+        if (n->inCriticalPath(id)) {
+            marked << n;
+        }
+        n->findSchedule(id)->setInCriticalPath(false);
+    }
+    QVERIFY(!marked.isEmpty());
+
+    // The recursive search must give the same result
+    m_project->setCurrentSchedule(id);
+    const QList<Node*> seeds = m_manager->expected()->endNodes();
+    for (Node *n : seeds) {
+        n->calcCriticalPath(false);
+    }
+    QList<Node*> expected;
+    for (Node *n : nodes) {
+        if (n->inCriticalPath(id)) {
+            expected << n;
+        }
+        n->findSchedule(id)->setInCriticalPath(false);
+    }
+    QCOMPARE(marked, expected);
+
+    QVERIFY(CriticalPathEngine::markCriticalPath(nodes, seeds, id, false));
+    QList<Node*> result;
+    for (Node *n : nodes) {
+        if (n->inCriticalPath(id)) {
+            result << n;
+        }
+    }
+    QCOMPARE(result, expected);
+}
+
+void CriticalPathEngineTester::paths()
+{
+    const long id = m_manager->scheduleId();
+    const QList<QList<Node*>> expected = criticalPaths(m_project, id);
+    QVERIFY(!expected.isEmpty());
+
+    CriticalPathEngine engine;
+    QCOMPARE(engine.calculate(m_project->allNodes(), id), expected);
+    QVERIFY(engine.isValid());
+    QCOMPARE(*m_project->criticalPathList(id), expected);
+}
+
+void CriticalPathEngineTester::relationChanged()
+{
+    const long id = m_manager->scheduleId();
+    m_project->calcCriticalPathList(m_manager->expected());
+    const QList<QList<Node*>> paths = *m_project->criticalPathList(id);
+    Relation *relation = nullptr;
+    for (const QList<Node*> &path : paths) {
+        if (path.count() > 1) {
+            relation = path.at(0)->findChildRelation(path.at(1));
+            break;
+        }
+    }
+    QVERIFY(relation);
+
+    m_project->takeRelation(relation);
+    QVERIFY(m_manager->expected()->criticalPathEngine().isValid());
+    QCOMPARE(*m_project->criticalPathList(id), criticalPaths(m_project, id));
+    QVERIFY(*m_project->criticalPathList(id) != paths);
+
+    QVERIFY(m_project->addRelation(relation, false));
+    QVERIFY(m_manager->expected()->criticalPathEngine().isValid());
+    QCOMPARE(*m_project->criticalPathList(id), criticalPaths(m_project, id));
+}
+
+} //namespace KPlato
+
+QTEST_GUILESS_MAIN(KPlato::CriticalPathEngineTester)
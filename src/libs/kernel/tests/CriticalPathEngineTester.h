@@ -0,0 +1,35 @@
+/* This file is part of the KDE project
+   SPDX-FileCopyrightText: 2026 agent <agent@local>
+   
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KPlato_CriticalPathEngineTester_h
+#define KPlato_CriticalPathEngineTester_h
+
+#include <QObject>
+
+namespace KPlato
+{
+class Project;
+class ScheduleManager;
+
+class CriticalPathEngineTester : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void markCriticalPath();
+    void paths();
+    void relationChanged();
+
+private:
+    Project *m_project;
+    ScheduleManager *m_manager;
+};
+
+} //namespace KPlato
+
+#endif
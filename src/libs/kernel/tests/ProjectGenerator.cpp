@@ -0,0 +1,147 @@
+/* This file is part of the KDE project
+ * SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+// clazy:excludeall=qstring-arg
+#include "ProjectGenerator.h"
+
+#include "kptproject.h"
+#include "kpttask.h"
+#include "kptcalendar.h"
+#include "kptrelation.h"
+#include "kptresourcerequest.h"
+#include "kptschedule.h"
+#include "Resource.h"
+
+#include <QRandomGenerator>
+
+namespace KPlato
+{
+
+QString ProjectGenerator::Parameters::toString() const
+{
+    return QStringLiteral("tasks=%1 summarySize=%2 density=%3 window=%4 resources=%5 calendars=%6 intervalsPerDay=%7 exceptionsPerMonth=%8 horizon=%9 granularity=%10 seed=%11")
+            .arg(tasks).arg(summarySize).arg(dependencyDensity).arg(dependencyWindow).arg(resources)
+            .arg(calendars).arg(intervalsPerDay).arg(exceptionsPerMonth).arg(horizon).arg(granularity).arg(seed);
+}
+
+ProjectGenerator::ProjectGenerator(const Parameters &parameters)
+    : m_parameters(parameters)
+{
+}
+
+Project *ProjectGenerator::generate() const
+{
+    const Parameters &p = m_parameters;
+    QRandomGenerator random(p.seed);
+
+    Project *project = new Project();
+    project->setId(project->uniqueNodeId());
+    project->registerNodeId(project);
+    project->setName(QStringLiteral("Generated: %1").arg(p.toString()));
+    const DateTime start(QDate(2024, 1, 8), QTime(8, 0, 0), project->timeZone());
+    project->setConstraintStartTime(start);
+    project->setConstraintEndTime(start.addDays(p.horizon));
+
+    // Calendars: working days mon-fri, the working hours split into intervalsPerDay
+    QList<Calendar*> calendars;
+    const int intervals = qMax(1, p.intervalsPerDay);
+    const int dayLength = 8 * 60 * 60 * 1000;
+    const int gap = 30 * 60 * 1000;
+    const int intervalLength = (dayLength - (intervals - 1) * gap) / intervals;
+    for (int c = 0; c < qMax(1, p.calendars); ++c) {
+        Calendar *calendar = new Calendar(QStringLiteral("Calendar %1").arg(c + 1));
+        if (c == 0) {
+            calendar->setDefault(true);
+        }
+        for (int wd = 1; wd <= 7; ++wd) {
+            CalendarDay *day = calendar->weekday(wd);
+            if (wd > 5) {
+                day->setState(CalendarDay::NonWorking);
+                continue;
+            }
+            day->setState(CalendarDay::Working);
+            QTime t(8, 0, 0);
+            for (int i = 0; i < intervals; ++i) {
+                day->addInterval(t, intervalLength);
+                t = t.addMSecs(intervalLength + gap);
+            }
+        }
+        const int months = p.horizon / 30 + 1;
+        for (int m = 0; m < months; ++m) {
+            for (int e = 0; e < p.exceptionsPerMonth; ++e) {
+                const QDate date = start.date().addDays(m * 30 + random.bounded(30));
+                if (calendar->findDay(date) == nullptr) {
+                    calendar->addDay(new CalendarDay(date, CalendarDay::NonWorking));
+                }
+            }
+        }
+        project->addCalendar(calendar);
+        calendars << calendar;
+    }
+
+    QList<Resource*> resources;
+    for (int r = 0; r < qMax(1, p.resources); ++r) {
+        Resource *resource = new Resource();
+        resource->setName(QStringLiteral("R%1").arg(r + 1));
+        resource->setNormalRate(100.0);
+        resource->setCalendar(calendars.at(r % calendars.count()));
+        project->addResource(resource);
+        resources << resource;
+    }
+
+    // Tasks
+    QList<Task*> tasks;
+    Task *summary = nullptr;
+    for (int t = 0; t < p.tasks; ++t) {
+        if (p.summarySize > 0 && t % p.summarySize == 0) {
+            summary = project->createTask();
+            summary->setName(QStringLiteral("S%1").arg(t / p.summarySize + 1));
+            project->addTask(summary, project);
+        }
+        Task *task = project->createTask();
+        task->setName(QStringLiteral("T%1").arg(t + 1));
+        task->estimate()->setType(Estimate::Type_Effort);
+        task->estimate()->setUnit(Duration::Unit_d);
+        task->estimate()->setExpectedEstimate(1 + random.bounded(qMax(1, p.maxEffort)));
+        if (summary) {
+            project->addSubTask(task, summary);
+        } else {
+            project->addTask(task, project);
+        }
+        task->requests().addResourceRequest(new ResourceRequest(resources.at(random.bounded(resources.count())), 100));
+        tasks << task;
+    }
+
+    // Dependencies, only to preceding tasks so the network is acyclic
+    const int whole = static_cast<int>(p.dependencyDensity);
+    const double fraction = p.dependencyDensity - whole;
+    for (int t = 1; t < tasks.count(); ++t) {
+        const int window = qMin(t, qMax(1, p.dependencyWindow));
+        int count = whole + (random.generateDouble() < fraction ? 1 : 0);
+        count = qMin(count, window);
+        QList<int> used;
+        while (used.count() < count) {
+            const int pred = t - 1 - random.bounded(window);
+            if (used.contains(pred)) {
+                continue;
+            }
+            used << pred;
+            project->addRelation(new Relation(tasks.at(pred), tasks.at(t)), false);
+        }
+    }
+
+    ScheduleManager *sm = project->createScheduleManager(QStringLiteral("Benchmark"));
+    project->addScheduleManager(sm);
+    sm->setAllowOverbooking(false);
+    return project;
+}
+
+ScheduleManager *ProjectGenerator::scheduleManager(Project *project)
+{
+    return project->scheduleManagers().value(0);
+}
+
+} // namespace KPlato
@@ -0,0 +1,66 @@
+/* This file is part of the KDE project
+ * SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#ifndef KPlato_ProjectGenerator_h
+#define KPlato_ProjectGenerator_h
+
+#include <QString>
+#include <QDateTime>
+
+namespace KPlato
+{
+class Project;
+class ScheduleManager;
+
+/**
+ * Generates synthetic projects for benchmarks.
+ * The same parameters (including seed) always generate the same project.
+ */
+class ProjectGenerator
+{
+public:
+    struct Parameters {
+        /// Number of leaf tasks
+        int tasks = 100;
+        /// Number of leaf tasks under each summary task, 0 gives a flat project
+        int summarySize = 20;
+        /// Average number of predecessors per task
+        double dependencyDensity = 1.5;
+        /// Predecessors are picked among this number of preceding tasks
+        int dependencyWindow = 100;
+        /// Number of work resources, tasks request one resource each
+        int resources = 10;
+        /// Number of resource calendars, resources are distributed among them
+        int calendars = 1;
+        /// Number of work intervals per working day
+        int intervalsPerDay = 1;
+        /// Number of non-working days added per calendar and month
+        int exceptionsPerMonth = 0;
+        /// Project length in days
+        int horizon = 365;
+        /// Maximum task effort in days
+        int maxEffort = 5;
+        /// Scheduling granularity in milliseconds
+        ulong granularity = 60 * 60 * 1000;
+        quint32 seed = 1;
+
+        QString toString() const;
+    };
+
+    explicit ProjectGenerator(const Parameters &parameters);
+
+    /// Generate a new project with one schedule manager
+    Project *generate() const;
+    /// Return the schedule manager in @p project created by generate()
+    static ScheduleManager *scheduleManager(Project *project);
+
+private:
+    Parameters m_parameters;
+};
+
+} // namespace KPlato
+
+#endif
@@ -0,0 +1,94 @@
+/* This file is part of the KDE project
+   SPDX-FileCopyrightText: 2026 agent <agent@local>
+   
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+// clazy:excludeall=qstring-arg
+#include "ProjectGeneratorTester.h"
+#include "ProjectGenerator.h"
+
+#include "kptproject.h"
+#include "kpttask.h"
+#include "kptschedule.h"
+
+#include <QTest>
+
+
+namespace KPlato
+{
+
+static int relationCount(Project *project)
+{
+    int count = 0;
+    const QList<Task*> tasks = project->allTasks();
+    for (const Task *t : tasks) {
+        count += t->numDependChildNodes();
+    }
+    return count;
+}
+
+void ProjectGeneratorTester::generate()
+{
+    ProjectGenerator::Parameters p;
+    p.tasks = 50;
+    p.summarySize = 10;
+    p.resources = 3;
+    p.calendars = 2;
+    p.dependencyDensity = 2.0;
+    Project *project = ProjectGenerator(p).generate();
+
+    QCOMPARE(project->allTasks().count(), 55); // 50 leaf tasks + 5 summary tasks
+    QCOMPARE(project->numChildren(), 5);
+    QCOMPARE(project->resourceList().count(), 3);
+    QCOMPARE(project->calendars().count(), 2);
+    // task 1 has no predecessor, task 2 has one, the rest two
+    QCOMPARE(relationCount(project), 1 + 2 * 48);
+    QVERIFY(ProjectGenerator::scheduleManager(project));
+
+    delete project;
+}
+
+void ProjectGeneratorTester::deterministic()
+{
+    ProjectGenerator::Parameters p;
+    p.tasks = 100;
+    p.dependencyDensity = 1.5;
+    p.exceptionsPerMonth = 2;
+    Project *p1 = ProjectGenerator(p).generate();
+    Project *p2 = ProjectGenerator(p).generate();
+
+    QCOMPARE(relationCount(p1), relationCount(p2));
+    const QList<Task*> t1 = p1->allTasks();
+    const QList<Task*> t2 = p2->allTasks();
+    QCOMPARE(t1.count(), t2.count());
+    for (int i = 0; i < t1.count(); ++i) {
+        QCOMPARE(t1.at(i)->name(), t2.at(i)->name());
+        QCOMPARE(t1.at(i)->estimate()->expectedEstimate(), t2.at(i)->estimate()->expectedEstimate());
+        QCOMPARE(t1.at(i)->numDependParentNodes(), t2.at(i)->numDependParentNodes());
+    }
+    delete p1;
+    delete p2;
+}
+
+void ProjectGeneratorTester::schedule()
+{
+    ProjectGenerator::Parameters p;
+    p.tasks = 40;
+    p.intervalsPerDay = 2;
+    Project *project = ProjectGenerator(p).generate();
+    ScheduleManager *sm = ProjectGenerator::scheduleManager(project);
+    sm->createSchedules();
+    project->calculate(*sm);
+
+    QVERIFY(sm->isScheduled());
+    MainSchedule *ms = sm->expected();
+    QVERIFY(ms->phaseStartTime(0) >= 0);
+    QCOMPARE(ms->phaseStartTime(1000), qint64(-1));
+
+    delete project;
+}
+
+} //namespace KPlato
+
+QTEST_GUILESS_MAIN(KPlato::ProjectGeneratorTester)
@@ -0,0 +1,26 @@
+/* This file is part of the KDE project
+   SPDX-FileCopyrightText: 2026 agent <agent@local>
+   
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KPlato_ProjectGeneratorTester_h
+#define KPlato_ProjectGeneratorTester_h
+
+#include <QObject>
+
+namespace KPlato
+{
+
+class ProjectGeneratorTester : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void generate();
+    void deterministic();
+    void schedule();
+};
+
+} //namespace KPlato
+
+#endif
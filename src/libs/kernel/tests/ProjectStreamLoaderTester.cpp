@@ -0,0 +1,295 @@
+/* This file is part of the KDE project
+   SPDX-FileCopyrightText: 2026 agent <agent@local>
+   
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+// clazy:excludeall=qstring-arg
+#include "ProjectStreamLoaderTester.h"
+#include "ProjectGenerator.h"
+
+#include "XmlStreamSaver.h"
+#include "kptxmlloaderobject.h"
+#include "kptproject.h"
+#include "kptresourcerequest.h"
+#include "kptschedule.h"
+#include "kpttask.h"
+#include "Resource.h"
+
+#include <KoStore.h>
+#include <KoXmlReader.h>
+#include <KoXmlWriter.h>
+
+#include <QBuffer>
+#include <QDebug>
+#include <QFile>
+#include <QScopedPointer>
+#include <QTest>
+#include <QXmlStreamReader>
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+
+namespace KPlato
+{
+
+static QByteArray save(Project *project)
+{
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+    KoXmlWriter writer(&buffer);
+    XmlStreamSaver saver(writer);
+    saver.save(project);
+    buffer.close();
+    return buffer.data();
+}
+
+static bool loadDocument(const QByteArray &data, Project *project)
+{
+    KoXmlDocument document;
+    if (!document.setContent(data, false)) {
+        return false;
+    }
+    XMLLoaderObject loader;
+    return loader.loadProject(project, document);
+}
+
+static bool loadStream(const QByteArray &data, Project *project)
+{
+    QXmlStreamReader reader(data);
+    reader.setNamespaceProcessing(false);
+    XMLLoaderObject loader;
+    return loader.loadProject(project, reader) && !reader.hasError();
+}
+
+// The main document of the .plan file given with PLAN_BENCHMARK_FILE
+static QByteArray planFileData()
+{
+    const QString fileName = qEnvironmentVariable("PLAN_BENCHMARK_FILE");
+    if (fileName.isEmpty()) {
+        return QByteArray();
+    }
+    QScopedPointer<KoStore> store(KoStore::createStore(fileName, KoStore::Read));
+    if (!store || store->bad() || !store->open("maindoc.xml")) {
+        return QByteArray();
+    }
+    const QByteArray data = store->read(store->size());
+    store->close();
+    return data;
+}
+
+// Memory usage of the process in kB from /proc/self/status, e.g. VmRSS or the peak VmHWM, -1 if not available
+static qint64 processMemory(const QByteArray &field)
+{
+    QFile file(QStringLiteral("/proc/self/status"));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return -1;
+    }
+    const QList<QByteArray> lines = file.readAll().split('\n');
+    for (const QByteArray &line : lines) {
+        if (line.startsWith(field + ':')) {
+            return line.mid(field.length() + 1).simplified().split(' ').value(0).toLongLong();
+        }
+    }
+    return -1;
+}
+
+// Give freed memory back to the system and restart the peak at the current usage
+static bool resetPeakMemory()
+{
+#ifdef __GLIBC__
+    malloc_trim(0);
+#endif
+    QFile file(QStringLiteral("/proc/self/clear_refs"));
+    return file.open(QIODevice::WriteOnly) && file.write("5") == 1;
+}
+
+QByteArray ProjectStreamLoaderTester::benchmarkData(int tasks) const
+{
+    if (tasks < 0) {
+        return planFileData();
+    }
+    Project *project = createProject(tasks);
+    const QByteArray data = save(project);
+    delete project;
+    return data;
+}
+
+Project *ProjectStreamLoaderTester::createProject(int tasks) const
+{
+    ProjectGenerator::Parameters p;
+    p.tasks = tasks;
+    p.summarySize = 10;
+    p.resources = 6;
+    Project *project = ProjectGenerator(p).generate();
+    const QList<Resource*> resources = project->resourceList();
+    // add required resources and alternatives to some of the requests
+    const QList<Task*> list = project->allTasks();
+    for (int i = 0; i < list.count(); i += 3) {
+        const QList<ResourceRequest*> requests = list.at(i)->requests().resourceRequests(false);
+        if (requests.isEmpty()) {
+            continue;
+        }
+        ResourceRequest *request = requests.first();
+        const int index = resources.indexOf(request->resource());
+        request->addRequiredResource(resources.at((index + 1) % resources.count()));
+        request->addAlternativeRequest(new ResourceRequest(resources.at((index + 2) % resources.count()), 50));
+    }
+    ScheduleManager *sm = ProjectGenerator::scheduleManager(project);
+    sm->createSchedules();
+    project->calculate(*sm);
+    return project;
+}
+
+void ProjectStreamLoaderTester::equivalence()
+{
+    Project *project = createProject(60);
+    QVERIFY(ProjectGenerator::scheduleManager(project)->isScheduled());
+    const QByteArray data = save(project);
+    delete project;
+
+    Project p1;
+    QVERIFY(loadDocument(data, &p1));
+    Project p2;
+    QVERIFY(loadStream(data, &p2));
+
+    QCOMPARE(p2.allTasks().count(), p1.allTasks().count());
+    QCOMPARE(p2.resourceList().count(), p1.resourceList().count());
+    QCOMPARE(p2.numScheduleManagers(), p1.numScheduleManagers());
+    const long id = p2.scheduleManagers().value(0)->scheduleId();
+    QCOMPARE(id, p1.scheduleManagers().value(0)->scheduleId());
+    int requests = 0;
+    int required = 0;
+    int alternatives = 0;
+    int appointments = 0;
+    const QList<Task*> tasks = p2.allTasks();
+    for (Task *t2 : tasks) {
+        Task *t1 = static_cast<Task*>(p1.findNode(t2->id()));
+        QVERIFY(t1);
+        const QList<ResourceRequest*> r1 = t1->requests().resourceRequests(false);
+        const QList<ResourceRequest*> r2 = t2->requests().resourceRequests(false);
+        QCOMPARE(r2.count(), r1.count());
+        for (int i = 0; i < r2.count(); ++i) {
+            QCOMPARE(r2.at(i)->resource()->id(), r1.at(i)->resource()->id());
+            QCOMPARE(r2.at(i)->units(), r1.at(i)->units());
+            QCOMPARE(r2.at(i)->requiredResources().count(), r1.at(i)->requiredResources().count());
+            QCOMPARE(r2.at(i)->alternativeRequests().count(), r1.at(i)->alternativeRequests().count());
+            required += r2.at(i)->requiredResources().count();
+            alternatives += r2.at(i)->alternativeRequests().count();
+        }
+        requests += r2.count();
+        QCOMPARE(t2->startTime(id), t1->startTime(id));
+        QCOMPARE(t2->endTime(id), t1->endTime(id));
+        QCOMPARE(t2->plannedEffort(id), t1->plannedEffort(id));
+        QCOMPARE(t2->appointments(id).count(), t1->appointments(id).count());
+        appointments += t2->appointments(id).count();
+    }
+    QVERIFY(requests > 0);
+    QVERIFY(required > 0);
+    QVERIFY(alternatives > 0);
+    QVERIFY(appointments > 0);
+}
+
+void ProjectStreamLoaderTester::unknownRequestTags()
+{
+    Project *project = createProject(10);
+    QByteArray data = save(project);
+    const QString taskId = project->allTasks().first()->id();
+    const QString resourceId = project->resourceList().last()->id();
+    delete project;
+
+    // the document loader ignores unknown elements, so shall the stream loader
+    const QByteArray tag("<resource-requests>");
+    QVERIFY(data.contains(tag));
+    data.replace(tag, tag + QStringLiteral("<unknown task-id=\"%1\" resource-id=\"%2\" request-id=\"999\" units=\"100\"/>").arg(taskId, resourceId).toUtf8());
+
+    Project p1;
+    QVERIFY(loadDocument(data, &p1));
+    Project p2;
+    QVERIFY(loadStream(data, &p2));
+    QVERIFY(!p1.findNode(taskId)->requests().resourceRequest(999));
+    QVERIFY(!p2.findNode(taskId)->requests().resourceRequest(999));
+    QCOMPARE(p2.findNode(taskId)->requests().resourceRequests(false).count(), p1.findNode(taskId)->requests().resourceRequests(false).count());
+}
+
+void ProjectStreamLoaderTester::benchmarkDocumentLoader_data()
+{
+    QTest::addColumn<int>("tasks");
+
+    QTest::newRow("500 tasks") << 500;
+    QTest::newRow("2000 tasks") << 2000;
+    QTest::newRow("5000 tasks") << 5000;
+    // a real, large project
+    if (!qEnvironmentVariableIsEmpty("PLAN_BENCHMARK_FILE")) {
+        QTest::newRow("file") << -1;
+    }
+}
+
+void ProjectStreamLoaderTester::benchmarkDocumentLoader()
+{
+    QFETCH(int, tasks);
+
+    const QByteArray data = benchmarkData(tasks);
+    QVERIFY(!data.isEmpty());
+    QBENCHMARK {
+        Project p;
+        QVERIFY(loadDocument(data, &p));
+    }
+}
+
+void ProjectStreamLoaderTester::benchmarkStreamLoader_data()
+{
+    benchmarkDocumentLoader_data();
+}
+
+void ProjectStreamLoaderTester::benchmarkStreamLoader()
+{
+    QFETCH(int, tasks);
+
+    const QByteArray data = benchmarkData(tasks);
+    QVERIFY(!data.isEmpty());
+    QBENCHMARK {
+        Project p;
+        QVERIFY(loadStream(data, &p));
+    }
+}
+
+void ProjectStreamLoaderTester::benchmarkLoaderMemory_data()
+{
+    QTest::addColumn<bool>("stream");
+    QTest::addColumn<int>("tasks");
+
+    QTest::newRow("document, 5000 tasks") << false << 5000;
+    QTest::newRow("stream, 5000 tasks") << true << 5000;
+    if (!qEnvironmentVariableIsEmpty("PLAN_BENCHMARK_FILE")) {
+        QTest::newRow("document, file") << false << -1;
+        QTest::newRow("stream, file") << true << -1;
+    }
+}
+
+// Peak memory used while loading, in addition to the document text.
+// Freed memory may be reused by the next row, run one row at a time for exact numbers.
+void ProjectStreamLoaderTester::benchmarkLoaderMemory()
+{
+    QFETCH(bool, stream);
+    QFETCH(int, tasks);
+
+    const QByteArray data = benchmarkData(tasks);
+    QVERIFY(!data.isEmpty());
+    if (!resetPeakMemory() || processMemory("VmHWM") < 0) {
+        QSKIP("Peak memory usage not available");
+    }
+    const qint64 before = processMemory("VmRSS");
+    Project p;
+    QVERIFY(stream ? loadStream(data, &p) : loadDocument(data, &p));
+    const qint64 peak = processMemory("VmHWM");
+    const qint64 retained = processMemory("VmRSS");
+    qInfo()<<"document:"<<data.size() / 1024<<"kB, peak:"<<peak - before<<"kB, project:"<<retained - before<<"kB";
+    QTest::setBenchmarkResult((peak - before) * 1024., QTest::BytesAllocated);
+}
+
+} //namespace KPlato
+
+QTEST_GUILESS_MAIN(KPlato::ProjectStreamLoaderTester)
@@ -0,0 +1,37 @@
+/* This file is part of the KDE project
+   SPDX-FileCopyrightText: 2026 agent <agent@local>
+   
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KPlato_ProjectStreamLoaderTester_h
+#define KPlato_ProjectStreamLoaderTester_h
+
+#include <QObject>
+
+namespace KPlato
+{
+class Project;
+
+class ProjectStreamLoaderTester : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void equivalence();
+    void unknownRequestTags();
+    void benchmarkDocumentLoader_data();
+    void benchmarkDocumentLoader();
+    void benchmarkStreamLoader_data();
+    void benchmarkStreamLoader();
+    void benchmarkLoaderMemory_data();
+    void benchmarkLoaderMemory();
+
+private:
+    Project *createProject(int tasks) const;
+    /// Generated project with @p tasks, or the PLAN_BENCHMARK_FILE if @p tasks is negative
+    QByteArray benchmarkData(int tasks) const;
+};
+
+} //namespace KPlato
+
+#endif
@@ -16,6 +16,7 @@
 #include "kptschedule.h"
 
 #include <QTest>
+#include <QSignalSpy>
 
 #include "debug.cpp"
 
@@ -113,6 +114,112 @@ void ProjectTester::testTaskDeleteCmd()
     m_task = nullptr;
 }
 
+void ProjectTester::childPositions()
+{
+    Project project;
+    project.setId(project.uniqueNodeId());
+    project.registerNodeId(&project);
+
+    QList<Node*> tasks;
+    for (int i = 0; i < 6; ++i) {
+        Task *t = project.createTask();
+        t->setName(QStringLiteral("T%1").arg(i));
+        QVERIFY(project.addTask(t, &project));
+        tasks << t;
+    }
+    for (int i = 0; i < tasks.count(); ++i) {
+        QCOMPARE(project.findChildNode(tasks.at(i)), i);
+    }
+    // insert in the middle
+    Task *t = project.createTask();
+    QVERIFY(project.addSubTask(t, 2, &project));
+    tasks.insert(2, t);
+    for (int i = 0; i < tasks.count(); ++i) {
+        QCOMPARE(project.findChildNode(tasks.at(i)), i);
+        QCOMPARE(project.findChildNode(tasks.at(i)), i);
+    }
+    // take
+    project.takeTask(tasks.at(0));
+    delete tasks.takeFirst();
+    for (int i = 0; i < tasks.count(); ++i) {
+        QCOMPARE(project.findChildNode(tasks.at(i)), i);
+    }
+    // move
+    QVERIFY(project.moveTaskUp(tasks.last()));
+    tasks.move(tasks.count() - 1, tasks.count() - 2);
+    QVERIFY(project.moveTaskDown(tasks.first()));
+    tasks.move(0, 1);
+    for (int i = 0; i < tasks.count(); ++i) {
+        QCOMPARE(project.findChildNode(tasks.at(i)), i);
+        QCOMPARE(tasks.at(i)->siblingBefore(), i > 0 ? tasks.at(i - 1) : nullptr);
+        QCOMPARE(tasks.at(i)->siblingAfter(), i < tasks.count() - 1 ? tasks.at(i + 1) : nullptr);
+    }
+    // move to another parent
+    Node *parent = tasks.at(0);
+    Node *child = tasks.at(3);
+    NodeMoveCmd cmd(&project, child, parent, 0);
+    cmd.execute();
+    QCOMPARE(parent->indexOf(child), 0);
+    QCOMPARE(project.findChildNode(child), -1);
+    tasks.removeAt(3);
+    for (int i = 0; i < tasks.count(); ++i) {
+        QCOMPARE(project.findChildNode(tasks.at(i)), i);
+    }
+    cmd.unexecute();
+    tasks.insert(3, child);
+    QCOMPARE(parent->indexOf(child), -1);
+    for (int i = 0; i < tasks.count(); ++i) {
+        QCOMPARE(project.findChildNode(tasks.at(i)), i);
+    }
+    QCOMPARE(project.findChildNode(nullptr), -1);
+}
+
+void ProjectTester::batchChanges()
+{
+    Project project;
+    project.setId(project.uniqueNodeId());
+    project.registerNodeId(&project);
+
+    QSignalSpy changed(&project, &Project::projectChanged);
+    QSignalSpy started(&project, &Project::changesStarted);
+    QSignalSpy finished(&project, &Project::changesFinished);
+    QSignalSpy added(&project, &Project::nodeAdded);
+
+    project.beginChanges();
+    QVERIFY(project.isChanging());
+    for (int i = 0; i < 3; ++i) {
+        QVERIFY(project.addTask(project.createTask(), &project));
+    }
+    const QString name = project.childNode(0)->name();
+    // nested
+    MacroCommand cmd;
+    cmd.setBatchProject(&project);
+    cmd.addCommand(new NodeModifyNameCmd(*project.childNode(0), QStringLiteral("T1")));
+    cmd.addCommand(new NodeModifyNameCmd(*project.childNode(1), QStringLiteral("T2")));
+    cmd.redo();
+    QVERIFY(project.isChanging());
+    QCOMPARE(changed.count(), 0);
+    QCOMPARE(finished.count(), 0);
+    project.endChanges();
+
+    QVERIFY(!project.isChanging());
+    QCOMPARE(started.count(), 1);
+    QCOMPARE(finished.count(), 1);
+    QCOMPARE(changed.count(), 1);
+    QCOMPARE(added.count(), 3);
+
+    cmd.undo();
+    QCOMPARE(started.count(), 2);
+    QCOMPARE(finished.count(), 2);
+    QCOMPARE(changed.count(), 2);
+    QCOMPARE(project.childNode(0)->name(), name);
+
+    // no changes, no projectChanged
+    project.beginChanges();
+    project.endChanges();
+    QCOMPARE(changed.count(), 2);
+}
+
 void ProjectTester::schedule()
 {
     QDate today = QDate::fromString(QStringLiteral("2012-02-01"), Qt::ISODate);
@@ -28,6 +28,8 @@ private Q_SLOTS:
     void testTakeTask();
     void testTaskAddCmd();
     void testTaskDeleteCmd();
+    void childPositions();
+    void batchChanges();
 
     void schedule();
     void scheduleFullday();
@@ -8,8 +8,11 @@
 
 #include "kptdatetime.h"
 #include "kptschedule.h"
+#include "kptproject.h"
+#include "ScheduleLog.h"
 
 #include <QTest>
+#include <QSignalSpy>
 
 namespace QTest
 {
@@ -129,6 +132,66 @@ void ScheduleTester::busy()
 
 }
 
+void ScheduleTester::logRecords()
+{
+    Project project;
+    MainSchedule schedule(&project, QStringLiteral("Test"), Schedule::Expected, 1);
+    DateTime start(date, t1);
+    DateTime end(date, t2);
+    scheduleLogDebug(&schedule, ScheduleLog::Event_RequiredAvailable, ScheduleLog::time(start), ScheduleLog::time(end));
+    scheduleLogDebug(&schedule, ScheduleLog::Event_Effort, ScheduleLog::time(start), Duration(1, 0, 0).milliseconds(), Duration(0, 8, 0).milliseconds());
+    QVector<Schedule::Log> logs = schedule.logs();
+    QCOMPARE(logs.count(), 2);
+    QCOMPARE(logs.at(0).node, &project);
+    QCOMPARE(logs.at(0).severity, (int)Schedule::Log::Type_Debug);
+    QVERIFY(logs.at(0).message.isEmpty());
+    QVERIFY(logs.at(0).text().startsWith(QStringLiteral("Required available in interval:")));
+    QCOMPARE(logs.at(1).text(), QStringLiteral("effort: %1 for %2 effort = %3").arg(start.toString(), Duration(1, 0, 0).toString(), Duration(0, 8, 0).toString()));
+
+    const int level = ScheduleLog::level();
+    ScheduleLog::setLevel(ScheduleLog::Severity_Info);
+    scheduleLogDebug(&schedule, ScheduleLog::Event_AvailableUntilInvalid);
+    QCOMPARE(schedule.logs().count(), 2);
+    ScheduleLog::setLevel(level);
+}
+
+void ScheduleTester::logRecordBatches()
+{
+    Project project;
+    ScheduleManager *sm = project.createScheduleManager(QStringLiteral("Test Plan"));
+    project.addScheduleManager(sm);
+    sm->createSchedules();
+    MainSchedule *schedule = sm->expected();
+    QVERIFY(schedule);
+    qRegisterMetaType<QVector<KPlato::Schedule::Log> >();
+    QSignalSpy spy(sm, &ScheduleManager::sigLogsAdded);
+
+    const int level = ScheduleLog::level();
+    ScheduleLog::setLevel(ScheduleLog::Severity_Debug);
+    if (!ScheduleLog::isEnabled(ScheduleLog::Severity_Debug)) {
+        ScheduleLog::setLevel(level);
+        QSKIP("Debug records are not compiled in");
+    }
+    // records are emitted when a batch is full, without waiting for the calculation to finish
+    for (int i = 0; i < MainSchedule::LogRecordBatchSize - 1; ++i) {
+        scheduleLogDebug(schedule, ScheduleLog::Event_AvailableUntilInvalid);
+    }
+    QCOMPARE(spy.count(), 0);
+    scheduleLogDebug(schedule, ScheduleLog::Event_AvailableUntilInvalid);
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(spy.at(0).at(0).value<QVector<Schedule::Log> >().count(), MainSchedule::LogRecordBatchSize);
+
+    // or when the first pending record is old enough
+    scheduleLogDebug(schedule, ScheduleLog::Event_AvailableUntilInvalid);
+    QCOMPARE(spy.count(), 1);
+    QTest::qWait(MainSchedule::LogRecordFlushInterval + 10);
+    scheduleLogDebug(schedule, ScheduleLog::Event_AvailableUntilInvalid);
+    QCOMPARE(spy.count(), 2);
+    QCOMPARE(spy.at(1).at(0).value<QVector<Schedule::Log> >().count(), 2);
+    QCOMPARE(schedule->logs().count(), MainSchedule::LogRecordBatchSize + 2);
+    ScheduleLog::setLevel(level);
+}
+
 } //namespace KPlato
 
 QTEST_GUILESS_MAIN(KPlato::ScheduleTester)
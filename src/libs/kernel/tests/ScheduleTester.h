@@ -26,6 +26,8 @@ private Q_SLOTS:
     
     void available();
     void busy();
+    void logRecords();
+    void logRecordBatches();
 
 private:
     ResourceSchedule resourceSchedule;
@@ -0,0 +1,187 @@
+/* This file is part of the KDE project
+   SPDX-FileCopyrightText: 2026 agent <agent@local>
+   
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+// clazy:excludeall=qstring-arg
+#include "TimePhasedCacheTester.h"
+#include "ProjectGenerator.h"
+
+#include "TimePhasedCache.h"
+#include "kptappointment.h"
+#include "kptproject.h"
+#include "kpttask.h"
+#include "kptschedule.h"
+#include "Resource.h"
+
+#include <QSignalSpy>
+#include <QTest>
+
+
+namespace KPlato
+{
+
+// Aggregate the appointments of @p s without using the cache
+static QMap<QDate, Duration> effortPrDay(const Schedule *s)
+{
+    QMap<QDate, Duration> map;
+    const QList<Appointment*> appointments = s->appointments();
+    for (const Appointment *a : appointments) {
+        const EffortCostMap ec = a->plannedPrDay(QDate(), QDate());
+        EffortCostDayMap::const_iterator it = ec.days().constBegin();
+        for (; it != ec.days().constEnd(); ++it) {
+            map[it.key()] += it.value().effort();
+        }
+    }
+    return map;
+}
+
+static void compare(const TimePhasedCache &cache, const Schedule *s)
+{
+    const QMap<QDate, Duration> expected = effortPrDay(s);
+    Duration total;
+    QMap<QDate, Duration>::const_iterator it = expected.constBegin();
+    for (; it != expected.constEnd(); ++it) {
+        QCOMPARE(cache.effort(s, it.key()), it.value());
+        total += it.value();
+    }
+    QCOMPARE(cache.totalEffort(s), total);
+    if (!expected.isEmpty()) {
+        QCOMPARE(cache.effort(s, expected.firstKey().addDays(-1)), Duration::zeroDuration);
+        QCOMPARE(cache.effort(s, expected.lastKey().addDays(1)), Duration::zeroDuration);
+    }
+}
+
+// Compare the coarser series of @p cache with the sum of the days in each period
+static void comparePeriods(const TimePhasedCache &cache, const Schedule *s)
+{
+    const QMap<QDate, Duration> expected = effortPrDay(s);
+    for (int r = TimePhasedCache::Week; r <= TimePhasedCache::Quarter; ++r) {
+        const TimePhasedCache::Resolution resolution = static_cast<TimePhasedCache::Resolution>(r);
+        QMap<QDate, Duration> periods;
+        QMap<QDate, Duration>::const_iterator it = expected.constBegin();
+        for (; it != expected.constEnd(); ++it) {
+            periods[TimePhasedCache::periodStart(it.key(), resolution)] += it.value();
+        }
+        for (it = periods.constBegin(); it != periods.constEnd(); ++it) {
+            // any day in the period gives the same result
+            QCOMPARE(cache.effort(s, it.key(), resolution), it.value());
+            QCOMPARE(cache.effort(s, TimePhasedCache::nextPeriodStart(it.key(), resolution).addDays(-1), resolution), it.value());
+        }
+    }
+}
+
+void TimePhasedCacheTester::initTestCase()
+{
+    ProjectGenerator::Parameters p;
+    p.tasks = 30;
+    p.resources = 4;
+    p.maxEffort = 10;
+    m_project = ProjectGenerator(p).generate();
+    m_manager = ProjectGenerator::scheduleManager(m_project);
+    m_manager->createSchedules();
+    m_project->calculate(*m_manager);
+    QVERIFY(m_manager->isScheduled());
+
+    // the cache is built in a worker thread
+    MainSchedule *ms = m_manager->expected();
+    QTRY_VERIFY(ms->timePhasedCache().isValid() && ms->timePhasedCache().revision() == ms->appointmentRevision());
+}
+
+void TimePhasedCacheTester::cleanupTestCase()
+{
+    delete m_project;
+}
+
+void TimePhasedCacheTester::effort()
+{
+    const long id = m_manager->scheduleId();
+    const TimePhasedCache cache = m_manager->expected()->timePhasedCache();
+    QVERIFY(cache.isValid());
+
+    const QList<Task*> tasks = m_project->allTasks();
+    for (const Task *t : tasks) {
+        const Schedule *s = t->findSchedule(id);
+        QVERIFY(s);
+        compare(cache, s);
+    }
+    const QList<Resource*> resources = m_project->resourceList();
+    for (const Resource *r : resources) {
+        const Schedule *s = r->findSchedule(id);
+        QVERIFY(s);
+        compare(cache, s);
+        if (!s->appointments().isEmpty()) {
+            QVERIFY(cache.startDate(s).isValid());
+            QVERIFY(cache.startDate(s) <= cache.endDate(s));
+        }
+    }
+}
+
+void TimePhasedCacheTester::periods()
+{
+    QCOMPARE(TimePhasedCache::periodStart(QDate(2026, 10, 18), TimePhasedCache::Day), QDate(2026, 10, 18));
+    QCOMPARE(TimePhasedCache::periodStart(QDate(2026, 10, 18), TimePhasedCache::Week), QDate(2026, 10, 12));
+    QCOMPARE(TimePhasedCache::periodStart(QDate(2026, 10, 18), TimePhasedCache::Month), QDate(2026, 10, 1));
+    QCOMPARE(TimePhasedCache::periodStart(QDate(2026, 10, 18), TimePhasedCache::Quarter), QDate(2026, 10, 1));
+    QCOMPARE(TimePhasedCache::periodStart(QDate(2026, 9, 30), TimePhasedCache::Quarter), QDate(2026, 7, 1));
+    QCOMPARE(TimePhasedCache::nextPeriodStart(QDate(2026, 12, 31), TimePhasedCache::Week), QDate(2027, 1, 4));
+    QCOMPARE(TimePhasedCache::nextPeriodStart(QDate(2026, 12, 31), TimePhasedCache::Month), QDate(2027, 1, 1));
+    QCOMPARE(TimePhasedCache::nextPeriodStart(QDate(2026, 11, 15), TimePhasedCache::Quarter), QDate(2027, 1, 1));
+
+    const long id = m_manager->scheduleId();
+    const TimePhasedCache cache = m_manager->expected()->timePhasedCache();
+    QVERIFY(cache.isValid());
+    const QList<Task*> tasks = m_project->allTasks();
+    for (const Task *t : tasks) {
+        comparePeriods(cache, t->findSchedule(id));
+    }
+    const QList<Resource*> resources = m_project->resourceList();
+    for (const Resource *r : resources) {
+        comparePeriods(cache, r->findSchedule(id));
+    }
+}
+
+void TimePhasedCacheTester::buildInWorker()
+{
+    const long id = m_manager->scheduleId();
+    MainSchedule *ms = m_manager->expected();
+
+    Task *task = m_project->allTasks().last();
+    Schedule *s = task->findSchedule(id);
+    QVERIFY(!s->appointments().isEmpty());
+    Appointment *a = s->appointments().first();
+    const DateTime start = a->endTime().addDays(7);
+    a->addInterval(start, start + Duration(qint64(4), Duration::Unit_h), 100);
+
+    QSignalSpy spy(m_project, &Project::timePhasedCacheChanged);
+    // the cache is not rebuilt by the caller, the last one is returned
+    TimePhasedCache cache = ms->timePhasedCache();
+    QVERIFY(cache.isValid());
+    QVERIFY(cache.revision() != ms->appointmentRevision());
+    QCOMPARE(cache.effort(s, start.date()), Duration::zeroDuration);
+    QTRY_COMPARE(ms->timePhasedCache().revision(), ms->appointmentRevision());
+    QTRY_VERIFY(!spy.isEmpty());
+    QCOMPARE(spy.last().at(0).value<ScheduleManager*>(), m_manager);
+
+    cache = ms->timePhasedCache();
+    QCOMPARE(cache.effort(s, start.date()), Duration(qint64(4), Duration::Unit_h));
+    compare(cache, s);
+    compare(cache, a->resource());
+
+    // a change made after the build is picked up by the next build
+    a->addInterval(start.addDays(1), start.addDays(1) + Duration(qint64(2), Duration::Unit_h), 100);
+    QVERIFY(cache.revision() != ms->appointmentRevision());
+    ms->buildTimePhasedCache();
+    // the copy we have is not changed
+    QCOMPARE(cache.effort(s, start.date().addDays(1)), Duration::zeroDuration);
+    QTRY_COMPARE(ms->timePhasedCache().revision(), ms->appointmentRevision());
+    cache = ms->timePhasedCache();
+    QCOMPARE(cache.effort(s, start.date().addDays(1)), Duration(qint64(2), Duration::Unit_h));
+    compare(cache, s);
+    comparePeriods(cache, s);
+}
+
+} //namespace KPlato
+
+QTEST_GUILESS_MAIN(KPlato::TimePhasedCacheTester)
@@ -0,0 +1,35 @@
+/* This file is part of the KDE project
+   SPDX-FileCopyrightText: 2026 agent <agent@local>
+   
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KPlato_TimePhasedCacheTester_h
+#define KPlato_TimePhasedCacheTester_h
+
+#include <QObject>
+
+namespace KPlato
+{
+class Project;
+class ScheduleManager;
+
+class TimePhasedCacheTester : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void effort();
+    void periods();
+    void buildInWorker();
+
+private:
+    Project *m_project;
+    ScheduleManager *m_manager;
+};
+
+} //namespace KPlato
+
+#endif
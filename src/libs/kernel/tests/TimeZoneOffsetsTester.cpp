@@ -0,0 +1,203 @@
+/* This file is part of the KDE project
+   SPDX-FileCopyrightText: 2026 agent <agent@local>
+   
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+// clazy:excludeall=qstring-arg
+#include "TimeZoneOffsetsTester.h"
+
+#include "TimeZoneOffsets.h"
+#include "kptcalendar.h"
+#include "kptappointment.h"
+#include "kptdatetime.h"
+
+#include <QTest>
+#include <QTimeZone>
+
+
+namespace KPlato
+{
+
+void TimeZoneOffsetsTester::timePoint()
+{
+    TimePoint t;
+    QVERIFY(!t.isValid());
+    QVERIFY(!TimePoint::fromDateTime(QDateTime()).isValid());
+    QVERIFY(!TimeZoneOffsets::forTimeZone(QTimeZone("Europe/Berlin")).toDateTime(t).isValid());
+
+    const QDateTime dt(QDate(2023, 6, 1), QTime(12, 0), Qt::UTC);
+    t = TimePoint::fromDateTime(dt);
+    QVERIFY(t.isValid());
+    QCOMPARE(t.toMSecsSinceEpoch(), dt.toMSecsSinceEpoch());
+    QCOMPARE(t.addMSecs(1000).toMSecsSinceEpoch(), dt.addSecs(1).toMSecsSinceEpoch());
+    QCOMPARE(t.msecsTo(t.addMSecs(60000)), 60000);
+    QVERIFY(t < t.addMSecs(1));
+    QVERIFY(t == TimePoint::fromDateTime(dt.toTimeZone(QTimeZone("Europe/Berlin"))));
+
+    const TimeZoneOffsets offsets = TimeZoneOffsets::forTimeZone(QTimeZone("Europe/Berlin"));
+    const DateTime result = offsets.toDateTime(t);
+    QCOMPARE(result.timeZone(), QTimeZone("Europe/Berlin"));
+    QCOMPARE(result.time(), QTime(14, 0));
+    QCOMPARE(result, DateTime(dt));
+    QCOMPARE(offsets.localDate(t), QDate(2023, 6, 1));
+    QCOMPARE(offsets.localTime(t), QTime(14, 0));
+
+    // before epoch, local date is the day before
+    t = TimePoint::fromDateTime(QDateTime(QDate(1969, 12, 31), QTime(22, 30), Qt::UTC));
+    QCOMPARE(offsets.localDate(t), QDate(1969, 12, 31));
+    QCOMPARE(offsets.localTime(t), QTime(23, 30));
+    QVERIFY(!offsets.localDate(TimePoint()).isValid());
+}
+
+void TimeZoneOffsetsTester::offsetFromUtc_data()
+{
+    QTest::addColumn<QByteArray>("zone");
+
+    QTest::newRow("UTC") << QByteArray("UTC");
+    QTest::newRow("Europe/Berlin") << QByteArray("Europe/Berlin");
+    QTest::newRow("America/New_York") << QByteArray("America/New_York");
+    QTest::newRow("Australia/Sydney") << QByteArray("Australia/Sydney");
+    QTest::newRow("Asia/Kolkata") << QByteArray("Asia/Kolkata");
+}
+
+void TimeZoneOffsetsTester::offsetFromUtc()
+{
+    QFETCH(QByteArray, zone);
+    const QTimeZone tz(zone);
+    if (!tz.isValid()) {
+        QSKIP("Time zone not available");
+    }
+    const TimeZoneOffsets offsets = TimeZoneOffsets::forTimeZone(tz);
+    QVERIFY(offsets.isValid());
+    QCOMPARE(offsets.timeZone(), tz);
+
+    // every 5 hours through some years, also outside the table
+    const QList<int> years = QList<int>() << 1960 << 2022 << 2023 << 2110;
+    for (int year : years) {
+        QDateTime dt(QDate(year, 1, 1), QTime(0, 0), Qt::UTC);
+        const QDateTime end = dt.addYears(1);
+        for (; dt < end; dt = dt.addSecs(5 * 3600)) {
+            QCOMPARE(offsets.offsetFromUtc(TimePoint::fromDateTime(dt)), tz.offsetFromUtc(dt));
+        }
+    }
+}
+
+void TimeZoneOffsetsTester::fromLocal_data()
+{
+    QTest::addColumn<QByteArray>("zone");
+    QTest::addColumn<QDate>("date");
+
+    QTest::newRow("Berlin, summer time") << QByteArray("Europe/Berlin") << QDate(2023, 3, 26);
+    QTest::newRow("Berlin, winter time") << QByteArray("Europe/Berlin") << QDate(2023, 10, 29);
+    QTest::newRow("New York, summer time") << QByteArray("America/New_York") << QDate(2023, 3, 12);
+    QTest::newRow("Sydney, summer time") << QByteArray("Australia/Sydney") << QDate(2023, 10, 1);
+    QTest::newRow("Kolkata") << QByteArray("Asia/Kolkata") << QDate(2023, 3, 26);
+}
+
+void TimeZoneOffsetsTester::fromLocal()
+{
+    QFETCH(QByteArray, zone);
+    QFETCH(QDate, date);
+    const QTimeZone tz(zone);
+    if (!tz.isValid()) {
+        QSKIP("Time zone not available");
+    }
+    const TimeZoneOffsets offsets = TimeZoneOffsets::forTimeZone(tz);
+    // the days around the change, skipping the hours where local time is skipped or repeated
+    for (QDate d = date.addDays(-1); d <= date.addDays(1); d = d.addDays(1)) {
+        for (QTime t(0, 0); ; t = t.addSecs(15 * 60)) {
+            const QDateTime expected(d, t, tz);
+            const bool changing = tz.offsetFromUtc(expected.addSecs(-3600)) != tz.offsetFromUtc(expected.addSecs(3600));
+            if (!changing) {
+                QCOMPARE(offsets.fromLocal(d, t).toMSecsSinceEpoch(), expected.toMSecsSinceEpoch());
+                QCOMPARE(offsets.toDateTime(offsets.fromLocal(d, t)), DateTime(expected));
+            }
+            if (t == QTime(23, 45)) {
+                break;
+            }
+        }
+    }
+}
+
+void TimeZoneOffsetsTester::daylightTime()
+{
+    const QTimeZone tz("Europe/Berlin");
+    const TimeZoneOffsets offsets = TimeZoneOffsets::forTimeZone(tz);
+
+    // 02:30 does not exist, moved forward to 03:30 summer time, same as DateTime
+    TimePoint t = offsets.fromLocal(QDate(2023, 3, 26), QTime(2, 30));
+    QCOMPARE(t.toMSecsSinceEpoch(), QDateTime(QDate(2023, 3, 26), QTime(1, 30), Qt::UTC).toMSecsSinceEpoch());
+    QCOMPARE(offsets.toDateTime(t).time(), QTime(3, 30));
+    QCOMPARE(t.toMSecsSinceEpoch(), DateTime(QDate(2023, 3, 26), QTime(2, 30), tz).toMSecsSinceEpoch());
+
+    // 02:30 exists twice, the first is summer time
+    t = offsets.fromLocal(QDate(2023, 10, 29), QTime(2, 30));
+    QCOMPARE(t.toMSecsSinceEpoch(), QDateTime(QDate(2023, 10, 29), QTime(0, 30), Qt::UTC).toMSecsSinceEpoch());
+    QCOMPARE(offsets.offsetFromUtc(t), 7200);
+    QCOMPARE(offsets.offsetFromUtc(t.addMSecs(3600 * 1000)), 3600);
+}
+
+void TimeZoneOffsetsTester::calendarIntervals()
+{
+    const QTimeZone tz("Europe/Berlin");
+    Calendar calendar(QStringLiteral("Test"));
+    calendar.setTimeZone(tz);
+    for (int i = 1; i <= 7; ++i) {
+        CalendarDay *day = calendar.weekday(i);
+        day->setState(CalendarDay::Working);
+        day->addInterval(TimeInterval(QTime(8, 0), 4 * 3600 * 1000));
+        day->addInterval(TimeInterval(QTime(13, 0), 4 * 3600 * 1000));
+    }
+    // over the change to summer time, the result is in the callers time zone
+    const QTimeZone utc("UTC");
+    const DateTime start(QDate(2023, 3, 25), QTime(0, 0), utc);
+    const DateTime end(QDate(2023, 3, 27), QTime(0, 0), utc);
+    AppointmentIntervalList lst = calendar.workIntervals(start, end, 100.);
+    const QList<AppointmentInterval> intervals = lst.map().values();
+    QCOMPARE(intervals.count(), 4);
+    QCOMPARE(intervals.at(0).startTime(), DateTime(QDate(2023, 3, 25), QTime(7, 0), utc));
+    QCOMPARE(intervals.at(0).startTime().timeZone(), utc);
+    QCOMPARE(intervals.at(1).endTime(), DateTime(QDate(2023, 3, 25), QTime(16, 0), utc));
+    QCOMPARE(intervals.at(2).startTime(), DateTime(QDate(2023, 3, 26), QTime(6, 0), utc));
+    QCOMPARE(intervals.at(3).endTime(), DateTime(QDate(2023, 3, 26), QTime(15, 0), utc));
+
+    const DateTimeInterval first = calendar.firstInterval(DateTime(QDate(2023, 3, 26), QTime(0, 0), tz), DateTime(QDate(2023, 3, 27), QTime(0, 0), tz));
+    QCOMPARE(first.first, DateTime(QDate(2023, 3, 26), QTime(8, 0), tz));
+    QCOMPARE(first.second, DateTime(QDate(2023, 3, 26), QTime(12, 0), tz));
+    QCOMPARE(first.first.timeZone(), tz);
+}
+
+void TimeZoneOffsetsTester::appointmentIntervals()
+{
+    const QTimeZone tz("Europe/Berlin");
+    const QTimeZone utc("UTC");
+    const TimeZoneOffsets offsets = TimeZoneOffsets::forTimeZone(tz);
+    const TimePoint start = offsets.fromLocal(QDate(2023, 3, 25), QTime(20, 0));
+    const TimePoint end = offsets.fromLocal(QDate(2023, 3, 26), QTime(4, 0));
+    AppointmentInterval ai(offsets, start, end, 50.);
+    QCOMPARE(ai.startTime(), DateTime(QDate(2023, 3, 25), QTime(20, 0), tz));
+    QCOMPARE(ai.endTime().timeZone(), tz);
+    QCOMPARE(ai.effort(start, end), Duration(7.0, Duration::Unit_h) * 0.5);
+    QCOMPARE(ai.effort(TimePoint(), start.addMSecs(3600 * 1000)), Duration(1.0, Duration::Unit_h) * 0.5);
+
+    // changing time zone keeps the instants
+    AppointmentInterval other = ai;
+    other.toTimeZone(TimeZoneOffsets::forTimeZone(utc));
+    QCOMPARE(other.start(), ai.start());
+    QCOMPARE(other.end(), ai.end());
+    QCOMPARE(other.startTime().time(), QTime(19, 0));
+    QCOMPARE(other.startDate(), QDate(2023, 3, 25));
+
+    // the list splits at local midnight
+    AppointmentIntervalList lst;
+    lst.add(ai);
+    QCOMPARE(lst.map().count(), 2);
+    QCOMPARE(lst.map().first().endTime(), DateTime(QDate(2023, 3, 26), QTime(0, 0), tz));
+    QCOMPARE(lst.map().last().startTime(), DateTime(QDate(2023, 3, 26), QTime(0, 0), tz));
+    QCOMPARE(lst.effort(start, end), ai.effort(start, end));
+}
+
+} //namespace KPlato
+
+QTEST_GUILESS_MAIN(KPlato::TimeZoneOffsetsTester)
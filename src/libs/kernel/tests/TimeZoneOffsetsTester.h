@@ -0,0 +1,31 @@
+/* This file is part of the KDE project
+   SPDX-FileCopyrightText: 2026 agent <agent@local>
+   
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KPlato_TimeZoneOffsetsTester_h
+#define KPlato_TimeZoneOffsetsTester_h
+
+#include <QObject>
+
+namespace KPlato
+{
+
+class TimeZoneOffsetsTester : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void timePoint();
+    void offsetFromUtc_data();
+    void offsetFromUtc();
+    void fromLocal_data();
+    void fromLocal();
+    void daylightTime();
+    void calendarIntervals();
+    void appointmentIntervals();
+};
+
+} //namespace KPlato
+
+#endif
@@ -11,6 +11,7 @@
 
 #include <QTest>
 #include <QString>
+#include <QXmlStreamReader>
 
 #include <KoXmlReader.h>
 
@@ -505,6 +506,21 @@ void XmlLoaderTester::test(const KoXmlDocument &doc)
     Project p;
 
     QVERIFY(loader.loadProject(&p, doc));
+    test(p);
+}
+
+void XmlLoaderTester::test(QXmlStreamReader &reader)
+{
+    XMLLoaderObject loader;
+    Project p;
+
+    QVERIFY(loader.loadProject(&p, reader));
+    QVERIFY(!reader.hasError());
+    test(p);
+}
+
+void XmlLoaderTester::test(Project &p)
+{
     QVERIFY(!p.calendars().isEmpty());
     QCOMPARE(p.accounts().accountCount(), 1);
     QCOMPARE(p.accounts().accountList().at(0)->childCount(), 1);
@@ -675,4 +691,11 @@ void XmlLoaderTester::version_0_7()
     test(doc);
 }
 
+void XmlLoaderTester::version_0_7_stream()
+{
+    QXmlStreamReader reader(data_v0_7());
+    reader.setNamespaceProcessing(false);
+    test(reader);
+}
+
 QTEST_GUILESS_MAIN(KPlato::XmlLoaderTester)
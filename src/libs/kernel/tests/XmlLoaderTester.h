@@ -10,19 +10,25 @@
 #include <QObject>
 
 class KoXmlDocument;
+class QXmlStreamReader;
 
 namespace KPlato
 {
 
+class Project;
+
 class XmlLoaderTester : public QObject
 {
     Q_OBJECT
 private Q_SLOTS:
     void version_0_6();
     void version_0_7();
+    void version_0_7_stream();
 
 private:
     void test(const KoXmlDocument &doc);
+    void test(QXmlStreamReader &reader);
+    void test(Project &p);
     QString data_v0_6() const;
     QString data_v0_7() const;
 };
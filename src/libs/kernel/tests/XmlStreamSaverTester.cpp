@@ -0,0 +1,133 @@
+/* This file is part of the KDE project
+   SPDX-FileCopyrightText: 2026 agent <agent@local>
+   
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+// clazy:excludeall=qstring-arg
+#include "XmlStreamSaverTester.h"
+#include "ProjectGenerator.h"
+
+#include "XmlStreamSaver.h"
+#include "XmlSaveContext.h"
+#include "kptproject.h"
+#include "kptschedule.h"
+
+#include <KoXmlWriter.h>
+
+#include <QBuffer>
+#include <QDomDocument>
+#include <QTest>
+
+
+namespace KPlato
+{
+
+static QMap<QString, QString> attributes(const QDomElement &element)
+{
+    QMap<QString, QString> map;
+    const QDomNamedNodeMap attrs = element.attributes();
+    for (int i = 0; i < attrs.count(); ++i) {
+        const QDomAttr attr = attrs.item(i).toAttr();
+        map.insert(attr.name(), attr.value());
+    }
+    return map;
+}
+
+static void compare(const QDomElement &actual, const QDomElement &expected)
+{
+    QCOMPARE(actual.tagName(), expected.tagName());
+    QCOMPARE(attributes(actual), attributes(expected));
+    QDomNode a = actual.firstChild();
+    QDomNode e = expected.firstChild();
+    for (; !a.isNull() && !e.isNull(); a = a.nextSibling(), e = e.nextSibling()) {
+        QCOMPARE(a.nodeType(), e.nodeType());
+        if (e.isElement()) {
+            compare(a.toElement(), e.toElement());
+            if (QTest::currentTestFailed()) {
+                qInfo()<<"In element:"<<expected.tagName()<<attributes(expected);
+                return;
+            }
+        } else if (e.isCharacterData()) {
+            QCOMPARE(a.toCharacterData().data(), e.toCharacterData().data());
+        }
+    }
+    QVERIFY(a.isNull());
+    QVERIFY(e.isNull());
+}
+
+void XmlStreamSaverTester::save()
+{
+    ProjectGenerator::Parameters p;
+    p.tasks = 30;
+    p.summarySize = 5;
+    p.resources = 4;
+    Project *project = ProjectGenerator(p).generate();
+    ScheduleManager *sm = ProjectGenerator::scheduleManager(project);
+    sm->createSchedules();
+    project->calculate(*sm);
+    QVERIFY(sm->isScheduled());
+    project->childNode(0)->setDescription(QStringLiteral("Line 1\nLine 2 & <more>"));
+
+    XmlSaveContext context(project);
+    context.save();
+
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+    KoXmlWriter writer(&buffer);
+    XmlStreamSaver saver(writer);
+    saver.save(project);
+    buffer.close();
+
+    QDomDocument document;
+    QString error;
+    QVERIFY2(document.setContent(buffer.data(), &error), error.toUtf8().constData());
+    QCOMPARE(document.doctype().name(), QStringLiteral("plan"));
+    compare(document.documentElement(), context.document.documentElement());
+
+    // The streamed document contains the appointments
+    QVERIFY(document.elementsByTagName(QStringLiteral("appointment")).count() > 0);
+    QCOMPARE(document.elementsByTagName(QStringLiteral("appointment")).count(), context.document.elementsByTagName(QStringLiteral("appointment")).count());
+
+    delete project;
+}
+
+void XmlStreamSaverTester::snapshot()
+{
+    ProjectGenerator::Parameters p;
+    p.tasks = 30;
+    p.summarySize = 5;
+    p.resources = 4;
+    Project *project = ProjectGenerator(p).generate();
+    ScheduleManager *sm = ProjectGenerator::scheduleManager(project);
+    sm->createSchedules();
+    project->calculate(*sm);
+    QVERIFY(sm->isScheduled());
+
+    XmlSaveContext context(project);
+    context.save();
+    const XmlSnapshot snapshot(project);
+    QVERIFY(!snapshot.isNull());
+
+    // The snapshot does not change with the project
+    project->childNode(0)->setName(QStringLiteral("Changed"));
+    project->childNode(1)->setDescription(QStringLiteral("Changed"));
+    delete project;
+
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+    KoXmlWriter writer(&buffer);
+    XmlStreamSaver saver(writer);
+    saver.save(snapshot);
+    buffer.close();
+
+    QDomDocument document;
+    QString error;
+    QVERIFY2(document.setContent(buffer.data(), &error), error.toUtf8().constData());
+    compare(document.documentElement(), context.document.documentElement());
+    QVERIFY(document.elementsByTagName(QStringLiteral("appointment")).count() > 0);
+}
+
+} //namespace KPlato
+
+QTEST_GUILESS_MAIN(KPlato::XmlStreamSaverTester)
@@ -0,0 +1,25 @@
+/* This file is part of the KDE project
+   SPDX-FileCopyrightText: 2026 agent <agent@local>
+   
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KPlato_XmlStreamSaverTester_h
+#define KPlato_XmlStreamSaverTester_h
+
+#include <QObject>
+
+namespace KPlato
+{
+
+class XmlStreamSaverTester : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void save();
+    void snapshot();
+};
+
+} //namespace KPlato
+
+#endif
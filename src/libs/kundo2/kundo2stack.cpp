@@ -292,6 +292,33 @@ void KUndo2Command::setText(const KUndo2MagicString &undoText)
     d->actionText = undoText.toSecondaryString();
 }
 
+/*!
+    Returns an estimate of the memory in bytes held by this command.
+
+    The undo stack uses the cost to keep the history within
+    KUndo2QStack::undoMemoryLimit(). The cost is requested once, after the
+    command has been executed, so it should include the data the command
+    keeps alive to be able to undo or redo, e.g. deleted objects it owns.
+
+    The default implementation returns the size of the command and its texts
+    plus the cost of its child commands.
+
+    \sa KUndo2QStack::setUndoMemoryLimit()
+*/
+
+qint64 KUndo2Command::memoryCost() const
+{
+    qint64 cost = sizeof(*this) + sizeof(*d);
+    cost += (d->actionText.size() + d->text.toString().size()) * sizeof(QChar);
+    for (const KUndo2Command *cmd : qAsConst(d->child_list)) {
+        cost += cmd->memoryCost();
+    }
+    for (const KUndo2Command *cmd : m_mergeCommandsVector) {
+        cost += cmd->memoryCost();
+    }
+    return cost;
+}
+
 /*!
     \since 4.4
 
@@ -571,7 +598,8 @@ void KUndo2QStack::purgeRedoState()
 }
 
 /*! \internal
-    If the number of commands on the stack exceedes the undo limit, deletes commands from
+    If the number of commands on the stack exceedes the undo limit, or the memory cost
+    of the commands exceedes the undo memory limit, deletes commands from
     the bottom of the stack.
 
     Returns true if commands were deleted.
@@ -579,10 +607,25 @@ void KUndo2QStack::purgeRedoState()
 
 bool KUndo2QStack::checkUndoLimit()
 {
-    if (m_undo_limit <= 0 || !m_macro_stack.isEmpty() || m_undo_limit >= m_command_list.count())
+    if (!m_macro_stack.isEmpty())
         return false;
 
-    int del_count = m_command_list.count() - m_undo_limit;
+    int del_count = 0;
+    if (m_undo_limit > 0 && m_undo_limit < m_command_list.count())
+        del_count = m_command_list.count() - m_undo_limit;
+
+    if (m_undo_memory_limit > 0) {
+        qint64 cost = 0;
+        for (int i = del_count; i < m_command_list.count(); ++i)
+            cost += commandCost(m_command_list.at(i));
+        // only commands below the current index can go, the last executed command is always kept
+        while (cost > m_undo_memory_limit && del_count < m_index) {
+            cost -= commandCost(m_command_list.at(del_count));
+            ++del_count;
+        }
+    }
+    if (del_count == 0)
+        return false;
 
     for (int i = 0; i < del_count; ++i)
         delete m_command_list.takeFirst();
@@ -597,6 +640,17 @@ bool KUndo2QStack::checkUndoLimit()
     return true;
 }
 
+/*! \internal
+    Returns the memory cost of \a cmd, calculated the first time it is needed.
+*/
+
+qint64 KUndo2QStack::commandCost(KUndo2Command *cmd)
+{
+    if (cmd->d->memoryCost < 0)
+        cmd->d->memoryCost = cmd->memoryCost();
+    return cmd->d->memoryCost;
+}
+
 /*!
     Constructs an empty undo stack with the parent \a parent. The
     stack will initially be in the clean state. If \a parent is a
@@ -606,7 +660,7 @@ bool KUndo2QStack::checkUndoLimit()
 */
 
 KUndo2QStack::KUndo2QStack(QObject *parent)
-    : QObject(parent), m_index(0), m_clean_index(0), m_group(nullptr), m_undo_limit(0), m_useCumulativeUndoRedo(false), m_lastMergedSetCount(0), m_lastMergedIndex(0)
+    : QObject(parent), m_index(0), m_clean_index(0), m_group(nullptr), m_undo_limit(0), m_undo_memory_limit(0), m_useCumulativeUndoRedo(false), m_lastMergedSetCount(0), m_lastMergedIndex(0)
 {
     setTimeT1(5);
     setTimeT2(1);
@@ -796,6 +850,7 @@ bool KUndo2QStack::push(KUndo2Command *cmd)
     if (try_merge && cur->mergeWith(cmd)) {
         delete cmd;
         cmd = nullptr;
+        cur->d->memoryCost = -1;
         if (!macro) {
             Q_EMIT indexChanged(m_index);
             Q_EMIT canUndoChanged(canUndo());
@@ -1251,6 +1306,44 @@ int KUndo2QStack::undoLimit() const
     return m_undo_limit;
 }
 
+/*!
+    \property KUndo2QStack::undoMemoryLimit
+    \brief the maximum memory in bytes held by the commands on this stack.
+
+    When a command is pushed and the sum of KUndo2Command::memoryCost() of the commands
+    on the stack exceedes the undoMemoryLimit, commands are deleted from the bottom of
+    the stack until the stack is within the limit. The most recently executed command
+    and the commands that can be redone are never deleted.
+    The limit applies in addition to undoLimit(). The default value is 0, which means
+    that there is no limit.
+
+    The limit is applied the next time a command is pushed.
+*/
+
+void KUndo2QStack::setUndoMemoryLimit(qint64 bytes)
+{
+    m_undo_memory_limit = qMax(qint64(0), bytes);
+}
+
+qint64 KUndo2QStack::undoMemoryLimit() const
+{
+    return m_undo_memory_limit;
+}
+
+/*!
+    Returns the sum of KUndo2Command::memoryCost() of the commands on this stack.
+
+    \sa undoMemoryLimit()
+*/
+
+qint64 KUndo2QStack::memoryCost() const
+{
+    qint64 cost = 0;
+    for (KUndo2Command *cmd : m_command_list)
+        cost += commandCost(cmd);
+    return cost;
+}
+
 /*!
     \property KUndo2QStack::active
     \brief the active status of this stack.
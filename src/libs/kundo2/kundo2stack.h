@@ -92,6 +92,8 @@ public:
     virtual bool mergeWith(const KUndo2Command *other);
     virtual bool timedMergeWith(KUndo2Command *other);
 
+    virtual qint64 memoryCost() const;
+
     int childCount() const;
     const KUndo2Command *child(int index) const;
 
@@ -143,6 +145,7 @@ class KUNDO2_EXPORT KUndo2QStack : public QObject
 //    Q_DECLARE_PRIVATE(KUndo2QStack)
     Q_PROPERTY(bool active READ isActive WRITE setActive NOTIFY activeChanged)
     Q_PROPERTY(int undoLimit READ undoLimit WRITE setUndoLimit NOTIFY undoLimitChanged)
+    Q_PROPERTY(qint64 undoMemoryLimit READ undoMemoryLimit WRITE setUndoMemoryLimit)
 
 public:
     explicit KUndo2QStack(QObject *parent = nullptr);
@@ -176,6 +179,10 @@ public:
     void setUndoLimit(int limit);
     int undoLimit() const;
 
+    void setUndoMemoryLimit(qint64 bytes);
+    qint64 undoMemoryLimit() const;
+    qint64 memoryCost() const;
+
     const KUndo2Command *command(int index) const;
 
     void setUseCumulativeUndoRedo(bool value);
@@ -218,6 +225,7 @@ private:
     int m_clean_index;
     KUndo2Group *m_group;
     int m_undo_limit;
+    qint64 m_undo_memory_limit;
     bool m_useCumulativeUndoRedo;
     double m_timeT1;
     double m_timeT2;
@@ -228,6 +236,7 @@ private:
     // also from QUndoStackPrivate
     void setIndex(int idx, bool clean);
     bool checkUndoLimit();
+    static qint64 commandCost(KUndo2Command *cmd);
 
     Q_DISABLE_COPY(KUndo2QStack)
     friend class KUndo2Group;
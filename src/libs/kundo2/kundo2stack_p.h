@@ -64,11 +64,12 @@ class KUndo2Command;
 class KUndo2CommandPrivate
 {
 public:
-    KUndo2CommandPrivate() : id(-1) {}
+    KUndo2CommandPrivate() : id(-1), memoryCost(-1) {}
     QList<KUndo2Command*> child_list;
     QString actionText;
     KUndo2MagicString text;
     int id;
+    qint64 memoryCost; // cached by KUndo2QStack, -1 if not calculated
 
     QScopedPointer<KUndo2CommandExtraData> extraData;
 };
@@ -58,6 +58,10 @@
 #include <QFileInfo>
 #include <QPainter>
 #include <QTimer>
+#include <QSaveFile>
+#include <QElapsedTimer>
+#include <QFutureWatcher>
+#include <QtConcurrent>
 #ifndef QT_NO_DBUS
 #include <KJobWidgets>
 #include <QDBusConnection>
@@ -160,7 +164,9 @@ public:
         readwrite(true),
         alwaysAllowSaving(false),
         disregardAutosaveFailure(false),
-        progressEnabled(true)
+        progressEnabled(true),
+        lastAutoSaveTime(-1),
+        lastAutoSaveBlockingTime(-1)
     {
         m_job = nullptr;
         m_statJob = nullptr;
@@ -249,6 +255,11 @@ public:
     bool disregardAutosaveFailure;
     bool progressEnabled;
 
+    QFutureWatcher<bool> autoSaveWriter; // writes the autosave snapshot in the background
+    QElapsedTimer autoSaveElapsed;
+    qint64 lastAutoSaveTime; // ms
+    qint64 lastAutoSaveBlockingTime; // ms
+
     bool openFile()
     {
         DocumentProgressProxy *progressProxy = nullptr;
@@ -437,6 +448,7 @@ KoDocument::KoDocument(KoPart *parent, KUndo2Stack *undoStack)
     d->filterManager = new KoFilterManager(this, d->progressUpdater);
 
     connect(&d->autoSaveTimer, &QTimer::timeout, this, &KoDocument::slotAutoSave);
+    connect(&d->autoSaveWriter, &QFutureWatcher<bool>::finished, this, &KoDocument::slotAutoSaveWritten);
     setAutoSave(defaultAutoSave());
 
     setObjectName(newObjectName());
@@ -454,6 +466,8 @@ KoDocument::KoDocument(KoPart *parent, KUndo2Stack *undoStack)
 
     KConfigGroup cfgGrp(d->parentPart->componentData().config(), "Undo");
     d->undoStack->setUndoLimit(cfgGrp.readEntry("UndoLimit", 1000));
+    // in MB, 0 means no limit
+    d->undoStack->setUndoMemoryLimit(cfgGrp.readEntry("UndoMemoryLimit", 256) * qint64(1024 * 1024));
 
     connect(d->undoStack, &KUndo2QStack::indexChanged, this, &KoDocument::slotUndoStackIndexChanged);
 
@@ -463,6 +477,8 @@ KoDocument::~KoDocument()
 {
     d->autoSaveTimer.disconnect(this);
     d->autoSaveTimer.stop();
+    d->autoSaveWriter.disconnect(this);
+    d->autoSaveWriter.waitForFinished();
     d->parentPart->deleteLater();
 
     delete d->filterManager;
@@ -713,6 +729,44 @@ bool KoDocument::isAutoErrorHandlingEnabled() const
     return d->autoErrorHandlingEnabled;
 }
 
+// Runs in a worker thread
+static bool writeAutoSaveFile(const QString &fileName, const QByteArray &data)
+{
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    if (file.write(data) != data.size()) {
+        file.cancelWriting();
+        return false;
+    }
+    return file.commit();
+}
+
+// Runs in a worker thread, saves the same as saveNativeFormatCalligra() except the preview
+static bool writeAutoSave(const QString &fileName, const QByteArray &mimeType, const QDomDocument &documentInfo, const std::function<bool(KoStore*)> &saveCopy)
+{
+    QByteArray data;
+    QBuffer buffer(&data);
+    KoStore *store = KoStore::createStore(&buffer, KoStore::Write, mimeType, KoStore::Zip);
+    if (store->bad()) {
+        delete store;
+        return false;
+    }
+    // Compressing takes most of the time, the file is only used for recovery
+    store->setCompressionEnabled(false);
+    bool ok = saveCopy(store);
+    if (ok && store->open("documentinfo.xml")) {
+        KoStoreDevice dev(store);
+        const QByteArray s = documentInfo.toByteArray(); // this is already Utf8!
+        (void)dev.write(s.data(), s.size());
+        (void)store->close();
+    }
+    ok = ok && store->finalize();
+    delete store;
+    return ok && writeAutoSaveFile(fileName, data);
+}
+
 void KoDocument::slotAutoSave()
 {
     if (d->modified && d->modifiedAfterAutosave && !d->isLoading) {
@@ -720,24 +774,56 @@ void KoDocument::slotAutoSave()
         if (d->specialOutputFlag == SaveEncrypted && d->password.isNull()) {
             // That advice should also fix this error from occurring again
             Q_EMIT statusBarMessage(i18n("The password of this encrypted document is not known. Autosave aborted! Please save your work manually."));
+        } else if (d->autoSaveWriter.isRunning()) {
+            debugMain << "Previous autosave is still being written";
         } else {
-            connect(this, &KoDocument::sigProgress, d->parentPart->currentMainwindow(), &KoMainWindow::slotProgress);
-            Q_EMIT statusBarMessage(i18n("Autosaving..."));
             d->autosaving = true;
-            bool ret = saveNativeFormat(autoSaveFile(localFilePath()));
-            setModified(true);
-            if (ret) {
-                d->modifiedAfterAutosave = false;
-                d->autoSaveTimer.stop(); // until the next change
+            d->autoSaveElapsed.start();
+            // Only a copy of the document is taken in the gui thread,
+            // it is serialized, packed and written to file in the background
+            std::function<bool(KoStore*)> saveCopy;
+            if (d->specialOutputFlag == 0 && !isOasisMimeType(d->outputMimeType)) {
+                saveCopy = createSaveCopy();
             }
             d->autosaving = false;
-            Q_EMIT clearStatusBarMessage();
-            disconnect(this, &KoDocument::sigProgress, d->parentPart->currentMainwindow(), &KoMainWindow::slotProgress);
-            if (!ret && !d->disregardAutosaveFailure) {
-                Q_EMIT statusBarMessage(i18n("Error during autosave! Partition full?"));
+            if (!saveCopy) {
+                warnMain << "Autosave is not supported for this document";
+                d->autoSaveTimer.stop();
+                Q_EMIT autoSaveFinished(false);
+                return;
             }
+            Q_EMIT statusBarMessage(i18n("Autosaving..."));
+            QDomDocument documentInfo = KoDocument::createDomDocument("document-info"
+                           /*DTD name*/, QStringLiteral("document-info") /*tag name*/, QStringLiteral("1.1"));
+            documentInfo = d->docInfo->save(documentInfo);
+            d->modifiedAfterAutosave = false;
+            d->autoSaveTimer.stop(); // until the next change
+            d->lastAutoSaveBlockingTime = d->autoSaveElapsed.elapsed();
+            d->autoSaveWriter.setFuture(QtConcurrent::run(writeAutoSave, autoSaveFile(localFilePath()), d->outputMimeType, documentInfo, saveCopy));
+        }
+    }
+}
+
+void KoDocument::slotAutoSaveWritten()
+{
+    const bool ret = d->autoSaveWriter.result();
+    d->lastAutoSaveTime = d->autoSaveElapsed.elapsed();
+    debugMain << "Autosave written:" << ret << d->lastAutoSaveTime << "ms, GUI blocked:" << d->lastAutoSaveBlockingTime << "ms";
+    Q_EMIT clearStatusBarMessage();
+    if (!ret) {
+        // try again at next timeout
+        d->modifiedAfterAutosave = true;
+        setAutoSave(d->autoSaveDelay);
+        if (!d->disregardAutosaveFailure) {
+            Q_EMIT statusBarMessage(i18n("Error during autosave! Partition full?"));
         }
     }
+    Q_EMIT autoSaveFinished(ret);
+}
+
+std::function<bool(KoStore*)> KoDocument::createSaveCopy()
+{
+    return std::function<bool(KoStore*)>();
 }
 
 void KoDocument::setReadWrite(bool readwrite)
@@ -819,8 +905,7 @@ bool KoDocument::saveNativeFormat(const QString & file)
     // OLD: QCString mimeType = oasis ? nativeOasisMimeType() : nativeFormatMimeType();
     QByteArray mimeType = d->outputMimeType;
     debugMain << "KoDocument::savingTo mimeType=" << mimeType;
-    QByteArray nativeOasisMime = nativeOasisMimeType();
-    bool oasis = !mimeType.isEmpty() && (mimeType == nativeOasisMime || mimeType == nativeOasisMime + "-template" || mimeType.startsWith("application/vnd.oasis.opendocument"));
+    bool oasis = isOasisMimeType(mimeType);
 
     // TODO: use std::auto_ptr or create store on stack [needs API fixing],
     // to remove all the 'delete store' in all the branches
@@ -839,6 +924,12 @@ bool KoDocument::saveNativeFormat(const QString & file)
     }
 }
 
+bool KoDocument::isOasisMimeType(const QByteArray &mimeType) const
+{
+    QByteArray nativeOasisMime = nativeOasisMimeType();
+    return !mimeType.isEmpty() && (mimeType == nativeOasisMime || mimeType == nativeOasisMime + "-template" || mimeType.startsWith("application/vnd.oasis.opendocument"));
+}
+
 bool KoDocument::saveNativeFormatODF(KoStore *store, const QByteArray &mimeType)
 {
     debugMain << "Saving to OASIS format";
@@ -953,7 +1044,7 @@ bool KoDocument::saveNativeFormatCalligra(KoStore *store)
     debugMain << "Saving root";
     if (store->open("root")) {
         KoStoreDevice dev(store);
-        if (!saveToStream(&dev) || !store->close()) {
+        if (!saveToStream(&dev, store) || !store->close()) {
             debugMain << "saveToStream failed";
             delete store;
             return false;
@@ -995,12 +1086,16 @@ bool KoDocument::saveNativeFormatCalligra(KoStore *store)
     return true;
 }
 
-bool KoDocument::saveToStream(QIODevice *dev)
+bool KoDocument::saveToStream(QIODevice *dev, KoStore *store)
 {
+    dev->open(QIODevice::WriteOnly);
+    KoXmlWriter writer(dev);
+    if (saveToXmlWriter(writer, store)) {
+        return true;
+    }
     QDomDocument doc = saveXML();
     // Save to buffer
     QByteArray s = doc.toByteArray(); // utf8 already
-    dev->open(QIODevice::WriteOnly);
     int nwritten = dev->write(s.data(), s.size());
     if (nwritten != (int)s.size())
         warnMain << "wrote " << nwritten << "- expected" <<  s.size();
@@ -1053,7 +1148,7 @@ bool KoDocument::saveToStore(KoStore *_store, const QString & _path)
     if (_store->open("root")) {
         debugMain << this << _store->currentPath();
         KoStoreDevice dev(_store);
-        if (!saveToStream(&dev)) {
+        if (!saveToStream(&dev, _store)) {
             _store->close();
             return false;
         }
@@ -1625,6 +1720,15 @@ bool KoDocument::oldLoadAndParse(KoStore *store, const QString& filename, KoXmlD
     return true;
 }
 
+bool KoDocument::loadMainDocument(KoStore *store)
+{
+    KoXmlDocument doc = KoXmlDocument(true);
+    bool ok = oldLoadAndParse(store, "root", doc);
+    if (ok)
+        ok = loadXML(doc, store);
+    return ok;
+}
+
 bool KoDocument::loadNativeFormat(const QString & file_)
 {
     QString file = file_;
@@ -1791,10 +1895,7 @@ bool KoDocument::loadNativeFormatFromStoreInternal(KoStore *store)
     } else if (store->hasFile("root") || store->hasFile("maindoc.xml")) {   // Fallback to "old" file format (maindoc.xml)
         if (!property("SKIPLOADMAINDOC").toBool()) {
             oasis = false;
-            KoXmlDocument doc = KoXmlDocument(true);
-            bool ok = oldLoadAndParse(store, "root", doc);
-            if (ok)
-                ok = loadXML(doc, store);
+            const bool ok = loadMainDocument(store);
             if (!ok) {
                 QApplication::restoreOverrideCursor();
                 return false;
@@ -2129,6 +2230,13 @@ QDomDocument KoDocument::saveXML()
     return QDomDocument();
 }
 
+bool KoDocument::saveToXmlWriter(KoXmlWriter &writer, KoStore *store)
+{
+    Q_UNUSED(writer);
+    Q_UNUSED(store);
+    return false; // use saveXML()
+}
+
 bool KoDocument::isNativeFormat(const QByteArray& mimetype) const
 {
     if (mimetype == nativeFormatMimeType())
@@ -2177,6 +2285,16 @@ bool KoDocument::isAutosaving() const
     return d->autosaving;
 }
 
+qint64 KoDocument::lastAutoSaveTime() const
+{
+    return d->lastAutoSaveTime;
+}
+
+qint64 KoDocument::lastAutoSaveBlockingTime() const
+{
+    return d->lastAutoSaveBlockingTime;
+}
+
 bool KoDocument::isLoading() const
 {
     return d->isLoading;
@@ -2184,6 +2302,8 @@ bool KoDocument::isLoading() const
 
 void KoDocument::removeAutoSaveFiles()
 {
+    // Do not let a pending autosave recreate the file
+    d->autoSaveWriter.waitForFinished();
     // Eliminate any auto-save file
     QString asf = autoSaveFile(localFilePath());   // the one in the current dir
     if (QFile::exists(asf))
@@ -13,6 +13,8 @@
 #include <QDateTime>
 #include <QList>
 
+#include <functional>
+
 #include "komain_export.h"
 #include <KoXmlReaderForward.h>
 #include <KoDocumentBase.h>
@@ -305,6 +307,13 @@ public:
      */
     virtual bool loadXML(const KoXmlDocument & doc, KoStore *store) = 0;
 
+    /**
+     *  Loads the main document (maindoc.xml) from @p store.
+     *  The default implementation parses the document and calls loadXML().
+     *  Reimplement this to read large documents directly from the store.
+     */
+    virtual bool loadMainDocument(KoStore *store);
+
 
     /**
      *  Reimplement this to save the contents of the %Calligra document into
@@ -312,6 +321,17 @@ public:
      */
     virtual QDomDocument saveXML();
 
+    /**
+     *  Reimplement this to write the contents of the %Calligra document
+     *  directly to @p writer, without building a QDomDocument first.
+     *  The writer is positioned before the start of the document.
+     *  @p store is the store the document is saved to, completeSaving() is called with it
+     *  when the document has been written. It is nullptr when saving to a flat xml file.
+     *  Return false, without writing anything, if not supported; then saveXML() is used.
+     *  The default implementation returns false.
+     */
+    virtual bool saveToXmlWriter(KoXmlWriter &writer, KoStore *store);
+
     /**
      *  Return a correctly created QDomDocument for this KoDocument,
      *  including processing instruction, complete DOCTYPE tag (with systemId and publicId), and root element.
@@ -375,6 +395,17 @@ public:
      */
     bool isAutosaving() const override;
 
+    /**
+     * Return the time in milliseconds the last autosave took,
+     * including writing the file in the background, or -1 if there has been no autosave.
+     */
+    qint64 lastAutoSaveTime() const;
+    /**
+     * Return the time in milliseconds the last autosave blocked the GUI,
+     * or -1 if there has been no autosave.
+     */
+    qint64 lastAutoSaveBlockingTime() const;
+
     /**
      * Set whether the next openUrl call should check for an auto-saved file
      * and offer to open it. This is usually true, but can be turned off
@@ -656,6 +687,12 @@ Q_SIGNALS:
 
     void backupFileChanged(bool);
 
+    /**
+     * Emitted when an autosave has been written, @p success is false if it failed.
+     * The file is normally written in the background, after slotAutoSave() has returned.
+     */
+    void autoSaveFinished(bool success);
+
 protected:
 
     friend class KoPart;
@@ -714,6 +751,17 @@ protected:
      */
     virtual bool completeSaving(KoStore *store);
 
+    /**
+     *  Reimplement this to take a copy of the document that can be saved in another thread.
+     *  Autosave calls this in the gui thread and calls the returned function in a worker thread
+     *  with the store the copy shall be saved to. The function writes the root entry and the
+     *  other entries needed to load the document, and it must not use the document.
+     *  The document info is added by autosave.
+     *  Return an empty function if the document can not be copied, it is then not autosaved.
+     *  The default implementation returns an empty function.
+     */
+    virtual std::function<bool(KoStore *store)> createSaveCopy();
+
 
     /** @internal */
     virtual void setModified();
@@ -765,6 +813,7 @@ Q_SIGNALS:
 private Q_SLOTS:
 
     void slotAutoSave();
+    void slotAutoSaveWritten();
 
     /// Called by the undo stack when undo or redo is called
     void slotUndoStackIndexChanged(int idx);
@@ -774,7 +823,8 @@ protected:
     bool oldLoadAndParse(KoStore *store, const char *filename, KoXmlDocument& doc);
 
 private:
-    bool saveToStream(QIODevice *dev);
+    bool saveToStream(QIODevice *dev, KoStore *store = nullptr);
+    bool isOasisMimeType(const QByteArray &mimeType) const;
 
     QString checkImageMimeTypes(const QString &mimeType, const QUrl &url) const;
 
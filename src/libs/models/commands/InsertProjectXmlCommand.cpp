@@ -77,6 +77,7 @@ InsertProjectXmlCommand::InsertProjectXmlCommand(Project *project, const QByteAr
     m_context.setProject(project);
     m_context.setProjectTimeZone(project->timeZone()); // from xml doc?
     m_context.setLoadTaskChildren(false);
+    setBatchProject(project);
 }
 
 InsertProjectXmlCommand::~InsertProjectXmlCommand()
@@ -87,6 +88,7 @@ void InsertProjectXmlCommand::execute()
 {
     if (m_first) {
         // create and execute commands
+        m_project->beginChanges();
         KoXmlDocument doc;
         QString err;
         int line = 0;
@@ -105,6 +107,7 @@ void InsertProjectXmlCommand::execute()
         createCmdRequests(projectElement);
         m_first = false;
         m_data.clear();
+        m_project->endChanges();
     } else {
         MacroCommand::execute();
     }
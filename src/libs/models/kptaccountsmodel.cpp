@@ -18,6 +18,7 @@
 #include "kptaccount.h"
 #include "kptdatetime.h"
 #include "kptschedule.h"
+#include "AppointmentStore.h"
 #include "kptdebug.h"
 
 #include <KoIcon.h>
@@ -490,6 +491,7 @@ void CostBreakdownItemModel::slotAccountInserted(const Account *account)
 {
     Q_UNUSED(account);
     //debugPlan<<account->name();
+    clearCache();
     endInsertRows();
 }
 
@@ -505,11 +507,13 @@ void CostBreakdownItemModel::slotAccountRemoved(const Account *account)
 {
     Q_UNUSED(account);
     //debugPlan<<account->name();
+    clearCache();
     endRemoveRows();
 }
 
 void CostBreakdownItemModel::slotDataChanged()
 {
+    clearCache();
     fetchData();
     QMap<Account*, EffortCostMap>::const_iterator it;
     for (it = m_plannedCostMap.constBegin(); it != m_plannedCostMap.constEnd(); ++it) {
@@ -542,6 +546,7 @@ void CostBreakdownItemModel::setProject(Project *project)
         disconnect(m_project, &Project::resourceRemoved, this, &CostBreakdownItemModel::slotDataChanged);
     }
     m_project = project;
+    clearCache();
     if (project) {
         Accounts *acc = &(project->accounts());
         debugPlan<<acc;
@@ -580,54 +585,59 @@ long CostBreakdownItemModel::id() const
     return m_manager == nullptr ? -1 : m_manager->scheduleId();
 }
 
-EffortCostMap CostBreakdownItemModel::fetchPlannedCost(Account *account)
+void CostBreakdownItemModel::clearCache()
 {
-    EffortCostMap ec;
-    ec = account->plannedCost(id());
-    m_plannedCostMap.insert(account, ec);
-    QDate s = ec.startDate();
-    if (! m_plannedStart.isValid() || s < m_plannedStart) {
-        m_plannedStart = s;
-    }
-    QDate e = ec.endDate();
-    if (! m_plannedEnd.isValid() || e > m_plannedEnd) {
-        m_plannedEnd = e;
-    }
-    return ec;
+    m_plannedCostCache.clear();
+    m_actualCostCache.clear();
+    m_cacheRevisions.clear();
 }
 
-EffortCostMap CostBreakdownItemModel::fetchActualCost(Account *account)
+static void updateDateRange(const QMap<Account*, EffortCostMap> &costs, QDate &start, QDate &end)
 {
-    debugPlan<<account->name();
-    EffortCostMap ec;
-    ec = account->actualCost(id());
-    m_actualCostMap.insert(account, ec);
-    QDate s = ec.startDate();
-    if (! m_actualStart.isValid() || s < m_actualStart) {
-        m_actualStart = s;
+    for (const EffortCostMap &ec : costs) {
+        const QDate s = ec.startDate();
+        if (s.isValid() && (! start.isValid() || s < start)) {
+            start = s;
+        }
+        const QDate e = ec.endDate();
+        if (e.isValid() && (! end.isValid() || e > end)) {
+            end = e;
+        }
     }
-    QDate e = ec.endDate();
-    if (! m_actualEnd.isValid() || e > m_actualEnd) {
-        m_actualEnd = e;
+}
+
+static QMap<Account*, EffortCostMap> toMap(const QHash<const Account*, EffortCostMap> &costs)
+{
+    QMap<Account*, EffortCostMap> map;
+    for (QHash<const Account*, EffortCostMap>::const_iterator it = costs.constBegin(); it != costs.constEnd(); ++it) {
+        map.insert(const_cast<Account*>(it.key()), it.value());
     }
-    debugPlan<<account->name()<<ec.totalEffort().toDouble(Duration::Unit_h)<<ec.totalCost();
-    return ec;
+    return map;
 }
 
 void CostBreakdownItemModel::fetchData()
 {
     //debugPlan<<m_start<<m_end;
     m_plannedCostMap.clear();
+    m_actualCostMap.clear();
     m_plannedStart = m_plannedEnd = QDate();
     m_actualStart = m_actualEnd = QDate();
     if (m_project == nullptr || m_manager == nullptr) {
         return;
     }
-    const QList<Account*> accounts = m_project->accounts().allAccounts();
-    for (Account *a : accounts) {
-        fetchPlannedCost(a);
-        fetchActualCost(a);
+    const long sid = id();
+    const int revision = m_manager->expected() ? m_manager->expected()->appointmentRevision() : 0;
+    // Recalculate if the appointments of this schedule has changed, e.g. it has been rescheduled
+    if (! m_plannedCostCache.contains(sid) || m_cacheRevisions.value(sid) != revision) {
+        const Accounts &accounts = m_project->accounts();
+        m_plannedCostCache.insert(sid, toMap(accounts.plannedCosts(QDate(), QDate(), sid)));
+        m_actualCostCache.insert(sid, toMap(accounts.actualCosts(QDate(), QDate(), sid)));
+        m_cacheRevisions.insert(sid, revision);
     }
+    m_plannedCostMap = m_plannedCostCache.value(sid);
+    m_actualCostMap = m_actualCostCache.value(sid);
+    updateDateRange(m_plannedCostMap, m_plannedStart, m_plannedEnd);
+    updateDateRange(m_actualCostMap, m_actualStart, m_actualEnd);
 }
 
 Qt::ItemFlags CostBreakdownItemModel::flags(const QModelIndex &index) const
@@ -1172,6 +1182,7 @@ Account *CostBreakdownItemModel::account(const QModelIndex &index) const
 void CostBreakdownItemModel::slotAccountChanged(Account *account)
 {
     Q_UNUSED(account);
+    clearCache();
     fetchData();
     QMap<Account*, EffortCostMap>::const_iterator it;
     for (it = m_plannedCostMap.constBegin(); it != m_plannedCostMap.constEnd(); ++it) {
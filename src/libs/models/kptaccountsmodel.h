@@ -13,6 +13,8 @@
 #include <kptitemmodelbase.h>
 #include "kpteffortcostmap.h"
 
+#include <QHash>
+
 namespace KPlato
 {
 
@@ -157,8 +159,8 @@ public:
     
 protected:
     void fetchData();
-    EffortCostMap fetchPlannedCost(Account *account);
-    EffortCostMap fetchActualCost(Account *account);
+    /// Forget the costs calculated for all schedules
+    void clearCache();
     
     QVariant cost(const Account *a, int offset, int role) const;
 
@@ -186,6 +188,11 @@ private:
     QMap<Account*, EffortCostMap> m_actualCostMap;
     QDate m_actualStart, m_actualEnd;
     QString m_format;
+    // Costs per schedule id, the daily costs serve all period types
+    QHash<long, QMap<Account*, EffortCostMap>> m_plannedCostCache;
+    QHash<long, QMap<Account*, EffortCostMap>> m_actualCostCache;
+    // The appointment revision of the schedule when its costs were cached
+    QHash<long, int> m_cacheRevisions;
     
 };
 
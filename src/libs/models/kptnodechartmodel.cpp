@@ -314,7 +314,9 @@ void ChartItemModel::setProject(Project *project)
         disconnect(m_project, &Project::nodeChanged, this, &ChartItemModel::slotNodeChanged);
         disconnect(m_project, &Project::resourceRemoved, this, &ChartItemModel::slotResourceRemoved);
         disconnect(m_project, &Project::resourceChanged, this, &ChartItemModel::slotResourceChanged);
+        disconnect(m_project, &Project::changesFinished, this, &ChartItemModel::slotChangesFinished);
     }
+    m_calculatePending = false;
     m_project = project;
     if (m_project) {
         connect(m_project, &Project::aboutToBeDeleted, this, &ChartItemModel::projectDeleted);
@@ -323,6 +325,7 @@ void ChartItemModel::setProject(Project *project)
         connect(m_project, &Project::nodeChanged, this, &ChartItemModel::slotNodeChanged);
         connect(m_project, &Project::resourceRemoved, this, &ChartItemModel::slotResourceRemoved);
         connect(m_project, &Project::resourceChanged, this, &ChartItemModel::slotResourceChanged);
+        connect(m_project, &Project::changesFinished, this, &ChartItemModel::slotChangesFinished);
     }
     endResetModel();
 }
@@ -368,10 +371,8 @@ void ChartItemModel::clearNodes()
 void ChartItemModel::slotNodeRemoved(Node *node)
 {
     if (m_nodes.contains(node)) {
-        beginResetModel();
         m_nodes.removeAt(m_nodes.indexOf(node));
-        calculate();
-        endResetModel();
+        recalculate();
     }
 }
 
@@ -379,16 +380,12 @@ void ChartItemModel::slotNodeChanged(Node *node)
 {
     //debugPlan<<this<<node;
     if (m_nodes.contains(node)) {
-        beginResetModel();
-        calculate();
-        endResetModel();
+        recalculate();
         return;
     }
     for (Node *n : qAsConst(m_nodes)) {
         if (node->isChildOf(n)) {
-            beginResetModel();
-            calculate();
-            endResetModel();
+            recalculate();
             return;
         }
     }
@@ -396,18 +393,33 @@ void ChartItemModel::slotNodeChanged(Node *node)
 
 void ChartItemModel::slotResourceChanged()
 {
-    beginResetModel();
-    calculate();
-    endResetModel();
+    recalculate();
 }
 
 void ChartItemModel::slotResourceRemoved()
 {
+    recalculate();
+}
+
+void ChartItemModel::recalculate()
+{
+    if (m_project && m_project->isChanging()) {
+        m_calculatePending = true;
+        return;
+    }
     beginResetModel();
     calculate();
     endResetModel();
 }
 
+void ChartItemModel::slotChangesFinished()
+{
+    if (m_calculatePending) {
+        m_calculatePending = false;
+        recalculate();
+    }
+}
+
 QDate ChartItemModel::startDate() const
 {
     QDate d = m_bcws.startDate();
@@ -128,8 +128,13 @@ public Q_SLOTS:
     void slotResourceRemoved();
 
     void slotSetScheduleManager(KPlato::ScheduleManager *sm);
+    /// Recalculate if it was postponed during a batch of changes
+    void slotChangesFinished();
 
 protected:
+    /// Calculate and reset the model, or postpone it if the project is in a batch of changes
+    void recalculate();
+
     double bcwsEffort(int day) const;
     double bcwpEffort(int day) const;
     double acwpEffort(int day) const;
@@ -146,6 +151,7 @@ protected:
     EffortCostMap m_bcws;
     EffortCostMap m_acwp;
     bool m_localizeValues;
+    bool m_calculatePending = false;
 };
 
 class PLANMODELS_EXPORT PerformanceDataCurrentDateModel : public QAbstractProxyModel
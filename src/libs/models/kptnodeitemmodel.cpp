@@ -3201,6 +3201,7 @@ NodeItemModel::~NodeItemModel()
 void NodeItemModel::setShowProject(bool on)
 {
     beginResetModel();
+    clearCache();
     m_projectshown = on;
     endResetModel();
     Q_EMIT projectShownChanged(on);
@@ -3209,6 +3210,9 @@ void NodeItemModel::setShowProject(bool on)
 void NodeItemModel::slotNodeToBeInserted(Node *parent, int row)
 {
     //debugPlan<<parent->name()<<"; "<<row;
+    if (postponeUpdate()) {
+        return;
+    }
     Q_ASSERT(m_node == nullptr);
     m_node = parent;
     beginInsertRows(index(parent), row, row);
@@ -3217,7 +3221,12 @@ void NodeItemModel::slotNodeToBeInserted(Node *parent, int row)
 void NodeItemModel::slotNodeInserted(Node *node)
 {
     //debugPlan<<node->parentNode()->name()<<"-->"<<node->name();
+    if (m_resetPending) {
+        return;
+    }
     Q_ASSERT(node->parentNode() == m_node);
+    // wbs codes and summary task values may have changed
+    clearCache();
     endInsertRows();
     m_node = nullptr;
     Q_EMIT nodeInserted(node);
@@ -3226,6 +3235,9 @@ void NodeItemModel::slotNodeInserted(Node *node)
 void NodeItemModel::slotNodeToBeRemoved(Node *node)
 {
     //debugPlan<<node->name();
+    if (postponeUpdate()) {
+        return;
+    }
     Q_ASSERT(m_node == nullptr);
     m_node = node;
     int row = index(node).row();
@@ -3235,10 +3247,14 @@ void NodeItemModel::slotNodeToBeRemoved(Node *node)
 void NodeItemModel::slotNodeRemoved(Node *node)
 {
     //debugPlan<<node->name();
+    if (m_resetPending) {
+        return;
+    }
     Q_ASSERT(node == m_node);
 #ifdef NDEBUG
     Q_UNUSED(node)
 #endif
+    clearCache();
     endRemoveRows();
     m_node = nullptr;
 }
@@ -3246,6 +3262,9 @@ void NodeItemModel::slotNodeRemoved(Node *node)
 void NodeItemModel::slotNodeToBeMoved(Node *node, int pos, Node *newParent, int newPos)
 {
     //debugPlan<<node->parentNode()->name()<<pos<<":"<<newParent->name()<<newPos;
+    if (postponeUpdate()) {
+        return;
+    }
     beginMoveRows(index(node->parentNode()), pos, pos, index(newParent), newPos);
 }
 
@@ -3253,16 +3272,58 @@ void NodeItemModel::slotNodeMoved(Node *node)
 {
     Q_UNUSED(node);
     //debugPlan<<node->parentNode()->name()<<node->parentNode()->indexOf(node);
+    if (m_resetPending) {
+        return;
+    }
+    clearCache();
     endMoveRows();
 }
 
 void NodeItemModel::slotLayoutChanged()
 {
     //debugPlan<<node->name();
+    if (m_resetPending) {
+        return;
+    }
     Q_EMIT layoutAboutToBeChanged();
+    clearCache();
     Q_EMIT layoutChanged();
 }
 
+void NodeItemModel::clearCache()
+{
+    m_cache.clear();
+}
+
+bool NodeItemModel::postponeUpdate()
+{
+    if (m_resetPending) {
+        return true;
+    }
+    if (m_project && m_project->isChanging()) {
+        beginResetModel();
+        m_resetPending = true;
+        return true;
+    }
+    return false;
+}
+
+void NodeItemModel::slotChangesFinished()
+{
+    if (m_resetPending) {
+        m_resetPending = false;
+        clearCache();
+        endResetModel();
+    }
+}
+
+void NodeItemModel::invalidateCache(const Node *node)
+{
+    for (const Node *n = node; n; n = n->parentNode()) {
+        m_cache.remove(n);
+    }
+}
+
 void NodeItemModel::slotProjectCalculated(ScheduleManager *sm)
 {
     debugPlan<<m_manager<<sm;
@@ -3274,24 +3335,36 @@ void NodeItemModel::slotProjectCalculated(ScheduleManager *sm)
 void NodeItemModel::slotWbsDefinitionChanged()
 {
     debugPlan;
-    if (m_project == nullptr) {
+    if (m_project == nullptr || m_resetPending) {
         return;
     }
+    clearCache();
     if (m_projectshown) {
         QModelIndex idx = createIndex(0, NodeModel::NodeWBSCode, m_project);
         Q_EMIT dataChanged(idx, idx);
     }
-    const QList<Node*> nodes = m_project->allNodes();
-    for (Node *n : nodes) {
-        int row = n->parentNode()->indexOf(n);
-        QModelIndex idx = createIndex(row, NodeModel::NodeWBSCode, n);
-        Q_EMIT dataChanged(idx, idx);
+    // one signal for all the children of a node
+    QList<const Node*> parents;
+    parents << m_project;
+    while (!parents.isEmpty()) {
+        const Node *p = parents.takeLast();
+        const QList<Node*> &children = p->childNodeIterator();
+        if (children.isEmpty()) {
+            continue;
+        }
+        const QModelIndex first = createIndex(0, NodeModel::NodeWBSCode, children.first());
+        const QModelIndex last = createIndex(children.count() - 1, NodeModel::NodeWBSCode, children.last());
+        Q_EMIT dataChanged(first, last);
+        for (const Node *n : children) {
+            parents << n;
+        }
     }
 }
 
 
 void NodeItemModel::setProject(Project *project)
 {
+    slotChangesFinished();
     beginResetModel();
     if (m_project) {
         disconnect(m_project, &Project::aboutToBeDeleted, this, &NodeItemModel::projectDeleted);
@@ -3307,7 +3380,17 @@ void NodeItemModel::setProject(Project *project)
         disconnect(m_project, &Project::nodeAdded, this, &NodeItemModel::slotNodeInserted);
         disconnect(m_project, &Project::nodeRemoved, this, &NodeItemModel::slotNodeRemoved);
         disconnect(m_project, &Project::projectCalculated, this, &NodeItemModel::slotProjectCalculated);
+
+        disconnect(m_project, &Project::resourceChanged, this, &NodeItemModel::clearCache);
+        disconnect(m_project, &Project::resourceGroupChanged, this, &NodeItemModel::clearCache);
+        disconnect(m_project, &Project::calendarChanged, this, &NodeItemModel::clearCache);
+        disconnect(m_project, &Project::standardWorktimeChanged, this, &NodeItemModel::clearCache);
+        disconnect(m_project, &Project::scheduleChanged, this, &NodeItemModel::clearCache);
+        disconnect(m_project, &Project::currentScheduleChanged, this, &NodeItemModel::clearCache);
+        disconnect(&m_project->accounts(), &Accounts::changed, this, &NodeItemModel::clearCache);
+        disconnect(m_project, &Project::changesFinished, this, &NodeItemModel::slotChangesFinished);
     }
+    clearCache();
     m_project = project;
     //debugPlan<<this<<m_project<<"->"<<project;
     m_nodemodel.setProject(project);
@@ -3325,6 +3408,16 @@ void NodeItemModel::setProject(Project *project)
         connect(m_project, &Project::nodeAdded, this, &NodeItemModel::slotNodeInserted);
         connect(m_project, &Project::nodeRemoved, this, &NodeItemModel::slotNodeRemoved);
         connect(m_project, &Project::projectCalculated, this, &NodeItemModel::slotProjectCalculated);
+
+        // names and values from other parts of the project shown by nodes
+        connect(m_project, &Project::resourceChanged, this, &NodeItemModel::clearCache);
+        connect(m_project, &Project::resourceGroupChanged, this, &NodeItemModel::clearCache);
+        connect(m_project, &Project::calendarChanged, this, &NodeItemModel::clearCache);
+        connect(m_project, &Project::standardWorktimeChanged, this, &NodeItemModel::clearCache);
+        connect(m_project, &Project::scheduleChanged, this, &NodeItemModel::clearCache);
+        connect(m_project, &Project::currentScheduleChanged, this, &NodeItemModel::clearCache);
+        connect(&m_project->accounts(), &Accounts::changed, this, &NodeItemModel::clearCache);
+        connect(m_project, &Project::changesFinished, this, &NodeItemModel::slotChangesFinished);
     }
     endResetModel();
 }
@@ -3335,6 +3428,7 @@ void NodeItemModel::setScheduleManager(ScheduleManager *sm)
         return;
     }
     beginResetModel();
+    clearCache();
     if (m_nodemodel.manager()) {
     }
     m_nodemodel.setManager(sm);
@@ -3714,7 +3808,27 @@ QVariant NodeItemModel::data(const QModelIndex &index, int role) const
     }
     QVariant result;
     if (n != nullptr) {
-        result = m_nodemodel.data(n, index.column(), role);
+        switch (role) {
+            case Qt::DisplayRole:
+            case Qt::EditRole:
+            case Qt::ToolTipRole:
+            case NodeModel::SortableRole: {
+                // sorting and filtering large projects ask for the same data many times
+                QHash<QPair<int, int>, QVariant> &values = m_cache[n];
+                const QPair<int, int> key(index.column(), role);
+                const auto it = values.constFind(key);
+                if (it != values.constEnd()) {
+                    result = it.value();
+                } else {
+                    result = m_nodemodel.data(n, index.column(), role);
+                    values.insert(key, result);
+                }
+                break;
+            }
+            default:
+                result = m_nodemodel.data(n, index.column(), role);
+                break;
+        }
         //debugPlan<<n->name()<<": "<<index.column()<<", "<<role<<result;
     }
     if (role == Qt::EditRole) {
@@ -4317,7 +4431,16 @@ Node *NodeItemModel::node(const QModelIndex &index) const
 void NodeItemModel::slotNodeChanged(Node *node, int property)
 {
     Q_UNUSED(property)
-    if (node == nullptr || (! m_projectshown && node->type() == Node::Type_Project)) {
+    if (node == nullptr || m_resetPending) {
+        return;
+    }
+    if (node->type() == Node::Type_Project) {
+        // e.g. the timezone changes all nodes
+        clearCache();
+    } else {
+        invalidateCache(node);
+    }
+    if (! m_projectshown && node->type() == Node::Type_Project) {
         return;
     }
     if (node->type() == Node::Type_Project) {
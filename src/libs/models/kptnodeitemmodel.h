@@ -14,6 +14,7 @@
 #include "kptworkpackagemodel.h"
 
 #include <QDate>
+#include <QHash>
 #include <QMetaEnum>
 #include <QSortFilterProxyModel>
 #include <QUrl>
@@ -347,7 +348,21 @@ protected Q_SLOTS:
     void slotLayoutChanged() override;
     virtual void slotProjectCalculated(KPlato::ScheduleManager *sm);
 
+    /// Clear all cached data, see data()
+    void clearCache();
+    /// Reset the model if updates were postponed during a batch of changes
+    void slotChangesFinished();
+
 protected:
+    /// Remove the cached data of @p node and its summary tasks
+    void invalidateCache(const Node *node);
+    /**
+     * If the project is in a batch of changes, start a model reset that ends
+     * when the changes are finished, see Project::beginChanges().
+     * Return true if the change shall not be signalled separately.
+     */
+    bool postponeUpdate();
+
     virtual bool setType(Node *node, const QVariant &value, int role);
     bool setCompletion(Node *node, const QVariant &value, int role);
     bool setAllocation(Node *node, const QVariant &value, int role);
@@ -363,6 +378,10 @@ protected:
     Node *m_node; // for sanity check
     NodeModel m_nodemodel;
     bool m_projectshown;
+    /// Data formatted by m_nodemodel per node, keyed on column and role.
+    /// Only the roles used for display, sorting and filtering are cached.
+    mutable QHash<const Node*, QHash<QPair<int, int>, QVariant> > m_cache;
+    bool m_resetPending = false;
 };
 
 //--------------------------------------
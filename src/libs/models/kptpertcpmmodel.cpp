@@ -346,6 +346,23 @@ void PertResultItemModel::slotNodeRemoved(Node * /*node*/)
     refresh();
 }
 
+// The critical paths are updated when a relation changes,
+// so the path lists m_top points into must be released first
+void PertResultItemModel::slotRelationToBeAdded(Relation * /*relation*/, int, int)
+{
+    clear();
+}
+
+void PertResultItemModel::slotRelationToBeRemoved(Relation * /*relation*/)
+{
+    clear();
+}
+
+void PertResultItemModel::slotRelationChanged(Relation * /*relation*/)
+{
+    refresh();
+}
+
 void PertResultItemModel::setProject(Project *project)
 {
     clear();
@@ -359,6 +376,11 @@ void PertResultItemModel::setProject(Project *project)
         disconnect(m_project, &Project::nodeAdded, this, &PertResultItemModel::slotNodeInserted);
         disconnect(m_project, &Project::nodeRemoved, this, &PertResultItemModel::slotNodeRemoved);
         disconnect(m_project, &Project::nodeMoved, this, &PertResultItemModel::slotLayoutChanged);
+
+        disconnect(m_project, &Project::relationToBeAdded, this, &PertResultItemModel::slotRelationToBeAdded);
+        disconnect(m_project, &Project::relationToBeRemoved, this, &PertResultItemModel::slotRelationToBeRemoved);
+        disconnect(m_project, &Project::relationAdded, this, &PertResultItemModel::slotRelationChanged);
+        disconnect(m_project, &Project::relationRemoved, this, &PertResultItemModel::slotRelationChanged);
     }
     m_project = project;
     m_nodemodel.setProject(project);
@@ -372,6 +394,11 @@ void PertResultItemModel::setProject(Project *project)
         connect(m_project, &Project::nodeAdded, this, &PertResultItemModel::slotNodeInserted);
         connect(m_project, &Project::nodeRemoved, this, &PertResultItemModel::slotNodeRemoved);
         connect(m_project, &Project::nodeMoved, this, &PertResultItemModel::slotLayoutChanged);
+
+        connect(m_project, &Project::relationToBeAdded, this, &PertResultItemModel::slotRelationToBeAdded);
+        connect(m_project, &Project::relationToBeRemoved, this, &PertResultItemModel::slotRelationToBeRemoved);
+        connect(m_project, &Project::relationAdded, this, &PertResultItemModel::slotRelationChanged);
+        connect(m_project, &Project::relationRemoved, this, &PertResultItemModel::slotRelationChanged);
     }
     refresh();
 }
@@ -134,6 +134,10 @@ protected Q_SLOTS:
     void slotNodeToBeRemoved(KPlato:: Node *node);
     void slotNodeRemoved(KPlato:: Node *node);
 
+    void slotRelationToBeAdded(KPlato::Relation *relation, int parentIndex, int childIndex);
+    void slotRelationToBeRemoved(KPlato::Relation *relation);
+    void slotRelationChanged(KPlato::Relation *relation);
+
 protected:
     QVariant alignment(int column) const;
     
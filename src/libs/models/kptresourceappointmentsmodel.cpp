@@ -169,6 +169,13 @@ void ResourceAppointmentsItemModel::slotAppointmentChanged(Resource *r, Appointm
     refresh();
 }
 
+void ResourceAppointmentsItemModel::slotChangesFinished()
+{
+    if (m_refreshPending) {
+        refresh();
+    }
+}
+
 void ResourceAppointmentsItemModel::slotProjectCalculated(ScheduleManager *sm)
 {
     if (sm == m_manager) {
@@ -176,6 +183,28 @@ void ResourceAppointmentsItemModel::slotProjectCalculated(ScheduleManager *sm)
     }
 }
 
+void ResourceAppointmentsItemModel::slotTimePhasedCacheChanged(ScheduleManager *sm)
+{
+    if (sm != m_manager || !m_manager || !m_manager->expected() || m_refreshPending) {
+        return;
+    }
+    // the appointments are the same, only the aggregated efforts are new
+    m_cache = m_manager->expected()->timePhasedCache();
+    emitDataChanged(QModelIndex());
+}
+
+void ResourceAppointmentsItemModel::emitDataChanged(const QModelIndex &parent)
+{
+    const int rows = rowCount(parent);
+    if (rows == 0) {
+        return;
+    }
+    Q_EMIT dataChanged(index(0, 1, parent), index(rows - 1, columnCount() - 1, parent));
+    for (int row = 0; row < rows; ++row) {
+        emitDataChanged(index(row, 0, parent));
+    }
+}
+
 void ResourceAppointmentsItemModel::setProject(Project *project)
 {
     Q_UNUSED(project)
@@ -185,6 +214,7 @@ void ResourceAppointmentsItemModel::setProject(Project *project)
         disconnect(m_project, &Project::defaultCalendarChanged, this, &ResourceAppointmentsItemModel::slotCalendarChanged);
         disconnect(m_project, &Project::projectCalculated, this, &ResourceAppointmentsItemModel::slotProjectCalculated);
         disconnect(m_project, &Project::scheduleManagerChanged, this, &ResourceAppointmentsItemModel::slotProjectCalculated);
+        disconnect(m_project, &Project::timePhasedCacheChanged, this, &ResourceAppointmentsItemModel::slotTimePhasedCacheChanged);
 
         connect(m_project, &Project::resourceGroupAdded, this, &ResourceAppointmentsItemModel::slotResourceGroupInserted);
         disconnect(m_project, &Project::resourceGroupToBeRemoved, this, &ResourceAppointmentsItemModel::slotResourceGroupToBeRemoved);
@@ -194,6 +224,7 @@ void ResourceAppointmentsItemModel::setProject(Project *project)
         disconnect(m_project, &Project::resourceToBeRemoved, this, &ResourceAppointmentsItemModel::slotResourceToBeRemoved);
         disconnect(m_project, &Project::resourceAdded, this, &ResourceAppointmentsItemModel::slotResourceInserted);
         disconnect(m_project, &Project::resourceRemoved, this, &ResourceAppointmentsItemModel::slotResourceRemoved);
+        disconnect(m_project, &Project::changesFinished, this, &ResourceAppointmentsItemModel::slotChangesFinished);
 
         const QList<Resource*> resources = m_project->resourceList();
         for (Resource *r : resources) {
@@ -210,6 +241,7 @@ void ResourceAppointmentsItemModel::setProject(Project *project)
         connect(m_project, &Project::defaultCalendarChanged, this, &ResourceAppointmentsItemModel::slotCalendarChanged);
         connect(m_project, &Project::projectCalculated, this, &ResourceAppointmentsItemModel::slotProjectCalculated);
         connect(m_project, &Project::scheduleManagerChanged, this, &ResourceAppointmentsItemModel::slotProjectCalculated);
+        connect(m_project, &Project::timePhasedCacheChanged, this, &ResourceAppointmentsItemModel::slotTimePhasedCacheChanged);
 
         connect(m_project, &Project::resourceGroupAdded, this, &ResourceAppointmentsItemModel::slotResourceGroupInserted);
         connect(m_project, &Project::resourceGroupToBeRemoved, this, &ResourceAppointmentsItemModel::slotResourceGroupToBeRemoved);
@@ -219,6 +251,7 @@ void ResourceAppointmentsItemModel::setProject(Project *project)
         connect(m_project, &Project::resourceToBeRemoved, this, &ResourceAppointmentsItemModel::slotResourceToBeRemoved);
         connect(m_project, &Project::resourceAdded, this, &ResourceAppointmentsItemModel::slotResourceInserted);
         connect(m_project, &Project::resourceRemoved, this, &ResourceAppointmentsItemModel::slotResourceRemoved);
+        connect(m_project, &Project::changesFinished, this, &ResourceAppointmentsItemModel::slotChangesFinished);
 
         const QList<Resource*> resources = m_project->resourceList();
         for (Resource *r : resources) {
@@ -280,6 +313,37 @@ QDate ResourceAppointmentsItemModel::endDate() const
     return QDate::currentDate();
 }
 
+void ResourceAppointmentsItemModel::setResolution(TimePhasedCache::Resolution resolution)
+{
+    if (resolution == m_resolution) {
+        return;
+    }
+    beginResetModel();
+    m_resolution = resolution;
+    endResetModel();
+    Q_EMIT refreshed();
+}
+
+QDate ResourceAppointmentsItemModel::columnDate(int column) const
+{
+    if (column < 2) {
+        return QDate();
+    }
+    const QDate start = TimePhasedCache::periodStart(startDate(), m_resolution);
+    const int period = column - 2;
+    switch (m_resolution) {
+        case TimePhasedCache::Week:
+            return start.addDays(7 * period);
+        case TimePhasedCache::Month:
+            return start.addMonths(period);
+        case TimePhasedCache::Quarter:
+            return start.addMonths(3 * period);
+        default:
+            break;
+    }
+    return start.addDays(period);
+}
+
 void ResourceAppointmentsItemModel::setScheduleManager(ScheduleManager *sm)
 {
     if (sm == m_manager) {
@@ -370,7 +434,18 @@ void ResourceAppointmentsItemModel::addGroup(ResourceGroup *group, ItemData *par
 
 void ResourceAppointmentsItemModel::refresh()
 {
-    beginResetModel();
+    if (m_project && m_project->isChanging()) {
+        // refresh once when the changes are finished
+        if (!m_refreshPending) {
+            m_refreshPending = true;
+            beginResetModel();
+        }
+        return;
+    }
+    if (!m_refreshPending) {
+        beginResetModel();
+    }
+    m_refreshPending = false;
     refreshData();
     delete m_rootItem;
     m_rootItem = new ItemData();
@@ -413,12 +488,27 @@ void ResourceAppointmentsItemModel::refreshData()
     }
     m_effortMap.clear();
     m_effortMap = ec;
+    // the cache may be older than the appointments, it is only used if it is current
+    m_cache = m_manager && m_manager->expected() ? m_manager->expected()->timePhasedCache() : TimePhasedCache();
     return;
 }
 
 int ResourceAppointmentsItemModel::columnCount(const QModelIndex &/*parent*/) const
 {
-    return 3 + startDate().daysTo(endDate());
+    const QDate start = TimePhasedCache::periodStart(startDate(), m_resolution);
+    const QDate end = TimePhasedCache::periodStart(endDate(), m_resolution);
+    const int months = (end.year() - start.year()) * 12 + end.month() - start.month();
+    switch (m_resolution) {
+        case TimePhasedCache::Week:
+            return 3 + start.daysTo(end) / 7;
+        case TimePhasedCache::Month:
+            return 3 + months;
+        case TimePhasedCache::Quarter:
+            return 3 + months / 3;
+        default:
+            break;
+    }
+    return 3 + start.daysTo(end);
 }
 
 int ResourceAppointmentsItemModel::rowCount(const QModelIndex &parent) const
@@ -528,26 +618,10 @@ QVariant ResourceAppointmentsItemModel::total(const ResourceGroup *group, const
 QVariant ResourceAppointmentsItemModel::total(const Resource *res, int role) const
 {
     switch (role) {
-        case Qt::DisplayRole: {
-            Duration d;
-            const QList<Appointment*> lst = res->appointments(id());
-            for (Appointment *a : lst) {
-                if (m_effortMap.contains(a)) {
-                    d += m_effortMap[ a ].totalEffort();
-                }
-            }
-            return QLocale().toString(d.toDouble(Duration::Unit_h), 'f', 1);
-        }
-        case Qt::EditRole: {
-            Duration d;
-            const QList<Appointment*> lst = res->appointments(id());
-            for (Appointment *a : lst) {
-                if (m_effortMap.contains(a)) {
-                    d += m_effortMap[ a ].totalEffort();
-                }
-            }
-            return d.toDouble(Duration::Unit_h);
-        }
+        case Qt::DisplayRole:
+            return QLocale().toString(effort(res).toDouble(Duration::Unit_h), 'f', 1);
+        case Qt::EditRole:
+            return effort(res).toDouble(Duration::Unit_h);
         case Qt::ToolTipRole:
         case Qt::StatusTipRole:
         case Qt::WhatsThisRole:
@@ -562,29 +636,19 @@ QVariant ResourceAppointmentsItemModel::total(const Resource *res, const QDate &
 {
     switch (role) {
         case Qt::DisplayRole: {
-            Duration d;
-            const QList<Appointment*> lst = res->appointments(id());
-            for (Appointment *a : lst) {
-                if (m_effortMap.contains(a)) {
-                    d += m_effortMap[ a ].effortOnDate(date);
-                }
-            }
-            QString ds = QLocale().toString(d.toDouble(Duration::Unit_h), 'f', 1);
-            Duration avail = res->effort(nullptr, DateTime(date, QTime(0,0,0)), Duration(1.0, Duration::Unit_d));
+            QString ds = QLocale().toString(effort(res, date).toDouble(Duration::Unit_h), 'f', 1);
+            Duration avail = res->effort(nullptr, DateTime(date, QTime(0,0,0)), Duration((qint64)date.daysTo(TimePhasedCache::nextPeriodStart(date, m_resolution)), Duration::Unit_d));
             QString avails = QLocale().toString(avail.toDouble(Duration::Unit_h), 'f', 1);
             return QStringLiteral("%1(%2)").arg(ds).arg(avails);
         }
-        case Qt::EditRole: {
-            Duration d;
-            const QList<Appointment*> lst = res->appointments(id());
-            for (Appointment *a : lst) {
-                if (m_effortMap.contains(a)) {
-                    d += m_effortMap[ a ].effortOnDate(date);
-                }
-            }
-            return d.toDouble(Duration::Unit_h);
-        }
+        case Qt::EditRole:
+            return effort(res, date).toDouble(Duration::Unit_h);
         case Qt::ToolTipRole:
+            if (m_resolution != TimePhasedCache::Day) {
+                return i18n("The total booking from %1 to %2, along with the maximum hours for the resource",
+                            QLocale().toString(date, QLocale::ShortFormat),
+                            QLocale().toString(TimePhasedCache::nextPeriodStart(date, m_resolution).addDays(-1), QLocale::ShortFormat));
+            }
             return i18n("The total booking on %1, along with the maximum hours for the resource", QLocale().toString(date, QLocale::ShortFormat));
         case Qt::StatusTipRole:
         case Qt::WhatsThisRole:
@@ -592,7 +656,7 @@ QVariant ResourceAppointmentsItemModel::total(const Resource *res, const QDate &
         case Qt::TextAlignmentRole:
             return (int)(Qt::AlignRight|Qt::AlignVCenter);
         case Qt::BackgroundRole: {
-            if (date.isValid() && res->calendar() && res->calendar()->state(date) != CalendarDay::Working) {
+            if (m_resolution == TimePhasedCache::Day && date.isValid() && res->calendar() && res->calendar()->state(date) != CalendarDay::Working) {
                 QColor c(0xf0f0f0);
                 return QVariant::fromValue(c);
                 //return QVariant(Qt::cyan);
@@ -600,11 +664,43 @@ QVariant ResourceAppointmentsItemModel::total(const Resource *res, const QDate &
             break;
         }
         case Role::Maximum:
-            return res->effort(nullptr, DateTime(date, QTime(0,0,0)), Duration(1.0, Duration::Unit_d)).toDouble(Duration::Unit_h);
+            return res->effort(nullptr, DateTime(date, QTime(0,0,0)), Duration((qint64)date.daysTo(TimePhasedCache::nextPeriodStart(date, m_resolution)), Duration::Unit_d)).toDouble(Duration::Unit_h);
     }
     return QVariant();
 }
 
+Duration ResourceAppointmentsItemModel::effort(const Resource *res, const QDate &date) const
+{
+    if (m_cache.isValid() && m_manager && m_manager->expected() && m_cache.revision() == m_manager->expected()->appointmentRevision()) {
+        const Schedule *s = res->schedule(id());
+        if (!s) {
+            return Duration::zeroDuration;
+        }
+        return date.isValid() ? m_cache.effort(s, date, m_resolution) : m_cache.totalEffort(s);
+    }
+    Duration d;
+    const QList<Appointment*> lst = res->appointments(id());
+    for (Appointment *a : lst) {
+        if (m_effortMap.contains(a)) {
+            d += date.isValid() ? effort(m_effortMap[ a ], date) : m_effortMap[ a ].totalEffort();
+        }
+    }
+    return d;
+}
+
+Duration ResourceAppointmentsItemModel::effort(const EffortCostMap &map, const QDate &date) const
+{
+    if (m_resolution == TimePhasedCache::Day) {
+        return map.effortOnDate(date);
+    }
+    Duration d;
+    const QDate end = TimePhasedCache::nextPeriodStart(date, m_resolution);
+    for (QDate day = qMax(date, map.startDate()); day < end && day <= map.endDate(); day = day.addDays(1)) {
+        d += map.effortOnDate(day);
+    }
+    return d;
+}
+
 QVariant ResourceAppointmentsItemModel::total(const Appointment *a, int role) const
 {
     switch (role) {
@@ -649,10 +745,10 @@ QVariant ResourceAppointmentsItemModel::assignment(const Appointment *a, const Q
         case Qt::DisplayRole: {
             Duration d;
             if (m_effortMap.contains(a)) {
-                if (date < m_effortMap[ a ].startDate() || date > m_effortMap[ a ].endDate()) {
+                if (TimePhasedCache::nextPeriodStart(date, m_resolution) <= m_effortMap[ a ].startDate() || date > m_effortMap[ a ].endDate()) {
                     return QVariant();
                 }
-                d = m_effortMap[ a ].effortOnDate(date);
+                d = effort(m_effortMap[ a ], date);
                 return QLocale().toString(d.toDouble(Duration::Unit_h), 'f', 1);
             }
             return QVariant();
@@ -660,16 +756,21 @@ QVariant ResourceAppointmentsItemModel::assignment(const Appointment *a, const Q
         case Qt::EditRole: {
             Duration d;
             if (m_effortMap.contains(a)) {
-                if (date < m_effortMap[ a ].startDate() || date > m_effortMap[ a ].endDate()) {
+                if (TimePhasedCache::nextPeriodStart(date, m_resolution) <= m_effortMap[ a ].startDate() || date > m_effortMap[ a ].endDate()) {
                     return QVariant();
                 }
-                d = m_effortMap[ a ].effortOnDate(date);
+                d = effort(m_effortMap[ a ], date);
                 return d.toDouble(Duration::Unit_h);
             }
             return QVariant();
         }
         case Qt::ToolTipRole: {
             if (m_effortMap.contains(a)) {
+                if (m_resolution != TimePhasedCache::Day) {
+                    return i18n("Booking by this task from %1 to %2",
+                                QLocale().toString(date, QLocale::ShortFormat),
+                                QLocale().toString(TimePhasedCache::nextPeriodStart(date, m_resolution).addDays(-1), QLocale::ShortFormat));
+                }
                 return i18n("Booking by this task on %1", QLocale().toString(date, QLocale::ShortFormat));
             }
             return QVariant();
@@ -682,7 +783,7 @@ QVariant ResourceAppointmentsItemModel::assignment(const Appointment *a, const Q
         case Qt::ForegroundRole:
             break;
         case Qt::BackgroundRole: {
-            Resource *r = parent(a);
+            Resource *r = m_resolution == TimePhasedCache::Day ? parent(a) : nullptr;
             if (r && r->calendar() && r->calendar()->state(date) != CalendarDay::Working) {
                 QColor c(0xf0f0f0);
                 return QVariant::fromValue(c);
@@ -720,7 +821,7 @@ QVariant ResourceAppointmentsItemModel::data(const QModelIndex &index, int role)
     if (index.column() == 1) {
         return total(static_cast<const ItemData*>(index.internalPointer()), role);
     }
-    QDate d = startDate().addDays(index.column() - 2);
+    QDate d = columnDate(index.column());
     return total(static_cast<const ItemData*>(index.internalPointer()), d, role);
 }
 
@@ -754,8 +855,18 @@ QVariant ResourceAppointmentsItemModel::headerData(int section, Qt::Orientation
                 default: {
                     //debugPlan<<section<<", "<<startDate()<<endDate();
                     if (section < columnCount()) {
-                        QDate d = startDate().addDays(section - 2);
+                        QDate d = columnDate(section);
                         if (d <= endDate()) {
+                            switch (m_resolution) {
+                                case TimePhasedCache::Week:
+                                    return i18nc("@title:column week number and year", "Week %1 %2", d.weekNumber(), d.addDays(3).year());
+                                case TimePhasedCache::Month:
+                                    return QLocale().toString(d, QStringLiteral("MMM yyyy"));
+                                case TimePhasedCache::Quarter:
+                                    return i18nc("@title:column quarter and year", "Q%1 %2", (d.month() - 1) / 3 + 1, d.year());
+                                default:
+                                    break;
+                            }
                             return d;
                         }
                     }
@@ -768,7 +879,12 @@ QVariant ResourceAppointmentsItemModel::headerData(int section, Qt::Orientation
                 case 1: return i18n("The total hours booked");
                 default: {
                     //debugPlan<<section<<", "<<startDate()<<endDate();
-                    QDate d = startDate().addDays(section - 2);
+                    QDate d = columnDate(section);
+                    if (m_resolution != TimePhasedCache::Day) {
+                        return i18n("Bookings from %1 to %2",
+                                    QLocale().toString(d, QLocale::ShortFormat),
+                                    QLocale().toString(TimePhasedCache::nextPeriodStart(d, m_resolution).addDays(-1), QLocale::ShortFormat));
+                    }
                     return i18n("Bookings on %1", QLocale().toString(d, QLocale::ShortFormat));
                 }
                 return QVariant();
@@ -1059,6 +1175,7 @@ void ResourceAppointmentsRowModel::setProject(Project *project)
     if (m_project) {
         disconnect(m_project, &Project::aboutToBeDeleted, this, &ResourceAppointmentsRowModel::projectDeleted);
         disconnect(m_project, &Project::projectCalculated, this, &ResourceAppointmentsRowModel::slotProjectCalculated);
+        disconnect(m_project, &Project::timePhasedCacheChanged, this, &ResourceAppointmentsRowModel::slotTimePhasedCacheChanged);
 
         disconnect(m_project, &Project::resourceToBeAdded, this, &ResourceAppointmentsRowModel::slotResourceToBeInserted);
         disconnect(m_project, &Project::resourceAdded, this, &ResourceAppointmentsRowModel::slotResourceInserted);
@@ -1074,6 +1191,7 @@ void ResourceAppointmentsRowModel::setProject(Project *project)
     if (m_project) {
         connect(m_project, &Project::aboutToBeDeleted, this, &ResourceAppointmentsRowModel::projectDeleted);
         connect(m_project, &Project::projectCalculated, this, &ResourceAppointmentsRowModel::slotProjectCalculated);
+        connect(m_project, &Project::timePhasedCacheChanged, this, &ResourceAppointmentsRowModel::slotTimePhasedCacheChanged);
 
         connect(m_project, &Project::resourceToBeAdded, this, &ResourceAppointmentsRowModel::slotResourceToBeInserted);
         connect(m_project, &Project::resourceAdded, this, &ResourceAppointmentsRowModel::slotResourceInserted);
@@ -1397,6 +1515,15 @@ void ResourceAppointmentsRowModel::slotProjectCalculated(ScheduleManager *sm)
     }
 }
 
+void ResourceAppointmentsRowModel::slotTimePhasedCacheChanged(ScheduleManager *sm)
+{
+    const int rows = rowCount();
+    if (sm == m_manager && rows > 0) {
+        // only the resource rows use the cache
+        Q_EMIT dataChanged(index(0, 0), index(rows - 1, columnCount() - 1));
+    }
+}
+
 Resource *ResourceAppointmentsRowModel::parentResource(const QModelIndex &index) const
 {
     if (m_project == nullptr) {
@@ -1532,6 +1659,18 @@ QVariant ResourceAppointmentsGanttModel::data(const QModelIndex &index, int role
         }
         return QVariant();
     }
+    if (role == Role::TimePhased) {
+        Resource *r = resource(index);
+        if (r == nullptr || m_schedule == nullptr) {
+            return QVariant();
+        }
+        // only a current cache is of any use, else the delegate paints the intervals
+        const TimePhasedCache cache = m_schedule->timePhasedCache();
+        if (cache.revision() != m_schedule->appointmentRevision()) {
+            return QVariant();
+        }
+        return QVariant::fromValue(TimePhasedEffort(cache, r->schedule(id())));
+    }
     return ResourceAppointmentsRowModel::data(index, role);
 }
 
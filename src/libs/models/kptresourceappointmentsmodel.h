@@ -11,6 +11,7 @@
 
 #include <kptitemmodelbase.h>
 #include "kpteffortcostmap.h"
+#include "TimePhasedCache.h"
 
 
 namespace KPlato
@@ -29,7 +30,8 @@ class Calendar;
 class ItemData;
 
 /**
-    The ResourceAppointmentsItemModel organizes appointments as hours booked per day.
+    The ResourceAppointmentsItemModel organizes appointments as hours booked per day,
+    or per week, month or quarter, see setResolution().
 
     All resources are listed under a 'Project' group.
 
@@ -67,6 +69,12 @@ public:
     QDate startDate() const;
     QDate endDate() const;
 
+    /// Set the period shown in each date column to @p resolution
+    void setResolution(KPlato::TimePhasedCache::Resolution resolution);
+    TimePhasedCache::Resolution resolution() const { return m_resolution; }
+    /// Return the first day of the period shown in @p column, invalid for the name and total columns
+    QDate columnDate(int column) const;
+
     Resource *parent(const Appointment *a) const;
 
 Q_SIGNALS:
@@ -90,12 +98,16 @@ protected Q_SLOTS:
 
     void slotCalendarChanged(KPlato::Calendar* cal);
     void slotProjectCalculated(KPlato::ScheduleManager *sm);
+    void slotTimePhasedCacheChanged(KPlato::ScheduleManager *sm);
     
     void slotAppointmentToBeInserted(KPlato::Resource *r, int row);
     void slotAppointmentInserted(KPlato::Resource*, KPlato::Appointment*);
     void slotAppointmentToBeRemoved(KPlato::Resource *r, int row);
     void slotAppointmentRemoved();
     void slotAppointmentChanged(KPlato::Resource *r, KPlato::Appointment *a);
+
+    /// Refresh if it was postponed during a batch of changes
+    void slotChangesFinished();
     
 protected:
     void refreshData();
@@ -108,6 +120,10 @@ protected:
     QVariant total(const Resource *res, int role) const;
     QVariant total(const Resource *res, const QDate &date, int role) const;
     QVariant total(const Appointment *a, int role) const;
+    /// Return the effort of @p res in the period that starts on @p date, or the total effort if @p date is invalid
+    Duration effort(const Resource *res, const QDate &date = QDate()) const;
+    /// Return the effort in @p map in the period that starts on @p date
+    Duration effort(const EffortCostMap &map, const QDate &date) const;
 
     QVariant assignment(const Appointment *a, const QDate &date, int role) const;
 
@@ -116,13 +132,17 @@ protected:
 
     void addResource(Resource *resource, ItemData *parentItem);
     void addGroup(ResourceGroup *group, ItemData *parentItem);
+    void emitDataChanged(const QModelIndex &parent);
 
 private:
     ItemData *m_rootItem;
     int m_columnCount;
     QHash<const Appointment*, EffortCostMap> m_effortMap;
+    TimePhasedCache m_cache;
+    TimePhasedCache::Resolution m_resolution = TimePhasedCache::Day;
     QDate m_start;
     QDate m_end;
+    bool m_refreshPending = false;
 };
 
 /**
@@ -194,6 +214,7 @@ protected Q_SLOTS:
     void slotAppointmentRemoved();
     void slotAppointmentChanged(KPlato::Resource *r, KPlato::Appointment *a);
     void slotProjectCalculated(KPlato::ScheduleManager *sm);
+    void slotTimePhasedCacheChanged(KPlato::ScheduleManager *sm);
 
 protected:
     QModelIndex createResourceIndex(int row, int column);
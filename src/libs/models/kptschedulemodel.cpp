@@ -1277,7 +1277,7 @@ void ScheduleLogItemModel::addLogEntry(const Schedule::Log &log, int /*row*/)
     QStandardItem *item = new QStandardItem(m_schedule->logSeverity(log.severity));
     item->setData(log.severity, SeverityRole);
     lst.append(item);
-    lst.append(new QStandardItem(log.message));
+    lst.append(new QStandardItem(log.text()));
     for (QStandardItem *itm : qAsConst(lst)) {
             if (log.resource) {
                 itm->setData(log.resource->id(), IdentityRole);
@@ -0,0 +1,140 @@
+/* This file is part of the KDE project
+ * SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+// clazy:excludeall=qstring-arg
+#include <QTest>
+
+#include "kptflatproxymodel.h"
+#include "kptnodeitemmodel.h"
+#include "kptproject.h"
+#include "kpttask.h"
+
+#include <QModelIndex>
+#include <QSortFilterProxyModel>
+
+using namespace KPlato;
+
+/**
+ * Measures the task editor model on a flat work breakdown structure:
+ * 20000 tasks under one summary task.
+ * Looking up the index and parent of every task, iterating the flat model
+ * used by the task views, sorting and moving tasks up and down.
+ */
+class NodeItemModelBenchmark : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+    void benchmarkIndex();
+    void benchmarkFlatModel();
+    void benchmarkSort();
+    void benchmarkMove();
+
+private:
+    Project *m_project;
+    Task *m_summary;
+    NodeItemModel *m_model;
+};
+
+void NodeItemModelBenchmark::initTestCase()
+{
+    m_project = new Project();
+    m_project->setName(QStringLiteral("P1"));
+    m_project->setId(m_project->uniqueNodeId());
+    m_project->registerNodeId(m_project);
+
+    m_summary = m_project->createTask();
+    m_summary->setName(QStringLiteral("S1"));
+    QVERIFY(m_project->addTask(m_summary, m_project));
+    for (int i = 0; i < 20000; ++i) {
+        Task *t = m_project->createTask();
+        t->setName(QStringLiteral("T%1").arg(i));
+        QVERIFY(m_project->addSubTask(t, m_summary));
+    }
+    m_model = new NodeItemModel();
+    m_model->setProject(m_project);
+    QCOMPARE(m_model->rowCount(m_model->index(m_summary)), 20000);
+}
+
+void NodeItemModelBenchmark::cleanupTestCase()
+{
+    delete m_model;
+    delete m_project;
+}
+
+void NodeItemModelBenchmark::benchmarkIndex()
+{
+    const QList<Node*> tasks = m_summary->childNodeIterator();
+    int rows = 0;
+    QBENCHMARK {
+        rows = 0;
+        for (const Node *n : tasks) {
+            const QModelIndex idx = m_model->index(n);
+            rows += idx.row() - m_model->parent(idx).row();
+        }
+    }
+    QCOMPARE(rows, 20000 * 19999 / 2);
+}
+
+void NodeItemModelBenchmark::benchmarkFlatModel()
+{
+    FlatProxyModel model;
+    model.setSourceModel(m_model);
+    QCOMPARE(model.rowCount(), 20001);
+    int count = 0;
+    QBENCHMARK {
+        count = 0;
+        for (int row = 0; row < model.rowCount(); ++row) {
+            const QModelIndex idx = model.index(row, NodeModel::NodeName);
+            count += model.data(idx).toString().isEmpty() ? 0 : 1;
+            count += model.mapToSource(idx).parent().isValid() ? 0 : 1;
+        }
+    }
+    QCOMPARE(count, 20001 + 1);
+}
+
+void NodeItemModelBenchmark::benchmarkSort()
+{
+    QSortFilterProxyModel model;
+    model.setSourceModel(m_model);
+    model.setSortRole(m_model->sortRole(NodeModel::NodeName));
+    const QModelIndex summary = model.index(0, 0);
+    QBENCHMARK {
+        model.sort(NodeModel::NodeName, Qt::AscendingOrder);
+        model.sort(NodeModel::NodeName, Qt::DescendingOrder);
+    }
+    QCOMPARE(model.index(0, NodeModel::NodeName, summary).data().toString(), QStringLiteral("T9999"));
+
+    // cached data must follow changes
+    Node *task = m_summary->childNode(0);
+    task->setName(QStringLiteral("T99999"));
+    QCOMPARE(m_model->index(task, NodeModel::NodeName).data().toString(), QStringLiteral("T99999"));
+    QCOMPARE(model.index(0, NodeModel::NodeName, summary).data().toString(), QStringLiteral("T99999"));
+    task->setName(QStringLiteral("T0"));
+    QCOMPARE(m_model->index(task, NodeModel::NodeName).data().toString(), QStringLiteral("T0"));
+}
+
+void NodeItemModelBenchmark::benchmarkMove()
+{
+    Node *first = m_summary->childNode(0);
+    Node *middle = m_summary->childNode(10000);
+    QBENCHMARK {
+        for (int i = 0; i < 100; ++i) {
+            QVERIFY(m_project->moveTaskDown(first));
+            QVERIFY(m_project->moveTaskDown(middle));
+        }
+        for (int i = 0; i < 100; ++i) {
+            QVERIFY(m_project->moveTaskUp(first));
+            QVERIFY(m_project->moveTaskUp(middle));
+        }
+    }
+    QCOMPARE(m_summary->indexOf(first), 0);
+    QCOMPARE(m_summary->indexOf(middle), 10000);
+}
+
+QTEST_GUILESS_MAIN(NodeItemModelBenchmark)
+#include <NodeItemModelBenchmark.moc>
@@ -0,0 +1,119 @@
+/* This file is part of the KDE project
+ * SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+// clazy:excludeall=qstring-arg
+#include <QTest>
+
+#include <QBuffer>
+#include <QByteArray>
+#include <QRandomGenerator>
+#include <QVector>
+#include <QXmlStreamWriter>
+
+#include <KoXmlReader.h>
+
+#include <algorithm>
+#include <limits>
+
+
+/**
+ * Measures loading a large document and visiting its elements
+ * in document order and in random order,
+ * with the document packed compressed and uncompressed.
+ */
+class BenchmarkXmlReader : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+    void benchmarkRead_data();
+    void benchmarkRead();
+
+private:
+    QByteArray m_content;
+    qint64 m_threshold;
+};
+
+void BenchmarkXmlReader::initTestCase()
+{
+    m_threshold = KoXmlDocument::compressionThreshold();
+
+    // project like document: tasks with a few child elements each
+    QBuffer buffer(&m_content);
+    buffer.open(QIODevice::WriteOnly);
+    QXmlStreamWriter writer(&buffer);
+    writer.writeStartDocument();
+    writer.writeStartElement(QStringLiteral("project"));
+    for (int i = 0; i < 20000; ++i) {
+        writer.writeStartElement(QStringLiteral("task"));
+        writer.writeAttribute(QStringLiteral("id"), QString::number(i));
+        writer.writeAttribute(QStringLiteral("name"), QStringLiteral("Task %1").arg(i));
+        writer.writeStartElement(QStringLiteral("estimate"));
+        writer.writeAttribute(QStringLiteral("expected"), QString::number(i % 40));
+        writer.writeEndElement();
+        writer.writeStartElement(QStringLiteral("schedule"));
+        writer.writeAttribute(QStringLiteral("start"), QStringLiteral("2023-01-01T08:00:00"));
+        writer.writeAttribute(QStringLiteral("end"), QStringLiteral("2023-01-01T16:00:00"));
+        writer.writeEndElement();
+        writer.writeEndElement();
+    }
+    writer.writeEndElement();
+    writer.writeEndDocument();
+}
+
+void BenchmarkXmlReader::cleanupTestCase()
+{
+    KoXmlDocument::setCompressionThreshold(m_threshold);
+}
+
+void BenchmarkXmlReader::benchmarkRead_data()
+{
+    QTest::addColumn<bool>("compressed");
+    QTest::addColumn<bool>("randomOrder");
+
+    QTest::newRow("compressed, document order") << true << false;
+    QTest::newRow("compressed, random order") << true << true;
+    QTest::newRow("uncompressed, document order") << false << false;
+    QTest::newRow("uncompressed, random order") << false << true;
+}
+
+void BenchmarkXmlReader::benchmarkRead()
+{
+    QFETCH(bool, compressed);
+    QFETCH(bool, randomOrder);
+
+    KoXmlDocument::setCompressionThreshold(compressed ? 0 : std::numeric_limits<qint64>::max());
+
+    QVector<int> order(20000);
+    for (int i = 0; i < order.count(); ++i) {
+        order[i] = i;
+    }
+    if (randomOrder) {
+        QRandomGenerator generator(4711);
+        std::shuffle(order.begin(), order.end(), generator);
+    }
+    qint64 sum = 0;
+    QBENCHMARK {
+        KoXmlDocument doc;
+        QVERIFY(doc.setContent(m_content, false));
+        const KoXmlElement project = doc.documentElement();
+        QVector<KoXmlElement> tasks;
+        tasks.reserve(order.count());
+        KoXmlElement task;
+        forEachElement(task, project) {
+            tasks << task;
+        }
+        QCOMPARE(tasks.count(), order.count());
+        for (int i : order) {
+            const KoXmlElement estimate = tasks.at(i).namedItem(QStringLiteral("estimate")).toElement();
+            sum += estimate.attribute(QStringLiteral("expected")).toInt();
+        }
+    }
+    QVERIFY(sum > 0);
+}
+
+QTEST_GUILESS_MAIN(BenchmarkXmlReader)
+#include <BenchmarkXmlReader.moc>
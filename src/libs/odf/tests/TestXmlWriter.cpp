@@ -19,6 +19,7 @@ private Q_SLOTS:
     void testDocytype();
     void testEmtpyElement();
     void testAttributes();
+    void testAttributeWhitespace();
     void testIndent();
     void testTextNode();
     void testTextSpan();
@@ -88,6 +89,16 @@ void TestXmlWriter::testAttributes()
     QCOMPARE(content(),  QStringLiteral("<test a=\"val\" b=\"&lt;&quot;&gt;\" c=\"-42\" d=\"1234.56789012345\" e=\"1234.56789012345pt\" f=\"false\" g=\"true\"/>"));
 }
 
+void TestXmlWriter::testAttributeWhitespace()
+{
+    setup();
+
+    writer->startElement("test");
+    writer->addAttribute("a", QStringLiteral("line 1\nline 2\r\n\tend"));
+    writer->endElement();
+    QCOMPARE(content(),  QStringLiteral("<test a=\"line 1&#10;line 2&#13;&#10;&#9;end\"/>"));
+}
+
 void TestXmlWriter::testEmtpyElement()
 {
     setup();
@@ -68,6 +68,7 @@
 #include <QXmlStreamEntityResolver>
 
 #include <QBuffer>
+#include <QAtomicInteger>
 #include <QByteArray>
 #include <QDataStream>
 #include <QHash>
@@ -286,10 +287,15 @@ typedef QVector<KoXmlPackedItem> KoXmlPackedGroup;
 #define GROUP_GROW_SHIFT 3
 #define GROUP_GROW_SIZE (1 << GROUP_GROW_SHIFT)
 
+// documents smaller than this are not compressed, see KoXmlDocument::setCompressionThreshold()
+static QAtomicInteger<qint64> s_compressionThreshold(512 * 1024);
+
 class KoXmlPackedDocument
 {
 public:
     bool processNamespace;
+    // compress the groups, only used with KOXML_COMPRESS
+    bool compress;
 #ifdef KOXML_COMPACT
     // map given depth to the list of items
     QHash<int, KoXmlPackedGroup> groups;
@@ -366,6 +372,9 @@ public:
         KoXmlPackedGroup& group = groups[depth];
 
 #ifdef KOXML_COMPRESS
+        if (group.isEmpty()) {
+            group.setCompressed(compress);
+        }
         KoXmlPackedItem& item = group.newItem();
 #else
         // reserve up front
@@ -457,7 +466,7 @@ public:
     }
 
 public:
-    KoXmlPackedDocument(): processNamespace(false), currentDepth(0) {
+    explicit KoXmlPackedDocument(bool compress = true): processNamespace(false), compress(compress), currentDepth(0) {
         clear();
     }
 
@@ -570,7 +579,7 @@ public:
         items.squeeze();
     }
 
-    KoXmlPackedDocument(): processNamespace(false), elementDepth(0) {
+    explicit KoXmlPackedDocument(bool compress = true): processNamespace(false), compress(compress), elementDepth(0) {
     }
 
 #endif
@@ -629,6 +638,30 @@ namespace {
         return error;
     }
 
+    // parse the element at the current position as if it was the document element
+    ParseError parseCurrentElement(QXmlStreamReader &xml, KoXmlPackedDocument &doc, bool stripSpaces = true)
+    {
+        doc.clear();
+        ParseError error;
+        if (xml.tokenType() != QXmlStreamReader::StartElement) {
+            error.error = true;
+            error.errorMsg = QStringLiteral("Not at the start of an element");
+        } else {
+            parseElement(xml, doc, stripSpaces);
+        }
+        if (!error.error && xml.hasError()) {
+            error.error = true;
+            error.errorMsg = xml.errorString();
+        }
+        if (error.error) {
+            error.errorColumn = xml.columnNumber();
+            error.errorLine = xml.lineNumber();
+        } else {
+            doc.finish();
+        }
+        return error;
+    }
+
     void parseElementContents(QXmlStreamReader &xml, KoXmlPackedDocument &doc)
     {
         xml.readNext();
@@ -1450,13 +1483,16 @@ public:
     ~KoXmlDocumentData();
 
     bool setContent(QXmlStreamReader *reader,
-                    QString* errorMsg = nullptr, int* errorLine = nullptr, int* errorColumn = nullptr);
+                    QString* errorMsg = nullptr, int* errorLine = nullptr, int* errorColumn = nullptr,
+                    bool currentElement = false);
 
     KoXmlDocumentType dt;
 
     bool emptyDocument :1;
     // to read the xml with or without spaces
     bool stripSpaces :1;
+    // size of the content to be read, -1 if unknown
+    qint64 contentSize;
 };
 
 #define KOXMLDOCDATA(d)  static_cast<KoXmlDocumentData*>(d)
@@ -1466,6 +1502,7 @@ KoXmlDocumentData::KoXmlDocumentData(unsigned long initialRefCount)
     : KoXmlNodeData(initialRefCount)
     , emptyDocument(true)
     , stripSpaces(true)
+    , contentSize(-1)
 {
 }
 
@@ -1473,7 +1510,7 @@ KoXmlDocumentData::~KoXmlDocumentData()
 {
 }
 
-bool KoXmlDocumentData::setContent(QXmlStreamReader* reader, QString* errorMsg, int* errorLine, int* errorColumn)
+bool KoXmlDocumentData::setContent(QXmlStreamReader* reader, QString* errorMsg, int* errorLine, int* errorColumn, bool currentElement)
 {
     // sanity checks
     if (!reader) return false;
@@ -1484,10 +1521,12 @@ bool KoXmlDocumentData::setContent(QXmlStreamReader* reader, QString* errorMsg,
     clear();
     nodeType = KoXmlNode::DocumentNode;
 
-    packedDoc = new KoXmlPackedDocument;
+    packedDoc = new KoXmlPackedDocument(contentSize < 0 || contentSize >= s_compressionThreshold.loadRelaxed());
     packedDoc->processNamespace = reader->namespaceProcessing();
 
-    ParseError error = parseDocument(*reader, *packedDoc, stripSpaces);
+    ParseError error = currentElement
+            ? parseCurrentElement(*reader, *packedDoc, stripSpaces)
+            : parseDocument(*reader, *packedDoc, stripSpaces);
     if (error.error) {
         // parsing error has occurred
         if (errorMsg) *errorMsg = error.errorMsg;
@@ -2182,11 +2221,32 @@ bool KoXmlDocument::setContent(QXmlStreamReader *reader,
         d = dat;
     }
 
+    QIODevice *device = reader ? reader->device() : nullptr;
+    KOXMLDOCDATA(d)->contentSize = device && !device->isSequential() ? device->size() : -1;
     const bool result = KOXMLDOCDATA(d)->setContent(reader, errorMsg, errorLine, errorColumn);
 
     return result;
 }
 
+bool KoXmlDocument::setContentFromCurrentElement(QXmlStreamReader *reader,
+                                                QString* errorMsg, int* errorLine, int* errorColumn)
+{
+    if (d->nodeType != KoXmlNode::DocumentNode) {
+        const bool stripSpaces = KOXMLDOCDATA(d)->stripSpaces;
+        d->unref();
+        KoXmlDocumentData *dat = new KoXmlDocumentData;
+        dat->nodeType = KoXmlNode::DocumentNode;
+        dat->stripSpaces = stripSpaces;
+        d = dat;
+    }
+
+    // an element is small compared to a document, no need to compress
+    KOXMLDOCDATA(d)->contentSize = 0;
+    const bool result = KOXMLDOCDATA(d)->setContent(reader, errorMsg, errorLine, errorColumn, true);
+
+    return result;
+}
+
 // no namespace processing
 bool KoXmlDocument::setContent(QIODevice* device, QString* errorMsg,
                                int* errorLine, int* errorColumn)
@@ -2212,6 +2272,7 @@ bool KoXmlDocument::setContent(QIODevice* device, bool namespaceProcessing,
     DumbEntityResolver entityResolver;
     reader.setEntityResolver(&entityResolver);
 
+    KOXMLDOCDATA(d)->contentSize = device->isSequential() ? -1 : device->size();
     const bool result = KOXMLDOCDATA(d)->setContent(&reader, errorMsg, errorLine, errorColumn);
 
     return result;
@@ -2225,6 +2286,24 @@ bool KoXmlDocument::setContent(const QByteArray& text, bool namespaceProcessing,
     return setContent(&buffer, namespaceProcessing, errorMsg, errorLine, errorColumn);
 }
 
+// the size of @p text in utf-8, comparable to the size of a file
+static qint64 utf8Size(const QString &text)
+{
+    qint64 size = 0;
+    for (const QChar c : text) {
+        const ushort u = c.unicode();
+        if (u < 0x80) {
+            size += 1;
+        } else if (u < 0x800 || c.isSurrogate()) {
+            // a surrogate pair is 4 bytes
+            size += 2;
+        } else {
+            size += 3;
+        }
+    }
+    return size;
+}
+
 bool KoXmlDocument::setContent(const QString& text, bool namespaceProcessing,
                                QString *errorMsg, int *errorLine, int *errorColumn)
 {
@@ -2242,6 +2321,7 @@ bool KoXmlDocument::setContent(const QString& text, bool namespaceProcessing,
     DumbEntityResolver entityResolver;
     reader.setEntityResolver(&entityResolver);
 
+    KOXMLDOCDATA(d)->contentSize = utf8Size(text);
     const bool result = KOXMLDOCDATA(d)->setContent(&reader, errorMsg, errorLine, errorColumn);
 
     return result;
@@ -2258,6 +2338,16 @@ void  KoXmlDocument::setWhitespaceStripping(bool stripSpaces)
     KOXMLDOCDATA(d)->stripSpaces = stripSpaces;
 }
 
+void KoXmlDocument::setCompressionThreshold(qint64 size)
+{
+    s_compressionThreshold.storeRelaxed(size);
+}
+
+qint64 KoXmlDocument::compressionThreshold()
+{
+    return s_compressionThreshold.loadRelaxed();
+}
+
 
 #endif
 
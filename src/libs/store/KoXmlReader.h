@@ -296,6 +296,14 @@ public:
                     QString* errorMsg = nullptr, int* errorLine = nullptr, int* errorColumn = nullptr);
     bool setContent(QXmlStreamReader *reader,
                     QString* errorMsg = nullptr, int* errorLine = nullptr, int* errorColumn = nullptr);
+    /**
+     * Read the element at the current position of @p reader, with its children,
+     * as the document element of this document.
+     * The reader must be positioned at a start element, and is left at the
+     * corresponding end element, so a large document can be read one element at a time.
+     */
+    bool setContentFromCurrentElement(QXmlStreamReader *reader,
+                    QString* errorMsg = nullptr, int* errorLine = nullptr, int* errorColumn = nullptr);
     bool setContent(const QByteArray& text, bool namespaceProcessing,
                     QString *errorMsg = nullptr, int *errorLine = nullptr, int *errorColumn = nullptr);
     bool setContent(const QString& text, bool namespaceProcessing,
@@ -311,6 +319,16 @@ public:
      */
     void setWhitespaceStripping(bool stripSpaces);
 
+    /**
+     * Documents of at least @p size bytes are kept compressed in memory,
+     * smaller documents are kept uncompressed for faster access.
+     * Use 0 to always compress.
+     * Affects documents loaded after the call, a load that is already
+     * running in another thread may still use the previous value.
+     */
+    static void setCompressionThreshold(qint64 size);
+    static qint64 compressionThreshold();
+
 private:
     friend class KoXmlNode;
     explicit KoXmlDocument(KoXmlDocumentData*);
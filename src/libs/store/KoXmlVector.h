@@ -22,6 +22,8 @@
 #include <QDataStream>
 #include <QBuffer>
 
+#include <algorithm>
+
 /**
  * KoXmlVector
  *
@@ -35,24 +37,50 @@
  * <li>just read content with operator[]</li>
  * </ul>
  *
+ * Compression can be switched off with setCompressed() before content is added,
+ * e.g. for small documents where the memory saved is not worth the time.
+ * The blocks are then kept unpacked and shared with the buffer when read.
+ *
  * @param uncompressedItemCount when number of buffered items reach this,
  *      compression will start small value will give better memory usage at the
  *      cost of speed bigger value will be better in term of speed, but use
  *      more memory
+ * @param cachedBlockCount number of recently used blocks kept unpacked
+ *      in addition to the buffer, avoids unpacking the same blocks over and
+ *      over again when reading in non-sequential order
  */
-template <typename T, int uncompressedItemCount = 256, int reservedBufferSize = 1024*1024>
+template <typename T, int uncompressedItemCount = 256, int reservedBufferSize = 1024*1024, int cachedBlockCount = 4>
 class KoXmlVector
 {
 private:
+    struct CachedBlock
+    {
+        int block;
+        QVector<T> items;
+    };
+
     unsigned m_totalItems;
+    bool m_compressed;
     QVector<unsigned> m_startIndex;
-    QVector<QByteArray> m_blocks;
+    QVector<QByteArray> m_blocks; // compressed blocks
+    QVector<QVector<T> > m_items; // unpacked blocks, if not compressed
 
     mutable unsigned m_bufferStartIndex;
+    mutable int m_bufferBlock; // -1 if the buffer is not a stored block
     mutable QVector<T> m_bufferItems;
     mutable QByteArray m_bufferData;
+    mutable QVector<CachedBlock> m_cache; // least recently used first
 
 protected:
+    /**
+     * find the stored block that holds item @p index
+     */
+    int findBlock(unsigned index) const {
+        // m_startIndex is sorted, find the last block starting at or before index
+        const auto it = std::upper_bound(m_startIndex.constBegin(), m_startIndex.constEnd(), index);
+        return it == m_startIndex.constBegin() ? 0 : int(it - m_startIndex.constBegin()) - 1;
+    }
+
     /**
      * fetch given item index to the buffer
      * will INVALIDATE all references to the buffer
@@ -63,60 +91,108 @@ protected:
             if (index - m_bufferStartIndex < (unsigned)m_bufferItems.count())
                 return;
 
-        // search in the stored blocks
-        // TODO: binary search to speed up
-        int loc = m_startIndex.count() - 1;
-        for (int c = 0; c < m_startIndex.count() - 1; ++c)
-            if (index >= m_startIndex[c])
-                if (index < m_startIndex[c+1]) {
-                    loc = c;
-                    break;
-                }
-
-        m_bufferStartIndex = m_startIndex[loc];
+        const int loc = findBlock(index);
+
+        if (!m_compressed) {
+            // implicitly shared, nothing to unpack
+            m_bufferItems = m_items.at(loc);
+            m_bufferStartIndex = m_startIndex[loc];
+            m_bufferBlock = loc;
+            return;
+        }
+
+        // keep the current buffer around, it is likely to be used again
+        CachedBlock current;
+        current.block = m_bufferBlock;
+        current.items.swap(m_bufferItems);
+
+        int cached = -1;
+        for (int c = 0; c < m_cache.count(); ++c) {
+            if (m_cache.at(c).block == loc) {
+                cached = c;
+                break;
+            }
+        }
+        if (cached >= 0) {
+            m_bufferItems.swap(m_cache[cached].items);
+            m_cache.remove(cached);
+        } else {
 #ifdef KOXMLVECTOR_USE_LZF
-        KoLZF::decompress(m_blocks[loc], m_bufferData);
-#else
-        m_bufferData = m_blocks[loc];
+            KoLZF::decompress(m_blocks[loc], m_bufferData);
 #endif
-        QBuffer buffer(&m_bufferData);
-        buffer.open(QIODevice::ReadOnly);
-        QDataStream in(&buffer);
-        m_bufferItems.clear();
-        in >> m_bufferItems;
+            QBuffer buffer(&m_bufferData);
+            buffer.open(QIODevice::ReadOnly);
+            QDataStream in(&buffer);
+            in >> m_bufferItems;
+        }
+        m_bufferStartIndex = m_startIndex[loc];
+        m_bufferBlock = loc;
+
+        if (cachedBlockCount > 0 && current.block >= 0) {
+            if (m_cache.count() >= cachedBlockCount) {
+                m_cache.removeFirst();
+            }
+            m_cache.append(current);
+        }
     }
 
     /**
      * store data in the buffer to main m_blocks
      */
     void storeBuffer() {
-        QBuffer buffer;
-        buffer.open(QIODevice::WriteOnly);
-        QDataStream out(&buffer);
-        out << m_bufferItems;
-
         m_startIndex.append(m_bufferStartIndex);
+        if (m_compressed) {
 #ifdef KOXMLVECTOR_USE_LZF
-        m_blocks.append(KoLZF::compress(buffer.data()));
-#else
-        m_blocks.append(buffer.data());
+            QBuffer buffer;
+            buffer.open(QIODevice::WriteOnly);
+            QDataStream out(&buffer);
+            out << m_bufferItems;
+            m_blocks.append(KoLZF::compress(buffer.data()));
 #endif
+        } else {
+            m_bufferItems.squeeze();
+            m_items.append(m_bufferItems);
+        }
 
         m_bufferStartIndex += m_bufferItems.count();
         m_bufferItems.clear();
     }
 
 public:
-    inline KoXmlVector(): m_totalItems(0), m_bufferStartIndex(0) {};
+#ifdef KOXMLVECTOR_USE_LZF
+    inline KoXmlVector(): m_totalItems(0), m_compressed(true), m_bufferStartIndex(0), m_bufferBlock(-1) {};
+#else
+    inline KoXmlVector(): m_totalItems(0), m_compressed(false), m_bufferStartIndex(0), m_bufferBlock(-1) {};
+#endif
+
+    /**
+     * Set if stored blocks are compressed.
+     * Only has effect on an empty vector, and only if compression is available.
+     */
+    void setCompressed(bool on) {
+        if (m_totalItems == 0) {
+#ifdef KOXMLVECTOR_USE_LZF
+            m_compressed = on;
+#else
+            Q_UNUSED(on)
+#endif
+        }
+    }
+    inline bool isCompressed() const {
+        return m_compressed;
+    }
 
     void clear() {
         m_totalItems = 0;
         m_startIndex.clear();
         m_blocks.clear();
+        m_items.clear();
 
         m_bufferStartIndex = 0;
+        m_bufferBlock = -1;
         m_bufferItems.clear();
         m_bufferData.reserve(reservedBufferSize);
+        m_cache.clear();
     }
 
     inline int count() const {
@@ -150,7 +226,8 @@ public:
      */
     const T &operator[](int i) const {
         fetchItem((unsigned)i);
-        return m_bufferItems[i - m_bufferStartIndex];
+        // at() does not detach the buffer from a shared block
+        return m_bufferItems.at(i - m_bufferStartIndex);
     }
 
     /**
@@ -217,7 +217,7 @@ void KoXmlWriter::addAttribute(const char* attrName, const QByteArray& value)
     writeChar(' ');
     writeCString(attrName);
     writeCString("=\"");
-    char* escaped = escapeForXML(value.constData(), value.size());
+    char* escaped = escapeForXML(value.constData(), value.size(), true);
     writeCString(escaped);
     if (escaped != d->escapeBuffer)
         delete[] escaped;
@@ -229,7 +229,7 @@ void KoXmlWriter::addAttribute(const char* attrName, const char* value)
     writeChar(' ');
     writeCString(attrName);
     writeCString("=\"");
-    char* escaped = escapeForXML(value, -1);
+    char* escaped = escapeForXML(value, -1, true);
     writeCString(escaped);
     if (escaped != d->escapeBuffer)
         delete[] escaped;
@@ -282,7 +282,7 @@ void KoXmlWriter::writeString(const QString& str)
 
 // In case of a reallocation (ret value != d->buffer), the caller owns the return value,
 // it must delete it (with [])
-char* KoXmlWriter::escapeForXML(const char* source, int length = -1) const
+char* KoXmlWriter::escapeForXML(const char* source, int length, bool attribute) const
 {
     // we're going to be pessimistic on char length; so lets make the outputLength less
     // the amount one char can take: 6
@@ -336,6 +336,14 @@ char* KoXmlWriter::escapeForXML(const char* source, int length = -1) const
         case 9:
         case 10:
         case 13:
+            if (attribute) {
+                const char* ref = *src == 9 ? "&#9;" : (*src == 10 ? "&#10;" : "&#13;");
+                const int refLength = qstrlen(ref);
+                memcpy(destination, ref, refLength);
+                destination += refLength;
+                ++src;
+                continue;
+            }
             *destination++ = *src++;
             continue;
         default:
@@ -275,7 +275,9 @@ private:
             writeChar('>');
         }
     }
-    char* escapeForXML(const char* source, int length) const;
+    // In attribute values tab, newline and carriage return are written as character references,
+    // else they are normalized to spaces when the document is read
+    char* escapeForXML(const char* source, int length, bool attribute = false) const;
     bool prepareForChild();
     void prepareForTextNode();
     void init();
@@ -145,6 +145,41 @@ void TestKoXmlVector::writeAndRead()
     }
 }
 
+void TestKoXmlVector::randomRead_data()
+{
+    QTest::addColumn<bool>("compressed");
+
+    QTest::newRow("compressed") << true;
+    QTest::newRow("uncompressed") << false;
+}
+
+void TestKoXmlVector::randomRead()
+{
+    QFETCH(bool, compressed);
+
+    KoXmlVector<TestStruct, writeAndReadUncompressedCount+1, 1024, 2> vector;
+    vector.setCompressed(compressed);
+
+    const unsigned int itemCount = writeAndReadUncompressedCount * 20 + 3;
+    for (unsigned int i = 0; i < itemCount; ++i) {
+        TestStruct &item = vector.newItem();
+        item.attr = false;
+        item.type = FirstType;
+        item.number = i;
+        item.string = QString::number(i);
+    }
+    vector.squeeze();
+#ifdef KOXMLVECTOR_USE_LZF
+    QCOMPARE(vector.isCompressed(), compressed);
+#endif
 
+    // jump between blocks, so that blocks are taken from and evicted from the cache
+    for (unsigned int n = 0; n < itemCount * 3; ++n) {
+        const unsigned int i = (n * 37) % itemCount;
+        const TestStruct &readItem = vector[i];
+        QCOMPARE(readItem.number, i);
+        QCOMPARE(readItem.string, QString::number(i));
+    }
+}
 
 QTEST_GUILESS_MAIN(TestKoXmlVector)
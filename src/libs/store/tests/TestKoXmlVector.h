@@ -18,6 +18,8 @@ private Q_SLOTS:
     void simpleConstructor();
     void writeAndRead_data();
     void writeAndRead();
+    void randomRead_data();
+    void randomRead();
 };
 
 #endif
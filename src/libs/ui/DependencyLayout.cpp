@@ -0,0 +1,56 @@
+/* This file is part of the KDE project
+ * SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+// clazy:excludeall=qstring-arg
+#include "DependencyLayout.h"
+
+#include <QPair>
+
+using namespace KPlato;
+
+int DependencyLayout::distance(Relation::Type type)
+{
+    return type == Relation::FinishStart ? 1 : 0;
+}
+
+QVector<int> DependencyLayout::columns(const Graph &graph)
+{
+    const int count = graph.parents.count();
+    // Longest path over the parent and relation edges, in topological order
+    QVector<QVector<QPair<int, int>>> successors(count);
+    QVector<int> inDegree(count, 0);
+    for (int i = 0; i < count; ++i) {
+        const int parent = graph.parents.at(i);
+        if (parent >= 0) {
+            successors[parent].append(qMakePair(i, 1));
+            ++inDegree[i];
+        }
+    }
+    for (const Edge &e : graph.edges) {
+        successors[e.predecessor].append(qMakePair(e.successor, e.distance));
+        ++inDegree[e.successor];
+    }
+    QVector<int> columns(count, 0);
+    QVector<int> queue;
+    queue.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        if (inDegree.at(i) == 0) {
+            queue.append(i);
+        }
+    }
+    for (int i = 0; i < queue.count(); ++i) {
+        const int node = queue.at(i);
+        const auto &list = successors.at(node);
+        for (const auto &s : list) {
+            columns[s.first] = qMax(columns.at(s.first), columns.at(node) + s.second);
+            if (--inDegree[s.first] == 0) {
+                queue.append(s.first);
+            }
+        }
+    }
+    // Nodes in a cycle (should not happen) keep the columns found so far
+    return columns;
+}
@@ -0,0 +1,64 @@
+/* This file is part of the KDE project
+ * SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#ifndef DEPENDENCYLAYOUT_H
+#define DEPENDENCYLAYOUT_H
+
+#include "planui_export.h"
+
+#include "kptrelation.h"
+
+#include <QVector>
+
+namespace KPlato
+{
+
+/**
+ * Column layout of the dependency editor.
+ *
+ * The rows of the dependency editor follow the WBS, so only the columns are calculated.
+ * A node is placed in the column after its parent, and not before the column of
+ * its predecessors. A finish-start relation moves the successor one column further.
+ *
+ * The graph is a plain copy of the items, so the layout can be calculated in another thread.
+ */
+class PLANUI_EXPORT DependencyLayout
+{
+public:
+    struct Edge {
+        int predecessor;
+        int successor;
+        /// Number of columns from the predecessor to the successor
+        int distance;
+
+        bool operator==(const Edge &other) const {
+            return predecessor == other.predecessor && successor == other.successor && distance == other.distance;
+        }
+    };
+
+    struct Graph {
+        /// The index of the parent of each node, -1 if the node is at top level
+        QVector<int> parents;
+        QVector<Edge> edges;
+
+        bool operator==(const Graph &other) const {
+            return parents == other.parents && edges == other.edges;
+        }
+        bool operator!=(const Graph &other) const { return !operator==(other); }
+    };
+
+    /// Return the number of columns from the predecessor to the successor of a relation of @p type
+    static int distance(Relation::Type type);
+
+    /// Return the column of each node in @p graph
+    static QVector<int> columns(const Graph &graph);
+};
+
+} // namespace KPlato
+
+Q_DECLARE_TYPEINFO(KPlato::DependencyLayout::Edge, Q_PRIMITIVE_TYPE);
+
+#endif
@@ -10,6 +10,7 @@
 #include "kptnodeitemmodel.h"
 #include "kptnode.h"
 #include "kptresourceappointmentsmodel.h"
+#include "TimePhasedCache.h"
 #include "kptdebug.h"
 
 #include <QModelIndex>
@@ -24,6 +25,7 @@
 #include <KGanttStyleOptionGanttItem>
 #include <KGanttConstraint>
 #include <KGanttAbstractGrid>
+#include <KGanttDateTimeGrid>
 
 /// The main namespace
 namespace KPlato
@@ -995,6 +997,20 @@ void ResourceGanttItemDelegate::paintResourceItem(QPainter* painter, const KGant
     pen.setColor(textColor);
     painter->setPen(pen);
 
+    // When zoomed out, paint the effort per period from the time-phased cache,
+    // so a multi-year overview does not have to walk every interval
+    const KGantt::DateTimeGrid *grid = qobject_cast<const KGantt::DateTimeGrid*>(opt.grid);
+    const TimePhasedEffort effort = idx.data(Role::TimePhased).value<TimePhasedEffort>();
+    if (grid && effort.isValid() && grid->dayWidth() < 24.) {
+        painter->save();
+        paintResourceEffort(painter, opt, r, x0, effort);
+        painter->restore();
+        if (!opt.text.isEmpty()) {
+            const Qt::Alignment ta = qAlignment(opt.displayPosition);
+            painter->drawText(boundingRect, ta, opt.text);
+        }
+        return;
+    }
     Appointment *tot = static_cast<Appointment*>(idx.data(Role::InternalAppointments).value<void*>());
     Q_ASSERT(tot);
     int rl = idx.data(Role::Maximum).toInt(); //TODO check calendar
@@ -1028,4 +1044,48 @@ void ResourceGanttItemDelegate::paintResourceItem(QPainter* painter, const KGant
     }
 }
 
+void ResourceGanttItemDelegate::paintResourceEffort(QPainter* painter, const KGantt::StyleOptionGanttItem& opt, const QRectF &rect, qreal x0, const TimePhasedEffort &effort)
+{
+    const KGantt::DateTimeGrid *grid = qobject_cast<const KGantt::DateTimeGrid*>(opt.grid);
+    // the finest resolution that still gives a visible bar per period
+    const qreal minWidth = 6.;
+    TimePhasedCache::Resolution resolution = TimePhasedCache::Quarter;
+    if (grid->dayWidth() >= minWidth) {
+        resolution = TimePhasedCache::Day;
+    } else if (grid->dayWidth() * 7 >= minWidth) {
+        resolution = TimePhasedCache::Week;
+    } else if (grid->dayWidth() * 28 >= minWidth) {
+        resolution = TimePhasedCache::Month;
+    }
+    // only the exposed periods are painted
+    QDate first = effort.startDate();
+    QDate last = effort.endDate();
+    if (opt.exposedRect.isValid()) {
+        const QDateTime left = grid->mapFromChart(x0 + opt.exposedRect.left()).toDateTime();
+        const QDateTime right = grid->mapFromChart(x0 + opt.exposedRect.right()).toDateTime();
+        if (left.isValid() && left.date() > first) {
+            first = left.date();
+        }
+        if (right.isValid() && right.date() < last) {
+            last = right.date();
+        }
+    }
+    QLocale locale;
+    painter->setBrush(defaultBrush(KGantt::TypeTask));
+    for (QDate d = TimePhasedCache::periodStart(first, resolution); d.isValid() && d <= last; d = TimePhasedCache::nextPeriodStart(d, resolution)) {
+        const Duration e = effort.effort(d, resolution);
+        if (e == Duration::zeroDuration) {
+            continue;
+        }
+        const qreal v1 = grid->mapToChart(d.startOfDay());
+        const qreal v2 = grid->mapToChart(TimePhasedCache::nextPeriodStart(d, resolution).startOfDay());
+        QRectF rr(v1 - x0, rect.y(), v2 - v1, rect.height());
+        painter->drawRect(rr);
+        const QString txt = locale.toString(e.toDouble(Duration::Unit_h), 'f', 1);
+        if (painter->boundingRect(rr, Qt::AlignCenter, txt).width() < rr.width()) {
+            painter->drawText(rr, Qt::AlignCenter, txt);
+        }
+    }
+}
+
 } // namespace KPlato
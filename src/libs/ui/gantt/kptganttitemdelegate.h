@@ -28,6 +28,8 @@ class QModelIndex;
 namespace KPlato
 {
 
+class TimePhasedEffort;
+
 class PLANUI_EXPORT GanttItemDelegate : public KGantt::ItemDelegate
 {
     Q_OBJECT
@@ -88,6 +90,8 @@ public:
 
 protected:
     void paintResourceItem(QPainter* painter, const KGantt::StyleOptionGanttItem& opt, const QModelIndex& idx);
+    /// Paint the effort per period of @p effort, the resolution follows the zoom level of the grid
+    void paintResourceEffort(QPainter* painter, const KGantt::StyleOptionGanttItem& opt, const QRectF &rect, qreal x0, const TimePhasedEffort &effort);
 
 private:
     Q_DISABLE_COPY(ResourceGanttItemDelegate)
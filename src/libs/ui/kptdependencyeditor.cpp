@@ -43,6 +43,7 @@
 #include <QKeyEvent>
 #include <QAction>
 #include <QMenu>
+#include <QtConcurrent>
 
 #include <KLocalizedString>
 #include <KActionMenu>
@@ -288,12 +289,17 @@ DependencyLinkItem::DependencyLinkItem(DependencyNodeItem *predecessor, Dependen
     //debugPlanDepEditor<<predecessor->text()<<"("<<predecessor->column()<<") -"<<successor->text();
     predItem->addChildRelation(this);
     succItem->addParentRelation(this);
-    succItem->setColumn();
+    if (predItem->itemScene()) {
+        predItem->itemScene()->scheduleLayout();
+    }
 
 }
 
 DependencyLinkItem::~DependencyLinkItem()
 {
+    if (itemScene()) {
+        itemScene()->linkToBeRemoved(this);
+    }
     if (predItem) {
         predItem->takeChildRelation(this);
     }
@@ -302,16 +308,6 @@ DependencyLinkItem::~DependencyLinkItem()
     }
 }
 
-int DependencyLinkItem::newChildColumn() const
-{
-    int col = predItem->column();
-    if (relation->type() == Relation::FinishStart) {
-        ++col;
-    }
-    //debugPlanDepEditor<<"new col="<<col;
-    return col;
-}
-
 void DependencyLinkItem::setItemVisible(bool show)
 {
     setVisible(show && predItem->isVisible() && succItem->isVisible());
@@ -866,6 +862,9 @@ void DependencyNodeItem::moveToY(qreal y)
     r. moveTop(y);
     setRectangle(r);
     //debugPlanDepEditor<<text()<<" move to="<<y<<" new pos:"<<rect();
+    if (itemScene()->isCreatingItems()) {
+        return; // paths and tree indicators are updated in endCreateItems()
+    }
     for (DependencyLinkItem *i : qAsConst(m_parentrelations)) {
         i->createPath();
     }
@@ -895,6 +894,9 @@ void DependencyNodeItem::moveToX(qreal x)
     r. moveLeft(x);
     setRectangle(r);
     //debugPlanDepEditor<<m_text->toPlainText()<<" to="<<x<<" new pos:"<<rect();
+    if (itemScene()->isCreatingItems()) {
+        return; // paths and tree indicators are updated in endCreateItems()
+    }
     for (DependencyLinkItem *i : qAsConst(m_parentrelations)) {
         i->createPath();
     }
@@ -908,25 +910,6 @@ void DependencyNodeItem::moveToX(qreal x)
     par->setTreeIndicator(true);
 }
 
-void DependencyNodeItem::setColumn()
-{
-    int col = m_parent == nullptr ? 0 : m_parent->column() + 1;
-    //debugPlanDepEditor<<this<<text();
-    for (DependencyLinkItem *i : qAsConst(m_parentrelations)) {
-        col = qMax(col, i->newChildColumn());
-    }
-    if (col != column()) {
-        setColumn(col);
-        for (DependencyLinkItem *i : qAsConst(m_childrelations)) {
-            i->succItem->setColumn();
-        }
-        //debugPlanDepEditor<<m_children.count()<<"Column="<<column()<<","<<text();
-        for (DependencyNodeItem *i : qAsConst(m_children)) {
-            i->setColumn();
-        }
-    }
-}
-
 void DependencyNodeItem::setColumn(int col)
 {
     moveToX(itemScene()->itemX(col));
@@ -944,7 +927,9 @@ DependencyLinkItem *DependencyNodeItem::takeParentRelation(DependencyLinkItem *r
         return nullptr;
     }
     DependencyLinkItem *dep = m_parentrelations.takeAt(i);
-    setColumn();
+    if (itemScene()) {
+        itemScene()->scheduleLayout();
+    }
     return dep;
 }
 
@@ -1165,7 +1150,8 @@ void DependencyNodeSymbolItem::paint(Project *project, QPainter *painter, const
 DependencyScene::DependencyScene(QWidget *parent)
     : QGraphicsScene(parent),
     m_model(nullptr),
-    m_readwrite(false)
+    m_readwrite(false),
+    m_creatingItems(false)
 {
     setSceneRect(QRectF());
     m_connectionitem = new DependencyCreatorItem();
@@ -1173,6 +1159,11 @@ DependencyScene::DependencyScene(QWidget *parent)
     //debugPlanDepEditor;
     m_connectionitem->hide();
     connect(qApp, &QApplication::paletteChanged, this, &DependencyScene::update);
+
+    m_layoutTimer.setSingleShot(true);
+    m_layoutTimer.setInterval(0);
+    connect(&m_layoutTimer, &QTimer::timeout, this, &DependencyScene::startLayout);
+    connect(&m_layoutWatcher, &QFutureWatcher<QVector<int>>::finished, this, &DependencyScene::slotLayoutFinished);
 }
 
 DependencyScene::~DependencyScene()
@@ -1303,6 +1294,8 @@ void DependencyScene::clearScene()
     qDeleteAll(its);
     removeItem(m_connectionitem);
     qDeleteAll(this->items());
+    m_nodeItems.clear();
+    m_linkItems.clear();
     setSceneRect(QRectF());
     addItem(m_connectionitem);
     //debugPlanDepEditor;
@@ -1338,15 +1331,14 @@ void DependencyScene::moveItem(DependencyNodeItem *item, const QList<Node*> &lst
         m_allItems.removeAt(idx);
         m_allItems.insert(ndx, item);
         item->setParentItem(m_allItems.value(lst.indexOf(newParent)));
-        item->setColumn();
         //debugPlanDepEditor<<item->text()<<":"<<idx<<"->"<<ndx<<", "<<item->column()<<r;
         if (! items.isEmpty()) {
             for (DependencyNodeItem *i : items) {
                 m_allItems.insert(++ndx, i);
-                i->setColumn();
                 //debugPlanDepEditor<<i->text()<<": ->"<<ndx<<", "<<i->column()<<r;
             }
         }
+        scheduleLayout();
     }
 }
 
@@ -1362,6 +1354,11 @@ void DependencyScene::setItemVisible(DependencyNodeItem *item, bool show)
     if (show && CONTAINS(m_hiddenItems, item)) {
         moveItem(item, m_project->flatNodeList()); // might have been moved
     }
+    updateItemRows();
+}
+
+void DependencyScene::updateItemRows()
+{
     m_hiddenItems.clear();
     m_visibleItems.clear();
     int viewrow = 0;
@@ -1402,8 +1399,9 @@ DependencyNodeItem *DependencyScene::createItem(Node *node)
     if (parent && !parent->isExpanded()) {
         parent->setExpanded(true);
     }
-    DependencyNodeItem *after = itemBefore(parent, node);
     int i = m_allItems.count()-1;
+    // when creating all items they are created in order
+    DependencyNodeItem *after = m_creatingItems ? nullptr : itemBefore(parent, node);
     if (after) {
         i = m_allItems.indexOf(after);
         //debugPlanDepEditor<<"after="<<after->node()->name()<<" pos="<<i;
@@ -1422,28 +1420,47 @@ DependencyNodeItem *DependencyScene::createItem(Node *node)
     }
     item->setRectangle(QRectF(itemX(col), itemY(), itemWidth(), itemHeight()));
     m_allItems.insert(i+1, item);
-    setItemVisible(item, true);
+    m_nodeItems.insert(node, item);
+    if (m_creatingItems) {
+        item->setItemVisible(true);
+    } else {
+        setItemVisible(item, true);
+    }
     return item;
 }
 
-DependencyLinkItem *DependencyScene::findItem(const Relation* rel) const
+void DependencyScene::beginCreateItems()
 {
-    const QList<QGraphicsItem*> items = itemList(DependencyLinkItem::Type);
-    for (QGraphicsItem *i : items) {
-        if (static_cast<DependencyLinkItem*>(i)->relation == rel) {
-            return static_cast<DependencyLinkItem*>(i);
+    m_creatingItems = true;
+}
+
+void DependencyScene::endCreateItems()
+{
+    updateItemRows();
+    layoutItems();
+    m_creatingItems = false;
+    for (DependencyLinkItem *i : qAsConst(m_linkItems)) {
+        i->createPath();
+    }
+    for (DependencyNodeItem *i : qAsConst(m_allItems)) {
+        if (i->parentItem() == nullptr && i->isVisible()) {
+            i->setTreeIndicator(true);
         }
     }
-    return nullptr;
+}
+
+DependencyLinkItem *DependencyScene::findItem(const Relation* rel) const
+{
+    return m_linkItems.value(rel);
 }
 
 DependencyLinkItem *DependencyScene::findItem(const DependencyConnectorItem *c1, const DependencyConnectorItem *c2, bool exact) const
 {
     DependencyNodeItem *n1 = c1->nodeItem();
     DependencyNodeItem *n2 = c2->nodeItem();
-    const QList<QGraphicsItem*> items = itemList(DependencyLinkItem::Type);
-    for (QGraphicsItem *i : items) {
-        DependencyLinkItem *link = static_cast<DependencyLinkItem*>(i);
+    // a link between n1 and n2 is one of the relations of n1
+    const QList<DependencyLinkItem*> items = n1->childRelations() + n1->parentRelations();
+    for (DependencyLinkItem *link : items) {
         if (link->predItem == n1 && link->succItem == n2) {
             switch (link->relation->type()) {
                 case Relation::StartStart:
@@ -1497,18 +1514,15 @@ DependencyLinkItem *DependencyScene::findItem(const DependencyConnectorItem *c1,
 
 DependencyNodeItem *DependencyScene::findItem(const Node *node) const
 {
-    const QList<QGraphicsItem*> items = itemList(DependencyNodeItem::Type);
-    for (QGraphicsItem *i : items) {
-        if (static_cast<DependencyNodeItem*>(i)->node() == node) {
-            return static_cast<DependencyNodeItem*>(i);
-        }
-    }
-    return nullptr;
+    return m_nodeItems.value(node);
 }
 
 void DependencyScene::itemToBeRemoved(DependencyNodeItem *item, DependencyNodeItem *parentItem)
 {
     if (item) {
+        if (m_nodeItems.value(item->node()) == item) {
+            m_nodeItems.remove(item->node());
+        }
         m_allItems.removeAll(item);
         m_hiddenItems.remove(m_hiddenItems.key(item));
         m_visibleItems.remove(m_visibleItems.key(item));
@@ -1526,6 +1540,87 @@ void DependencyScene::itemToBeRemoved(DependencyNodeItem *item, DependencyNodeIt
     removeItem(item);
 }
 
+void DependencyScene::scheduleLayout()
+{
+    if (!m_creatingItems) {
+        m_layoutTimer.start();
+    }
+}
+
+void DependencyScene::layoutItems()
+{
+    m_layoutTimer.stop();
+    const auto graph = layoutGraph();
+    if (graph != m_layoutGraph || m_layoutColumns.count() != graph.parents.count()) {
+        m_layoutGraph = graph;
+        m_layoutColumns = DependencyLayout::columns(graph);
+    }
+    applyLayout(m_layoutColumns);
+}
+
+void DependencyScene::startLayout()
+{
+    if (m_layoutWatcher.isRunning()) {
+        return; // slotLayoutFinished() restarts
+    }
+    const auto graph = layoutGraph();
+    if (graph == m_layoutGraph && m_layoutColumns.count() == graph.parents.count()) {
+        // nothing has changed since the last layout
+        applyLayout(m_layoutColumns);
+        return;
+    }
+    m_layoutGraph = graph;
+    m_layoutColumns.clear();
+    m_layoutWatcher.setFuture(QtConcurrent::run(&DependencyLayout::columns, graph));
+}
+
+void DependencyScene::slotLayoutFinished()
+{
+    m_layoutColumns = m_layoutWatcher.result();
+    // applies the result if the items are unchanged, else calculates a new layout
+    startLayout();
+}
+
+DependencyLayout::Graph DependencyScene::layoutGraph() const
+{
+    DependencyLayout::Graph graph;
+    QHash<const DependencyNodeItem*, int> index;
+    index.reserve(m_allItems.count());
+    for (int i = 0; i < m_allItems.count(); ++i) {
+        index.insert(m_allItems.at(i), i);
+    }
+    graph.parents.reserve(m_allItems.count());
+    for (const DependencyNodeItem *item : qAsConst(m_allItems)) {
+        graph.parents.append(index.value(item->parentItem(), -1));
+        const QList<DependencyLinkItem*> relations = item->childRelations();
+        for (const DependencyLinkItem *link : relations) {
+            const int successor = index.value(link->succItem, -1);
+            if (successor >= 0) {
+                graph.edges.append({ index.value(item), successor, DependencyLayout::distance(link->relation->type()) });
+            }
+        }
+    }
+    return graph;
+}
+
+void DependencyScene::applyLayout(const QVector<int> &columns)
+{
+    Q_ASSERT(columns.count() == m_allItems.count());
+    for (int i = 0; i < m_allItems.count(); ++i) {
+        DependencyNodeItem *item = m_allItems.at(i);
+        if (item->column() != columns.at(i)) {
+            item->setColumn(columns.at(i));
+        }
+    }
+}
+
+void DependencyScene::linkToBeRemoved(DependencyLinkItem *item)
+{
+    if (m_linkItems.value(item->relation) == item) {
+        m_linkItems.remove(item->relation);
+    }
+}
+
 void DependencyScene::createLinks()
 {
     for (DependencyNodeItem *i : qAsConst(m_allItems)) {
@@ -1539,17 +1634,21 @@ void DependencyScene::createLinks(DependencyNodeItem *item)
         createLink(item, rel);
     }
 }
-void DependencyScene::createLink(DependencyNodeItem *parent, Relation *rel)
+DependencyLinkItem *DependencyScene::createLink(DependencyNodeItem *parent, Relation *rel)
 {
     DependencyNodeItem *child = findItem(rel->child());
     if (parent == nullptr || child == nullptr) {
-        return;
+        return nullptr;
     }
     DependencyLinkItem *dep = new DependencyLinkItem(parent, child, rel);
     dep->setEditable(m_readwrite);
     addItem(dep);
+    m_linkItems.insert(rel, dep);
     //debugPlanDepEditor;
-    dep->createPath();
+    if (!m_creatingItems) {
+        dep->createPath();
+    }
+    return dep;
 }
 
 void DependencyScene::mouseMoveEvent(QGraphicsSceneMouseEvent *mouseEvent)
@@ -1974,13 +2073,10 @@ void DependencyView::slotRelationAdded(Relation* rel)
     }
     DependencyLinkItem *item = findItem(rel);
     if (item == nullptr) {
-        DependencyNodeItem *p = findItem(rel->parent());
-        DependencyNodeItem *c = findItem(rel->child());
-        DependencyLinkItem *r = new DependencyLinkItem(p, c, rel);
-        scene()->addItem(r);
-        //debugPlanDepEditor;
-        r->createPath();
-        r->setVisible(c->isVisible() && p->isVisible());
+        DependencyLinkItem *r = itemScene()->createLink(findItem(rel->parent()), rel);
+        if (r) {
+            r->setItemVisible(true);
+        }
     } else debugPlanDepEditor<<"Relation already exists!";
 }
 
@@ -1991,8 +2087,7 @@ void DependencyView::slotRelationRemoved(Relation* rel)
     }
     DependencyLinkItem *item = findItem(rel);
     if (item) {
-        scene()->removeItem(item);
-        delete item;
+        delete item; // removes itself from the scene
     } else debugPlanDepEditor<<"Relation does not exist!";
 }
 
@@ -2082,9 +2177,11 @@ void DependencyView::createItems()
         return;
     }
     scene()->addLine(0.0, 0.0, 1.0, 0.0);
+    itemScene()->beginCreateItems();
     createItems(m_project);
 
     createLinks();
+    itemScene()->endCreateItems();
 }
 
 DependencyNodeItem *DependencyView::createItem(Node *node)
@@ -15,6 +15,7 @@
 #include "kptviewbase.h"
 #include "kptnode.h"
 #include "gantt/kptganttitemdelegate.h"
+#include "DependencyLayout.h"
 
 #include <KGanttGlobal>
 
@@ -22,6 +23,8 @@
 #include <QGraphicsItem>
 #include <QGraphicsTextItem>
 #include <QTimer>
+#include <QHash>
+#include <QFutureWatcher>
 
 #include <KPageDialog>
 
@@ -94,9 +97,6 @@ public:
     enum { Type = QGraphicsItem::UserType + 11 };
     int type() const override { return Type; }
 
-
-    int newChildColumn() const;
-
     using DependencyLinkItemBase::createPath;
     void createPath() override;
     QPointF startPoint() const override;
@@ -181,7 +181,6 @@ public:
 
     void setRow(int row);
     int row() const;
-    void setColumn();
     void setColumn(int column);
     int column() const;
 
@@ -368,11 +367,22 @@ public:
     DependencyNodeItem *itemBefore(DependencyNodeItem *parent, Node *node) const;
     DependencyNodeItem *createItem(Node *node);
 
+    /// Create items for a complete project between beginCreateItems() and endCreateItems().
+    /// Rows, link paths and tree indicators are updated once in endCreateItems().
+    void beginCreateItems();
+    void endCreateItems();
+    bool isCreatingItems() const { return m_creatingItems; }
+
     void setItemVisible(DependencyNodeItem *item, bool show);
 
+    /// Calculate the item columns in a worker thread when control returns to the event loop
+    void scheduleLayout();
+    /// Calculate the item columns now
+    void layoutItems();
+
     void createLinks();
     void createLinks(DependencyNodeItem *item);
-    void createLink(DependencyNodeItem *parent, Relation *rel);
+    DependencyLinkItem *createLink(DependencyNodeItem *parent, Relation *rel);
 
     void connectorEntered(DependencyConnectorItem *item, bool entered);
     void setFromItem(DependencyConnectorItem *item);
@@ -394,6 +404,7 @@ public:
     void setReadWrite(bool on);
 
     void itemToBeRemoved(DependencyNodeItem *item, DependencyNodeItem *parentItem = nullptr);
+    void linkToBeRemoved(DependencyLinkItem *item);
 
 Q_SIGNALS:
     void connectorClicked(KPlato::DependencyConnectorItem *item);
@@ -404,6 +415,8 @@ Q_SIGNALS:
 
 protected Q_SLOTS:
     void update();
+    void startLayout();
+    void slotLayoutFinished();
 
 protected:
     void drawBackground (QPainter * painter, const QRectF & rect) override;
@@ -413,13 +426,26 @@ protected:
     void keyPressEvent (QKeyEvent *keyEvent) override;
     void contextMenuEvent (QGraphicsSceneContextMenuEvent *contextMenuEvent) override;
 
+    void updateItemRows();
+    DependencyLayout::Graph layoutGraph() const;
+    void applyLayout(const QVector<int> &columns);
+
 private:
     Project *m_project;
     NodeItemModel *m_model;
     bool m_readwrite;
+    bool m_creatingItems;
     QList<DependencyNodeItem*> m_allItems;
     QMap<int, DependencyNodeItem*> m_visibleItems;
     QMap<int, DependencyNodeItem*> m_hiddenItems;
+    QHash<const Node*, DependencyNodeItem*> m_nodeItems;
+    QHash<const Relation*, DependencyLinkItem*> m_linkItems;
+
+    QTimer m_layoutTimer;
+    QFutureWatcher<QVector<int>> m_layoutWatcher;
+    /// The graph of the last layout, m_layoutColumns is valid if it has the same size
+    DependencyLayout::Graph m_layoutGraph;
+    QVector<int> m_layoutColumns;
     DependencyCreatorItem *m_connectionitem;
 
     QList<DependencyConnectorItem*> m_clickedItems;
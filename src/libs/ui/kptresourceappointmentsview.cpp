@@ -36,6 +36,8 @@
 #include <KLocalizedString>
 #include <KActionCollection>
 
+#include <QComboBox>
+#include <QFormLayout>
 #include <QList>
 #include <QVBoxLayout>
 #include <QTabWidget>
@@ -54,6 +56,18 @@ ResourceAppointmentsConfigDialog::ResourceAppointmentsConfigDialog(ViewBase *vie
 
     QTabWidget *tab = new QTabWidget();
 
+    QWidget *columns = new QWidget();
+    columns->setWindowTitle(i18n("Columns"));
+    QFormLayout *form = new QFormLayout(columns);
+    QComboBox *resolution = new QComboBox(columns);
+    resolution->addItem(i18nc("@item:inlistbox", "Day"), TimePhasedCache::Day);
+    resolution->addItem(i18nc("@item:inlistbox", "Week"), TimePhasedCache::Week);
+    resolution->addItem(i18nc("@item:inlistbox", "Month"), TimePhasedCache::Month);
+    resolution->addItem(i18nc("@item:inlistbox", "Quarter"), TimePhasedCache::Quarter);
+    resolution->setCurrentIndex(resolution->findData(treeview->model()->resolution()));
+    form->addRow(i18nc("@label:listbox", "Bookings per:"), resolution);
+    tab->addTab(columns, columns->windowTitle());
+
     QWidget *w = ViewBase::createPageLayoutWidget(view);
     tab->addTab(w, w->windowTitle());
     m_pagelayout = w->findChild<KoPageLayoutWidget*>();
@@ -68,7 +82,8 @@ ResourceAppointmentsConfigDialog::ResourceAppointmentsConfigDialog(ViewBase *vie
     if (selectPrint) {
         setCurrentPage(page);
     }
-    connect(this, &QDialog::accepted, this, [this]() {
+    connect(this, &QDialog::accepted, this, [this, resolution]() {
+        m_treeview->model()->setResolution(static_cast<TimePhasedCache::Resolution>(resolution->currentData().toInt()));
         m_view->setPageLayout(m_pagelayout->pageLayout());
         m_view->setPrintingOptions(m_headerfooter->options());
     });
@@ -96,6 +111,7 @@ ResourceAppointmentsTreeView::ResourceAppointmentsTreeView(QWidget *parent)
 bool ResourceAppointmentsTreeView::loadContext(const KoXmlElement &context)
 {
     debugPlan;
+    model()->setResolution(static_cast<TimePhasedCache::Resolution>(context.attribute(QStringLiteral("resolution"), QStringLiteral("0")).toInt()));
     DoubleTreeViewBase::loadContext(QMetaEnum(), context);
     return true;
 }
@@ -103,6 +119,7 @@ bool ResourceAppointmentsTreeView::loadContext(const KoXmlElement &context)
 void ResourceAppointmentsTreeView::saveContext(QDomElement &settings) const
 {
     debugPlan;
+    settings.setAttribute(QStringLiteral("resolution"), model()->resolution());
     DoubleTreeViewBase::saveContext(QMetaEnum(), settings);
 }
 
@@ -0,0 +1,103 @@
+/* This file is part of the KDE project
+   SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+// clazy:excludeall=qstring-arg
+#include "DependencyLayoutTester.h"
+
+#include "DependencyLayout.h"
+
+#include <QTest>
+
+#include <algorithm>
+
+namespace KPlato
+{
+
+static DependencyLayout::Edge edge(int predecessor, int successor, Relation::Type type)
+{
+    return { predecessor, successor, DependencyLayout::distance(type) };
+}
+
+void DependencyLayoutTester::parents()
+{
+    DependencyLayout::Graph graph;
+    QCOMPARE(DependencyLayout::columns(graph), QVector<int>());
+
+    // 0
+    //   1
+    //     2
+    //   3
+    // 4
+    graph.parents = { -1, 0, 1, 0, -1 };
+    QCOMPARE(DependencyLayout::columns(graph), QVector<int>({ 0, 1, 2, 1, 0 }));
+}
+
+void DependencyLayoutTester::relations()
+{
+    QCOMPARE(DependencyLayout::distance(Relation::FinishStart), 1);
+    QCOMPARE(DependencyLayout::distance(Relation::StartStart), 0);
+    QCOMPARE(DependencyLayout::distance(Relation::FinishFinish), 0);
+
+    DependencyLayout::Graph graph;
+    graph.parents = { -1, -1, -1, -1 };
+    graph.edges = { edge(0, 1, Relation::FinishStart), edge(1, 2, Relation::StartStart), edge(2, 3, Relation::FinishFinish) };
+    QCOMPARE(DependencyLayout::columns(graph), QVector<int>({ 0, 1, 1, 1 }));
+
+    // a child is placed after its parent and after its predecessors
+    graph.parents = { -1, -1, 1 };
+    graph.edges = { edge(0, 2, Relation::FinishStart) };
+    QCOMPARE(DependencyLayout::columns(graph), QVector<int>({ 0, 0, 1 }));
+    graph.edges = { edge(0, 1, Relation::FinishStart), edge(1, 2, Relation::FinishStart) };
+    QCOMPARE(DependencyLayout::columns(graph), QVector<int>({ 0, 1, 2 }));
+}
+
+void DependencyLayoutTester::longestPath()
+{
+    // 0 -FS-> 1 -FS-> 2 -SS-> 4
+    // 0 -SS-> 3 -FS-> 4
+    // 0 -FF-> 4
+    DependencyLayout::Graph graph;
+    graph.parents = { -1, -1, -1, -1, -1 };
+    graph.edges = {
+        edge(0, 1, Relation::FinishStart),
+        edge(1, 2, Relation::FinishStart),
+        edge(2, 4, Relation::StartStart),
+        edge(0, 3, Relation::StartStart),
+        edge(3, 4, Relation::FinishStart),
+        edge(0, 4, Relation::FinishFinish)
+    };
+    QCOMPARE(DependencyLayout::columns(graph), QVector<int>({ 0, 1, 2, 0, 2 }));
+
+    // the order of the edges does not matter
+    std::reverse(graph.edges.begin(), graph.edges.end());
+    QCOMPARE(DependencyLayout::columns(graph), QVector<int>({ 0, 1, 2, 0, 2 }));
+}
+
+void DependencyLayoutTester::cycle()
+{
+    // 0 -FS-> 1 -FS-> 2 -FS-> 1, 2 -FS-> 3, and 4 is not related
+    DependencyLayout::Graph graph;
+    graph.parents = { -1, -1, -1, -1, -1 };
+    graph.edges = {
+        edge(0, 1, Relation::FinishStart),
+        edge(1, 2, Relation::FinishStart),
+        edge(2, 1, Relation::FinishStart),
+        edge(2, 3, Relation::FinishStart)
+    };
+    // the nodes in and after the cycle keep the columns found before it
+    const QVector<int> columns = DependencyLayout::columns(graph);
+    QCOMPARE(columns.count(), 5);
+    QCOMPARE(columns, QVector<int>({ 0, 1, 0, 0, 0 }));
+
+    // a node that is its own predecessor
+    graph.parents = { -1, -1 };
+    graph.edges = { edge(0, 0, Relation::StartStart), edge(0, 1, Relation::FinishStart) };
+    QCOMPARE(DependencyLayout::columns(graph), QVector<int>({ 0, 0 }));
+}
+
+} //namespace KPlato
+
+QTEST_GUILESS_MAIN(KPlato::DependencyLayoutTester)
@@ -0,0 +1,27 @@
+/* This file is part of the KDE project
+   SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KPlato_DependencyLayoutTester_h
+#define KPlato_DependencyLayoutTester_h
+
+#include <QObject>
+
+namespace KPlato
+{
+
+class DependencyLayoutTester : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void parents();
+    void relations();
+    void longestPath();
+    void cycle();
+};
+
+} //namespace KPlato
+
+#endif
@@ -6,8 +6,6 @@
 
 // clazy:excludeall=qstring-arg
 #include "kptbuiltinschedulerplugin.h"
-#include "kptmaindocument.h"
-#include "kptpart.h"
 
 #include "kptproject.h"
 #include "kptschedule.h"
@@ -116,11 +114,15 @@ void BuiltinSchedulerPlugin::slotFinished(SchedulerThread *job)
 void BuiltinSchedulerPlugin::schedule(SchedulingContext &context)
 {
     KPlatoScheduler *job = new KPlatoScheduler();
+    m_jobsMutex.lock();
     m_jobs << job;
+    m_jobsMutex.unlock();
     context.scheduleInParallel = scheduleInParallel();
     connect(job, &KPlato::KPlatoScheduler::progressChanged, this, &KPlato::SchedulerPlugin::progressChanged);
     job->schedule(context);
+    m_jobsMutex.lock();
     m_jobs.clear();
+    m_jobsMutex.unlock();
     delete job;
 }
 
@@ -152,13 +154,9 @@ void KPlatoScheduler::stopScheduling()
 
 void KPlatoScheduler::cancelScheduling(SchedulingContext &context)
 {
+    // The projects are owned by the scheduling thread,
+    // it polls the flag and stops the calculation, see slotProgress()
     context.cancelScheduling = true;
-    for (const auto doc : qAsConst(context.calculatedDocuments)) {
-        doc->project()->stopcalculation = true;
-        if (doc->project()->currentScheduleManager()) {
-            doc->project()->currentScheduleManager()->setCalculationResult(KPlato::ScheduleManager::CalculationCanceled);
-        }
-    }
 }
 
 void KPlatoScheduler::run()
@@ -197,6 +195,8 @@ void KPlatoScheduler::run()
 
     bool x = connect(m_manager, SIGNAL(sigLogAdded(KPlato::Schedule::Log)), this, SLOT(slotAddLog(KPlato::Schedule::Log)));
     Q_ASSERT(x); Q_UNUSED(x);
+    x = connect(m_manager, SIGNAL(sigLogsAdded(QVector<KPlato::Schedule::Log>)), this, SLOT(slotAddLogs(QVector<KPlato::Schedule::Log>)));
+    Q_ASSERT(x);
     m_project->calculate(*m_manager);
     if (m_haltScheduling) {
         deleteLater();
@@ -206,23 +206,13 @@ void KPlatoScheduler::run()
 void KPlatoScheduler::slotProgress(int value)
 {
     Q_UNUSED(value)
+    if (m_calculatingProject && m_context && m_context->cancelScheduling) {
+        m_calculatingProject->stopcalculation = true;
+    }
     ++m_progress;
     Q_EMIT progressChanged(m_progress * 100 / m_maxprogress);
 }
 
-KoDocument *KPlatoScheduler::copyDocument(KoDocument *doc)
-{
-    auto part = new Part(nullptr);
-    auto copy = new MainDocument(part);
-    auto domDoc = doc->saveXML();
-    auto xml = KoXmlDocument();
-    xml.setContent(domDoc.toString());
-    copy->loadXML(xml, nullptr);
-    copy->setProperty(SCHEDULEMANAGERNAME, doc->property(SCHEDULEMANAGERNAME));
-    copy->project()->setProperty(SCHEDULEMANAGERNAME, doc->project()->property(SCHEDULEMANAGERNAME));
-    return copy;
-}
-
 void KPlatoScheduler::schedule(SchedulingContext &context)
 {
     if (context.projects.isEmpty()) {
@@ -230,15 +220,17 @@ void KPlatoScheduler::schedule(SchedulingContext &context)
         logError(context.project, nullptr, QStringLiteral("No projects to schedule"));
         return;
     }
-    QHash<KoDocument*, KoDocument*> projectMap;
+    m_context = &context;
+    // The documents are private copies made by the caller,
+    // so they are calculated in place and merged by the caller
+    QList<KoDocument*> documents;
     QMapIterator<int, KoDocument*> it(context.projects);
     for (it.toBack(); it.hasPrevious();) {
-        context.calculatedDocuments << copyDocument(it.previous().value());
-        projectMap.insert(context.calculatedDocuments.last(), it.value());
+        documents << it.previous().value();
     }
 
     int taskCount = 0;
-    for (const auto doc : qAsConst(context.calculatedDocuments)) {
+    for (const auto doc : qAsConst(documents)) {
         auto p = doc->project();
         connect(p, &KPlato::Project::sigProgress, this, &KPlato::KPlatoScheduler::slotProgress);
         taskCount += p->leafNodes().count();
@@ -254,7 +246,7 @@ void KPlatoScheduler::schedule(SchedulingContext &context)
     }
 
     auto includes = context.resourceBookings;
-    for (auto doc : qAsConst(context.calculatedDocuments)) {
+    for (auto doc : qAsConst(documents)) {
         calculateProject(context, doc, includes);
         if (!context.cancelScheduling) {
             includes << doc;
@@ -264,12 +256,9 @@ void KPlatoScheduler::schedule(SchedulingContext &context)
         takeLog();
         logWarning(context.project, nullptr, i18n("Scheduling canceled"));
     } else {
-        for (auto doc : qAsConst(context.calculatedDocuments)) {
-            mergeProject(doc->project(), projectMap.value(doc)->project());
-            projectMap.value(doc)->setProperty(SCHEDULEMANAGERNAME, doc->property(SCHEDULEMANAGERNAME));
-        }
         logInfo(context.project, nullptr, i18n("Scheduling finished at %1, elapsed time: %2 seconds", QDateTime::currentDateTime().toString(Qt::ISODate), (double)timer.elapsed()/1000));
     }
+    m_context = nullptr;
     context.log = takeLog();
 }
 
@@ -281,7 +270,8 @@ void KPlatoScheduler::calculateProject(SchedulingContext &context, KoDocument *d
     for (auto d : includes) {
         KPlato::Project *project = d->project();
         project->setProperty(SCHEDULEMANAGERNAME, d->property(SCHEDULEMANAGERNAME));
-        QMetaObject::invokeMethod(doc, "insertSharedResourceAssignments", Q_ARG(const KPlato::Project*, project));
+        // doc is a private copy that has been moved to this thread, see MainDocument::copyForScheduling()
+        QMetaObject::invokeMethod(doc, "insertSharedResourceAssignments", Qt::DirectConnection, Q_ARG(const KPlato::Project*, project));
         logInfo(doc->project(), nullptr, i18n("Inserting resource bookings from project: %1", project->name()));
     }
     KPlato::Project *project = doc->project();
@@ -293,17 +283,23 @@ void KPlatoScheduler::calculateProject(SchedulingContext &context, KoDocument *d
     project->setCurrentScheduleManager(sm);
     doc->setProperty(SCHEDULEMANAGERNAME, sm->name());
     connect(sm, &KPlato::ScheduleManager::sigLogAdded, this, &KPlatoScheduler::slotAddLog);
+    connect(sm, &KPlato::ScheduleManager::sigLogsAdded, this, &KPlatoScheduler::slotAddLogs);
     KPlato::DateTime oldstart = project->constraintStartTime();
     KPlato::DateTime start = context.calculateFrom;
     if (oldstart > start) {
         start = oldstart;
     }
     sm->setRecalculateFrom(start);
+    m_calculatingProject = project;
     project->calculate(*sm);
+    m_calculatingProject = nullptr;
+    if (context.cancelScheduling) {
+        sm->setCalculationResult(KPlato::ScheduleManager::CalculationCanceled);
+    }
     project->setConstraintStartTime(oldstart);
     disconnect(sm, &KPlato::ScheduleManager::sigLogAdded, this, &KPlatoScheduler::slotAddLog);
+    disconnect(sm, &KPlato::ScheduleManager::sigLogsAdded, this, &KPlatoScheduler::slotAddLogs);
     project->currentSchedule()->clearLogs();
-    doc->setModified(true);
 }
 
 /*static*/
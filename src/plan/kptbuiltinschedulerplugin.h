@@ -45,7 +45,7 @@ protected Q_SLOTS:
 };
 
 
-class KPlatoScheduler : public SchedulerThread
+class PLAN_EXPORT KPlatoScheduler : public SchedulerThread
 {
     Q_OBJECT
 
@@ -56,6 +56,7 @@ public:
 
     void schedule(SchedulingContext &context) override;
 
+    /// Merge the current schedule of @p calculatedProject into @p originalProject
     static void mergeProject(Project *calculatedProject, Project *originalProject);
 
 public Q_SLOTS:
@@ -64,19 +65,21 @@ public Q_SLOTS:
     /// Halt scheduling
     void haltScheduling() override { m_haltScheduling = true; stopScheduling(); }
 
+    /// Tell a running schedule() to stop, may be called from another thread
     void cancelScheduling(SchedulingContext &context) override;
 
 protected:
     void run() override;
     void calculateProject(SchedulingContext &context, KoDocument *project, QList<const KoDocument*> includes);
 
-    KoDocument *copyDocument(KoDocument *doc);
-
 protected Q_SLOTS:
     void slotProgress(int value);
 
 private:
     int m_progress = 0;
+    // Only used in the scheduling thread
+    SchedulingContext *m_context = nullptr;
+    Project *m_calculatingProject = nullptr;
 };
 
 } //namespace KPlato
@@ -28,6 +28,9 @@
 #include "kpttask.h"
 #include "KPlatoXmlLoader.h"
 #include "XmlSaveContext.h"
+#include "XmlStreamSaver.h"
+#include "ProjectStreamLoader.h"
+#include "BookingDigest.h"
 #include "kptpackage.h"
 #include "SharedResourcesDialog.h"
 #include "ModifyCalendarOriginCmd.h"
@@ -40,6 +43,7 @@
 #include <KoStore.h>
 #include <KoXmlReader.h>
 #include <KoStoreDevice.h>
+#include <KoXmlWriter.h>
 #include <KoOdfReadStore.h>
 #include <KoUpdater.h>
 #include <KoProgressUpdater.h>
@@ -48,8 +52,14 @@
 #include <QApplication>
 #include <QPainter>
 #include <QDir>
+#include <QScopedPointer>
 #include <QMutableMapIterator>
 #include <QTemporaryFile>
+#include <QXmlStreamReader>
+#include <QFuture>
+#include <QtConcurrent>
+
+#include <atomic>
 
 #include <KLocalizedString>
 #include <KMessageBox>
@@ -73,6 +83,7 @@ MainDocument::MainDocument(KoPart *part, bool loadSchedulerPlugins)
         m_loadingSharedResourcesTemplate(false),
         m_viewlistModified(false),
         m_checkingForWorkPackages(false),
+        m_recheckWorkPackages(false),
         m_loadingSharedProject(false),
         m_skipSharedProjects(false),
         m_isLoading(false),
@@ -80,7 +91,8 @@ MainDocument::MainDocument(KoPart *part, bool loadSchedulerPlugins)
         m_calculationCommand(nullptr),
         m_currentCalculationManager(nullptr),
         m_nextCalculationManager(nullptr),
-        m_taskModulesWatch(nullptr)
+        m_taskModulesWatch(nullptr),
+        m_workPackagesWatch(nullptr)
 {
     Q_ASSERT(part);
     setAlwaysAllowSaving(true);
@@ -94,12 +106,19 @@ MainDocument::MainDocument(KoPart *part, bool loadSchedulerPlugins)
     m_project->setId(m_project->uniqueNodeId());
     m_project->registerNodeId(m_project); // register myself
 
+    m_workPackagesWatchTimer.setSingleShot(true);
+    m_workPackagesWatchTimer.setInterval(1000);
+    connect(&m_workPackagesWatchTimer, &QTimer::timeout, this, [this]() { checkForWorkPackages(true); });
+    connect(&m_workPackageReader, &QFutureWatcher<IncomingWorkPackage>::finished, this, &MainDocument::slotWorkPackagesRead);
+
     connect(this, &MainDocument::insertSharedProject, this, &MainDocument::slotInsertSharedProject);
 }
 
 
 MainDocument::~MainDocument()
 {
+    m_workPackageReader.disconnect(this);
+    m_workPackageReader.waitForFinished();
     qDeleteAll(m_schedulerPlugins);
     if (m_project) {
         m_project->deref(); // deletes if last user
@@ -302,7 +321,7 @@ bool MainDocument::loadOdf(KoOdfReadStore &odfStore)
     return loadXML(odfStore.contentDoc(), nullptr); // We have only one format, so try to load that!
 }
 
-bool MainDocument::loadXML(const KoXmlDocument &document, KoStore*)
+bool MainDocument::loadXML(const KoXmlDocument &document, KoStore *store)
 {
     debugPlanXml<<"--->";
     QPointer<KoUpdater> updater;
@@ -367,19 +386,11 @@ bool MainDocument::loadXML(const KoXmlDocument &document, KoStore*)
     m_xmlLoader.setMimetype(value);
     QString syntaxVersion = plan.attribute("version", PLAN_FILE_SYNTAX_VERSION);
     m_xmlLoader.setVersion(syntaxVersion);
-    if (syntaxVersion > PLAN_FILE_SYNTAX_VERSION) {
-        if (!property(NOUI).toBool()) {
-            KMessageBox::ButtonCode ret = KMessageBox::warningContinueCancel(
-                      nullptr, i18n("This document was created with a newer version of Plan (syntax version: %1)\n"
-                               "Opening it in this version of Plan will lose some information.", syntaxVersion),
-                      i18n("File-Format Mismatch"), KGuiItem(i18n("Continue")));
-            if (ret == KMessageBox::Cancel) {
-                setErrorMessage(QStringLiteral("USER_CANCELED"));
-                debugPlanXml<<"Canceled"<<"<---";
-                return false;
-            }
-        }
+    if (!checkSyntaxVersion(syntaxVersion)) {
+        debugPlanXml<<"Canceled"<<"<---";
+        return false;
     }
+    loadAppointmentStream(store, plan.attribute("appointments"));
     Project *newProject = new Project(m_config, true);
     newProject->setSchedulerPlugins(m_schedulerPlugins);
     if (!m_xmlLoader.loadProject(newProject, document)) {
@@ -387,6 +398,7 @@ bool MainDocument::loadXML(const KoXmlDocument &document, KoStore*)
     } else {
         setProject(newProject);
     }
+    m_xmlLoader.setAppointmentStream(AppointmentStream());
 
     setModified(false);
     debugPlanXml<<"<---";
@@ -394,6 +406,111 @@ bool MainDocument::loadXML(const KoXmlDocument &document, KoStore*)
     return true;
 }
 
+bool MainDocument::loadMainDocument(KoStore *store)
+{
+    debugPlanXml<<"--->";
+    if (!KPlatoSettings::useStreamLoader()) {
+        debugPlanXml<<"Stream loader not enabled";
+        return KoDocument::loadMainDocument(store);
+    }
+    if (!store->open(QStringLiteral("root"))) {
+        return KoDocument::loadMainDocument(store); // let it handle the error
+    }
+    // Peek at the plan element to decide which loader to use
+    QXmlStreamAttributes attributes;
+    {
+        QXmlStreamReader reader(store->device());
+        reader.setNamespaceProcessing(false);
+        if (reader.readNextStartElement()) {
+            attributes = reader.attributes();
+        }
+    }
+    store->close();
+    const QString mimetype = attributes.value(QStringLiteral("mime")).toString();
+    const QString syntaxVersion = attributes.hasAttribute(QStringLiteral("version")) ? attributes.value(QStringLiteral("version")).toString() : PLAN_FILE_SYNTAX_VERSION;
+    if (!ProjectStreamLoader::canLoad(mimetype, syntaxVersion)) {
+        debugPlanXml<<"Use document loader:"<<mimetype<<syntaxVersion;
+        return KoDocument::loadMainDocument(store);
+    }
+    QPointer<KoUpdater> updater;
+    if (progressUpdater()) {
+        updater = progressUpdater()->startSubtask(1, QStringLiteral("Plan::Part::loadMainDocument"));
+        updater->setProgress(0);
+        m_xmlLoader.setUpdater(updater);
+    }
+    m_xmlLoader.setMimetype(mimetype);
+    m_xmlLoader.setVersion(syntaxVersion);
+    if (!checkSyntaxVersion(syntaxVersion)) {
+        debugPlanXml<<"Canceled"<<"<---";
+        return false;
+    }
+    loadAppointmentStream(store, attributes.value(QStringLiteral("appointments")).toString());
+
+    if (!store->open(QStringLiteral("root"))) {
+        m_xmlLoader.setAppointmentStream(AppointmentStream());
+        setErrorMessage(i18n("Could not find %1", QStringLiteral("root")));
+        return false;
+    }
+    QXmlStreamReader reader(store->device());
+    reader.setNamespaceProcessing(false);
+    Project *newProject = new Project(m_config, true);
+    newProject->setSchedulerPlugins(m_schedulerPlugins);
+    const bool ok = m_xmlLoader.loadProject(newProject, reader);
+    const bool parseError = reader.hasError();
+    if (parseError) {
+        errorPlanXml<<"Parsing error in root at line"<<reader.lineNumber()<<"column"<<reader.columnNumber()<<reader.errorString();
+        setErrorMessage(i18n("Parsing error in %1 at line %2, column %3\nError message: %4", QStringLiteral("root"), reader.lineNumber(), reader.columnNumber(), reader.errorString()));
+    }
+    store->close();
+    m_xmlLoader.setAppointmentStream(AppointmentStream());
+    if (!ok) {
+        delete newProject;
+        if (parseError) {
+            debugPlanXml<<"Failed"<<"<---";
+            return false;
+        }
+    } else {
+        setProject(newProject);
+    }
+    setModified(false);
+    debugPlanXml<<"<---";
+    Q_EMIT changed();
+    return true;
+}
+
+bool MainDocument::checkSyntaxVersion(const QString &syntaxVersion)
+{
+    if (syntaxVersion > PLAN_FILE_SYNTAX_VERSION) {
+        if (!property(NOUI).toBool()) {
+            KMessageBox::ButtonCode ret = KMessageBox::warningContinueCancel(
+                      nullptr, i18n("This document was created with a newer version of Plan (syntax version: %1)\n"
+                               "Opening it in this version of Plan will lose some information.", syntaxVersion),
+                      i18n("File-Format Mismatch"), KGuiItem(i18n("Continue")));
+            if (ret == KMessageBox::Cancel) {
+                setErrorMessage(QStringLiteral("USER_CANCELED"));
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void MainDocument::loadAppointmentStream(KoStore *store, const QString &fileName)
+{
+    AppointmentStream appointments;
+    if (!fileName.isEmpty()) {
+        if (store && store->open(fileName)) {
+            if (!appointments.setData(store->read(store->size()))) {
+                warnPlanXml<<"Invalid appointment stream:"<<fileName;
+            }
+            store->close();
+        } else {
+            warnPlanXml<<"Could not open appointment stream:"<<fileName;
+        }
+    }
+    m_xmlLoader.setAppointmentStream(appointments);
+}
+
 QString MainDocument::uniqueTempFileName()
 {
     auto tempFile = new QTemporaryFile(QStringLiteral("%1/calligraplan-XXXXXX.plan").arg(QDir::tempPath()));
@@ -449,6 +566,19 @@ QDomDocument MainDocument::saveXML()
     return context.document;
 }
 
+bool MainDocument::saveToXmlWriter(KoXmlWriter &writer, KoStore *store)
+{
+    debugPlan<<store;
+    XmlStreamSaver saver(writer);
+    m_appointmentStream.clear();
+    // xml is the default, older versions do not know the binary entry
+    if (store && KPlatoSettings::saveAppointmentStream()) {
+        saver.setAppointmentStream(&m_appointmentStream);
+    }
+    saver.save(m_project);
+    return true;
+}
+
 QList<QUrl> MainDocument::publishWorkpackages(const QList<Node*> &nodes, Resource *resource, long scheduleId)
 {
     debugPlanWp<<resource<<nodes;
@@ -466,29 +596,60 @@ QList<QUrl> MainDocument::publishWorkpackages(const QList<Node*> &nodes, Resourc
     } else {
         path = QDir::tempPath();
     }
-    for (Node *n : nodes) {
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    Q_EMIT statusBarMessage(i18n("Saving..."));
+    // The files are created and written in the thread pool.
+    // This thread waits for them, so the project does not change while they read it.
+    const QDomDocument header = createWorkPackageDocument(scheduleId, resource);
+    std::atomic<bool> failed(false);
+    QList<QFuture<bool>> writers;
+    for (const Node *n : nodes) {
         QTemporaryFile tmpfile(path + QStringLiteral("/calligraplanwork_XXXXXX") + QStringLiteral(".planwork"));
         tmpfile.setAutoRemove(false);
         if (!tmpfile.open()) {
             debugPlanWp<<"Failed to open file";
             setErrorMessage(i18n("Failed to open work package file"));
-            return QList<QUrl>();
+            failed = true;
+            break;
         }
-        QUrl url = QUrl::fromLocalFile(tmpfile.fileName());
+        const QUrl url = QUrl::fromLocalFile(tmpfile.fileName());
         debugPlanWp<<url;
-        if (!saveWorkPackageUrl(url, n, scheduleId, resource)) {
+        attachURLs << url;
+        const QDomDocument document = header.cloneNode(true).toDocument();
+        writers << QtConcurrent::run([this, document, n, scheduleId, url, &failed]() {
+            if (failed) {
+                return false; // another file failed, all files are removed
+            }
+            QDomDocument wp = document;
+            QDomElement projectElement = wp.documentElement().firstChildElement(QStringLiteral("project"));
+            m_project->saveWorkPackageNodeXML(projectElement, n, scheduleId);
+            const bool ok = saveWorkPackageFormat(url.path(), wp, n); // kzip don't handle file://
+            if (!ok) {
+                failed = true;
+            }
+            return ok;
+        });
+    }
+    for (int i = 0; i < writers.count(); ++i) {
+        writers[i].waitForFinished();
+        if (!writers.at(i).result() && errorMessage().isEmpty()) {
             debugPlan<<"Failed to save to file";
-            setErrorMessage(xi18nc("@info", "Failed to save to temporary file:<br/><filename>%1</filename>", url.url()));
-            return QList<QUrl>();
+            setErrorMessage(xi18nc("@info", "Failed to save to temporary file:<br/><filename>%1</filename>", attachURLs.at(i).url()));
         }
-        attachURLs << url;
     }
+    if (failed) {
+        for (const QUrl &url : qAsConst(attachURLs)) {
+            QFile::remove(url.path());
+        }
+        attachURLs.clear();
+    }
+    QApplication::restoreOverrideCursor();
+    Q_EMIT clearStatusBarMessage();
     return attachURLs;
 }
 
-QDomDocument MainDocument::saveWorkPackageXML(const Node *node, long id, Resource *resource)
+QDomDocument MainDocument::createWorkPackageDocument(long id, Resource *resource) const
 {
-    debugPlanWp<<resource<<node;
     QDomDocument document(QStringLiteral("plan"));
 
     document.appendChild(document.createProcessingInstruction(
@@ -515,142 +676,117 @@ QDomDocument MainDocument::saveWorkPackageXML(const Node *node, long id, Resourc
     debugPlanWp<<"retrieve:"<<m_project->workPackageInfo().retrieveUrl.toString(QUrl::None);
     doc.appendChild(wp);
 
-    // Save the project
-    m_project->saveWorkPackageXML(doc, node, id);
+    // Save the project element only
+    m_project->saveWorkPackageXML(doc, nullptr, id);
 
     return document;
 }
 
-bool MainDocument::saveWorkPackageToStream(QIODevice *dev, const Node *node, long id, Resource *resource)
-{
-    QDomDocument doc = saveWorkPackageXML(node, id, resource);
-    // Save to buffer
-    QByteArray s = doc.toByteArray(); // utf8 already
-    dev->open(QIODevice::WriteOnly);
-    int nwritten = dev->write(s.data(), s.size());
-    if (nwritten != (int)s.size()) {
-        warnPlanWp<<"wrote:"<<nwritten<<"- expected:"<< s.size();
-    }
-    return nwritten == (int)s.size();
-}
-
-bool MainDocument::saveWorkPackageFormat(const QString &file, const Node *node, long id, Resource *resource)
+bool MainDocument::saveWorkPackageFormat(const QString &file, const QDomDocument &document, const Node *node)
 {
     debugPlanWp <<"Saving to store";
 
-    KoStore::Backend backend = KoStore::Zip;
-#ifdef QCA2
-/*    if (d->m_specialOutputFlag == SaveEncrypted) {
-        backend = KoStore::Encrypted;
-        debugPlan <<"Saving using encrypted backend.";
-    }*/
-#endif
-
-    QByteArray mimeType = "application/x-vnd.kde.plan.work";
-    debugPlanWp <<"MimeType=" << mimeType;
-
-    KoStore *store = KoStore::createStore(file, KoStore::Write, mimeType, backend);
-/*    if (d->m_specialOutputFlag == SaveEncrypted && !d->m_password.isNull()) {
-        store->setPassword(d->m_password);
-    }*/
+    KoStore *store = KoStore::createStore(file, KoStore::Write, "application/x-vnd.kde.plan.work", KoStore::Zip);
     if (store->bad()) {
-        setErrorMessage(i18n("Could not create the workpackage file for saving: %1", file)); // more details needed?
+        warnPlanWp<<"Could not create store:"<<file;
         delete store;
         return false;
     }
-    // Tell KoStore not to touch the file names
-
-
-    if (! store->open("root")) {
-        setErrorMessage(i18n("Not able to write '%1'. Partition full?", QStringLiteral("maindoc.xml")));
+    if (!store->open("root")) {
+        warnPlanWp<<"Could not open root:"<<file;
         delete store;
         return false;
     }
-    KoStoreDevice dev(store);
-    if (!saveWorkPackageToStream(&dev, node, id, resource) || !store->close()) {
-        errorPlanWp <<"saveToStream failed";
+    bool ok = false;
+    {
+        KoStoreDevice dev(store);
+        const QByteArray s = document.toByteArray(); // utf8 already
+        dev.open(QIODevice::WriteOnly);
+        ok = dev.write(s.data(), s.size()) == s.size();
+    }
+    if (!store->close() || !ok) {
+        errorPlanWp<<"Failed to write root:"<<file;
         delete store;
         return false;
     }
     node->documents().saveToStore(store);
 
     debugPlanWp <<"Saving done of url:" << file;
-    if (!store->finalize()) {
-        delete store;
-        return false;
-    }
-    // Success
+    ok = store->finalize();
     delete store;
-
-    return true;
+    return ok;
 }
 
-bool MainDocument::saveWorkPackageUrl(const QUrl &_url, const Node *node, long id, Resource *resource)
+void MainDocument::readWorkPackage(IncomingWorkPackage &wp, const QSet<QDateTime> &merged)
 {
-    debugPlanWp<<_url;
-    QApplication::setOverrideCursor(Qt::WaitCursor);
-    Q_EMIT statusBarMessage(i18n("Saving..."));
-    bool ret = false;
-    ret = saveWorkPackageFormat(_url.path(), node, id, resource); // kzip don't handle file://
-    QApplication::restoreOverrideCursor();
-    Q_EMIT clearStatusBarMessage();
-    return ret;
-}
-
-bool MainDocument::loadWorkPackage(Project &project, const QUrl &url)
-{
-    debugPlanWp<<url;
-    if (! url.isLocalFile()) {
+    wp.ok = false;
+    if (! wp.url.isLocalFile()) {
         warnPlanWp<<Q_FUNC_INFO<<"TODO: download if url not local";
-        return false;
+        return;
     }
-    KoStore *store = KoStore::createStore(url.path(), KoStore::Read, "", KoStore::Auto);
+    KoStore *store = KoStore::createStore(wp.url.path(), KoStore::Read, "", KoStore::Auto);
     if (store->bad()) {
-//        d->lastErrorMessage = i18n("Not a valid Calligra file: %1", file);
-        errorPlanWp<<"bad store"<<url.toDisplayString();
+        errorPlanWp<<"bad store"<<wp.url.toDisplayString();
         delete store;
-//        QApplication::restoreOverrideCursor();
-        return false;
+        return;
     }
     if (! store->open("root")) { // "old" file format (maindoc.xml)
-        // i18n("File does not have a maindoc.xml: %1", file);
-        errorPlanWp<<"No root"<<url.toDisplayString();
+        errorPlanWp<<"No root"<<wp.url.toDisplayString();
         delete store;
-//        QApplication::restoreOverrideCursor();
-        return false;
+        return;
     }
-    Package *package = nullptr;
-    KoXmlDocument doc;
     QString errorMsg; // Error variables for QDomDocument::setContent
     int errorLine, errorColumn;
-    bool ok = doc.setContent(store->device(), &errorMsg, &errorLine, &errorColumn);
-    if (! ok) {
-        errorPlanWp << "Parsing error in " << url.url() << "! Aborting!" << '\n'
+    wp.ok = wp.document.setContent(store->device(), &errorMsg, &errorLine, &errorColumn);
+    if (! wp.ok) {
+        errorPlanWp << "Parsing error in " << wp.url.url() << "! Aborting!" << '\n'
                 << " In line: " << errorLine << ", column: " << errorColumn << '\n'
                 << " Error message: " << errorMsg;
-        //d->lastErrorMessage = i18n("Parsing error in %1 at line %2, column %3\nError message: %4",filename  ,errorLine, errorColumn , QCoreApplication::translate("QXml", errorMsg.toUtf8(), 0, QCoreApplication::UnicodeUTF8));
-    } else {
-        package = loadWorkPackageXML(project, store->device(), doc, url);
-        if (package) {
-            package->url = url;
-            m_workpackages.insert(package->timeTag, package);
-            if (!m_mergedPackages.contains(package->timeTag)) {
-                m_mergedPackages[package->timeTag] = package->project; // register this for next time
+    }
+    store->close();
+    delete store;
+    if (wp.ok && !merged.isEmpty()) {
+        // Skip packages that have already been merged without loading the project
+        const KoXmlElement plan = wp.document.documentElement();
+        if (plan.attribute("mime") == PLANWORK_MIME_TYPE) {
+            const KoXmlElement e = plan.namedItem("workpackage").toElement();
+            if (merged.contains(QDateTime::fromString(e.attribute("time-tag"), Qt::ISODate))) {
+                debugPlanWp<<"Skip workpackage:"<<"already merged:"<<wp.url;
+                wp.ok = false;
             }
-        } else {
-            ok = false;
         }
     }
-    store->close();
-    //###
-    if (ok && package && package->settings.documents) {
-        ok = extractFiles(store, package);
+}
+
+bool MainDocument::loadWorkPackage(Project &project, const QUrl &url)
+{
+    debugPlanWp<<url;
+    IncomingWorkPackage wp;
+    wp.url = url;
+    readWorkPackage(wp);
+    return loadWorkPackage(project, wp);
+}
+
+bool MainDocument::loadWorkPackage(Project &project, const IncomingWorkPackage &wp)
+{
+    if (! wp.ok) {
+        return false;
     }
-    delete store;
-    if (! ok) {
-//        QApplication::restoreOverrideCursor();
+    Package *package = loadWorkPackageXML(project, nullptr, wp.document, wp.url);
+    if (! package) {
         return false;
     }
+    package->url = wp.url;
+    m_workpackages.insert(package->timeTag, package);
+    if (!m_mergedPackages.contains(package->timeTag)) {
+        m_mergedPackages[package->timeTag] = package->project; // register this for next time
+    }
+    if (package->settings.documents) {
+        KoStore *store = KoStore::createStore(wp.url.path(), KoStore::Read, "", KoStore::Auto);
+        const bool ok = !store->bad() && extractFiles(store, package);
+        delete store;
+        return ok;
+    }
     return true;
 }
 
@@ -810,7 +946,9 @@ bool MainDocument::extractFile(KoStore *store, Package *package, const Document
 void MainDocument::autoCheckForWorkPackages()
 {
     QTimer *timer = qobject_cast<QTimer*>(sender());
-    if (m_project && m_project->workPackageInfo().checkForWorkPackages) {
+    // When the retrieve directory is watched, changes to it triggers the check
+    const bool watched = setWorkPackagesWatch();
+    if (m_project && m_project->workPackageInfo().checkForWorkPackages && !watched) {
         checkForWorkPackages(true);
     }
     if (timer && timer->interval() != 10000) {
@@ -820,9 +958,58 @@ void MainDocument::autoCheckForWorkPackages()
     }
 }
 
+bool MainDocument::setWorkPackagesWatch()
+{
+    QString path;
+    if (m_project && m_project->workPackageInfo().checkForWorkPackages && m_project->workPackageInfo().retrieveUrl.isLocalFile()) {
+        path = m_project->workPackageInfo().retrieveUrl.toLocalFile();
+    }
+    if (path == m_workPackagesWatchPath) {
+        return !path.isEmpty();
+    }
+    delete m_workPackagesWatch;
+    m_workPackagesWatch = nullptr;
+    m_workPackagesWatchPath = path;
+    if (!path.isEmpty()) {
+        m_workPackagesWatch = new KDirWatch(this);
+        m_workPackagesWatch->addDir(path, KDirWatch::WatchFiles);
+        connect(m_workPackagesWatch, &KDirWatch::dirty, this, &MainDocument::workPackagesDirChanged);
+        connect(m_workPackagesWatch, &KDirWatch::created, this, &MainDocument::workPackagesDirChanged);
+    }
+    return false;
+}
+
+void MainDocument::workPackagesDirChanged()
+{
+    // Packages often arrive in bunches, check when they have settled
+    m_workPackagesWatchTimer.start();
+}
+
+namespace {
+// Reads workpackage files in the thread pool
+struct WorkPackageReader
+{
+    typedef MainDocument::IncomingWorkPackage result_type;
+
+    explicit WorkPackageReader(const QSet<QDateTime> &merged) : merged(merged) {}
+    result_type operator()(const MainDocument::IncomingWorkPackage &package) const
+    {
+        result_type wp = package;
+        MainDocument::readWorkPackage(wp, merged);
+        return wp;
+    }
+
+    QSet<QDateTime> merged;
+};
+}
+
 void MainDocument::checkForWorkPackages(bool keep)
 {
-    if (m_checkingForWorkPackages || m_project == nullptr || m_project->numChildren() == 0 || m_project->workPackageInfo().retrieveUrl.isEmpty()) {
+    if (m_checkingForWorkPackages) {
+        m_recheckWorkPackages = true;
+        return;
+    }
+    if (m_project == nullptr || m_project->numChildren() == 0 || m_project->workPackageInfo().retrieveUrl.isEmpty()) {
         return;
     }
     if (! keep) {
@@ -830,29 +1017,55 @@ void MainDocument::checkForWorkPackages(bool keep)
         m_mergedPackages.clear();
     }
     QDir dir(m_project->workPackageInfo().retrieveUrl.path(), QStringLiteral("*.planwork"));
-    m_infoList = dir.entryInfoList(QDir::Files | QDir::Readable, QDir::Time);
+    const QFileInfoList infoList = dir.entryInfoList(QDir::Files | QDir::Readable, QDir::Time);
+    QList<IncomingWorkPackage> packages;
+    for (int i = infoList.count() - 1; i >= 0; --i) { // oldest first
+        IncomingWorkPackage wp;
+        wp.url = QUrl::fromLocalFile(infoList.at(i).absoluteFilePath());
+        if (!m_skipUrls.contains(wp.url)) {
+            packages << wp;
+        }
+    }
+    if (packages.isEmpty()) {
+        return;
+    }
+    m_checkingForWorkPackages = true;
+    QSet<QDateTime> merged;
+    for (QMap<QDateTime, Project*>::const_iterator it = m_mergedPackages.constBegin(); it != m_mergedPackages.constEnd(); ++it) {
+        merged.insert(it.key());
+    }
+    // Read and parse the files in the thread pool, loading into projects is done in checkForWorkPackage()
+    m_workPackageReader.setFuture(QtConcurrent::mapped(packages, WorkPackageReader(merged)));
+}
+
+void MainDocument::slotWorkPackagesRead()
+{
+    m_incomingWorkPackages = m_workPackageReader.future().results();
     checkForWorkPackage();
-    return;
 }
 
 void MainDocument::checkForWorkPackage()
 {
-    if (! m_infoList.isEmpty()) {
-        m_checkingForWorkPackages = true;
-        QUrl url = QUrl::fromLocalFile(m_infoList.takeLast().absoluteFilePath());
-        if (!m_skipUrls.contains(url) && !loadWorkPackage(*m_project, url)) {
-            m_skipUrls << url;
-            debugPlanWp<<"skip url:"<<url;
+    if (! m_incomingWorkPackages.isEmpty()) {
+        const IncomingWorkPackage wp = m_incomingWorkPackages.takeFirst();
+        if (!loadWorkPackage(*m_project, wp)) {
+            m_skipUrls << wp.url;
+            debugPlanWp<<"skip url:"<<wp.url;
         }
-        if (! m_infoList.isEmpty()) {
+        if (! m_incomingWorkPackages.isEmpty()) {
             QTimer::singleShot (0, this, &MainDocument::checkForWorkPackage);
             return;
         }
-        // Merge our workpackages
-        if (! m_workpackages.isEmpty()) {
-            Q_EMIT workPackageLoaded();
-        }
-        m_checkingForWorkPackages = false;
+    }
+    // Merge our workpackages
+    if (! m_workpackages.isEmpty()) {
+        Q_EMIT workPackageLoaded();
+    }
+    m_checkingForWorkPackages = false;
+    if (m_recheckWorkPackages) {
+        // files arrived while checking
+        m_recheckWorkPackages = false;
+        checkForWorkPackages(true);
     }
 }
 
@@ -1008,7 +1221,30 @@ void MainDocument::registerView(View* view)
 
 bool MainDocument::completeSaving(KoStore *store)
 {
+    if (!m_appointmentStream.isEmpty()) {
+        const bool ok = store->open(AppointmentStream::fileName());
+        if (ok) {
+            KoStoreDevice dev(store);
+            const QByteArray s = m_appointmentStream.data();
+            (void)dev.write(s.data(), s.size());
+            (void)store->close();
+        }
+        m_appointmentStream.clear();
+        if (!ok) {
+            setErrorMessage(i18n("Failed to save appointments"));
+            return false;
+        }
+    }
     if (!m_savingTemplate) {
+        // lets projects that share our resources read our bookings without loading this file
+        BookingDigest digest;
+        digest.create(m_project);
+        if (store->open(BookingDigest::fileName())) {
+            KoStoreDevice dev(store);
+            const QByteArray s = digest.data();
+            (void)dev.write(s.data(), s.size());
+            (void)store->close();
+        }
         XmlSaveContext saver(m_project);
         if (saver.saveWorkIntervalsCache()) {
             if (store->open("workintervalscache.xml")) {
@@ -1052,6 +1288,62 @@ bool MainDocument::completeSaving(KoStore *store)
     return true;
 }
 
+std::function<bool(KoStore*)> MainDocument::createSaveCopy()
+{
+    // Nothing in the copy refers to the project, it is written in a worker thread
+    const XmlSnapshot snapshot(m_project);
+    const bool saveAppointmentStream = KPlatoSettings::saveAppointmentStream();
+    QDomDocument context;
+    if (m_context && m_views.isEmpty()) {
+        context = m_context->document();
+    } else {
+        for (View *view : qAsConst(m_views)) {
+            if (view) {
+                if (m_context == nullptr) m_context = new Context();
+                context = m_context->save(view);
+                break;
+            }
+        }
+    }
+    // Same as saveToXmlWriter() and completeSaving(), the booking digest and
+    // the work intervals cache are not needed to load the document
+    return [snapshot, saveAppointmentStream, context](KoStore *store) {
+        if (!store->open("root")) {
+            return false;
+        }
+        AppointmentStream appointments;
+        {
+            KoStoreDevice dev(store);
+            dev.open(QIODevice::WriteOnly);
+            KoXmlWriter writer(&dev);
+            XmlStreamSaver saver(writer);
+            if (saveAppointmentStream) {
+                saver.setAppointmentStream(&appointments);
+            }
+            saver.save(snapshot);
+        }
+        if (!store->close()) {
+            return false;
+        }
+        if (!appointments.isEmpty()) {
+            if (!store->open(AppointmentStream::fileName())) {
+                return false;
+            }
+            KoStoreDevice dev(store);
+            const QByteArray s = appointments.data();
+            (void)dev.write(s.data(), s.size());
+            (void)store->close();
+        }
+        if (!context.isNull() && store->open("context.xml")) {
+            KoStoreDevice dev(store);
+            const QByteArray s = context.toByteArray(); // this is already Utf8!
+            (void)dev.write(s.data(), s.size());
+            (void)store->close();
+        }
+        return true;
+    };
+}
+
 bool MainDocument::loadAndParse(KoStore *store, const QString &filename, KoXmlDocument &doc)
 {
     //debugPlan << "oldLoadAndParse: Trying to open " << filename;
@@ -1258,9 +1550,13 @@ void MainDocument::insertSharedProjects(const QUrl &url)
 void MainDocument::slotInsertSharedProject()
 {
     debugPlan<<m_sharedProjectsFiles;
+    while (!m_sharedProjectsFiles.isEmpty() && insertSharedProjectBookings(m_sharedProjectsFiles.first())) {
+        m_sharedProjectsFiles.removeFirst();
+    }
     if (m_sharedProjectsFiles.isEmpty()) {
         return;
     }
+    // no digest, load the complete project
     Part *part = new Part(this);
     MainDocument *doc = new MainDocument(part);
     doc->m_skipSharedProjects = true; // never load recursively
@@ -1279,45 +1575,61 @@ void MainDocument::slotInsertSharedProject()
 void MainDocument::insertSharedResourceAssignments(const KPlato::Project *project)
 {
     debugPlanShared<<m_project->id()<<"Loaded project:"<<project->id()<<project->name();
-    if (project->id() != m_project->id() && project->isScheduled(ANYSCHEDULED)) {
-        ScheduleManager *sm = project->findScheduleManagerByName(project->property("schedulemanager-name").toString());
-        if (!sm) {
-            debugPlanShared<<"manager ("<<project->property("schedulemanager-name")<<") not set, search for a suitable one";
-            // find a suitable schedule
-            const QList<ScheduleManager*> managers = project->allScheduleManagers();
-            for (ScheduleManager *m : managers) {
-                if (m->isBaselined()) {
-                    sm = m;
-                    break;
-                }
-                if (m->isScheduled()) {
-                    sm = m; // take the last one, more likely to be subschedule
-                }
-            }
-        }
-        debugPlanShared<<"manager"<<sm;
-        if (sm) {
-            debugPlanShared<<"manager"<<sm->name();
-            const QList<Resource*> resources = project->resourceList();
-            for (Resource *r : resources ) {
-                Resource *res = m_project->resource(r->id());
-                if (res && res->isShared()) {
-                    Appointment *app = new Appointment();
-                    app->setAuxcilliaryInfo(project->name());
-                    const QList<Appointment*> appointments = r->appointments(sm->scheduleId());
-                    for (const Appointment *a : appointments) {
-                        *app += *a;
-                    }
-                    if (app->isEmpty()) {
-                        delete app;
-                    } else {
-                        res->addExternalAppointment(project->id(), app);
-                        debugPlanShared<<res->name()<<"added:"<<app->auxcilliaryInfo()<<app;
-                    }
-                }
-            }
-        }
+    BookingDigest digest;
+    digest.create(project);
+    debugPlanShared<<"manager"<<digest.scheduleManagerName();
+    digest.insertExternalAppointments(m_project);
+}
+
+bool MainDocument::insertSharedProjectBookings(const QUrl &url)
+{
+    if (!url.isLocalFile()) {
+        return false;
+    }
+    QScopedPointer<KoStore> store(KoStore::createStore(url.toLocalFile(), KoStore::Read, "", KoStore::Auto));
+    if (store->bad() || !store->hasFile(BookingDigest::fileName()) || !store->open(BookingDigest::fileName())) {
+        debugPlanShared<<"No booking digest:"<<url;
+        return false;
+    }
+    const QByteArray data = store->device()->readAll();
+    store->close();
+    BookingDigest digest;
+    if (!digest.setData(data)) {
+        warnPlan<<"Invalid booking digest, load project:"<<url;
+        return false;
+    }
+    debugPlanShared<<m_project->id()<<"Digest of project:"<<digest.projectId()<<digest.projectName()<<"manager"<<digest.scheduleManagerName();
+    digest.insertExternalAppointments(m_project);
+    return true;
+}
+
+KoDocument *MainDocument::copyForScheduling()
+{
+    auto part = new Part(nullptr);
+    auto copy = new MainDocument(part);
+    copy->setAutoSave(0);
+    copy->setProperty(NOUI, true);
+    auto xml = KoXmlDocument();
+    xml.setContent(saveXML().toString());
+    copy->loadXML(xml, nullptr);
+    copy->setProperty(SCHEDULEMANAGERNAME, property(SCHEDULEMANAGERNAME));
+    copy->project()->setProperty(SCHEDULEMANAGERNAME, m_project->property(SCHEDULEMANAGERNAME));
+    // The copy is calculated in another thread, so nothing shall react to changes in the project
+    disconnect(copy->m_project, nullptr, copy, nullptr);
+    delete copy->m_taskModulesWatch;
+    copy->m_taskModulesWatch = nullptr;
+    copy->m_project->moveToThread(nullptr);
+    copy->moveToThread(nullptr);
+    return copy;
+}
+
+void MainDocument::mergeSchedule(KPlato::Project *project)
+{
+    if (!project->currentScheduleManager()) {
+        warnPlan<<Q_FUNC_INFO<<project->name()<<"has not been scheduled";
+        return;
     }
+    KPlatoScheduler::mergeProject(project, m_project);
 }
 
 void MainDocument::insertSharedProjectCompleted()
@@ -1463,6 +1775,7 @@ bool MainDocument::mergeResources(Project &project)
     }
     MacroCommand *cmd = new MacroCommand(kundo2_i18n("Update Shared Resources"));
     cmd->setBusyCursorEnabled(true);
+    cmd->setBatchProject(m_project);
     KUndo2Command *command = nullptr;
     if (!removed.isEmpty()) {
         //KMessageBox::ButtonCode result = KMessageBox::PrimaryAction;
@@ -1488,6 +1801,8 @@ bool MainDocument::mergeResources(Project &project)
             }
         }
     }
+    // models update once when all shared objects are merged
+    m_project->beginChanges();
     debugPlanShared<<"Shared objects:\n"<<"Groups:"<<project.resourceGroups()<<"\nResources:"<<project.resourceList()<<"\nCalendars:"<<project.calendars();
     // update values of already existing objects
     const QList<ResourceGroup*> sharedGroups = project.allResourceGroups();
@@ -1653,6 +1968,7 @@ bool MainDocument::mergeResources(Project &project)
     } else {
         cmd->addCommand(icmd);
     }
+    m_project->endChanges();
     if (!cmd->isEmpty()) {
         debugPlanShared<<m_project<<&project<<"Update:"<<cmd->text();
         auto c = new MacroCommand(cmd->text());
@@ -23,8 +23,13 @@
 #include <MimeTypes.h>
 #include "KoDocument.h"
 
+#include <KoXmlReader.h>
+
 #include <QFileInfo>
 #include <QDomDocument>
+#include <QFutureWatcher>
+#include <QSet>
+#include <QTimer>
 
 
 
@@ -77,9 +82,14 @@ public:
 
     // The load and save functions. Look in the file kplato.dtd for info
     bool loadXML(const KoXmlDocument &document, KoStore *store) override;
+    /// Load a plan document directly from the store, see ProjectStreamLoader
+    /// The stream loader is used when enabled in the settings,
+    /// other documents and documents that the stream loader does not support are loaded with loadXML()
+    bool loadMainDocument(KoStore *store) override;
     QDomDocument saveXML() override;
-    /// Save a workpackage file containing @p node with schedule identity @p id, owned by @p resource
-    QDomDocument saveWorkPackageXML(const Node *node, long id, Resource *resource = nullptr);
+    /// Save the project directly to @p writer, see XmlStreamSaver
+    /// When saving to a @p store and enabled in the settings, the appointment intervals are saved in a separate entry, see AppointmentStream
+    bool saveToXmlWriter(KoXmlWriter &writer, KoStore *store) override;
 
     bool saveOdf(SavingContext &/*documentContext */) override { return false; }
     bool loadOdf(KoOdfReadStore & odfStore) override;
@@ -93,12 +103,20 @@ public:
 
     DocumentChild *createChild(KoDocument *doc, const QRect &geometry = QRect());
 
-    bool saveWorkPackageToStream(QIODevice * dev, const Node *node, long id, Resource *resource = nullptr);
-    bool saveWorkPackageFormat(const QString &file, const Node *node, long id, Resource *resource = nullptr);
-    bool saveWorkPackageUrl(const QUrl & _url, const Node *node, long id, Resource *resource = nullptr  );
-
+    /// Save the workpackage @p document of @p node, and the documents of @p node
+    /// that shall be sent as a copy, to the workpackage file @p file
+    static bool saveWorkPackageFormat(const QString &file, const QDomDocument &document, const Node *node);
 
     QList<QUrl> publishWorkpackages(const QList<Node*> &nodes, Resource *resource, long scheduleId);
+
+    /// A workpackage file read and parsed in a worker thread, see checkForWorkPackages()
+    struct IncomingWorkPackage {
+        QUrl url;
+        KoXmlDocument document;
+        bool ok = false;
+    };
+    /// Read and parse the workpackage file wp.url, skip it if it is in @p merged. Thread safe.
+    static void readWorkPackage(IncomingWorkPackage &wp, const QSet<QDateTime> &merged = QSet<QDateTime>());
     /// Load the workpackage from @p url into @p project. Return true if successful, else false.
     bool loadWorkPackage(Project &project, const QUrl &url);
     Package *loadWorkPackageXML(Project& project, QIODevice*, const KoXmlDocument& document, const QUrl& url);
@@ -133,6 +151,15 @@ public:
     /// Insert resource assignments from @p project
     Q_INVOKABLE void insertSharedResourceAssignments(const KPlato::Project *project);
 
+    /// Create a private copy of this document that can be scheduled in another thread.
+    /// The project of the copy is not connected to the copy, and neither the copy
+    /// nor its project has thread affinity, the thread that schedules it must move them to itself.
+    /// The caller takes ownership of the copy.
+    Q_INVOKABLE KoDocument *copyForScheduling();
+    /// Merge the schedule calculated in @p project into this project.
+    /// @p project is normally the project of a document created with copyForScheduling()
+    Q_INVOKABLE void mergeSchedule(KPlato::Project *project);
+
     QMap<QString, KPlato::SchedulerPlugin*> schedulerPlugins() const override;
     void setSchedulerPlugins(QMap<QString, KPlato::SchedulerPlugin*> &plugins);
 
@@ -198,6 +225,12 @@ protected:
     bool completeLoading(KoStore* store) override;
     /// Save kplato specific files
     bool completeSaving(KoStore* store) override;
+    /// Take a copy of the project for autosave, see XmlSnapshot
+    std::function<bool(KoStore*)> createSaveCopy() override;
+
+    /// Insert resource assignments from the booking digest in the file @p url.
+    /// Returns false if the file has no usable digest and must be loaded.
+    bool insertSharedProjectBookings(const QUrl &url);
 
     // used by insert file
     struct InsertFileInfo {
@@ -229,8 +262,21 @@ protected Q_SLOTS:
     void setTaskModulesWatch();
     void taskModuleDirChanged();
 
+    void workPackagesDirChanged();
+    void slotWorkPackagesRead();
+
 private:
     bool loadAndParse(KoStore* store, const QString& filename, KoXmlDocument& doc);
+    /// Ask the user to continue if @p syntaxVersion is newer than this version of Plan
+    bool checkSyntaxVersion(const QString &syntaxVersion);
+    /// Read the appointment stream @p fileName from @p store into the loader
+    void loadAppointmentStream(KoStore *store, const QString &fileName);
+    /// Create a workpackage document with the project element but without any node
+    QDomDocument createWorkPackageDocument(long id, Resource *resource) const;
+    /// Load the workpackage @p wp, read by readWorkPackage(), into @p project
+    bool loadWorkPackage(Project &project, const IncomingWorkPackage &wp);
+    /// Watch the retrieve directory, return true if it was already watched
+    bool setWorkPackagesWatch();
 
     void loadSchedulerPlugins();
 
@@ -245,10 +291,12 @@ private:
     bool m_loadingTemplate;
     bool m_loadingSharedResourcesTemplate;
     bool m_savingTemplate;
+    AppointmentStream m_appointmentStream; // written to the store in completeSaving()
 
     QMap<QString, SchedulerPlugin*> m_schedulerPlugins;
     QMap<QDateTime, Package*> m_workpackages;
-    QFileInfoList m_infoList;
+    QList<IncomingWorkPackage> m_incomingWorkPackages;
+    QFutureWatcher<IncomingWorkPackage> m_workPackageReader;
     QList<QUrl> m_skipUrls;
     QMap<QDateTime, Project*> m_mergedPackages;
 
@@ -256,6 +304,7 @@ private:
 
     bool m_viewlistModified;
     bool m_checkingForWorkPackages;
+    bool m_recheckWorkPackages;
 
     QList<QPointer<View> > m_views;
 
@@ -272,6 +321,9 @@ private:
     ScheduleManager* m_nextCalculationManager;
 
     KDirWatch *m_taskModulesWatch;
+    KDirWatch *m_workPackagesWatch;
+    QString m_workPackagesWatchPath;
+    QTimer m_workPackagesWatchTimer; // lets the files be completely written before they are read
 };
 
 
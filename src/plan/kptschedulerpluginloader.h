@@ -7,6 +7,8 @@
 #ifndef KPTSCHEDULERPLUGINLOADER_H
 #define KPTSCHEDULERPLUGINLOADER_H
 
+#include "plan_export.h"
+
 #include <QObject>
  
 /// The main namespace.
@@ -15,7 +17,7 @@ namespace KPlato
 
 class SchedulerPlugin;
 
-class SchedulerPluginLoader : public QObject
+class PLAN_EXPORT SchedulerPluginLoader : public QObject
 {
     Q_OBJECT
 public:
@@ -0,0 +1,699 @@
+/* This file is part of the KDE project
+ * SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+// clazy:excludeall=qstring-arg
+#include "MspdiReader.h"
+
+#include <kptproject.h>
+#include <kpttask.h>
+#include <kptresource.h>
+#include <kptresourcerequest.h>
+#include <kptrelation.h>
+#include <kptduration.h>
+#include <kptdatetime.h>
+#include <kptcalendar.h>
+
+#include <KLocalizedString>
+
+#include <QIODevice>
+#include <QLoggingCategory>
+
+#define MPXJIMPORT_LOG "calligra.plan.filter.mpxj.import"
+#define debugMspdiImport qCDebug(QLoggingCategory(MPXJIMPORT_LOG))<<Q_FUNC_INFO
+#define warnMspdiImport qCWarning(QLoggingCategory(MPXJIMPORT_LOG))<<Q_FUNC_INFO
+
+using namespace KPlato;
+
+// Limit the number of days an exception can expand to
+static const int s_maxExceptionDays = 3660;
+
+static bool isTrue(const QString &value)
+{
+    return value == QLatin1String("1") || value == QLatin1String("true");
+}
+
+// MSPDI: 1 = Sunday .. 7 = Saturday, Plan: 1 = Monday .. 7 = Sunday
+static int toWeekday(int dayType)
+{
+    return dayType == 1 ? 7 : dayType - 1;
+}
+
+static Node::ConstraintType toConstraintType(int type)
+{
+    switch (type) {
+        case 1: return Node::ALAP;
+        case 2: return Node::MustStartOn;
+        case 3: return Node::MustFinishOn;
+        case 4: return Node::StartNotEarlier;
+        case 7: return Node::FinishNotLater;
+        case 5: // start no later than
+        case 6: // finish no earlier than
+            warnMspdiImport<<"Constraint type not supported, using ASAP:"<<type;
+            break;
+        default:
+            break;
+    }
+    return Node::ASAP;
+}
+
+static Relation::Type toRelationType(int type)
+{
+    switch (type) {
+        case 0: return Relation::FinishFinish;
+        case 3: return Relation::StartStart;
+        case 2: // start-finish, not supported, use default
+        default:
+            break;
+    }
+    return Relation::FinishStart;
+}
+
+MspdiReader::MspdiReader(Project &project)
+    : m_project(project)
+    , m_minutesPerDay(480)
+{
+}
+
+QString MspdiReader::errorString() const
+{
+    return m_reader.errorString();
+}
+
+bool MspdiReader::read(QIODevice *device)
+{
+    m_reader.setDevice(device);
+    if (!m_reader.readNextStartElement()) {
+        if (!m_reader.hasError()) {
+            m_reader.raiseError(i18n("The file is empty"));
+        }
+        return false;
+    }
+    if (m_reader.name() != QLatin1String("Project") || m_reader.namespaceUri() != QLatin1String("http://schemas.microsoft.com/project")) {
+        m_reader.raiseError(i18n("The file is not an MS Project xml file"));
+        return false;
+    }
+    readProject();
+    if (m_reader.hasError()) {
+        warnMspdiImport<<m_reader.errorString()<<"line:"<<m_reader.lineNumber();
+        return false;
+    }
+    addCalendars();
+    addRelations();
+    Calendar *calendar = m_calendars.value(m_defaultCalendar);
+    if (calendar) {
+        m_project.setDefaultCalendar(calendar);
+    }
+    setDurationCalendar(calendar);
+    debugMspdiImport<<"Loaded"<<m_calendars.count()<<"calendars"<<m_tasks.count()<<"tasks"<<m_resources.count()<<"resources";
+    return true;
+}
+
+double MspdiReader::parseDuration(const QString &duration, bool *ok)
+{
+    // P[nY][nM][nD][T[nH][nM][nS]], years and months are not used by MS Project
+    bool valid = duration.startsWith(QLatin1Char('P'));
+    bool time = false;
+    double seconds = 0.0;
+    int start = 1;
+    for (int i = 1; valid && i < duration.length(); ++i) {
+        const QChar c = duration.at(i);
+        if (c.isDigit() || c == QLatin1Char('.')) {
+            continue;
+        }
+        if (c == QLatin1Char('T')) {
+            valid = !time && i == start;
+            time = true;
+            start = i + 1;
+            continue;
+        }
+        const double value = duration.midRef(start, i - start).toDouble(&valid);
+        start = i + 1;
+        if (!valid) {
+            break;
+        }
+        switch (c.unicode()) {
+            case 'Y': valid = !time; seconds += value * 365 * 86400; break;
+            case 'D': valid = !time; seconds += value * 86400; break;
+            case 'H': valid = time; seconds += value * 3600; break;
+            case 'S': valid = time; seconds += value; break;
+            case 'M': seconds += time ? value * 60 : value * 30 * 86400; break;
+            default: valid = false; break;
+        }
+    }
+    valid = valid && start == duration.length();
+    if (ok) {
+        *ok = valid;
+    }
+    return valid ? seconds : 0.0;
+}
+
+DateTime MspdiReader::toDateTime(const QString &value) const
+{
+    // Times are local times without a timezone
+    const QDateTime dt = QDateTime::fromString(value, Qt::ISODate);
+    if (!dt.isValid()) {
+        return DateTime();
+    }
+    return DateTime(dt.date(), dt.time(), m_project.timeZone());
+}
+
+void MspdiReader::readProject()
+{
+    QString name;
+    QString title;
+    while (m_reader.readNextStartElement()) {
+        const QStringRef tag = m_reader.name();
+        if (tag == QLatin1String("Name")) {
+            name = m_reader.readElementText();
+        } else if (tag == QLatin1String("Title")) {
+            title = m_reader.readElementText();
+        } else if (tag == QLatin1String("Manager")) {
+            m_project.setLeader(m_reader.readElementText());
+        } else if (tag == QLatin1String("StartDate")) {
+            const DateTime dt = toDateTime(m_reader.readElementText());
+            if (dt.isValid()) {
+                m_project.setConstraintStartTime(dt);
+                m_project.setStartTime(dt);
+            }
+        } else if (tag == QLatin1String("FinishDate")) {
+            const DateTime dt = toDateTime(m_reader.readElementText());
+            if (dt.isValid()) {
+                m_project.setConstraintEndTime(dt);
+                m_project.setEndTime(dt);
+            }
+        } else if (tag == QLatin1String("CalendarUID")) {
+            m_defaultCalendar = m_reader.readElementText();
+        } else if (tag == QLatin1String("MinutesPerDay")) {
+            const int minutes = m_reader.readElementText().toInt();
+            if (minutes > 0) {
+                m_minutesPerDay = minutes;
+            }
+        } else if (tag == QLatin1String("Calendars")) {
+            readCalendars();
+        } else if (tag == QLatin1String("Tasks")) {
+            readTasks();
+        } else if (tag == QLatin1String("Resources")) {
+            readResources();
+        } else if (tag == QLatin1String("Assignments")) {
+            readAssignments();
+        } else {
+            m_reader.skipCurrentElement();
+        }
+    }
+    m_project.setName(title.isEmpty() ? name : title);
+}
+
+void MspdiReader::readCalendars()
+{
+    while (m_reader.readNextStartElement()) {
+        if (m_reader.name() == QLatin1String("Calendar")) {
+            readCalendar();
+        } else {
+            m_reader.skipCurrentElement();
+        }
+    }
+    addCalendars();
+}
+
+void MspdiReader::readCalendar()
+{
+    Calendar *calendar = new Calendar();
+    QString uid;
+    QString baseUid;
+    while (m_reader.readNextStartElement()) {
+        const QStringRef tag = m_reader.name();
+        if (tag == QLatin1String("UID")) {
+            uid = m_reader.readElementText();
+        } else if (tag == QLatin1String("Name")) {
+            calendar->setName(m_reader.readElementText());
+        } else if (tag == QLatin1String("BaseCalendarUID")) {
+            baseUid = m_reader.readElementText();
+        } else if (tag == QLatin1String("WeekDays")) {
+            readWeekDays(calendar);
+        } else if (tag == QLatin1String("Exceptions")) {
+            readExceptions(calendar);
+        } else {
+            m_reader.skipCurrentElement();
+        }
+    }
+    if (uid.isEmpty() || m_calendars.contains(uid)) {
+        warnMspdiImport<<"Invalid calendar uid:"<<uid;
+        delete calendar;
+        return;
+    }
+    m_calendars.insert(uid, calendar);
+    m_pendingCalendars.append({ calendar, baseUid });
+}
+
+void MspdiReader::addCalendars()
+{
+    // Base calendars are added before the calendars derived from them
+    while (!m_pendingCalendars.isEmpty()) {
+        bool added = false;
+        for (int i = 0; i < m_pendingCalendars.count(); ++i) {
+            const PendingCalendar pending = m_pendingCalendars.at(i);
+            Calendar *parent = m_calendars.value(pending.baseUid);
+            if (parent && !parent->project()) {
+                continue;
+            }
+            m_project.addCalendar(pending.calendar, parent);
+            m_pendingCalendars.remove(i--);
+            added = true;
+        }
+        if (!added) {
+            // cyclic base calendars
+            const PendingCalendar pending = m_pendingCalendars.takeFirst();
+            warnMspdiImport<<"Base calendar not found:"<<pending.calendar->name()<<pending.baseUid;
+            m_project.addCalendar(pending.calendar);
+        }
+    }
+}
+
+void MspdiReader::readWeekDays(Calendar *calendar)
+{
+    while (m_reader.readNextStartElement()) {
+        if (m_reader.name() == QLatin1String("WeekDay")) {
+            readWeekDay(calendar);
+        } else {
+            m_reader.skipCurrentElement();
+        }
+    }
+}
+
+void MspdiReader::readWeekDay(Calendar *calendar)
+{
+    int dayType = -1;
+    bool working = false;
+    QDate from;
+    QDate to;
+    CalendarDay times;
+    while (m_reader.readNextStartElement()) {
+        const QStringRef tag = m_reader.name();
+        if (tag == QLatin1String("DayType")) {
+            dayType = m_reader.readElementText().toInt();
+        } else if (tag == QLatin1String("DayWorking")) {
+            working = isTrue(m_reader.readElementText());
+        } else if (tag == QLatin1String("TimePeriod")) {
+            while (m_reader.readNextStartElement()) {
+                if (m_reader.name() == QLatin1String("FromDate")) {
+                    from = toDateTime(m_reader.readElementText()).date();
+                } else if (m_reader.name() == QLatin1String("ToDate")) {
+                    to = toDateTime(m_reader.readElementText()).date();
+                } else {
+                    m_reader.skipCurrentElement();
+                }
+            }
+        } else if (tag == QLatin1String("WorkingTimes")) {
+            readWorkingTimes(&times);
+        } else {
+            m_reader.skipCurrentElement();
+        }
+    }
+    if (dayType == 0) {
+        // exception in files from older versions of MS Project
+        addDays(calendar, from, to, working, times);
+        return;
+    }
+    if (dayType < 1 || dayType > 7) {
+        warnMspdiImport<<"Invalid day type:"<<dayType;
+        return;
+    }
+    CalendarDay *day = calendar->weekday(toWeekday(dayType));
+    day->setState(working ? CalendarDay::Working : CalendarDay::NonWorking);
+    if (working) {
+        const QList<TimeInterval*> intervals = times.timeIntervals();
+        for (const TimeInterval *ti : intervals) {
+            day->addInterval(TimeInterval(*ti));
+        }
+    }
+}
+
+void MspdiReader::readExceptions(Calendar *calendar)
+{
+    while (m_reader.readNextStartElement()) {
+        if (m_reader.name() == QLatin1String("Exception")) {
+            readException(calendar);
+        } else {
+            m_reader.skipCurrentElement();
+        }
+    }
+}
+
+void MspdiReader::readException(Calendar *calendar)
+{
+    int type = 1;
+    bool working = false;
+    QDate from;
+    QDate to;
+    CalendarDay times;
+    while (m_reader.readNextStartElement()) {
+        const QStringRef tag = m_reader.name();
+        if (tag == QLatin1String("Type")) {
+            type = m_reader.readElementText().toInt();
+        } else if (tag == QLatin1String("DayWorking")) {
+            working = isTrue(m_reader.readElementText());
+        } else if (tag == QLatin1String("TimePeriod")) {
+            while (m_reader.readNextStartElement()) {
+                if (m_reader.name() == QLatin1String("FromDate")) {
+                    from = toDateTime(m_reader.readElementText()).date();
+                } else if (m_reader.name() == QLatin1String("ToDate")) {
+                    to = toDateTime(m_reader.readElementText()).date();
+                } else {
+                    m_reader.skipCurrentElement();
+                }
+            }
+        } else if (tag == QLatin1String("WorkingTimes")) {
+            readWorkingTimes(&times);
+        } else {
+            m_reader.skipCurrentElement();
+        }
+    }
+    if (type != 1) {
+        // Only daily exceptions are supported, other recurrence patterns would need expanding
+        warnMspdiImport<<"Recurring calendar exception not supported:"<<calendar->name()<<type<<from<<to;
+        return;
+    }
+    addDays(calendar, from, to, working, times);
+}
+
+void MspdiReader::addDays(Calendar *calendar, QDate from, QDate to, bool working, const CalendarDay &times)
+{
+    if (!from.isValid() || !to.isValid() || from > to || from.daysTo(to) > s_maxExceptionDays) {
+        warnMspdiImport<<"Invalid calendar exception:"<<calendar->name()<<from<<to;
+        return;
+    }
+    const QList<TimeInterval*> intervals = times.timeIntervals();
+    for (QDate date = from; date <= to; date = date.addDays(1)) {
+        if (calendar->findDay(date)) {
+            continue;
+        }
+        CalendarDay *day = new CalendarDay(date, working ? CalendarDay::Working : CalendarDay::NonWorking);
+        if (working) {
+            for (const TimeInterval *ti : intervals) {
+                day->addInterval(TimeInterval(*ti));
+            }
+        }
+        calendar->addDay(day);
+    }
+}
+
+void MspdiReader::readWorkingTimes(CalendarDay *day)
+{
+    while (m_reader.readNextStartElement()) {
+        if (m_reader.name() != QLatin1String("WorkingTime")) {
+            m_reader.skipCurrentElement();
+            continue;
+        }
+        QTime from;
+        QTime to;
+        while (m_reader.readNextStartElement()) {
+            if (m_reader.name() == QLatin1String("FromTime")) {
+                from = QTime::fromString(m_reader.readElementText(), Qt::ISODate);
+            } else if (m_reader.name() == QLatin1String("ToTime")) {
+                to = QTime::fromString(m_reader.readElementText(), Qt::ISODate);
+            } else {
+                m_reader.skipCurrentElement();
+            }
+        }
+        if (!from.isValid() || !to.isValid()) {
+            continue;
+        }
+        int length = from.msecsTo(to);
+        if (length <= 0) {
+            length += 86400000; // ends at midnight
+        }
+        day->addInterval(TimeInterval(from, length));
+    }
+}
+
+void MspdiReader::readTasks()
+{
+    while (m_reader.readNextStartElement()) {
+        if (m_reader.name() == QLatin1String("Task")) {
+            readTask();
+        } else {
+            m_reader.skipCurrentElement();
+        }
+    }
+}
+
+void MspdiReader::readTask()
+{
+    QString uid;
+    QString name;
+    QString notes;
+    int level = 1;
+    int type = 0;
+    int constraint = 0;
+    DateTime constraintDate;
+    double duration = 0.0;
+    double work = 0.0;
+    bool milestone = false;
+    bool isNull = false;
+    QVector<PendingLink> links;
+    while (m_reader.readNextStartElement()) {
+        const QStringRef tag = m_reader.name();
+        if (tag == QLatin1String("UID")) {
+            uid = m_reader.readElementText();
+        } else if (tag == QLatin1String("Name")) {
+            name = m_reader.readElementText();
+        } else if (tag == QLatin1String("Notes")) {
+            notes = m_reader.readElementText();
+        } else if (tag == QLatin1String("OutlineLevel")) {
+            level = m_reader.readElementText().toInt();
+        } else if (tag == QLatin1String("Type")) {
+            type = m_reader.readElementText().toInt();
+        } else if (tag == QLatin1String("ConstraintType")) {
+            constraint = m_reader.readElementText().toInt();
+        } else if (tag == QLatin1String("ConstraintDate")) {
+            constraintDate = toDateTime(m_reader.readElementText());
+        } else if (tag == QLatin1String("Duration")) {
+            duration = parseDuration(m_reader.readElementText());
+        } else if (tag == QLatin1String("Work")) {
+            work = parseDuration(m_reader.readElementText());
+        } else if (tag == QLatin1String("Milestone")) {
+            milestone = isTrue(m_reader.readElementText());
+        } else if (tag == QLatin1String("IsNull")) {
+            isNull = isTrue(m_reader.readElementText());
+        } else if (tag == QLatin1String("PredecessorLink")) {
+            readPredecessorLink(links);
+        } else {
+            m_reader.skipCurrentElement();
+        }
+    }
+    if (level <= 0 || isNull) {
+        // The project summary task or an empty line
+        return;
+    }
+    if (uid.isEmpty() || m_tasks.contains(uid)) {
+        warnMspdiImport<<"Invalid task uid:"<<uid<<name;
+        return;
+    }
+    Task *task = m_project.createTask();
+    task->setName(name);
+    task->setDescription(notes);
+    const Node::ConstraintType ct = toConstraintType(constraint);
+    task->setConstraint(ct);
+    if (ct == Node::MustStartOn || ct == Node::StartNotEarlier) {
+        task->setConstraintStartTime(constraintDate);
+    } else if (ct == Node::MustFinishOn || ct == Node::FinishNotLater) {
+        task->setConstraintEndTime(constraintDate);
+    }
+    Estimate *estimate = task->estimate();
+    estimate->setUnit(Duration::Unit_h);
+    if (milestone) {
+        estimate->setExpectedEstimate(0.0);
+    } else if (type == 1 || work <= 0.0) {
+        // fixed duration
+        estimate->setType(Estimate::Type_Duration);
+        estimate->setExpectedEstimate(duration / 3600.0);
+        m_durationEstimates.append(estimate);
+    } else {
+        estimate->setType(Estimate::Type_Effort);
+        estimate->setExpectedEstimate(work / 3600.0);
+    }
+    // Tasks are in outline order, the parent is the last task on the level above
+    level = qMin(level, m_parents.count() + 1);
+    Task *parent = level > 1 ? m_parents.at(level - 2) : nullptr;
+    if (!m_project.addSubTask(task, parent)) {
+        delete task;
+        return;
+    }
+    m_parents.resize(level);
+    m_parents[level - 1] = task;
+    m_tasks.insert(uid, task);
+    for (PendingLink &link : links) {
+        link.task = uid;
+        m_links.append(link);
+    }
+}
+
+void MspdiReader::setDurationCalendar(Calendar *calendar)
+{
+    // A duration in MS Project is working time, PT8H is one day with the default settings.
+    // Use the project calendar when there is one, else convert to elapsed time with the hours per day.
+    for (Estimate *estimate : qAsConst(m_durationEstimates)) {
+        if (calendar) {
+            estimate->setCalendar(calendar);
+        } else {
+            estimate->setExpectedEstimate(estimate->expectedEstimate() * 24.0 * 60.0 / m_minutesPerDay);
+        }
+    }
+}
+
+void MspdiReader::readPredecessorLink(QVector<PendingLink> &links)
+{
+    PendingLink link;
+    link.type = 1;
+    link.lag = 0.0;
+    int lagFormat = 7;
+    while (m_reader.readNextStartElement()) {
+        const QStringRef tag = m_reader.name();
+        if (tag == QLatin1String("PredecessorUID")) {
+            link.predecessor = m_reader.readElementText();
+        } else if (tag == QLatin1String("Type")) {
+            link.type = m_reader.readElementText().toInt();
+        } else if (tag == QLatin1String("LinkLag")) {
+            // tenths of minutes
+            link.lag = m_reader.readElementText().toDouble() * 6.0;
+        } else if (tag == QLatin1String("LagFormat")) {
+            lagFormat = m_reader.readElementText().toInt();
+        } else {
+            m_reader.skipCurrentElement();
+        }
+    }
+    if (lagFormat == 19 || lagFormat == 20) {
+        warnMspdiImport<<"Lag in percent not supported";
+        link.lag = 0.0;
+    }
+    links.append(link);
+}
+
+void MspdiReader::addRelations()
+{
+    for (const PendingLink &link : qAsConst(m_links)) {
+        Task *child = m_tasks.value(link.task);
+        Task *parent = m_tasks.value(link.predecessor);
+        if (!child || !parent) {
+            warnMspdiImport<<"Task not found:"<<link.predecessor<<"->"<<link.task;
+            continue;
+        }
+        Relation *relation = new Relation(parent, child, toRelationType(link.type), Duration(link.lag, Duration::Unit_s));
+        if (!m_project.addRelation(relation)) {
+            warnMspdiImport<<"Could not add relation:"<<link.predecessor<<"->"<<link.task;
+            delete relation;
+        }
+    }
+    m_links.clear();
+}
+
+void MspdiReader::readResources()
+{
+    while (m_reader.readNextStartElement()) {
+        if (m_reader.name() == QLatin1String("Resource")) {
+            readResource();
+        } else {
+            m_reader.skipCurrentElement();
+        }
+    }
+}
+
+void MspdiReader::readResource()
+{
+    QString uid;
+    QString name;
+    QString initials;
+    QString email;
+    QString calendar;
+    int type = 1;
+    double units = 1.0;
+    double rate = 0.0;
+    double overtimeRate = 0.0;
+    bool isNull = false;
+    while (m_reader.readNextStartElement()) {
+        const QStringRef tag = m_reader.name();
+        if (tag == QLatin1String("UID")) {
+            uid = m_reader.readElementText();
+        } else if (tag == QLatin1String("Name")) {
+            name = m_reader.readElementText();
+        } else if (tag == QLatin1String("Initials")) {
+            initials = m_reader.readElementText();
+        } else if (tag == QLatin1String("EmailAddress")) {
+            email = m_reader.readElementText();
+        } else if (tag == QLatin1String("Type")) {
+            type = m_reader.readElementText().toInt();
+        } else if (tag == QLatin1String("MaxUnits")) {
+            units = m_reader.readElementText().toDouble();
+        } else if (tag == QLatin1String("StandardRate")) {
+            rate = m_reader.readElementText().toDouble();
+        } else if (tag == QLatin1String("OvertimeRate")) {
+            overtimeRate = m_reader.readElementText().toDouble();
+        } else if (tag == QLatin1String("CalendarUID")) {
+            calendar = m_reader.readElementText();
+        } else if (tag == QLatin1String("IsNull")) {
+            isNull = isTrue(m_reader.readElementText());
+        } else {
+            m_reader.skipCurrentElement();
+        }
+    }
+    if (isNull || (uid == QLatin1String("0") && name.isEmpty())) {
+        // MS Project adds an empty resource
+        return;
+    }
+    if (uid.isEmpty() || m_resources.contains(uid)) {
+        warnMspdiImport<<"Invalid resource uid:"<<uid<<name;
+        return;
+    }
+    Resource *resource = new Resource();
+    resource->setName(name);
+    resource->setInitials(initials);
+    resource->setEmail(email);
+    // 0 = material, 1 = work, 2 = cost
+    resource->setType(type == 1 ? Resource::Type_Work : Resource::Type_Material);
+    resource->setUnits(qRound(units * 100.0));
+    resource->setNormalRate(rate);
+    resource->setOvertimeRate(overtimeRate);
+    resource->setCalendar(m_calendars.value(calendar));
+    m_project.addResource(resource);
+    m_resources.insert(uid, resource);
+}
+
+void MspdiReader::readAssignments()
+{
+    while (m_reader.readNextStartElement()) {
+        if (m_reader.name() == QLatin1String("Assignment")) {
+            readAssignment();
+        } else {
+            m_reader.skipCurrentElement();
+        }
+    }
+}
+
+void MspdiReader::readAssignment()
+{
+    QString taskUid;
+    QString resourceUid;
+    double units = 1.0;
+    while (m_reader.readNextStartElement()) {
+        const QStringRef tag = m_reader.name();
+        if (tag == QLatin1String("TaskUID")) {
+            taskUid = m_reader.readElementText();
+        } else if (tag == QLatin1String("ResourceUID")) {
+            resourceUid = m_reader.readElementText();
+        } else if (tag == QLatin1String("Units")) {
+            units = m_reader.readElementText().toDouble();
+        } else {
+            m_reader.skipCurrentElement();
+        }
+    }
+    Task *task = m_tasks.value(taskUid);
+    Resource *resource = m_resources.value(resourceUid);
+    if (!task || !resource) {
+        // Unassigned tasks refer to a resource that does not exist
+        return;
+    }
+    task->requests().addResourceRequest(new ResourceRequest(resource, qRound(units * 100.0)));
+}
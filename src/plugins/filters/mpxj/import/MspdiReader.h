@@ -0,0 +1,97 @@
+/* This file is part of the KDE project
+ * SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+#ifndef MSPDIREADER_H
+#define MSPDIREADER_H
+
+#include <QDate>
+#include <QHash>
+#include <QString>
+#include <QVector>
+#include <QXmlStreamReader>
+
+class QIODevice;
+
+namespace KPlato
+{
+    class Calendar;
+    class CalendarDay;
+    class DateTime;
+    class Estimate;
+    class Project;
+    class Resource;
+    class Task;
+}
+
+/**
+ * Reads an MS Project xml file (MSPDI) directly into a project.
+ *
+ * The file is read in one pass with QXmlStreamReader.
+ * Calendars, tasks, resources, dependencies and resource assignments are imported.
+ * The schedule and progress are not imported, the project must be scheduled in Plan.
+ *
+ * Objects are matched by their UID in the file, Plan generates its own identities.
+ */
+class MspdiReader
+{
+public:
+    explicit MspdiReader(KPlato::Project &project);
+
+    /// Read the file from @p device into the project, return false on error
+    bool read(QIODevice *device);
+    QString errorString() const;
+
+    /// Parse an xsd:duration, e.g. PT8H0M0S, and return the number of seconds
+    static double parseDuration(const QString &duration, bool *ok = nullptr);
+
+private:
+    struct PendingCalendar {
+        KPlato::Calendar *calendar;
+        QString baseUid;
+    };
+    struct PendingLink {
+        QString task;
+        QString predecessor;
+        int type;
+        double lag; // seconds
+    };
+
+    void readProject();
+    void readCalendars();
+    void readCalendar();
+    void readWeekDays(KPlato::Calendar *calendar);
+    void readWeekDay(KPlato::Calendar *calendar);
+    void readExceptions(KPlato::Calendar *calendar);
+    void readException(KPlato::Calendar *calendar);
+    void readWorkingTimes(KPlato::CalendarDay *day);
+    void addDays(KPlato::Calendar *calendar, QDate from, QDate to, bool working, const KPlato::CalendarDay &times);
+    void addCalendars();
+    void readTasks();
+    void readTask();
+    void readPredecessorLink(QVector<PendingLink> &links);
+    void readResources();
+    void readResource();
+    void readAssignments();
+    void readAssignment();
+    void addRelations();
+    void setDurationCalendar(KPlato::Calendar *calendar);
+
+    KPlato::DateTime toDateTime(const QString &value) const;
+
+    KPlato::Project &m_project;
+    QXmlStreamReader m_reader;
+    QString m_defaultCalendar;
+    int m_minutesPerDay;
+    QHash<QString, KPlato::Calendar*> m_calendars;
+    QVector<PendingCalendar> m_pendingCalendars;
+    QHash<QString, KPlato::Task*> m_tasks;
+    QVector<KPlato::Task*> m_parents; // the current summary task on each outline level
+    QVector<PendingLink> m_links;
+    QVector<KPlato::Estimate*> m_durationEstimates; // durations are in working time
+    QHash<QString, KPlato::Resource*> m_resources;
+};
+
+#endif
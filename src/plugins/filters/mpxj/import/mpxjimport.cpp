@@ -5,6 +5,7 @@
  */
 
 #include "mpxjimport.h"
+#include "MspdiReader.h"
 
 #include <KoFilterChain.h>
 #include <KoFilterManager.h>
@@ -59,6 +60,9 @@ K_PLUGIN_FACTORY_WITH_JSON(MpxjImportFactory, "plan_mpxj_import.json", registerP
  *  Primavera suretrack
  *  Sage 100 Contractor
  *
+ * MS Project xml files (application/x-mspdi) are read natively by MspdiReader,
+ * all other types are converted by planconvert.jar (MPXJ).
+ *
  * Handled in separate import plugin:
  * "PLANNER", Planner        application/x-planner
 */
@@ -116,6 +120,9 @@ KoFilter::ConversionStatus MpxjImport::convert(const QByteArray& from, const QBy
         errorMpxjImport<<"Internal error, no document";
         return KoFilter::InternalError;
     }
+    if (from == "application/x-mspdi") {
+        return doMspdiImport(m_chain->inputFile(), part);
+    }
     QTemporaryFile tmp;
     if (!tmp.open()) {
         errorMpxjImport<<"Temporary plan file has not been created";
@@ -143,6 +150,25 @@ KoFilter::ConversionStatus MpxjImport::convert(const QByteArray& from, const QBy
     return sts;
 }
 
+KoFilter::ConversionStatus MpxjImport::doMspdiImport(const QString &inFile, KoDocument *part)
+{
+    if (!part->project()) {
+        errorMpxjImport<<"Internal error, no project";
+        return KoFilter::InternalError;
+    }
+    QFile file(inFile);
+    if (!file.open(QIODevice::ReadOnly)) {
+        errorMpxjImport<<"Failed to open file:"<<inFile;
+        return KoFilter::FileNotFound;
+    }
+    MspdiReader reader(*part->project());
+    if (!reader.read(&file)) {
+        errorMpxjImport<<"Failed to read file:"<<reader.errorString();
+        return KoFilter::ParsingError;
+    }
+    return KoFilter::OK;
+}
+
 KoFilter::ConversionStatus MpxjImport::doImport(const QString &inFile, const QString &outFile)
 {
     auto normalizedInFile = inFile;
@@ -19,6 +19,8 @@ class QFile;
 class QByteArray;
 class QStringList;
 
+class KoDocument;
+
 
 class MpxjImport : public KoFilter
 {
@@ -33,6 +35,7 @@ public:
 
 protected:
     KoFilter::ConversionStatus doImport( const QString &inFile, const QString &outFile );
+    KoFilter::ConversionStatus doMspdiImport(const QString &inFile, KoDocument *part);
     void run(const QStringList &args);
 
     static const QHash<QString, QString> fileTypeMap();
@@ -0,0 +1,282 @@
+/* This file is part of the KDE project
+   SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+// clazy:excludeall=qstring-arg
+#include "MspdiReaderTester.h"
+
+#include "MspdiReader.h"
+
+#include "kptproject.h"
+#include "kpttask.h"
+#include "kptrelation.h"
+#include "kptresourcerequest.h"
+#include "kptcalendar.h"
+#include "Resource.h"
+
+#include <QBuffer>
+#include <QTest>
+
+
+namespace KPlato
+{
+
+static const char s_header[] =
+    "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
+    "<Project xmlns=\"http://schemas.microsoft.com/project\">\n";
+
+static const char s_calendars[] =
+    "<Calendars>\n"
+    " <Calendar><UID>1</UID><Name>Standard</Name><IsBaseCalendar>1</IsBaseCalendar><BaseCalendarUID>-1</BaseCalendarUID>\n"
+    "  <WeekDays>\n"
+    "   <WeekDay><DayType>1</DayType><DayWorking>0</DayWorking></WeekDay>\n"
+    "   <WeekDay><DayType>2</DayType><DayWorking>1</DayWorking><WorkingTimes>\n"
+    "    <WorkingTime><FromTime>08:00:00</FromTime><ToTime>12:00:00</ToTime></WorkingTime>\n"
+    "    <WorkingTime><FromTime>13:00:00</FromTime><ToTime>17:00:00</ToTime></WorkingTime>\n"
+    "   </WorkingTimes></WeekDay>\n"
+    "   <WeekDay><DayType>7</DayType><DayWorking>0</DayWorking></WeekDay>\n"
+    "  </WeekDays>\n"
+    "  <Exceptions><Exception><Type>1</Type><DayWorking>0</DayWorking>\n"
+    "   <TimePeriod><FromDate>2023-12-25T00:00:00</FromDate><ToDate>2023-12-26T23:59:00</ToDate></TimePeriod>\n"
+    "  </Exception></Exceptions>\n"
+    " </Calendar>\n"
+    "</Calendars>\n";
+
+// A resource calendar defined before its base calendar
+static const char s_resourceCalendar[] =
+    "<Calendars>\n"
+    " <Calendar><UID>2</UID><Name>Resource</Name><BaseCalendarUID>1</BaseCalendarUID></Calendar>\n"
+    " <Calendar><UID>1</UID><Name>Standard</Name><BaseCalendarUID>-1</BaseCalendarUID></Calendar>\n"
+    "</Calendars>\n";
+
+static QByteArray task(int uid, int level, const QString &name, const QString &extra = QString())
+{
+    return QStringLiteral("<Task><UID>%1</UID><ID>%1</ID><Name>%2</Name><OutlineLevel>%3</OutlineLevel>%4</Task>\n")
+        .arg(uid).arg(name).arg(level).arg(extra).toUtf8();
+}
+
+static QByteArray predecessorLink(int predecessor, int type, int lag = 0)
+{
+    return QStringLiteral("<PredecessorLink><PredecessorUID>%1</PredecessorUID><Type>%2</Type><LinkLag>%3</LinkLag><LagFormat>7</LagFormat></PredecessorLink>")
+        .arg(predecessor).arg(type).arg(lag).toUtf8();
+}
+
+// Generate a project with summary tasks of 20 tasks, dependencies and one assignment per task
+static QByteArray generate(int tasks)
+{
+    QByteArray data = s_header;
+    data += "<Name>generated.xml</Name><Title>Generated</Title><StartDate>2023-01-02T08:00:00</StartDate><CalendarUID>1</CalendarUID>\n";
+    data += s_calendars;
+    data += "<Tasks>\n";
+    data += task(0, 0, QStringLiteral("Generated"));
+    int uid = 1;
+    for (int i = 0; i < tasks; ++i) {
+        if (i % 20 == 0) {
+            data += task(uid++, 1, QStringLiteral("Summary %1").arg(i / 20), QStringLiteral("<Summary>1</Summary>"));
+        }
+        QString extra = QStringLiteral("<Type>0</Type><Duration>PT16H0M0S</Duration><Work>PT16H0M0S</Work><Notes>Task number %1</Notes>").arg(i);
+        if (i % 20 > 0) {
+            extra += QString::fromUtf8(predecessorLink(uid - 1, 1, 4800));
+        }
+        if (i % 20 > 1) {
+            extra += QString::fromUtf8(predecessorLink(uid - 2, 3));
+        }
+        data += task(uid++, 2, QStringLiteral("Task %1").arg(i), extra);
+    }
+    data += "</Tasks>\n<Resources>\n<Resource><UID>0</UID><ID>0</ID><Type>1</Type></Resource>\n";
+    for (int i = 1; i <= 10; ++i) {
+        data += QStringLiteral("<Resource><UID>%1</UID><ID>%1</ID><Name>Resource %1</Name><Type>1</Type><MaxUnits>1.00</MaxUnits><StandardRate>100</StandardRate><CalendarUID>1</CalendarUID></Resource>\n").arg(i).toUtf8();
+    }
+    data += "</Resources>\n<Assignments>\n";
+    for (int i = 1; i < uid; ++i) {
+        data += QStringLiteral("<Assignment><UID>%1</UID><TaskUID>%1</TaskUID><ResourceUID>%2</ResourceUID><Units>1</Units></Assignment>\n").arg(i).arg(i % 10 + 1).toUtf8();
+    }
+    data += "</Assignments>\n</Project>\n";
+    return data;
+}
+
+static bool read(const QByteArray &data, Project &project, QString *error = nullptr)
+{
+    QBuffer buffer;
+    buffer.setData(data);
+    buffer.open(QIODevice::ReadOnly);
+    MspdiReader reader(project);
+    const bool result = reader.read(&buffer);
+    if (error) {
+        *error = reader.errorString();
+    }
+    return result;
+}
+
+void MspdiReaderTester::duration()
+{
+    bool ok = false;
+    QCOMPARE(MspdiReader::parseDuration(QStringLiteral("PT8H0M0S"), &ok), 8.0 * 3600);
+    QVERIFY(ok);
+    QCOMPARE(MspdiReader::parseDuration(QStringLiteral("PT0H30M15.5S"), &ok), 30.0 * 60 + 15.5);
+    QVERIFY(ok);
+    QCOMPARE(MspdiReader::parseDuration(QStringLiteral("P2DT1H"), &ok), 2.0 * 86400 + 3600);
+    QVERIFY(ok);
+    QCOMPARE(MspdiReader::parseDuration(QStringLiteral("PT"), &ok), 0.0);
+    QVERIFY(ok);
+
+    MspdiReader::parseDuration(QStringLiteral("8h"), &ok);
+    QVERIFY(!ok);
+    MspdiReader::parseDuration(QStringLiteral("PT8"), &ok);
+    QVERIFY(!ok);
+    MspdiReader::parseDuration(QStringLiteral("P8H"), &ok);
+    QVERIFY(!ok);
+}
+
+void MspdiReaderTester::load()
+{
+    QByteArray data = s_header;
+    data += "<Title>Test</Title><Manager>Manager</Manager><StartDate>2023-01-02T08:00:00</StartDate><CalendarUID>1</CalendarUID>\n";
+    data += s_calendars;
+    data += "<Tasks>\n";
+    data += task(0, 0, QStringLiteral("Project summary"));
+    data += task(1, 1, QStringLiteral("S1"), QStringLiteral("<Summary>1</Summary>"));
+    data += task(2, 2, QStringLiteral("T1"), QStringLiteral("<Type>0</Type><Duration>PT16H0M0S</Duration><Work>PT24H0M0S</Work><ConstraintType>4</ConstraintType><ConstraintDate>2023-01-04T08:00:00</ConstraintDate>"));
+    data += task(3, 2, QStringLiteral("T2"), QStringLiteral("<Type>1</Type><Duration>PT8H0M0S</Duration>") + QString::fromUtf8(predecessorLink(2, 1, 600)));
+    data += task(4, 1, QStringLiteral("M1"), QStringLiteral("<Milestone>1</Milestone>") + QString::fromUtf8(predecessorLink(3, 3)) + QString::fromUtf8(predecessorLink(99, 1)));
+    data += "</Tasks>\n<Resources>\n";
+    data += "<Resource><UID>0</UID><ID>0</ID><Type>1</Type></Resource>\n";
+    data += "<Resource><UID>1</UID><Name>R1</Name><Type>1</Type><MaxUnits>0.50</MaxUnits><StandardRate>10</StandardRate><CalendarUID>1</CalendarUID></Resource>\n";
+    data += "<Resource><UID>2</UID><Name>Material</Name><Type>0</Type></Resource>\n";
+    data += "</Resources>\n<Assignments>\n";
+    data += "<Assignment><UID>1</UID><TaskUID>2</TaskUID><ResourceUID>1</ResourceUID><Units>0.5</Units></Assignment>\n";
+    data += "<Assignment><UID>2</UID><TaskUID>3</TaskUID><ResourceUID>-65535</ResourceUID><Units>1</Units></Assignment>\n";
+    data += "</Assignments>\n</Project>\n";
+
+    Project project;
+    QString error;
+    QVERIFY2(read(data, project, &error), qPrintable(error));
+
+    QCOMPARE(project.name(), QStringLiteral("Test"));
+    QCOMPARE(project.leader(), QStringLiteral("Manager"));
+
+    Calendar *calendar = project.defaultCalendar();
+    QVERIFY(calendar);
+    QCOMPARE(calendar->name(), QStringLiteral("Standard"));
+    QCOMPARE(calendar->weekday(1)->state(), (int)CalendarDay::Working);
+    QCOMPARE(calendar->weekday(1)->numIntervals(), 2);
+    QCOMPARE(calendar->weekday(6)->state(), (int)CalendarDay::NonWorking);
+    QCOMPARE(calendar->weekday(7)->state(), (int)CalendarDay::NonWorking);
+    QVERIFY(calendar->findDay(QDate(2023, 12, 25)));
+    QVERIFY(calendar->findDay(QDate(2023, 12, 26)));
+    QVERIFY(!calendar->findDay(QDate(2023, 12, 27)));
+
+    QCOMPARE(project.numChildren(), 2);
+    Node *s1 = project.childNode(0);
+    QCOMPARE(s1->name(), QStringLiteral("S1"));
+    QCOMPARE(s1->type(), (int)Node::Type_Summarytask);
+    QCOMPARE(s1->numChildren(), 2);
+    Task *t1 = static_cast<Task*>(s1->childNode(0));
+    QCOMPARE(t1->name(), QStringLiteral("T1"));
+    QCOMPARE(t1->estimate()->type(), Estimate::Type_Effort);
+    QCOMPARE(t1->estimate()->expectedValue(), Duration(24.0, Duration::Unit_h));
+    QCOMPARE(t1->constraint(), (int)Node::StartNotEarlier);
+    QCOMPARE(t1->constraintStartTime(), DateTime(QDate(2023, 1, 4), QTime(8, 0), project.timeZone()));
+    Task *t2 = static_cast<Task*>(s1->childNode(1));
+    QCOMPARE(t2->estimate()->type(), Estimate::Type_Duration);
+    QCOMPARE(t2->estimate()->expectedValue(), Duration(8.0, Duration::Unit_h));
+    // the duration is working time in the project calendar
+    QCOMPARE(t2->estimate()->calendar(), calendar);
+    Node *m1 = project.childNode(1);
+    QCOMPARE(m1->type(), (int)Node::Type_Milestone);
+
+    QCOMPARE(t2->numDependParentNodes(), 1);
+    Relation *relation = t2->dependParentNodes().first();
+    QCOMPARE(relation->parent(), t1);
+    QCOMPARE(relation->type(), Relation::FinishStart);
+    QCOMPARE(relation->lag(), Duration(1.0, Duration::Unit_h));
+    // the link to a missing task is ignored
+    QCOMPARE(m1->numDependParentNodes(), 1);
+    QCOMPARE(m1->dependParentNodes().first()->type(), Relation::StartStart);
+
+    // the empty resource is not imported
+    QCOMPARE(project.resourceList().count(), 2);
+    Resource *r1 = project.resourceList().at(0);
+    QCOMPARE(r1->name(), QStringLiteral("R1"));
+    QCOMPARE(r1->type(), Resource::Type_Work);
+    QCOMPARE(r1->units(), 50);
+    QCOMPARE(r1->calendar(true), calendar);
+    QCOMPARE(project.resourceList().at(1)->type(), Resource::Type_Material);
+
+    QCOMPARE(t1->requests().resourceRequests().count(), 1);
+    QCOMPARE(t1->requests().resourceRequests().first()->resource(), r1);
+    QCOMPARE(t1->requests().resourceRequests().first()->units(), 50);
+    QVERIFY(t2->requests().isEmpty());
+}
+
+void MspdiReaderTester::durationWithoutCalendar()
+{
+    // Without a calendar the working time is converted with the hours per day
+    QByteArray data = s_header;
+    data += "<Title>Test</Title><MinutesPerDay>420</MinutesPerDay>\n<Tasks>\n";
+    data += task(1, 1, QStringLiteral("T1"), QStringLiteral("<Type>1</Type><Duration>PT14H0M0S</Duration>"));
+    data += task(2, 1, QStringLiteral("T2"), QStringLiteral("<Type>0</Type><Duration>PT7H0M0S</Duration><Work>PT0H0M0S</Work>"));
+    data += "</Tasks>\n</Project>\n";
+
+    Project project;
+    QVERIFY(read(data, project));
+    QCOMPARE(project.numChildren(), 2);
+    Task *t1 = static_cast<Task*>(project.childNode(0));
+    QCOMPARE(t1->estimate()->type(), Estimate::Type_Duration);
+    QVERIFY(!t1->estimate()->calendar());
+    QCOMPARE(t1->estimate()->expectedValue(), Duration(48.0, Duration::Unit_h));
+    Task *t2 = static_cast<Task*>(project.childNode(1));
+    QCOMPARE(t2->estimate()->type(), Estimate::Type_Duration);
+    QCOMPARE(t2->estimate()->expectedValue(), Duration(24.0, Duration::Unit_h));
+}
+
+void MspdiReaderTester::invalidFile()
+{
+    Project project;
+    QVERIFY(!read(QByteArray(), project));
+    QVERIFY(!read(QByteArray("<project xmlns=\"http://planner.imendio.org/\"/>"), project));
+
+    QByteArray data = s_header;
+    data += "<Tasks>\n";
+    data += task(1, 1, QStringLiteral("T1"));
+    data += "</Project>\n";
+    QVERIFY(!read(data, project));
+
+    // base calendars are added first
+    Project project2;
+    data = s_header;
+    data += s_resourceCalendar;
+    data += "</Project>\n";
+    QVERIFY(read(data, project2));
+    QCOMPARE(project2.calendars().count(), 1);
+    QCOMPARE(project2.calendars().first()->name(), QStringLiteral("Standard"));
+    QCOMPARE(project2.calendars().first()->childCount(), 1);
+}
+
+void MspdiReaderTester::benchmarkLoad_data()
+{
+    QTest::addColumn<int>("tasks");
+
+    QTest::newRow("1000 tasks") << 1000;
+    QTest::newRow("10000 tasks") << 10000;
+}
+
+void MspdiReaderTester::benchmarkLoad()
+{
+    QFETCH(int, tasks);
+
+    const QByteArray data = generate(tasks);
+    int loaded = 0;
+    QBENCHMARK {
+        Project project;
+        QVERIFY(read(data, project));
+        loaded = project.allTasks().count();
+    }
+    QCOMPARE(loaded, tasks + (tasks + 19) / 20);
+}
+
+} //namespace KPlato
+
+QTEST_GUILESS_MAIN(KPlato::MspdiReaderTester)
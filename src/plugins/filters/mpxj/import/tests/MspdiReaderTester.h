@@ -0,0 +1,29 @@
+/* This file is part of the KDE project
+   SPDX-FileCopyrightText: 2026 agent <agent@local>
+   
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KPlato_MspdiReaderTester_h
+#define KPlato_MspdiReaderTester_h
+
+#include <QObject>
+
+namespace KPlato
+{
+
+class MspdiReaderTester : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void duration();
+    void load();
+    void durationWithoutCalendar();
+    void invalidFile();
+    void benchmarkLoad_data();
+    void benchmarkLoad();
+};
+
+} //namespace KPlato
+
+#endif
@@ -153,11 +153,15 @@ void PlanTJPlugin::slotFinished(SchedulerThread *j)
 void PlanTJPlugin::schedule(SchedulingContext &context)
 {
     PlanTJScheduler *job = new PlanTJScheduler(currentGranularity());
+    m_jobsMutex.lock();
     m_jobs << job;
+    m_jobsMutex.unlock();
     connect(job, &PlanTJScheduler::progressChanged, this, &PlanTJPlugin::progressChanged);
     context.scheduleInParallel = scheduleInParallel();
     job->schedule(context);
+    m_jobsMutex.lock();
     m_jobs.clear();
+    m_jobsMutex.unlock();
     delete job;
 }
 
@@ -347,31 +347,44 @@ int PlanTJScheduler::toTJDayOfWeek(int day)
 
 // static
 DateTime PlanTJScheduler::fromTime_t(time_t t, const QTimeZone &tz) {
-    return DateTime (QDateTime::fromTime_t(t).toTimeZone(tz));
+    return DateTime(QDateTime::fromMSecsSinceEpoch(qint64(t) * 1000, tz));
 }
 
-time_t PlanTJScheduler::toTJTime_t(const QDateTime &dt, ulong granularity)
+// Round the local time of @p date, @p time down to @p granularity seconds
+static time_t roundedTJTime(const TimeZoneOffsets &tz, QDate date, QTime time, ulong granularity)
 {
-    int secs = QTime(0, 0, 0).secsTo(dt.time());
+    int secs = QTime(0, 0, 0).secsTo(time);
     secs -= secs % granularity;
-    return QDateTime(dt.date(), QTime(0, 0, 0).addSecs(secs), dt.timeZone()).toTime_t();
+    return tz.fromLocal(date, QTime(0, 0, 0).addSecs(secs)).toMSecsSinceEpoch() / 1000;
+}
+
+time_t PlanTJScheduler::toTJTime_t(const QDateTime &dt, ulong granularity)
+{
+    return roundedTJTime(TimeZoneOffsets::forTimeZone(dt.timeZone()), dt.date(), dt.time(), granularity);
 }
 
 // static
-AppointmentInterval PlanTJScheduler::fromTJInterval(const TJ::Interval &tji, const QTimeZone &tz) {
-    AppointmentInterval a(fromTime_t(tji.getStart(), tz), fromTime_t(tji.getEnd(), tz).addSecs(1));
+time_t PlanTJScheduler::toTJTime_t(const TimeZoneOffsets &tz, TimePoint time, ulong granularity)
+{
+    return roundedTJTime(tz, tz.localDate(time), tz.localTime(time), granularity);
+}
+
+// The tj interval ends at the last second of the interval
+AppointmentInterval PlanTJScheduler::fromTJInterval(const TJ::Interval &tji, const TimeZoneOffsets &tz) {
+    AppointmentInterval a(tz, TimePoint(qint64(tji.getStart()) * 1000), TimePoint((qint64(tji.getEnd()) + 1) * 1000));
     return a;
 }
 
 // static
 TJ::Interval PlanTJScheduler::toTJInterval(const QDateTime &start, const QDateTime &end, ulong granularity) {
-    int secs = QTime(0, 0, 0).secsTo(start.time());
-    secs -= secs % granularity;
-    QDateTime s(start.date(), QTime(0, 0, 0).addSecs(secs), start.timeZone());
-    secs = QTime(0, 0, 0).secsTo(end.time());
-    secs -= secs % granularity;
-    QDateTime e(end.date(), QTime(0, 0, 0).addSecs(secs), end.timeZone());
-    TJ::Interval ti(s.toTime_t(), e.addSecs(-1).toTime_t());
+    TJ::Interval ti(toTJTime_t(start, granularity), toTJTime_t(end, granularity) - 1);
+    return ti;
+}
+
+// static
+TJ::Interval PlanTJScheduler::toTJInterval(const AppointmentInterval &interval, ulong granularity) {
+    const TimeZoneOffsets &tz = interval.timeZoneOffsets();
+    TJ::Interval ti(toTJTime_t(tz, interval.start(), granularity), toTJTime_t(tz, interval.end(), granularity) - 1);
     return ti;
 }
 
@@ -418,9 +431,10 @@ bool PlanTJScheduler::kplatoFromTJ()
 
     m_project->calcCriticalPathList(m_schedule);
     // calculate positive float
+    QHash<Node*, Duration> floats;
     for (Node* t : qAsConst(m_taskmap)) {
         if (! t->inCriticalPath() && t->isStartNode()) {
-            calcPositiveFloat(t);
+            calcPositiveFloat(t, floats);
         }
     }
 
@@ -486,6 +500,7 @@ bool PlanTJScheduler::taskFromTJ(Project *project, TJ::Task *job, Node *task)
     if (task->endTime() > project->endTime()) {
         project->setEndTime(task->endTime());
     }
+    const TimeZoneOffsets offsets = TimeZoneOffsets::forTimeZone(tz);
     const auto lst = job->getBookedResources(0);
     for (TJ::CoreAttributes *a : lst) {
         TJ::Resource *r = static_cast<TJ::Resource*>(a);
@@ -493,9 +508,9 @@ bool PlanTJScheduler::taskFromTJ(Project *project, TJ::Task *job, Node *task)
         Q_ASSERT(res);
         const QVector<TJ::Interval> lst = r->getBookedIntervals(0, job);
         for (const TJ::Interval &tji : lst) {
-            AppointmentInterval ai = fromTJInterval(tji, tz);
-            double load = res->type() == Resource::Type_Material ? res->units() : ai.load() * r->getEfficiency();
-            res->addAppointment(cs, ai.startTime(), ai.endTime(), load);
+            AppointmentInterval ai = fromTJInterval(tji, offsets);
+            ai.setLoad(res->type() == Resource::Type_Material ? res->units() : ai.load() * r->getEfficiency());
+            res->addAppointment(cs, ai);
             logDebug(task, nullptr, '\'' + res->name() + "' added appointment: " +  ai.startTime().toString(Qt::ISODate) + " - " + ai.endTime().toString(Qt::ISODate));
         }
     }
@@ -551,8 +566,13 @@ void PlanTJScheduler::adjustSummaryTasks(const QList<Node*> &nodes)
     }
 }
 
-Duration PlanTJScheduler::calcPositiveFloat(Node *task)
+Duration PlanTJScheduler::calcPositiveFloat(Node *task, QHash<Node*, Duration> &floats)
 {
+    // Each task is calculated once, else shared successors are walked once per path
+    QHash<Node*, Duration>::const_iterator it = floats.constFind(task);
+    if (it != floats.constEnd()) {
+        return it.value();
+    }
     if (static_cast<Task*>(task)->positiveFloat() != 0) {
         return static_cast<Task*>(task)->positiveFloat();
     }
@@ -563,7 +583,7 @@ Duration PlanTJScheduler::calcPositiveFloat(Node *task)
         const auto lst = task->dependChildNodes() + static_cast<Task*>(task)->childProxyRelations();
         for (const Relation *r : lst) {
             if (! r->child()->inCriticalPath()) {
-                Duration f = calcPositiveFloat(static_cast<Task*>(r->child()));
+                Duration f = calcPositiveFloat(static_cast<Task*>(r->child()), floats);
                 if (x == 0 || f < x) {
                     x = f;
                 }
@@ -572,6 +592,7 @@ Duration PlanTJScheduler::calcPositiveFloat(Node *task)
     }
     Duration totfloat = static_cast<Task*>(task)->freeFloat() + x;
     static_cast<Task*>(task)->setPositiveFloat(totfloat);
+    floats.insert(task, totfloat);
     return totfloat;
 }
 
@@ -687,7 +708,7 @@ TJ::Resource *PlanTJScheduler::addResource(KPlato::Resource *r)
     QMultiMap<QDate, AppointmentInterval>::const_iterator it = map.constBegin();
     TJ::Shift *shift = new TJ::Shift(m_tjProject, resource->id(), resource->name(), nullptr, QString(), 0);
     for (; it != mapend; ++it) {
-        shift->addWorkingInterval(toTJInterval(it.value().startTime(), it.value().endTime(), m_granularity/1000));
+        shift->addWorkingInterval(toTJInterval(it.value(), m_granularity/1000));
     }
     res->addShift(toTJInterval(start, end, m_granularity/1000), shift);
     m_resourcemap[res] = resource;
@@ -739,7 +760,7 @@ void PlanTJScheduler::addWorkingTime(const KPlato::Task *task, TJ::Task *job)
     QMultiMap<QDate, AppointmentInterval>::const_iterator it = map.constBegin();
     TJ::Shift *shift = new TJ::Shift(m_tjProject, task->id() + QString("-%1").arg(++id), task->name(), nullptr, QString(), 0);
     for (; it != mapend; ++it) {
-        shift->addWorkingInterval(toTJInterval(it.value().startTime(), it.value().endTime(), m_granularity/1000));
+        shift->addWorkingInterval(toTJInterval(it.value(), m_granularity/1000));
     }
     job->addShift(toTJInterval(start, end, m_granularity/1000), shift);
 }
@@ -1093,10 +1114,6 @@ void PlanTJScheduler::schedule(SchedulingContext &context)
     } else {
         logInfo(m_project, nullptr, i18n("Scheduling finished at %1, elapsed time: %2 seconds", QDateTime::currentDateTime().toString(Qt::ISODate), (double)timer.elapsed()/1000));
         context.log = takeLog();
-        QMultiMap<int, KoDocument*>::const_iterator it = context.projects.constBegin();
-        for (; it != context.projects.constEnd(); ++it) {
-            it.value()->setModified(true);
-        }
     }
     m_project = nullptr; // or else it is deleted
 }
@@ -1235,7 +1252,7 @@ void PlanTJScheduler::insertBookings(KPlato::SchedulingContext &context)
         const QMultiMap<QDate, AppointmentInterval> map = ait.value().intervals().map();
         QMultiMap<QDate, AppointmentInterval>::const_iterator it;
         for (it = map.constBegin(); it != map.constEnd(); ++it) {
-            TJ::Interval interval = toTJInterval(it.value().startTime(), it.value().endTime(), m_granularity / 1000);
+            TJ::Interval interval = toTJInterval(it.value(), m_granularity / 1000);
             ait.key()->bookInterval(0, interval, 3 /*undefined*/);
             if (it.value().load() < r->units()) {
                 logWarning(m_project, r, i18n("Appointment with load (%1) less than available resource units (%2) not supported").arg(it.value().load(), r->units()));
@@ -18,6 +18,7 @@
 #include <QThread>
 #include <QObject>
 #include <QMap>
+#include <QHash>
 #include <QList>
 
 class QDateTime;
@@ -100,7 +101,7 @@ protected:
     bool taskFromTJ(TJ::Task *job, Node *task);
     bool taskFromTJ(Project *project, TJ::Task *job, Node *task);
     void calcPertValues(Node *task);
-    Duration calcPositiveFloat(Node *task);
+    Duration calcPositiveFloat(Node *task, QHash<Node*, Duration> &floats);
     Resource *resource(Project *project, TJ::Resource *tjResource);
 
     void populateProjects(KPlato::SchedulingContext &context);
@@ -109,8 +110,10 @@ protected:
     static int toTJDayOfWeek(int day);
     static DateTime fromTime_t(time_t, const QTimeZone &tz);
     static time_t toTJTime_t(const QDateTime &dt, ulong granularity);
-    AppointmentInterval fromTJInterval(const TJ::Interval &tji, const QTimeZone &tz);
+    static time_t toTJTime_t(const TimeZoneOffsets &tz, TimePoint time, ulong granularity);
+    AppointmentInterval fromTJInterval(const TJ::Interval &tji, const TimeZoneOffsets &tz);
     static TJ::Interval toTJInterval(const QDateTime &start, const QDateTime &end, ulong tjGranularity);
+    static TJ::Interval toTJInterval(const AppointmentInterval &interval, ulong tjGranularity);
     static TJ::Interval toTJInterval(const QTime &start, const QTime &end, ulong tjGranularity);
     
 private:
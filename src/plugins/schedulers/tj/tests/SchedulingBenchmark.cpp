@@ -0,0 +1,277 @@
+/* This file is part of the KDE project
+ * SPDX-FileCopyrightText: 2026 agent <agent@local>
+ *
+ * SPDX-License-Identifier: LGPL-2.0-or-later
+ */
+
+// clazy:excludeall=qstring-arg
+
+/*
+ * Measures how the built-in scheduler and the TJ scheduler scale on
+ * projects generated by ProjectGenerator.
+ *
+ * Each run prints one JSON object per line (or one CSV row) with wall time
+ * per phase and peak memory, e.g.:
+ *   PlanSchedulingBenchmark --tasks 1000,5000 --density 2 --resources 50 --scheduler all
+ *
+ * Phases:
+ *   clone    save the project and load it into the scheduler's private copy
+ *   <name>   the phases registered by the scheduler (e.g. Init, Schedule)
+ *   update   update the original project with the result
+ */
+
+#include "PlanTJScheduler.h"
+#include "kptbuiltinschedulerplugin.h"
+
+#include "kptproject.h"
+#include "kptschedule.h"
+
+#include "tests/ProjectGenerator.h"
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTextStream>
+
+using namespace KPlato;
+
+namespace {
+
+/// Reset the peak resident set size, returns false if not supported
+bool resetPeakMemory()
+{
+#ifdef Q_OS_LINUX
+    QFile file(QStringLiteral("/proc/self/clear_refs"));
+    if (file.open(QIODevice::WriteOnly)) {
+        return file.write("5") == 1;
+    }
+#endif
+    return false;
+}
+
+/// Return the peak resident set size in kB, or -1 if not known
+qint64 peakMemory()
+{
+#ifdef Q_OS_LINUX
+    QFile file(QStringLiteral("/proc/self/status"));
+    if (file.open(QIODevice::ReadOnly)) {
+        const QList<QByteArray> lines = file.readAll().split('\n');
+        for (const QByteArray &line : lines) {
+            if (line.startsWith("VmHWM:")) {
+                return line.mid(6).trimmed().split(' ').value(0).toLongLong();
+            }
+        }
+    }
+#endif
+    return -1;
+}
+
+SchedulerThread *createScheduler(const QString &name, Project *project, ScheduleManager *sm, ulong granularity)
+{
+    if (name == QStringLiteral("tj")) {
+        return new PlanTJScheduler(project, sm, granularity);
+    }
+    return new KPlatoScheduler(project, sm, granularity);
+}
+
+QJsonObject run(const QString &schedulerName, const ProjectGenerator::Parameters &parameters, int iteration)
+{
+    QJsonObject result;
+    result.insert(QStringLiteral("scheduler"), schedulerName);
+    result.insert(QStringLiteral("iteration"), iteration);
+    result.insert(QStringLiteral("tasks"), parameters.tasks);
+    result.insert(QStringLiteral("summarySize"), parameters.summarySize);
+    result.insert(QStringLiteral("density"), parameters.dependencyDensity);
+    result.insert(QStringLiteral("resources"), parameters.resources);
+    result.insert(QStringLiteral("calendars"), parameters.calendars);
+    result.insert(QStringLiteral("intervalsPerDay"), parameters.intervalsPerDay);
+    result.insert(QStringLiteral("exceptionsPerMonth"), parameters.exceptionsPerMonth);
+    result.insert(QStringLiteral("horizon"), parameters.horizon);
+    result.insert(QStringLiteral("granularity"), static_cast<qint64>(parameters.granularity));
+    result.insert(QStringLiteral("seed"), static_cast<qint64>(parameters.seed));
+
+    QElapsedTimer timer;
+    timer.start();
+    Project *project = ProjectGenerator(parameters).generate();
+    ScheduleManager *sm = ProjectGenerator::scheduleManager(project);
+    result.insert(QStringLiteral("generate"), timer.elapsed());
+
+    const bool peakReset = resetPeakMemory();
+    QJsonObject phases;
+
+    timer.restart();
+    SchedulerThread *scheduler = createScheduler(schedulerName, project, sm, parameters.granularity);
+    qint64 clone = timer.elapsed();
+
+    // phase start times are on the same monotonic clock
+    timer.restart();
+    const qint64 runStart = timer.msecsSinceReference();
+    scheduler->doRun();
+    const qint64 runEnd = runStart + timer.elapsed();
+
+    ScheduleManager *tm = scheduler->manager();
+    MainSchedule *ts = tm ? tm->expected() : nullptr;
+    if (ts) {
+        const QMap<int, QString> names = ts->phaseNames();
+        qint64 start = runEnd;
+        for (QMap<int, QString>::const_iterator it = names.constEnd(); it != names.constBegin();) {
+            --it;
+            const qint64 phaseStart = ts->phaseStartTime(it.key());
+            if (phaseStart < 0) {
+                continue;
+            }
+            phases.insert(it.value(), start - phaseStart);
+            start = phaseStart;
+        }
+        // time spent loading the private copy before the first phase
+        clone += start - runStart;
+    } else {
+        phases.insert(QStringLiteral("run"), runEnd - runStart);
+    }
+    phases.insert(QStringLiteral("clone"), clone);
+
+    timer.restart();
+    if (tm && scheduler->project()) {
+        SchedulerThread::updateProject(scheduler->project(), tm, project, sm);
+    }
+    const qint64 update = timer.elapsed();
+    phases.insert(QStringLiteral("update"), update);
+
+    qint64 total = 0;
+    for (auto it = phases.constBegin(); it != phases.constEnd(); ++it) {
+        total += static_cast<qint64>(it.value().toDouble());
+    }
+    result.insert(QStringLiteral("phases"), phases);
+    result.insert(QStringLiteral("total"), total);
+    result.insert(QStringLiteral("result"), sm->calculationResult());
+    result.insert(QStringLiteral("peakMemoryKb"), peakMemory());
+    result.insert(QStringLiteral("peakMemoryIsPerRun"), peakReset);
+
+    delete scheduler;
+    delete project;
+    return result;
+}
+
+QList<int> intList(const QString &value)
+{
+    QList<int> lst;
+    const QStringList values = value.split(QLatin1Char(','), Qt::SkipEmptyParts);
+    for (const QString &v : values) {
+        lst << v.toInt();
+    }
+    return lst;
+}
+
+QList<double> doubleList(const QString &value)
+{
+    QList<double> lst;
+    const QStringList values = value.split(QLatin1Char(','), Qt::SkipEmptyParts);
+    for (const QString &v : values) {
+        lst << v.toDouble();
+    }
+    return lst;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName(QStringLiteral("PlanSchedulingBenchmark"));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Benchmark the Plan schedulers on generated projects. Comma separated values give one run per combination."));
+    parser.addHelpOption();
+    const QCommandLineOption schedulerOption(QStringLiteral("scheduler"), QStringLiteral("builtin, tj or all"), QStringLiteral("name"), QStringLiteral("all"));
+    const QCommandLineOption tasksOption(QStringLiteral("tasks"), QStringLiteral("Number of tasks"), QStringLiteral("n"), QStringLiteral("100,1000"));
+    const QCommandLineOption summaryOption(QStringLiteral("summary-size"), QStringLiteral("Tasks per summary task, 0 = flat"), QStringLiteral("n"), QStringLiteral("20"));
+    const QCommandLineOption densityOption(QStringLiteral("density"), QStringLiteral("Average predecessors per task"), QStringLiteral("d"), QStringLiteral("1.5"));
+    const QCommandLineOption resourcesOption(QStringLiteral("resources"), QStringLiteral("Number of resources"), QStringLiteral("n"), QStringLiteral("10"));
+    const QCommandLineOption calendarsOption(QStringLiteral("calendars"), QStringLiteral("Number of calendars"), QStringLiteral("n"), QStringLiteral("1"));
+    const QCommandLineOption intervalsOption(QStringLiteral("intervals"), QStringLiteral("Work intervals per day"), QStringLiteral("n"), QStringLiteral("1"));
+    const QCommandLineOption exceptionsOption(QStringLiteral("exceptions"), QStringLiteral("Non-working days per calendar and month"), QStringLiteral("n"), QStringLiteral("0"));
+    const QCommandLineOption horizonOption(QStringLiteral("horizon"), QStringLiteral("Project length in days"), QStringLiteral("days"), QStringLiteral("365"));
+    const QCommandLineOption granularityOption(QStringLiteral("granularity"), QStringLiteral("Scheduling granularity in minutes"), QStringLiteral("minutes"), QStringLiteral("60"));
+    const QCommandLineOption seedOption(QStringLiteral("seed"), QStringLiteral("Random seed"), QStringLiteral("n"), QStringLiteral("1"));
+    const QCommandLineOption runsOption(QStringLiteral("runs"), QStringLiteral("Runs per combination"), QStringLiteral("n"), QStringLiteral("1"));
+    const QCommandLineOption csvOption(QStringLiteral("csv"), QStringLiteral("Output CSV instead of JSON lines"));
+    parser.addOptions({ schedulerOption, tasksOption, summaryOption, densityOption, resourcesOption, calendarsOption, intervalsOption,
+                        exceptionsOption, horizonOption, granularityOption, seedOption, runsOption, csvOption });
+    parser.process(app);
+
+    QStringList schedulers;
+    const QString s = parser.value(schedulerOption);
+    if (s == QStringLiteral("all")) {
+        schedulers << QStringLiteral("builtin") << QStringLiteral("tj");
+    } else {
+        schedulers = s.split(QLatin1Char(','), Qt::SkipEmptyParts);
+    }
+    const int runs = qMax(1, parser.value(runsOption).toInt());
+    const bool csv = parser.isSet(csvOption);
+
+    QTextStream out(stdout);
+    bool header = csv;
+    const QStringList columns = QStringList() << QStringLiteral("scheduler") << QStringLiteral("iteration") << QStringLiteral("tasks")
+        << QStringLiteral("summarySize") << QStringLiteral("density") << QStringLiteral("resources") << QStringLiteral("calendars")
+        << QStringLiteral("intervalsPerDay") << QStringLiteral("exceptionsPerMonth") << QStringLiteral("horizon") << QStringLiteral("granularity")
+        << QStringLiteral("seed") << QStringLiteral("generate") << QStringLiteral("total") << QStringLiteral("result")
+        << QStringLiteral("peakMemoryKb") << QStringLiteral("peakMemoryIsPerRun");
+
+    ProjectGenerator::Parameters parameters;
+    parameters.summarySize = parser.value(summaryOption).toInt();
+    parameters.calendars = parser.value(calendarsOption).toInt();
+    parameters.intervalsPerDay = parser.value(intervalsOption).toInt();
+    parameters.exceptionsPerMonth = parser.value(exceptionsOption).toInt();
+    parameters.seed = parser.value(seedOption).toUInt();
+    const QList<int> taskCounts = intList(parser.value(tasksOption));
+    const QList<double> densities = doubleList(parser.value(densityOption));
+    const QList<int> resourceCounts = intList(parser.value(resourcesOption));
+    const QList<int> horizons = intList(parser.value(horizonOption));
+    const QList<int> granularities = intList(parser.value(granularityOption));
+
+    for (int tasks : taskCounts) {
+        for (double density : densities) {
+            for (int resources : resourceCounts) {
+                for (int horizon : horizons) {
+                    for (int granularity : granularities) {
+                        parameters.tasks = tasks;
+                        parameters.dependencyDensity = density;
+                        parameters.resources = resources;
+                        parameters.horizon = horizon;
+                        parameters.granularity = static_cast<ulong>(granularity) * 60 * 1000;
+                        for (const QString &scheduler : qAsConst(schedulers)) {
+                            for (int i = 0; i < runs; ++i) {
+                                const QJsonObject result = run(scheduler, parameters, i);
+                                if (!csv) {
+                                    out << QJsonDocument(result).toJson(QJsonDocument::Compact) << '\n';
+                                    out.flush();
+                                    continue;
+                                }
+                                const QJsonObject phases = result.value(QStringLiteral("phases")).toObject();
+                                if (header) {
+                                    out << columns.join(QLatin1Char(',')) << ",phases\n";
+                                    header = false;
+                                }
+                                QStringList row;
+                                for (const QString &c : columns) {
+                                    row << result.value(c).toVariant().toString();
+                                }
+                                QStringList phaseList;
+                                for (auto it = phases.constBegin(); it != phases.constEnd(); ++it) {
+                                    phaseList << QStringLiteral("%1=%2").arg(it.key()).arg(static_cast<qint64>(it.value().toDouble()));
+                                }
+                                row << phaseList.join(QLatin1Char(';'));
+                                out << row.join(QLatin1Char(',')) << '\n';
+                                out.flush();
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return 0;
+}
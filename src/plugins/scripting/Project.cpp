@@ -23,7 +23,9 @@
 #include "kptresource.h"
 #include "kptcommand.h"
 
+#include <QDateTime>
 #include <QMetaEnum>
+#include <QVector>
 
 
 Scripting::Project::Project(Scripting::Module* module, KPlato::Project *project)
@@ -35,10 +37,12 @@ Scripting::Project::Project(Scripting::Module* module, KPlato::Project *project)
     m_nodeModel.setReadWrite(true);
     m_nodeModel.setReadOnly(NodeModel::NodeDescription, false);
     connect(&m_nodeModel, SIGNAL(executeCommand(KUndo2Command*)), SLOT(slotAddCommand(KUndo2Command*)));
+    m_nodeTableModel.setProject(project);
 
     m_resourceModel.setProject(project);
     m_resourceModel.setReadWrite(true);
     connect(&m_resourceModel, SIGNAL(executeCommand(KUndo2Command*)), SLOT(slotAddCommand(KUndo2Command*)));
+    m_resourceTableModel.setProject(project);
 
     m_accountModel.setProject(project);
     m_accountModel.setReadWrite(true);
@@ -181,6 +185,131 @@ QVariant Scripting::Project::setData(QObject* object, const QString& property, c
     return "Invalid";
 }
 
+static void addNodes(QList<const KPlato::Node*> &nodes, const KPlato::Node *node)
+{
+    nodes << node;
+    for (const KPlato::Node *n : node->childNodeIterator()) {
+        addNodes(nodes, n);
+    }
+}
+
+QVariantList Scripting::Project::taskTable(const QVariantList &tasks, const QStringList &properties, const QString &role, qlonglong scheduleId)
+{
+    QList<const KPlato::Node*> nodes;
+    if (tasks.isEmpty()) {
+        addNodes(nodes, kplatoProject());
+    } else {
+        for (const QVariant &v : tasks) {
+            Node *n = qobject_cast<Node*>(v.value<QObject*>());
+            nodes << (n && n->project() == this ? n->kplatoNode() : nullptr);
+        }
+    }
+    // Resolve the columns and roles once, see nodeData()
+    QVector<int> columns;
+    QVector<int> roles;
+    for (const QString &property : properties) {
+        const int col = nodeColumnNumber(property);
+        int r = stringToRole(role, m_nodeprogramroles.value(col));
+        if (col == NodeModel::NodeDescription && r == Qt::DisplayRole) {
+            r = Qt::EditRole; // cannot use displayrole here
+        }
+        if (col < 0) {
+            debugPlanScripting<<"Invalid property"<<property;
+        }
+        columns << col;
+        roles << r;
+    }
+    m_nodeTableModel.setManager(kplatoProject()->scheduleManager(scheduleId));
+
+    QVariantList table;
+    table.reserve(nodes.count());
+    for (const KPlato::Node *node : qAsConst(nodes)) {
+        QVariantList row;
+        if (node) {
+            row.reserve(columns.count());
+            for (int i = 0; i < columns.count(); ++i) {
+                const int col = columns.at(i);
+                const int r = roles.at(i);
+                if (col < 0 || r < 0) {
+                    row << QVariant();
+                    continue;
+                }
+                if (r == Qt::TextAlignmentRole) {
+                    row << m_nodeModel.headerData(col, Qt::Horizontal, r);
+                    continue;
+                }
+                QVariant value = m_nodeTableModel.data(node, col, r);
+                if (r == Qt::EditRole) {
+                    switch (col) {
+                        case NodeModel::NodeType:
+                            value = QVariant(node->typeToString(KPlato::Node::NodeTypes(value.toInt()), false));
+                            break;
+                        case NodeModel::NodeConstraint:
+                            value = QVariant(node->constraintList(false).value(value.toInt()));
+                            break;
+                        case NodeModel::NodeActualStart:
+                        case NodeModel::NodeActualFinish:
+                            if (!value.isValid()) {
+                                value = QDateTime::currentDateTime();
+                            }
+                            break;
+                        default:
+                            break;
+                    }
+                }
+                row << value;
+            }
+        }
+        table << QVariant(row);
+    }
+    m_nodeTableModel.setManager(nullptr);
+    return table;
+}
+
+QVariantList Scripting::Project::resourceTable(const QVariantList &resources, const QStringList &properties, const QString &role)
+{
+    QList<const KPlato::Resource*> lst;
+    if (resources.isEmpty()) {
+        const QList<KPlato::Resource*> all = kplatoProject()->resourceList();
+        for (const KPlato::Resource *r : all) {
+            lst << r;
+        }
+    } else {
+        for (const QVariant &v : resources) {
+            Resource *r = qobject_cast<Resource*>(v.value<QObject*>());
+            lst << (r && r->project() == this ? r->kplatoResource() : nullptr);
+        }
+    }
+    // Resolve the columns and roles once, see resourceData()
+    QVector<int> columns;
+    QVector<int> roles;
+    for (const QString &property : properties) {
+        const int col = resourceColumnNumber(property);
+        if (col < 0) {
+            debugPlanScripting<<"Invalid property"<<property;
+        }
+        columns << col;
+        roles << stringToRole(role, m_resourceprogramroles.value(col));
+    }
+    QVariantList table;
+    table.reserve(lst.count());
+    for (const KPlato::Resource *resource : qAsConst(lst)) {
+        QVariantList row;
+        if (resource) {
+            row.reserve(columns.count());
+            for (int i = 0; i < columns.count(); ++i) {
+                if (columns.at(i) < 0 || roles.at(i) < 0) {
+                    row << QVariant();
+                } else {
+                    row << m_resourceTableModel.data(resource, columns.at(i), roles.at(i));
+                }
+            }
+        }
+        table << QVariant(row);
+    }
+    return table;
+}
+
 QVariant Scripting::Project::headerData(int objectType, const QString &property, const QString &role)
 {
     switch (objectType) {
@@ -19,6 +19,7 @@
 #include "kptproject.h"
 #include "kptnodeitemmodel.h"
 #include "kptresourcemodel.h"
+#include "ResourceModel.h"
 #include "kptaccountsmodel.h"
 #include "kptcalendarmodel.h"
 
@@ -90,6 +91,14 @@ namespace Scripting {
             /// 'Invalid'   Invalid indata (e.g. unknown @p object or the @p object does not belong to this project)
             /// 'Error'     Setting data failed for some other reason
             QVariant setData(QObject *object, const QString &property, const QVariant &data, const QString &role = "EditRole");
+            /// Return the @p properties of @p tasks as a table, one row per task with one column per property.
+            /// If @p tasks is empty, the project and all its tasks are returned in tree order.
+            /// Columns, role and schedule are resolved once, so this is much faster than calling data() per value.
+            /// Tasks that do not belong to this project give an empty row.
+            QVariantList taskTable(const QVariantList &tasks, const QStringList &properties, const QString &role = "DisplayRole", qlonglong scheduleId = -1);
+            /// Return the @p properties of @p resources as a table, one row per resource with one column per property.
+            /// If @p resources is empty, all resources of the project are returned.
+            QVariantList resourceTable(const QVariantList &resources, const QStringList &properties, const QString &role = "DisplayRole");
             /// Return header text
             QVariant headerData(int objectType, const QString &property, const QString &role = "DisplayRole");
 
@@ -249,8 +258,10 @@ namespace Scripting {
             KPlato::NodeItemModel m_nodeModel;
             QMap<KPlato::Node*, Node*> m_nodes;
             QMap<int, int> m_nodeprogramroles;
+            KPlato::NodeModel m_nodeTableModel; // used by taskTable(), bypasses the item model indexes
             
             KPlato::ResourceItemModel m_resourceModel;
+            KPlato::ResourceModel m_resourceTableModel; // used by resourceTable()
             QMap<KPlato::ResourceGroup*, ResourceGroup*> m_groups;
             QMap<KPlato::Resource*, Resource*> m_resources;
             QMap<int, int> m_resourceprogramroles;
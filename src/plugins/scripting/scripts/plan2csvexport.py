@@ -66,7 +66,7 @@ class PlanExport:
                 writer.writerow( record )
 
         if objectType == 0: # Nodes
-            self.exportValues( writer, proj, proj, props, schedule )
+            writer.writerows( proj.taskTable( [], props, "DisplayRole", schedule ) )
         elif objectType == 1: # Resources
             for i in range( proj.resourceGroupCount() ):
                 self.exportValues( writer, proj, proj.resourceGroupAt( i ), props, schedule )
@@ -78,7 +78,11 @@ class PlanExport:
             writer.next()
 
         if objectType == 0: # Nodes
-            self.exportValues( writer, proj, proj, props, schedule )
+            for record in proj.taskTable( [], props, "DisplayRole", schedule ):
+                if not writer.setValues(record):
+                    if self.forms.showMessageBox("WarningContinueCancel", T.i18n("Warning"), T.i18n("Failed to set all properties of '%1' to cell '%2'", [", ".join(record), writer.cell()])) == "Cancel":
+                        return
+                writer.next()
         elif objectType == 1: # Resources
             for i in range( proj.resourceGroupCount() ):
                 self.exportValues( writer, proj, proj.resourceGroupAt( i ), props, schedule )
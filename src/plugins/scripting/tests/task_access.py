@@ -285,6 +285,22 @@ try:
     text = asserttext1.format(property, result, before)
     assert result == before, text
 
+    properties = ['Name', 'Type', 'Constraint', 'Description']
+    table = project.taskTable([task], properties, 'EditRole')
+    assert len(table) == 1, "Expected one row, got {0}".format(len(table))
+    for i in range(len(properties)):
+        data = project.data(task, properties[i], 'EditRole')
+        result = table[0][i]
+        text = asserttext1.format(properties[i], result, data)
+        assert result == data, text
+
+    table = project.taskTable([], ['Name'])
+    assert len(table) > project.taskCount(), "Expected the project and its tasks, got {0} rows".format(len(table))
+    data = project.data(project, 'Name')
+    result = table[0][0]
+    text = asserttext1.format('Name', result, data)
+    assert result == data, text
+
 except:
     TestResult.setResult( False )
     TestResult.setMessage("\n" + traceback.format_exc(1))
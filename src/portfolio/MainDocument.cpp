@@ -265,6 +265,48 @@ bool MainDocument::completeSaving(KoStore *store)
     return true;
 }
 
+std::function<bool(KoStore*)> MainDocument::createSaveCopy()
+{
+    // The copies are written in a worker thread
+    const QDomDocument document = saveXML();
+    QList<QPair<QString, QDomDocument>> embedded;
+    for (KoDocument *doc : qAsConst(m_documents)) {
+        if (doc->property(SAVEEMBEDDED).toBool()) {
+            embedded << qMakePair(doc->property(EMBEDDEDURL).toString(), doc->saveXML());
+        }
+    }
+    return [document, embedded](KoStore *store) {
+        if (!store->open(QStringLiteral("root"))) {
+            return false;
+        }
+        bool ok = false;
+        {
+            KoStoreDevice dev(store);
+            const QByteArray s = document.toByteArray(); // utf8 already
+            ok = dev.write(s.data(), s.size()) == s.size();
+        }
+        if (!store->close() || !ok) {
+            return false;
+        }
+        // Same as saveDocumentToStore()
+        for (const auto &doc : embedded) {
+            store->pushDirectory();
+            ok = store->open(QStringLiteral("tar:/") + doc.first);
+            if (ok) {
+                KoStoreDevice dev(store);
+                const QByteArray s = doc.second.toByteArray(); // utf8 already
+                ok = dev.write(s.data(), s.size()) == s.size();
+                ok = store->close() && ok;
+            }
+            store->popDirectory();
+            if (!ok) {
+                return false;
+            }
+        }
+        return true;
+    };
+}
+
 bool MainDocument::isLoading() const
 {
     return KoDocument::isLoading();
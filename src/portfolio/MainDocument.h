@@ -132,6 +132,7 @@ protected:
     bool completeLoading(KoStore* store) override;
     /// Save kplato specific files
     bool completeSaving(KoStore* store) override;
+    std::function<bool(KoStore*)> createSaveCopy() override;
 
     bool isEqual(const char *s1, const char *s2) const;
 
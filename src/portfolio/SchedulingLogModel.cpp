@@ -83,7 +83,7 @@ void SchedulingLogModel::addLogEntry(const KPlato::Schedule::Log &log)
     item->setData(log.severity, SeverityRole);
     item->setEditable(false);
     lst.append(item);
-    lst.append(new QStandardItem(log.message));
+    lst.append(new QStandardItem(log.text()));
     for (QStandardItem *itm : qAsConst(lst)) {
             if (log.resource) {
                 itm->setData(log.resource->id(), IdentityRole);
@@ -42,10 +42,14 @@
 #include <QMenu>
 #include <QComboBox>
 #include <QProgressDialog>
+#include <QThread>
+#include <QTimer>
+#include <QtConcurrent>
 
 SchedulingView::SchedulingView(KoPart *part, KoDocument *doc, QWidget *parent)
     : KoView(part, doc, parent)
     , m_readWrite(false)
+    , m_progress(nullptr)
 {
     //debugPlan;
     setupGui();
@@ -130,6 +134,10 @@ SchedulingView::SchedulingView(KoPart *part, KoDocument *doc, QWidget *parent)
 
 SchedulingView::~SchedulingView()
 {
+    if (m_schedulingWatcher.isRunning()) {
+        m_schedulingContext.scheduler->cancelScheduling(m_schedulingContext);
+        m_schedulingWatcher.waitForFinished();
+    }
 }
 
 void SchedulingView::portfolioChanged()
@@ -301,6 +309,10 @@ void SchedulingView::updateActionsEnabled()
     const auto portfolio = static_cast<MainDocument*>(koDocument());
     const auto docs = portfolio->documents();
     const auto calculateFrom = ui.calculationDateTime->dateTime();
+    if (isScheduling()) {
+        ui.calculate->setEnabled(false);
+        return;
+    }
     bool enable = false;
     for (auto doc : docs) {
         if (doc->property(SCHEDULINGCONTROL).toString() == QStringLiteral("Schedule")) {
@@ -363,23 +375,46 @@ QDateTime SchedulingView::calculationTime() const
 
 void SchedulingView::calculate()
 {
+    if (isScheduling()) {
+        return;
+    }
     MainDocument *portfolio = static_cast<MainDocument*>(koDocument());
-    QVariantList managerNames;
-    {const auto docs = portfolio->documents();
-    for (auto doc : docs) {
-        managerNames << doc->property(SCHEDULEMANAGERNAME);
-    }}
+    m_copies.clear();
     m_schedulingContext.clear();
     m_logModel.setLog(m_schedulingContext.log);
     const auto key = schedulerKey();
     if (calculateSchedule(portfolio->schedulerPlugin(key))) {
-        selectionChanged(QItemSelection(), QItemSelection());
-        if (!m_schedulingContext.cancelScheduling && !m_schedulingContext.projects.isEmpty()) {
-            portfolio->setModified(true);
-        }
+        updateActionsEnabled();
+    }
+}
+
+// Move the scheduling copies and their projects to @p thread,
+// only the thread the copies have affinity with may move them
+static void moveDocuments(const QList<KoDocument*> &documents, QThread *thread)
+{
+    for (KoDocument *doc : documents) {
+        doc->project()->moveToThread(thread);
+        doc->moveToThread(thread);
     }
 }
 
+bool SchedulingView::isScheduling() const
+{
+    return m_schedulingWatcher.isRunning() || !m_mergeQueue.isEmpty();
+}
+
+KoDocument *SchedulingView::copyForScheduling(KoDocument *doc)
+{
+    KoDocument *copy = nullptr;
+    QMetaObject::invokeMethod(doc, "copyForScheduling", Q_RETURN_ARG(KoDocument*, copy));
+    if (copy) {
+        // owned by the context, deleted when the context is cleared
+        m_schedulingContext.calculatedDocuments << copy;
+        m_copies.insert(copy, doc);
+    }
+    return copy;
+}
+
 bool SchedulingView::calculateSchedule(KPlato::SchedulerPlugin *scheduler)
 {
     auto portfolio = static_cast<MainDocument*>(koDocument());
@@ -454,6 +489,32 @@ bool SchedulingView::calculateSchedule(KPlato::SchedulerPlugin *scheduler)
     }
     m_schedulingContext.project->setConstraintEndTime(targetEnd);
 
+    // The scheduler runs in a worker thread on private copies of the documents,
+    // the results are merged into the documents when it has finished
+    QMultiMap<int, KoDocument*> projects;
+    for (it = m_schedulingContext.projects.constBegin(); it != m_schedulingContext.projects.constEnd(); ++it) {
+        auto copy = copyForScheduling(it.value());
+        if (!copy) {
+            warnPortfolio<<"Failed to copy project"<<it.value();
+            KPlato::Schedule::Log log(it.value()->project(), KPlato::Schedule::Log::Type_Error, i18n("Internal error. Failed to copy the project for scheduling."));
+            m_logModel.setLog(QVector<KPlato::Schedule::Log>() << log);
+            if (QApplication::overrideCursor()) {
+                QApplication::restoreOverrideCursor();
+            }
+            return false;
+        }
+        projects.insert(it.key(), copy);
+    }
+    m_schedulingContext.projects = projects;
+    const auto bookings = m_schedulingContext.resourceBookings;
+    m_schedulingContext.resourceBookings.clear();
+    for (auto doc : bookings) {
+        auto copy = copyForScheduling(const_cast<KoDocument*>(doc));
+        if (copy) {
+            m_schedulingContext.resourceBookings << copy;
+        }
+    }
+
     m_progress = new QProgressDialog(this);
     m_progress->setLabelText(i18n("Scheduling projects"));
     m_progress->setWindowModality(Qt::WindowModal);
@@ -462,25 +523,82 @@ bool SchedulingView::calculateSchedule(KPlato::SchedulerPlugin *scheduler)
         if (QApplication::overrideCursor()) {
             QApplication::restoreOverrideCursor();
         }
-        if (!m_progress->wasCanceled()) {
+        if (m_progress && !m_progress->wasCanceled()) {
             m_progress->setValue(value);
         }
     });
-    connect(m_progress, &QProgressDialog::canceled, this, [this]() {
-        m_schedulingContext.scheduler->cancelScheduling(m_schedulingContext);
-    });
-    scheduler->schedule(m_schedulingContext);
-    m_logModel.setLog(m_schedulingContext.log);
+    connect(m_progress, &QProgressDialog::canceled, this, &SchedulingView::cancelScheduling);
+    connect(&m_schedulingWatcher, &QFutureWatcher<void>::finished, this, &SchedulingView::slotSchedulingFinished, Qt::UniqueConnection);
+    // The copies are not used in the ui thread until the scheduler has finished
+    const QList<KoDocument*> copies = m_schedulingContext.calculatedDocuments;
+    QThread *uiThread = thread();
+    m_schedulingWatcher.setFuture(QtConcurrent::run([this, scheduler, copies, uiThread]() {
+        moveDocuments(copies, QThread::currentThread());
+        scheduler->schedule(m_schedulingContext);
+        moveDocuments(copies, uiThread);
+    }));
+    return true;
+}
 
-    for (QMap<int, KoDocument*>::const_iterator it = m_schedulingContext.projects.constBegin(); it != m_schedulingContext.projects.constEnd(); ++it) {
-        portfolio->emitDocumentChanged(it.value());
-        Q_EMIT projectCalculated(it.value()->project(), it.value()->project()->findScheduleManagerByName(it.value()->property(SCHEDULEMANAGERNAME).toString()));
+void SchedulingView::cancelScheduling()
+{
+    if (!m_schedulingWatcher.isRunning()) {
+        return;
+    }
+    // Do not wait for the scheduler, the result is discarded when it has finished
+    m_schedulingContext.scheduler->cancelScheduling(m_schedulingContext);
+    if (m_progress) {
+        m_progress->deleteLater();
+        m_progress = nullptr;
     }
-    m_progress->deleteLater();
     if (QApplication::overrideCursor()) {
         QApplication::restoreOverrideCursor();
     }
-    return true;
+    KPlato::Schedule::Log log(m_schedulingContext.project, KPlato::Schedule::Log::Type_Warning, i18n("Scheduling canceled"));
+    m_logModel.setLog(QVector<KPlato::Schedule::Log>() << log);
+}
+
+void SchedulingView::slotSchedulingFinished()
+{
+    disconnect(m_schedulingContext.scheduler, &KPlato::SchedulerPlugin::progressChanged, this, nullptr);
+    if (m_progress) {
+        m_progress->deleteLater();
+        m_progress = nullptr;
+    }
+    if (QApplication::overrideCursor()) {
+        QApplication::restoreOverrideCursor();
+    }
+    m_logModel.setLog(m_schedulingContext.log);
+    if (m_schedulingContext.cancelScheduling) {
+        updateActionsEnabled();
+        return;
+    }
+    m_mergeQueue = m_schedulingContext.projects.values();
+    mergeNextProject();
+}
+
+void SchedulingView::mergeNextProject()
+{
+    // Merge one project at a time to keep the ui responsive
+    auto portfolio = static_cast<MainDocument*>(koDocument());
+    if (m_mergeQueue.isEmpty()) {
+        selectionChanged(QItemSelection(), QItemSelection());
+        if (!m_schedulingContext.projects.isEmpty()) {
+            portfolio->setModified(true);
+        }
+        updateActionsEnabled();
+        return;
+    }
+    const auto copy = m_mergeQueue.takeFirst();
+    const auto doc = m_copies.value(copy);
+    if (doc) {
+        QMetaObject::invokeMethod(doc, "mergeSchedule", Q_ARG(KPlato::Project*, copy->project()));
+        doc->setProperty(SCHEDULEMANAGERNAME, copy->property(SCHEDULEMANAGERNAME));
+        doc->setModified(true);
+        portfolio->emitDocumentChanged(doc);
+        Q_EMIT projectCalculated(doc->project(), doc->project()->findScheduleManagerByName(doc->property(SCHEDULEMANAGERNAME).toString()));
+    }
+    QTimer::singleShot(0, this, &SchedulingView::mergeNextProject);
 }
 
 void SchedulingView::saveSettings(QDomElement &settings) const
@@ -17,6 +17,9 @@
 
 #include <SchedulingContext.h>
 
+#include <QFutureWatcher>
+#include <QPointer>
+
 class ScheduleManagerInfo;
 
 class KoDocument;
@@ -74,6 +77,10 @@ protected Q_SLOTS:
 
     void portfolioChanged();
 
+    void cancelScheduling();
+    void slotSchedulingFinished();
+    void mergeNextProject();
+
 protected:
     void updateReadWrite(bool readwrite) override;
     void setupGui();
@@ -83,6 +90,8 @@ protected:
 
     QDateTime calculationTime() const;
     bool calculateSchedule(KPlato::SchedulerPlugin *scheduler);
+    bool isScheduling() const;
+    KoDocument *copyForScheduling(KoDocument *doc);
 
 private:
     bool m_readWrite;
@@ -91,6 +100,11 @@ private:
     SchedulingLogModel m_logModel;
     KPlato::SchedulingContext m_schedulingContext;
     QProgressDialog *m_progress;
+    QFutureWatcher<void> m_schedulingWatcher;
+    /// Maps the scheduled copies to the portfolio documents
+    QHash<KoDocument*, QPointer<KoDocument>> m_copies;
+    /// Copies with results not yet merged into the portfolio documents
+    QList<KoDocument*> m_mergeQueue;
 };
 
 #endif